@@ -180,6 +180,7 @@ int main(int argc, char **argv)
                 TableConnector(&cfgDb, CFG_BUFFER_PORT_INGRESS_PROFILE_LIST_NAME),
                 TableConnector(&cfgDb, CFG_BUFFER_PORT_EGRESS_PROFILE_LIST_NAME),
                 TableConnector(&cfgDb, CFG_DEFAULT_LOSSLESS_BUFFER_PARAMETER),
+                TableConnector(&cfgDb, CFG_LOSSLESS_TRAFFIC_PATTERN_TABLE_NAME),
                 TableConnector(&stateDb, STATE_BUFFER_MAXIMUM_VALUE_TABLE)
             };
             cfgOrchList.emplace_back(new BufferMgrDynamic(&cfgDb, &stateDb, &applDb, buffer_table_connectors, db_items_ptr));
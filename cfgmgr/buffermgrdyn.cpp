@@ -1,6 +1,7 @@
 #include <fstream>
 #include <iostream>
 #include <string.h>
+#include <inttypes.h>
 #include "logger.h"
 #include "dbconnector.h"
 #include "producerstatetable.h"
@@ -46,9 +47,16 @@ BufferMgrDynamic::BufferMgrDynamic(DBConnector *cfgDb, DBConnector *stateDb, DBC
         m_stateBufferPoolTable(stateDb, STATE_BUFFER_POOL_TABLE_NAME),
         m_stateBufferProfileTable(stateDb, STATE_BUFFER_PROFILE_TABLE_NAME),
         m_applPortTable(applDb, APP_PORT_TABLE_NAME),
+        m_stateAsicTable(stateDb, "ASIC_TABLE"),
+        m_cfgLosslessTrafficPatternTable(cfgDb, CFG_LOSSLESS_TRAFFIC_PATTERN_TABLE_NAME),
         m_portInitDone(false),
         m_firstTimeCalculateBufferPool(true),
-        m_mmuSizeNumber(0)
+        m_mmuSizeNumber(0),
+        m_bufferModelParamsLoaded(false),
+        m_losslessTrafficPatternLoaded(false),
+        m_bufferPoolDirty(false),
+        m_bufferPoolDirtyCount(0),
+        m_bufferPoolRecalculations(0)
 {
     SWSS_LOG_ENTER();
 
@@ -85,6 +93,12 @@ BufferMgrDynamic::BufferMgrDynamic(DBConnector *cfgDb, DBConnector *stateDb, DBC
         return;
     }
 
+    m_bufferFormula = BufferVendorFormula::create(platform);
+    if (m_bufferFormula)
+    {
+        SWSS_LOG_NOTICE("Headroom and buffer pool sizes are calculated by buffermgrd for platform %s", platform.c_str());
+    }
+
     // Init timer
     auto interv = timespec { .tv_sec = BUFFERMGR_TIMER_PERIOD, .tv_nsec = 0 };
     m_buffermgrPeriodtimer = new SelectableTimer(interv);
@@ -177,6 +191,7 @@ void BufferMgrDynamic::initTableHandlerMap()
 {
     m_bufferTableHandlerMap.insert(buffer_handler_pair(STATE_BUFFER_MAXIMUM_VALUE_TABLE, &BufferMgrDynamic::handleBufferMaxParam));
     m_bufferTableHandlerMap.insert(buffer_handler_pair(CFG_DEFAULT_LOSSLESS_BUFFER_PARAMETER, &BufferMgrDynamic::handleDefaultLossLessBufferParam));
+    m_bufferTableHandlerMap.insert(buffer_handler_pair(CFG_LOSSLESS_TRAFFIC_PATTERN_TABLE_NAME, &BufferMgrDynamic::handleLosslessTrafficPatternTable));
     m_bufferTableHandlerMap.insert(buffer_handler_pair(CFG_BUFFER_POOL_TABLE_NAME, &BufferMgrDynamic::handleBufferPoolTable));
     m_bufferTableHandlerMap.insert(buffer_handler_pair(CFG_BUFFER_PROFILE_TABLE_NAME, &BufferMgrDynamic::handleBufferProfileTable));
     m_bufferTableHandlerMap.insert(buffer_handler_pair(CFG_BUFFER_QUEUE_TABLE_NAME, &BufferMgrDynamic::handleBufferQueueTable));
@@ -274,8 +289,84 @@ string BufferMgrDynamic::getPgPoolMode()
 }
 
 // Meta flows which are called by main flows
+// Fetch the parameters of the vendor formula
+// The ASIC info is fetched only once because it isn't updated at run time
+// The lossless traffic pattern is fetched on first use and then kept up to date by handleLosslessTrafficPatternTable
+bool BufferMgrDynamic::loadBufferModelParams()
+{
+    if (!m_bufferModelParamsLoaded)
+    {
+        vector<string> keys;
+        vector<FieldValueTuple> fvs;
+
+        // Only one key should exist in ASIC_TABLE
+        m_stateAsicTable.getKeys(keys);
+        if (keys.empty() || !m_stateAsicTable.get(keys[0], fvs))
+        {
+            SWSS_LOG_INFO("ASIC_TABLE isn't ready, unable to calculate buffer sizes in buffermgrd");
+            return false;
+        }
+
+        for (auto &fv : fvs)
+        {
+            if (fvField(fv) == "cell_size")
+                m_bufferModelParams.cell_size = fvValue(fv);
+            else if (fvField(fv) == "pipeline_latency")
+                m_bufferModelParams.pipeline_latency = fvValue(fv);
+            else if (fvField(fv) == "mac_phy_delay")
+                m_bufferModelParams.mac_phy_delay = fvValue(fv);
+            else if (fvField(fv) == "peer_response_time")
+                m_bufferModelParams.peer_response_time = fvValue(fv);
+        }
+
+        m_bufferModelParamsLoaded = true;
+    }
+
+    if (!m_losslessTrafficPatternLoaded)
+    {
+        vector<string> keys;
+        vector<FieldValueTuple> fvs;
+
+        // Only one key should exist in LOSSLESS_TRAFFIC_PATTERN
+        m_cfgLosslessTrafficPatternTable.getKeys(keys);
+        if (keys.empty() || !m_cfgLosslessTrafficPatternTable.get(keys[0], fvs))
+        {
+            SWSS_LOG_INFO("LOSSLESS_TRAFFIC_PATTERN isn't ready, unable to calculate buffer sizes in buffermgrd");
+            return false;
+        }
+
+        setLosslessTrafficPattern(fvs);
+    }
+
+    m_bufferModelParams.over_subscribe_ratio = m_overSubscribeRatio;
+    m_bufferModelParams.shared_headroom_pool_size = m_configuredSharedHeadroomPoolSize;
+    m_bufferModelParams.mmu_size = m_mmuSize;
+
+    return true;
+}
+
 void BufferMgrDynamic::calculateHeadroomSize(buffer_profile_t &headroom)
 {
+    if (m_bufferFormula && loadBufferModelParams())
+    {
+        buffer_headroom_t result;
+
+        if (!m_bufferFormula->calculateHeadroom(m_bufferModelParams, headroom.speed, headroom.cable_length,
+                                                headroom.port_mtu, m_identifyGearboxDelay, result))
+        {
+            SWSS_LOG_WARN("Failed to calculate headroom for %s", headroom.name.c_str());
+            return;
+        }
+
+        headroom.xon = result.xon;
+        headroom.xoff = result.xoff;
+        headroom.size = result.size;
+        if (!result.xon_offset.empty())
+            headroom.xon_offset = result.xon_offset;
+
+        return;
+    }
+
     // Call vendor-specific lua plugin to calculate the xon, xoff, xon_offset, size and threshold
     vector<string> keys = {};
     vector<string> argv = {};
@@ -332,12 +423,25 @@ void BufferMgrDynamic::calculateHeadroomSize(buffer_profile_t &headroom)
 // 3. Program to APPL_DB.BUFFER_POOL_TABLE only if its sizes differ from the stored value
 void BufferMgrDynamic::recalculateSharedBufferPool()
 {
+    m_bufferPoolRecalculations++;
+    SWSS_LOG_INFO("Recalculating shared buffer pool size, %" PRIu64 " times for %" PRIu64 " updates so far",
+                  m_bufferPoolRecalculations, m_bufferPoolDirtyCount);
+
     try
     {
-        vector<string> keys = {};
-        vector<string> argv = {};
+        vector<string> ret;
 
-        auto ret = runRedisScript(*m_applDb, m_bufferpoolSha, keys, argv);
+        if (m_bufferFormula && loadBufferModelParams())
+        {
+            m_bufferFormula->calculatePools(m_bufferModelParams, m_bufferModel, ret);
+        }
+        else
+        {
+            vector<string> keys = {};
+            vector<string> argv = {};
+
+            ret = runRedisScript(*m_applDb, m_bufferpoolSha, keys, argv);
+        }
 
         // The format of the result:
         // a list of lines containing key, value pairs with colon as separator
@@ -455,8 +559,19 @@ void BufferMgrDynamic::recalculateSharedBufferPool()
     }
 }
 
+// Called whenever the shared buffer pool size can be affected by an update
+// The size is checked once at the end of handling the batch of updates
+// instead of once per port, PG or profile touched by them
+void BufferMgrDynamic::markSharedBufferPoolDirty()
+{
+    m_bufferPoolDirty = true;
+    m_bufferPoolDirtyCount++;
+}
+
 void BufferMgrDynamic::checkSharedBufferPoolSize()
 {
+    m_bufferPoolDirty = false;
+
     // PortInitDone indicates all steps of port initialization has been done
     // Only after that does the buffer pool size update starts
     if (!m_portInitDone)
@@ -535,6 +650,8 @@ void BufferMgrDynamic::updateBufferProfileToDb(const string &name, const buffer_
 
     m_applBufferProfileTable.set(name, fvVector);
     m_stateBufferProfileTable.set(name, fvVector);
+
+    m_bufferModel.setProfile(name, profile.size, profile.xon, profile.xoff);
 }
 
 // Database operation
@@ -557,10 +674,12 @@ void BufferMgrDynamic::updateBufferPgToDb(const string &key, const string &profi
  
         fvVector.push_back(make_pair("profile", profile_ref));
         m_applBufferPgTable.set(key, fvVector);
+        m_bufferModel.setPriorityGroup(key, profile);
     }
     else
     {
         m_applBufferPgTable.del(key);
+        m_bufferModel.removePriorityGroup(key);
     }
 }
 
@@ -652,6 +771,8 @@ void BufferMgrDynamic::releaseProfile(const string &profile_name)
 
     m_stateBufferProfileTable.del(profile_name);
 
+    m_bufferModel.removeProfile(profile_name);
+
     m_bufferProfileLookup.erase(profile_name);
 
     SWSS_LOG_NOTICE("BUFFER_PROFILE %s has been released successfully", profile_name.c_str());
@@ -752,7 +873,7 @@ task_process_status BufferMgrDynamic::removeAllPgsFromPort(const string &port)
         portPg.running_profile_name.clear();
     }
 
-    checkSharedBufferPoolSize();
+    markSharedBufferPoolDirty();
 
     // Remove the old profile which is probably not referenced anymore.
     if (!profilesToBeReleased.empty())
@@ -883,7 +1004,7 @@ task_process_status BufferMgrDynamic::refreshPriorityGroupsForPort(const string
 
     if (isHeadroomUpdated)
     {
-        checkSharedBufferPoolSize();
+        markSharedBufferPoolDirty();
     }
     else
     {
@@ -1003,7 +1124,7 @@ void BufferMgrDynamic::refreshSharedHeadroomPool(bool enable_state_updated_by_ra
 
     if (m_portInitDone)
     {
-        checkSharedBufferPoolSize();
+        markSharedBufferPoolDirty();
     }
 }
 
@@ -1073,7 +1194,7 @@ task_process_status BufferMgrDynamic::doRemovePgTask(const string &pg_key, const
     SWSS_LOG_NOTICE("Remove BUFFER_PG %s (profile %s, %s)", pg_key.c_str(), bufferPg.running_profile_name.c_str(), bufferPg.configured_profile_name.c_str());
 
     // Recalculate pool size
-    checkSharedBufferPoolSize();
+    markSharedBufferPoolDirty();
 
     if (portInfo.state != PORT_ADMIN_DOWN)
     {
@@ -1123,7 +1244,7 @@ task_process_status BufferMgrDynamic::doUpdateBufferProfileForDynamicTh(buffer_p
         }
     }
 
-    checkSharedBufferPoolSize();
+    markSharedBufferPoolDirty();
 
     return task_process_status::task_success;
 }
@@ -1159,7 +1280,7 @@ task_process_status BufferMgrDynamic::doUpdateBufferProfileForSize(buffer_profil
     }
 
     if (update_pool_size)
-        checkSharedBufferPoolSize();
+        markSharedBufferPoolDirty();
 
     return task_process_status::task_success;
 }
@@ -1232,6 +1353,47 @@ task_process_status BufferMgrDynamic::handleDefaultLossLessBufferParam(KeyOpFiel
     return task_process_status::task_success;
 }
 
+void BufferMgrDynamic::setLosslessTrafficPattern(const vector<FieldValueTuple> &fvs)
+{
+    m_bufferModelParams.lossless_mtu.clear();
+    m_bufferModelParams.small_packet_percentage.clear();
+
+    for (auto &fv : fvs)
+    {
+        if (fvField(fv) == "mtu")
+            m_bufferModelParams.lossless_mtu = fvValue(fv);
+        else if (fvField(fv) == "small_packet_percentage")
+            m_bufferModelParams.small_packet_percentage = fvValue(fv);
+    }
+
+    m_losslessTrafficPatternLoaded = true;
+}
+
+// The new pattern is taken into account by the next headroom and pool calculations, as the lua plugins do
+task_process_status BufferMgrDynamic::handleLosslessTrafficPatternTable(KeyOpFieldsValuesTuple &tuple)
+{
+    string op = kfvOp(tuple);
+
+    if (op == SET_COMMAND)
+    {
+        setLosslessTrafficPattern(kfvFieldsValues(tuple));
+        SWSS_LOG_INFO("Lossless traffic pattern updated, mtu %s small packet percentage %s",
+                      m_bufferModelParams.lossless_mtu.c_str(), m_bufferModelParams.small_packet_percentage.c_str());
+    }
+    else if (op == DEL_COMMAND)
+    {
+        // Fetched again on next use, the buffer sizes can't be calculated until it's configured again
+        m_losslessTrafficPatternLoaded = false;
+    }
+    else
+    {
+        SWSS_LOG_ERROR("Unsupported command %s received for LOSSLESS_TRAFFIC_PATTERN table", op.c_str());
+        return task_process_status::task_failed;
+    }
+
+    return task_process_status::task_success;
+}
+
 task_process_status BufferMgrDynamic::handleCableLenTable(KeyOpFieldsValuesTuple &tuple)
 {
     string op = kfvOp(tuple);
@@ -1389,6 +1551,8 @@ task_process_status BufferMgrDynamic::handlePortTable(KeyOpFieldsValuesTuple &tu
         string &mtu = portInfo.mtu;
         string &speed = portInfo.speed;
 
+        m_bufferModel.setPortSpeed(port, speed);
+
         bool need_refresh_all_pgs = false, need_remove_all_pgs = false;
 
         if (speed_updated || mtu_updated)
@@ -1485,6 +1649,10 @@ task_process_status BufferMgrDynamic::handlePortTable(KeyOpFieldsValuesTuple &tu
             task_status = refreshPriorityGroupsForPort(port, portInfo.speed, portInfo.cable_length, portInfo.mtu);
         }
     }
+    else if (op == DEL_COMMAND)
+    {
+        m_bufferModel.removePort(port);
+    }
 
     return task_status;
 }
@@ -1504,6 +1672,7 @@ task_process_status BufferMgrDynamic::handleBufferPoolTable(KeyOpFieldsValuesTup
         // 2. Record the table in the internal cache m_bufferPoolLookup
         buffer_pool_t &bufferPool = m_bufferPoolLookup[pool];
         string newSHPSize = "0";
+        string configuredSize;
 
         bufferPool.dynamic_size = true;
         for (auto i = kfvFieldsValues(tuple).begin(); i != kfvFieldsValues(tuple).end(); i++)
@@ -1515,6 +1684,7 @@ task_process_status BufferMgrDynamic::handleBufferPoolTable(KeyOpFieldsValuesTup
             if (field == buffer_size_field_name)
             {
                 bufferPool.dynamic_size = false;
+                configuredSize = value;
             }
             else if (field == buffer_pool_xoff_field_name)
             {
@@ -1532,6 +1702,8 @@ task_process_status BufferMgrDynamic::handleBufferPoolTable(KeyOpFieldsValuesTup
             SWSS_LOG_INFO("Inserting BUFFER_POOL table field %s value %s", field.c_str(), value.c_str());
         }
 
+        m_bufferModel.setPool(pool, configuredSize);
+
         bool dontUpdatePoolToDb = bufferPool.dynamic_size;
         if (pool == INGRESS_LOSSLESS_PG_POOL_NAME)
         {
@@ -1579,6 +1751,7 @@ task_process_status BufferMgrDynamic::handleBufferPoolTable(KeyOpFieldsValuesTup
         m_applBufferPoolTable.del(pool);
         m_stateBufferPoolTable.del(pool);
         m_bufferPoolLookup.erase(pool);
+        m_bufferModel.removePool(pool);
     }
     else
     {
@@ -1709,6 +1882,8 @@ task_process_status BufferMgrDynamic::handleBufferProfileTable(KeyOpFieldsValues
 
             m_stateBufferProfileTable.set(profileName, fvVector);
             m_bufferProfileIgnored.insert(profileName);
+
+            m_bufferModel.setProfile(profileName, profileApp.size, profileApp.xon, profileApp.xoff);
         }
     }
     else if (op == DEL_COMMAND)
@@ -1742,6 +1917,7 @@ task_process_status BufferMgrDynamic::handleBufferProfileTable(KeyOpFieldsValues
             {
                 m_applBufferProfileTable.del(profileName);
                 m_stateBufferProfileTable.del(profileName);
+                m_bufferModel.removeProfile(profileName);
             }
 
             m_bufferProfileLookup.erase(profileName);
@@ -1858,6 +2034,7 @@ task_process_status BufferMgrDynamic::handleOneBufferPgEntry(const string &key,
         {
             SWSS_LOG_NOTICE("Inserting BUFFER_PG table entry %s into APPL_DB directly", key.c_str());
             m_applBufferPgTable.set(key, fvVector);
+            m_bufferModel.setPriorityGroup(key, bufferPg.configured_profile_name);
             bufferPg.running_profile_name = bufferPg.configured_profile_name;
         }
 
@@ -1891,6 +2068,7 @@ task_process_status BufferMgrDynamic::handleOneBufferPgEntry(const string &key,
         {
             SWSS_LOG_NOTICE("Removing BUFFER_PG table entry %s from APPL_DB directly", key.c_str());
             m_applBufferPgTable.del(key);
+            m_bufferModel.removePriorityGroup(key);
         }
 
         m_portPgLookup[port].erase(key);
@@ -1949,6 +2127,27 @@ task_process_status BufferMgrDynamic::handleBufferPgTable(KeyOpFieldsValuesTuple
 
 task_process_status BufferMgrDynamic::handleBufferQueueTable(KeyOpFieldsValuesTuple &tuple)
 {
+    string key = kfvKey(tuple);
+    string op = kfvOp(tuple);
+
+    transformSeperator(key);
+
+    if (op == SET_COMMAND)
+    {
+        for (auto i : kfvFieldsValues(tuple))
+        {
+            if (fvField(i) == buffer_profile_field_name)
+            {
+                transformReference(fvValue(i));
+                m_bufferModel.setQueue(key, parseObjectNameFromReference(fvValue(i)));
+            }
+        }
+    }
+    else if (op == DEL_COMMAND)
+    {
+        m_bufferModel.removeQueue(key);
+    }
+
     return doBufferTableTask(tuple, m_applBufferQueueTable);
 }
 
@@ -2035,14 +2234,16 @@ void BufferMgrDynamic::doTask(Consumer &consumer)
         return;
     }
 
-    while (it != consumer.m_toSync.end())
+    bool failed = false;
+    while (!failed && it != consumer.m_toSync.end())
     {
         auto task_status = (this->*(m_bufferTableHandlerMap[table_name]))(it->second);
         switch (task_status)
         {
             case task_process_status::task_failed:
                 SWSS_LOG_ERROR("Failed to process table update");
-                return;
+                failed = true;
+                break;
             case task_process_status::task_need_retry:
                 SWSS_LOG_INFO("Unable to process table update. Will retry...");
                 it++;
@@ -2056,6 +2257,11 @@ void BufferMgrDynamic::doTask(Consumer &consumer)
                 break;
         }
     }
+
+    if (m_bufferPoolDirty)
+    {
+        checkSharedBufferPoolSize();
+    }
 }
 
 void BufferMgrDynamic::doTask(SelectableTimer &timer)
@@ -4,6 +4,7 @@
 #include "dbconnector.h"
 #include "producerstatetable.h"
 #include "orch.h"
+#include "buffermodel.h"
 
 #include <map>
 #include <set>
@@ -14,6 +15,8 @@ namespace swss {
 #define INGRESS_LOSSLESS_PG_POOL_NAME "ingress_lossless_pool"
 #define DEFAULT_MTU_STR             "9100"
 
+#define CFG_LOSSLESS_TRAFFIC_PATTERN_TABLE_NAME "LOSSLESS_TRAFFIC_PATTERN"
+
 #define BUFFERMGR_TIMER_PERIOD 10
 
 typedef struct {
@@ -187,6 +190,10 @@ private:
 
     Table m_applPortTable;
 
+    // Parameters of the headroom calculation
+    Table m_stateAsicTable;
+    Table m_cfgLosslessTrafficPatternTable;
+
     bool m_supportGearbox;
     gearbox_delay_t m_gearboxDelay;
     std::string m_identifyGearboxDelay;
@@ -198,6 +205,13 @@ private:
     std::string m_bufferpoolSha;
     std::string m_checkHeadroomSha;
 
+    // Vendor specific formula which replaces the headroom and buffer pool plugins
+    // The buffer model mirrors the profiles, PGs and queues programmed to APPL_DB
+    // and is updated incrementally, so that the pool size is calculated without iterating them
+    // The lua plugins are used for vendors without a formula
+    std::unique_ptr<BufferVendorFormula> m_bufferFormula;
+    BufferPoolModel m_bufferModel;
+
     // Parameters for headroom generation
     std::string m_mmuSize;
     unsigned long m_mmuSizeNumber;
@@ -205,6 +219,15 @@ private:
 
     std::string m_overSubscribeRatio;
 
+    buffer_model_params_t m_bufferModelParams;
+    bool m_bufferModelParamsLoaded;
+    bool m_losslessTrafficPatternLoaded;
+
+    // The shared buffer pool size needs to be checked after the current batch of updates
+    bool m_bufferPoolDirty;
+    uint64_t m_bufferPoolDirtyCount;
+    uint64_t m_bufferPoolRecalculations;
+
     // Initializers
     void initTableHandlerMap();
     void parseGearboxInfo(std::shared_ptr<std::vector<KeyOpFieldsValuesTuple>> gearboxInfo);
@@ -227,7 +250,10 @@ private:
     void updateBufferPgToDb(const std::string &key, const std::string &profile, bool add);
 
     // Meta flows
+    bool loadBufferModelParams();
+    void setLosslessTrafficPattern(const std::vector<FieldValueTuple> &fvs);
     void calculateHeadroomSize(buffer_profile_t &headroom);
+    void markSharedBufferPoolDirty();
     void checkSharedBufferPoolSize();
     void recalculateSharedBufferPool();
     task_process_status allocateProfile(const std::string &speed, const std::string &cable, const std::string &mtu, const std::string &threshold, const std::string &gearbox_model, std::string &profile_name);
@@ -247,6 +273,7 @@ private:
     // Table update handlers
     task_process_status handleBufferMaxParam(KeyOpFieldsValuesTuple &t);
     task_process_status handleDefaultLossLessBufferParam(KeyOpFieldsValuesTuple &t);
+    task_process_status handleLosslessTrafficPatternTable(KeyOpFieldsValuesTuple &t);
     task_process_status handleCableLenTable(KeyOpFieldsValuesTuple &t);
     task_process_status handlePortTable(KeyOpFieldsValuesTuple &t);
     task_process_status handleBufferPoolTable(KeyOpFieldsValuesTuple &t);
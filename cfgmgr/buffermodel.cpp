@@ -0,0 +1,531 @@
+#include <cctype>
+#include <cmath>
+#include <cstdio>
+#include <cstdlib>
+#include "buffermodel.h"
+
+using namespace std;
+using namespace swss;
+
+// Numbers are converted and printed the way lua does, so that the results
+// are identical to those of the plugins
+static bool parseNumber(const string &str, double &value)
+{
+    if (str.empty())
+        return false;
+
+    char *end = nullptr;
+    value = strtod(str.c_str(), &end);
+
+    return end != str.c_str() && *end == '\0';
+}
+
+static bool parseNumber(const string &str, uint64_t &value)
+{
+    double number;
+
+    if (!parseNumber(str, number) || number < 0)
+        return false;
+
+    value = static_cast<uint64_t>(number);
+    return true;
+}
+
+static string formatNumber(double value)
+{
+    char buf[32];
+
+    snprintf(buf, sizeof(buf), "%.14g", value);
+    return buf;
+}
+
+// Only priority groups and queues of front panel ports are taken into account
+static bool isFrontPanelPort(const string &port)
+{
+    return port.size() > 8 && port.compare(0, 8, "Ethernet") == 0 && isdigit(port[8]);
+}
+
+// Number of priorities or queues in a range, like 2 in "3-4"
+static uint64_t getRangeCount(const string &key)
+{
+    auto pos = key.find(':');
+    if (pos == string::npos)
+        return 1;
+
+    string range = key.substr(pos + 1);
+    auto dash = range.find('-');
+    if (dash == string::npos)
+        return 1;
+
+    uint64_t first, last;
+    if (!parseNumber(range.substr(0, dash), first) || !parseNumber(range.substr(dash + 1), last) || last < first)
+        return 1;
+
+    return last - first + 1;
+}
+
+BufferPoolModel::BufferPoolModel() :
+    m_missingReferences(0),
+    m_occupiedSize(0),
+    m_accumulativeXoff(0)
+{
+}
+
+uint64_t BufferPoolModel::getOccupiedSize(const buffer_model_profile_t &profile, uint64_t size, uint64_t references)
+{
+    if (!profile.exists || !profile.has_size)
+        return 0;
+
+    return size * references;
+}
+
+uint64_t BufferPoolModel::getAccumulativeXoff(const buffer_model_profile_t &profile, uint64_t size, uint64_t references)
+{
+    if (!profile.exists || !profile.has_size || !profile.has_xon_xoff || size == 0)
+        return 0;
+
+    if (profile.xon + profile.xoff <= size)
+        return 0;
+
+    return (profile.xon + profile.xoff - size) * references;
+}
+
+void BufferPoolModel::detach(const buffer_model_profile_t &profile)
+{
+    m_occupiedSize -= getOccupiedSize(profile, profile.size, profile.references);
+    m_accumulativeXoff -= getAccumulativeXoff(profile, profile.size, profile.references);
+}
+
+void BufferPoolModel::attach(const buffer_model_profile_t &profile)
+{
+    m_occupiedSize += getOccupiedSize(profile, profile.size, profile.references);
+    m_accumulativeXoff += getAccumulativeXoff(profile, profile.size, profile.references);
+}
+
+void BufferPoolModel::setProfile(const string &name, const string &size, const string &xon, const string &xoff)
+{
+    auto &profile = m_profiles[name];
+
+    if (profile.exists)
+    {
+        detach(profile);
+    }
+    else
+    {
+        profile.exists = true;
+        m_missingReferences -= profile.items;
+    }
+
+    profile.has_size = parseNumber(size, profile.size);
+    profile.has_xon_xoff = parseNumber(xon, profile.xon) && parseNumber(xoff, profile.xoff);
+
+    attach(profile);
+}
+
+void BufferPoolModel::removeProfile(const string &name)
+{
+    auto it = m_profiles.find(name);
+    if (it == m_profiles.end() || !it->second.exists)
+        return;
+
+    auto &profile = it->second;
+
+    detach(profile);
+    profile.exists = false;
+
+    if (profile.items == 0)
+        m_profiles.erase(it);
+    else
+        m_missingReferences += profile.items;
+}
+
+const buffer_model_profile_t *BufferPoolModel::getProfile(const string &name) const
+{
+    auto it = m_profiles.find(name);
+    if (it == m_profiles.end())
+        return nullptr;
+
+    return &it->second;
+}
+
+void BufferPoolModel::addReferences(const string &name, const string &speed, uint64_t count, bool add)
+{
+    auto &profile = m_profiles[name];
+
+    detach(profile);
+
+    if (add)
+    {
+        profile.items++;
+        profile.references += count;
+        profile.references_by_speed[speed] += count;
+        if (!profile.exists)
+            m_missingReferences++;
+    }
+    else
+    {
+        profile.items--;
+        profile.references -= count;
+        auto &bySpeed = profile.references_by_speed[speed];
+        bySpeed -= count;
+        if (bySpeed == 0)
+            profile.references_by_speed.erase(speed);
+        if (!profile.exists)
+            m_missingReferences--;
+    }
+
+    attach(profile);
+
+    if (!profile.exists && profile.items == 0)
+        m_profiles.erase(name);
+}
+
+void BufferPoolModel::setItem(item_lookup_t &items, const string &key, const string &profile)
+{
+    string port = key.substr(0, key.find(':'));
+    if (!isFrontPanelPort(port))
+        return;
+
+    removeItem(items, key);
+
+    auto &item = items[key];
+    item.port = port;
+    item.profile = profile;
+    item.count = getRangeCount(key);
+
+    auto portRef = m_ports.find(port);
+    addReferences(profile, portRef == m_ports.end() ? "" : portRef->second, item.count, true);
+
+    auto &portItems = (&items == &m_priorityGroups) ? m_portPriorityGroups : m_portQueues;
+    portItems[port].insert(key);
+}
+
+void BufferPoolModel::removeItem(item_lookup_t &items, const string &key)
+{
+    auto it = items.find(key);
+    if (it == items.end())
+        return;
+
+    auto &item = it->second;
+    auto portRef = m_ports.find(item.port);
+    addReferences(item.profile, portRef == m_ports.end() ? "" : portRef->second, item.count, false);
+
+    auto &portItems = (&items == &m_priorityGroups) ? m_portPriorityGroups : m_portQueues;
+    auto &keys = portItems[item.port];
+    keys.erase(key);
+    if (keys.empty())
+        portItems.erase(item.port);
+
+    items.erase(it);
+}
+
+void BufferPoolModel::setPriorityGroup(const string &key, const string &profile)
+{
+    setItem(m_priorityGroups, key, profile);
+}
+
+void BufferPoolModel::removePriorityGroup(const string &key)
+{
+    removeItem(m_priorityGroups, key);
+}
+
+void BufferPoolModel::setQueue(const string &key, const string &profile)
+{
+    setItem(m_queues, key, profile);
+}
+
+void BufferPoolModel::removeQueue(const string &key)
+{
+    removeItem(m_queues, key);
+}
+
+void BufferPoolModel::setPortSpeed(const string &port, const string &speed)
+{
+    auto portRef = m_ports.find(port);
+    string oldSpeed;
+
+    if (portRef != m_ports.end())
+    {
+        if (portRef->second == speed)
+            return;
+        oldSpeed = portRef->second;
+    }
+
+    m_ports[port] = speed;
+
+    // Move the references of the items on the port to the new speed
+    for (auto *lookup : { &m_portPriorityGroups, &m_portQueues })
+    {
+        auto &items = (lookup == &m_portPriorityGroups) ? m_priorityGroups : m_queues;
+        auto keysRef = lookup->find(port);
+        if (keysRef == lookup->end())
+            continue;
+
+        for (auto &key : keysRef->second)
+        {
+            auto &item = items[key];
+            addReferences(item.profile, oldSpeed, item.count, false);
+            addReferences(item.profile, speed, item.count, true);
+        }
+    }
+}
+
+void BufferPoolModel::removePort(const string &port)
+{
+    if (m_ports.find(port) == m_ports.end())
+        return;
+
+    setPortSpeed(port, "");
+    m_ports.erase(port);
+}
+
+void BufferPoolModel::setPool(const string &name, const string &size)
+{
+    m_pools[name] = size;
+}
+
+void BufferPoolModel::removePool(const string &name)
+{
+    m_pools.erase(name);
+}
+
+unique_ptr<BufferVendorFormula> BufferVendorFormula::create(const string &vendor)
+{
+    if (vendor == "mellanox" || vendor == "vs")
+        return unique_ptr<BufferVendorFormula>(new MellanoxBufferFormula());
+
+    return nullptr;
+}
+
+bool MellanoxBufferFormula::calculateHeadroom(const buffer_model_params_t &params,
+                                              const string &speed, const string &cable_length,
+                                              const string &port_mtu, const string &gearbox_delay,
+                                              buffer_headroom_t &headroom) const
+{
+    double port_speed, cable, mtu, gearbox;
+    double cell_size, pipeline_latency, mac_phy_delay, peer_response_time;
+    double lossless_mtu, small_packet_percentage;
+
+    if (!parseNumber(speed, port_speed) ||
+        cable_length.empty() || !parseNumber(cable_length.substr(0, cable_length.size() - 1), cable) ||
+        !parseNumber(port_mtu, mtu))
+    {
+        return false;
+    }
+
+    if (!parseNumber(gearbox_delay, gearbox))
+        gearbox = 0;
+
+    if (!parseNumber(params.cell_size, cell_size) ||
+        !parseNumber(params.pipeline_latency, pipeline_latency) ||
+        !parseNumber(params.mac_phy_delay, mac_phy_delay) ||
+        !parseNumber(params.peer_response_time, peer_response_time) ||
+        !parseNumber(params.lossless_mtu, lossless_mtu) ||
+        !parseNumber(params.small_packet_percentage, small_packet_percentage))
+    {
+        return false;
+    }
+
+    pipeline_latency *= 1024;
+    mac_phy_delay *= 1024;
+    peer_response_time *= 1024;
+
+    double over_subscribe_ratio, shp_size;
+    bool shp_enabled = (parseNumber(params.shared_headroom_pool_size, shp_size) && shp_size != 0) ||
+                       (parseNumber(params.over_subscribe_ratio, over_subscribe_ratio) && over_subscribe_ratio != 0);
+
+    const double speed_of_light = 198000000;
+    const double minimal_packet_size = 64;
+    double speed_overhead = 0;
+
+    // Adjustment for 400G
+    if (port_speed == 400000)
+    {
+        pipeline_latency = 37 * 1024;
+        speed_overhead = mtu;
+    }
+
+    double worst_case_factor;
+    if (cell_size > 2 * minimal_packet_size)
+        worst_case_factor = cell_size / minimal_packet_size;
+    else
+        worst_case_factor = (2 * cell_size) / (1 + cell_size);
+
+    double cell_occupancy = (100 - small_packet_percentage + small_packet_percentage * worst_case_factor) / 100;
+
+    double bytes_on_gearbox = 0;
+    if (gearbox != 0)
+        bytes_on_gearbox = port_speed * gearbox / (8 * 1024);
+
+    double bytes_on_cable = 2 * cable * port_speed * 1000000000 / speed_of_light / (8 * 1024);
+    double propagation_delay = mtu + bytes_on_cable + 2 * bytes_on_gearbox + mac_phy_delay + peer_response_time;
+
+    // Calculate the xoff and xon and then round up at 1024 bytes
+    double xoff_value = lossless_mtu + propagation_delay * cell_occupancy;
+    xoff_value = ceil(xoff_value / 1024) * 1024;
+    double xon_value = ceil(pipeline_latency / 1024) * 1024;
+
+    double headroom_size;
+    if (shp_enabled)
+        headroom_size = xon_value;
+    else
+        headroom_size = xoff_value + xon_value + speed_overhead;
+    headroom_size = ceil(headroom_size / 1024) * 1024;
+
+    headroom.xon = formatNumber(ceil(xon_value));
+    headroom.xoff = formatNumber(ceil(xoff_value));
+    headroom.size = formatNumber(ceil(headroom_size));
+
+    return true;
+}
+
+bool MellanoxBufferFormula::calculatePools(const buffer_model_params_t &params, const BufferPoolModel &model,
+                                           vector<string> &result) const
+{
+    const uint64_t lossypg_reserved = 19 * 1024;
+    const uint64_t lossypg_reserved_400g = 37 * 1024;
+    const uint64_t mgmt_pool_size = 256 * 1024;
+    const uint64_t egress_mirror_headroom = 10 * 1024;
+
+    // The referenced profile hasn't been inserted or has been removed, retry later
+    if (model.getMissingReferences() > 0)
+        return false;
+
+    uint64_t total_port = model.getPortCount();
+    uint64_t occupied = model.getOccupiedSize();
+    uint64_t xoff = model.getAccumulativeXoff();
+    uint64_t lossypg_400g = 0;
+
+    // Each lossy PG reserves some extra buffer, and more on a 400G port
+    auto lossyPg = model.getProfile("ingress_lossy_profile");
+    if (lossyPg)
+    {
+        auto it = lossyPg->references_by_speed.find("400000");
+        if (it != lossyPg->references_by_speed.end())
+            lossypg_400g = it->second;
+
+        occupied -= BufferPoolModel::getOccupiedSize(*lossyPg, lossyPg->size, lossyPg->references);
+        occupied += BufferPoolModel::getOccupiedSize(*lossyPg, lossyPg->size + lossypg_reserved, lossyPg->references);
+        xoff -= BufferPoolModel::getAccumulativeXoff(*lossyPg, lossyPg->size, lossyPg->references);
+        xoff += BufferPoolModel::getAccumulativeXoff(*lossyPg, lossyPg->size + lossypg_reserved, lossyPg->references);
+    }
+
+    // The lossy queues are counted once per port
+    auto lossyQueue = model.getProfile("egress_lossy_profile");
+    if (lossyQueue)
+    {
+        occupied -= BufferPoolModel::getOccupiedSize(*lossyQueue, lossyQueue->size, lossyQueue->references);
+        occupied += BufferPoolModel::getOccupiedSize(*lossyQueue, lossyQueue->size, total_port);
+        xoff -= BufferPoolModel::getAccumulativeXoff(*lossyQueue, lossyQueue->size, lossyQueue->references);
+        xoff += BufferPoolModel::getAccumulativeXoff(*lossyQueue, lossyQueue->size, total_port);
+    }
+
+    auto &pools = model.getPools();
+
+    double over_subscribe_ratio = 0;
+    double shp_size = 0;
+    bool shp_enabled = parseNumber(params.over_subscribe_ratio, over_subscribe_ratio) && over_subscribe_ratio != 0;
+    if (parseNumber(params.shared_headroom_pool_size, shp_size) && shp_size != 0)
+        shp_enabled = true;
+    else
+        shp_size = 0;
+
+    double accumulative_xoff = 0;
+    if (shp_enabled && shp_size == 0)
+        accumulative_xoff = static_cast<double>(xoff);
+
+    double accumulative_occupied_buffer = static_cast<double>(occupied);
+
+    // Extra lossy xon buffer for 400G port
+    accumulative_occupied_buffer += static_cast<double>((lossypg_reserved_400g - lossypg_reserved) * lossypg_400g);
+
+    // Accumulate sizes for egress mirror and management pool
+    double accumulative_egress_mirror_overhead = static_cast<double>(total_port * egress_mirror_headroom);
+    accumulative_occupied_buffer += accumulative_egress_mirror_overhead + static_cast<double>(mgmt_pool_size);
+
+    double mmu_size, cell_size;
+    if (!parseNumber(params.mmu_size, mmu_size))
+    {
+        auto it = pools.find("egress_lossless_pool");
+        if (it == pools.end() || !parseNumber(it->second, mmu_size))
+            return false;
+    }
+    if (!parseNumber(params.cell_size, cell_size))
+        return false;
+
+    // Align mmu_size at cell size boundary, otherwise the sdk will complain and the syncd will fail
+    double ceiling_mmu_size = floor(mmu_size / cell_size) * cell_size;
+
+    // Fetch all the pools that need update
+    vector<string> pools_need_update;
+    int ingress_pool_count = 0;
+    bool has_ingress_lossless_pool_size = false;
+    double ingress_lossless_pool_size = 0;
+    for (auto &pool : pools)
+    {
+        if (pool.first.compare(0, 7, "ingress") != 0)
+            continue;
+
+        double size;
+        if (!parseNumber(pool.second, size))
+        {
+            pools_need_update.push_back(pool.first);
+            ingress_pool_count++;
+        }
+        else if (pool.first == "ingress_lossless_pool" && shp_enabled && shp_size == 0)
+        {
+            has_ingress_lossless_pool_size = true;
+            ingress_lossless_pool_size = size;
+        }
+    }
+    for (auto &pool : pools)
+    {
+        if (pool.first.compare(0, 6, "egress") == 0 && pool.second.empty())
+            pools_need_update.push_back(pool.first);
+    }
+
+    if (shp_enabled && shp_size == 0)
+        shp_size = ceil(accumulative_xoff / over_subscribe_ratio);
+
+    accumulative_occupied_buffer += shp_size;
+
+    double pool_size;
+    if (ingress_pool_count == 1)
+        pool_size = mmu_size - accumulative_occupied_buffer;
+    else
+        pool_size = (mmu_size - accumulative_occupied_buffer) / 2;
+
+    if (pool_size > ceiling_mmu_size)
+        pool_size = ceiling_mmu_size;
+
+    bool shp_deployed = false;
+    for (auto &name : pools_need_update)
+    {
+        if (shp_size != 0 && name == "ingress_lossless_pool")
+        {
+            result.push_back(name + ":" + formatNumber(ceil(pool_size)) + ":" + formatNumber(ceil(shp_size)));
+            shp_deployed = true;
+        }
+        else
+        {
+            result.push_back(name + ":" + formatNumber(ceil(pool_size)));
+        }
+    }
+
+    if (!shp_deployed && shp_size != 0 && has_ingress_lossless_pool_size)
+    {
+        result.push_back("ingress_lossless_pool:" + formatNumber(ceil(ingress_lossless_pool_size)) + ":" + formatNumber(ceil(shp_size)));
+    }
+
+    result.push_back("debug:mmu_size:" + formatNumber(mmu_size));
+    result.push_back("debug:accumulative size:" + formatNumber(accumulative_occupied_buffer));
+    result.push_back("debug:extra_400g:" + to_string(lossypg_reserved_400g - lossypg_reserved) + ":" + to_string(lossypg_400g));
+    result.push_back("debug:mgmt_pool:" + to_string(mgmt_pool_size));
+    result.push_back("debug:egress_mirror:" + formatNumber(accumulative_egress_mirror_overhead));
+    result.push_back(string("debug:shp_enabled:") + (shp_enabled ? "true" : "false"));
+    result.push_back("debug:shp_size:" + formatNumber(shp_size));
+    result.push_back("debug:accumulative xoff:" + formatNumber(accumulative_xoff));
+    result.push_back("debug:total port:" + to_string(total_port));
+
+    return true;
+}
@@ -0,0 +1,183 @@
+#ifndef __BUFFERMODEL__
+#define __BUFFERMODEL__
+
+#include <cstdint>
+#include <map>
+#include <memory>
+#include <set>
+#include <string>
+#include <vector>
+
+namespace swss {
+
+// Parameters the vendor formulas read from the databases
+// - STATE_DB.ASIC_TABLE: cell_size, pipeline_latency, mac_phy_delay, peer_response_time
+// - CONFIG_DB.LOSSLESS_TRAFFIC_PATTERN: mtu, small_packet_percentage
+// - CONFIG_DB.DEFAULT_LOSSLESS_BUFFER_PARAMETER: over_subscribe_ratio
+// - CONFIG_DB.BUFFER_POOL|ingress_lossless_pool: xoff
+// - STATE_DB.BUFFER_MAX_PARAM_TABLE|global: mmu_size
+// Fields are kept as strings so that a missing or an invalid value is
+// handled by the formula the same way the lua plugin handles it.
+typedef struct {
+    std::string cell_size;
+    std::string pipeline_latency;
+    std::string mac_phy_delay;
+    std::string peer_response_time;
+    std::string lossless_mtu;
+    std::string small_packet_percentage;
+    std::string over_subscribe_ratio;
+    std::string shared_headroom_pool_size;
+    std::string mmu_size;
+} buffer_model_params_t;
+
+typedef struct {
+    std::string xon;
+    std::string xoff;
+    std::string size;
+    std::string xon_offset;
+} buffer_headroom_t;
+
+// A profile as it is in APPL_DB.BUFFER_PROFILE_TABLE along with the number of
+// priorities and queues referencing it
+typedef struct {
+    bool exists;
+    bool has_size;
+    bool has_xon_xoff;
+    uint64_t size;
+    uint64_t xon;
+    uint64_t xoff;
+    // Number of BUFFER_PG and BUFFER_QUEUE items referencing the profile
+    uint64_t items;
+    // Number of priorities and queues in the referencing items, in total and per port speed
+    uint64_t references;
+    std::map<std::string, uint64_t> references_by_speed;
+} buffer_model_profile_t;
+
+// Model of the shared buffer usage of the switch
+//
+// It mirrors the BUFFER_PROFILE, BUFFER_PG and BUFFER_QUEUE tables buffermgrd
+// programs to APPL_DB and maintains the accumulative sizes buffer_pool_<vendor>.lua
+// gets by iterating all of them, adjusting them by the delta of each update.
+// Keys of priority groups and queues are <port>:<range> with range like "3-4".
+class BufferPoolModel
+{
+public:
+    BufferPoolModel();
+
+    void setProfile(const std::string &name, const std::string &size, const std::string &xon, const std::string &xoff);
+    void removeProfile(const std::string &name);
+
+    void setPriorityGroup(const std::string &key, const std::string &profile);
+    void removePriorityGroup(const std::string &key);
+    void setQueue(const std::string &key, const std::string &profile);
+    void removeQueue(const std::string &key);
+
+    void setPortSpeed(const std::string &port, const std::string &speed);
+    void removePort(const std::string &port);
+
+    // Pools in CONFIG_DB.BUFFER_POOL, size is empty for pools whose size is dynamically calculated
+    void setPool(const std::string &name, const std::string &size);
+    void removePool(const std::string &name);
+
+    const buffer_model_profile_t *getProfile(const std::string &name) const;
+    const std::map<std::string, std::string> &getPools() const
+    {
+        return m_pools;
+    }
+    uint64_t getPortCount() const
+    {
+        return m_ports.size();
+    }
+    // Number of items referencing a profile which doesn't exist
+    uint64_t getMissingReferences() const
+    {
+        return m_missingReferences;
+    }
+    // Sum of size * references of all profiles
+    uint64_t getOccupiedSize() const
+    {
+        return m_occupiedSize;
+    }
+    // Sum of (xon + xoff - size) * references of all profiles whose xon + xoff exceeds size
+    uint64_t getAccumulativeXoff() const
+    {
+        return m_accumulativeXoff;
+    }
+
+    static uint64_t getOccupiedSize(const buffer_model_profile_t &profile, uint64_t size, uint64_t references);
+    static uint64_t getAccumulativeXoff(const buffer_model_profile_t &profile, uint64_t size, uint64_t references);
+
+private:
+    typedef struct {
+        std::string port;
+        std::string profile;
+        uint64_t count;
+    } item_t;
+
+    typedef std::map<std::string, item_t> item_lookup_t;
+
+    void setItem(item_lookup_t &items, const std::string &key, const std::string &profile);
+    void removeItem(item_lookup_t &items, const std::string &key);
+    void addReferences(const std::string &profile, const std::string &speed, uint64_t count, bool add);
+
+    // Remove the contribution of a profile to the accumulative sizes before it's updated and add it back afterwards
+    void detach(const buffer_model_profile_t &profile);
+    void attach(const buffer_model_profile_t &profile);
+
+    std::map<std::string, buffer_model_profile_t> m_profiles;
+    item_lookup_t m_priorityGroups;
+    item_lookup_t m_queues;
+    // port -> speed
+    std::map<std::string, std::string> m_ports;
+    // port -> keys of priority groups and queues on the port
+    std::map<std::string, std::set<std::string>> m_portPriorityGroups;
+    std::map<std::string, std::set<std::string>> m_portQueues;
+    std::map<std::string, std::string> m_pools;
+
+    uint64_t m_missingReferences;
+    uint64_t m_occupiedSize;
+    uint64_t m_accumulativeXoff;
+};
+
+// Vendor specific formula for the headroom and the buffer pool sizes
+//
+// It takes the place of buffer_headroom_<vendor>.lua and buffer_pool_<vendor>.lua
+// and returns the results in the format of the plugins.
+// A vendor without a formula keeps running the lua plugins.
+class BufferVendorFormula
+{
+public:
+    virtual ~BufferVendorFormula() = default;
+
+    // Returns nullptr if there is no formula for the vendor
+    static std::unique_ptr<BufferVendorFormula> create(const std::string &vendor);
+
+    // Same arguments as the lua plugin: speed, cable length like "5m", port mtu and gearbox delay
+    virtual bool calculateHeadroom(const buffer_model_params_t &params,
+                                   const std::string &speed, const std::string &cable_length,
+                                   const std::string &port_mtu, const std::string &gearbox_delay,
+                                   buffer_headroom_t &headroom) const = 0;
+
+    // The format of the result:
+    //     <pool name>:<pool size>[:<shared headroom pool size>]
+    //     debug:<debug info>
+    virtual bool calculatePools(const buffer_model_params_t &params, const BufferPoolModel &model,
+                                std::vector<std::string> &result) const = 0;
+};
+
+// Formula of buffer_headroom_mellanox.lua and buffer_pool_mellanox.lua, which the vs plugins are copies of
+class MellanoxBufferFormula : public BufferVendorFormula
+{
+public:
+    bool calculateHeadroom(const buffer_model_params_t &params,
+                           const std::string &speed, const std::string &cable_length,
+                           const std::string &port_mtu, const std::string &gearbox_delay,
+                           buffer_headroom_t &headroom) const override;
+
+    bool calculatePools(const buffer_model_params_t &params, const BufferPoolModel &model,
+                        std::vector<std::string> &result) const override;
+};
+
+}
+
+#endif /* __BUFFERMODEL__ */
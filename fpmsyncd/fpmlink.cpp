@@ -235,24 +235,27 @@ uint64_t FpmLink::readData()
            * */
             isRaw = isRawProcessing(nl_hdr);
 
-            nl_msg *msg = nlmsg_convert(nl_hdr);
-            if (msg == NULL)
-            {
-                throw system_error(make_error_code(errc::bad_message), "Unable to convert nlmsg");
-            }
-
-            nlmsg_set_proto(msg, NETLINK_ROUTE);
-
             if (isRaw)
             {
                 /* EVPN Type5 Add route processing */
                 processRawMsg(nl_hdr);
             }
-            else
+            /*
+             * Regular routes are decoded straight from the receive buffer,
+             * only the messages it declines are converted to libnl objects.
+             */
+            else if (!m_routesync->onRouteMsgRaw(nl_hdr))
             {
+                nl_msg *msg = nlmsg_convert(nl_hdr);
+                if (msg == NULL)
+                {
+                    throw system_error(make_error_code(errc::bad_message), "Unable to convert nlmsg");
+                }
+
+                nlmsg_set_proto(msg, NETLINK_ROUTE);
                 NetDispatcher::getInstance().onNetlinkMessage(msg);
+                nlmsg_free(msg);
             }
-            nlmsg_free(msg);
         }
         start += msg_len;
     }
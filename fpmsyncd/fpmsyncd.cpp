@@ -1,5 +1,6 @@
 #include <iostream>
 #include <inttypes.h>
+#include <unistd.h>
 #include "logger.h"
 #include "select.h"
 #include "selectabletimer.h"
@@ -23,6 +24,11 @@ const uint32_t DEFAULT_ROUTING_RESTART_INTERVAL = 120;
 // TODO: support eoiu hold interval config
 const uint32_t DEFAULT_EOIU_HOLD_INTERVAL = 3;
 
+// Interval of the route update counters in STATE_DB
+const uint32_t STATS_INTERVAL = 10;
+
+#define FPMSYNCD_STATS_TABLE_NAME "FPMSYNCD_STATS"
+
 // Check if eoiu state reached by both ipv4 and ipv6
 static bool eoiuFlagsSet(Table &bgpStateTable)
 {
@@ -44,15 +50,55 @@ static bool eoiuFlagsSet(Table &bgpStateTable)
     return true;
 }
 
+void usage()
+{
+    cout << "Usage: fpmsyncd [-w coalescing_window] [-b coalescing_batch_size]" << endl;
+    cout << "    -w coalescing_window: time in milliseconds during which the updates of a" << endl;
+    cout << "                          route are coalesced, 0 (default) disables coalescing" << endl;
+    cout << "    -b coalescing_batch_size: number of coalesced routes written before the" << endl;
+    cout << "                              window has elapsed, 0 (default) for no limit" << endl;
+}
+
 int main(int argc, char **argv)
 {
+    int opt;
+    long coalescingWindow = 0;
+    long coalescingBatchSize = 0;
+
+    while ((opt = getopt(argc, argv, "w:b:h")) != -1 )
+    {
+        switch (opt)
+        {
+        case 'w':
+            coalescingWindow = atol(optarg);
+            break;
+        case 'b':
+            coalescingBatchSize = atol(optarg);
+            break;
+        case 'h':
+            usage();
+            return 1;
+        default: /* '?' */
+            usage();
+            return EXIT_FAILURE;
+        }
+    }
+
+    if (coalescingWindow < 0 || coalescingBatchSize < 0)
+    {
+        usage();
+        return EXIT_FAILURE;
+    }
+
     swss::Logger::linkToDbNative("fpmsyncd");
     DBConnector db("APPL_DB", 0);
     RedisPipeline pipeline(&db);
     RouteSync sync(&pipeline);
+    sync.setCoalescing(chrono::milliseconds(coalescingWindow), (size_t)coalescingBatchSize);
 
     DBConnector stateDb("STATE_DB", 0);
     Table bgpStateTable(&stateDb, STATE_BGP_TABLE_NAME);
+    Table statsTable(&stateDb, FPMSYNCD_STATS_TABLE_NAME);
 
     NetDispatcher::getInstance().registerMessageHandler(RTM_NEWROUTE, &sync);
     NetDispatcher::getInstance().registerMessageHandler(RTM_DELROUTE, &sync);
@@ -68,6 +114,10 @@ int main(int argc, char **argv)
             SelectableTimer eoiuCheckTimer(timespec{0, 0});
             // After eoiu flags are detected, start a hold timer before starting reconciliation.
             SelectableTimer eoiuHoldTimer(timespec{0, 0});
+            // Write the coalesced routes once their window has elapsed, even if no more updates come.
+            SelectableTimer coalescingTimer(timespec{coalescingWindow / 1000, (coalescingWindow % 1000) * 1000000});
+            // Publish the route update counters.
+            SelectableTimer statsTimer(timespec{STATS_INTERVAL, 0});
            
             /*
              * Pipeline should be flushed right away to deal with state pending
@@ -80,6 +130,16 @@ int main(int argc, char **argv)
             cout << "Connected!" << endl;
 
             s.addSelectable(&fpm);
+            /* Keep the interface names used by the route messages up to date */
+            s.addSelectable(&sync.m_ifNameCache);
+
+            if (coalescingWindow)
+            {
+                coalescingTimer.start();
+                s.addSelectable(&coalescingTimer);
+            }
+            statsTimer.start();
+            s.addSelectable(&statsTimer);
 
             /* If warm-restart feature is enabled, execute 'restoration' logic */
             bool warmStartEnabled = sync.m_warmStartHelper.checkAndStart();
@@ -122,6 +182,12 @@ int main(int argc, char **argv)
                 /* Reading FPM messages forever (and calling "readMe" to read them) */
                 s.select(&temps);
 
+                /* Link messages were handled by the interface name cache in readData() */
+                if (temps == &sync.m_ifNameCache)
+                {
+                    continue;
+                }
+
                 /*
                  * Upon expiration of the warm-restart timer or eoiu Hold Timer, proceed to run the
                  * reconciliation process if not done yet and remove the timer from
@@ -182,8 +248,15 @@ int main(int argc, char **argv)
                         s.removeSelectable(&eoiuCheckTimer);
                     }
                 }
+                else if (temps == &statsTimer)
+                {
+                    vector<FieldValueTuple> fvs;
+                    sync.getStats(fvs);
+                    statsTable.set("route", fvs);
+                }
                 else if (!warmStartEnabled || sync.m_warmStartHelper.isReconciled())
                 {
+                    sync.flushRoutes();
                     pipeline.flush();
                     SWSS_LOG_DEBUG("Pipeline flushed");
                 }
@@ -192,6 +265,10 @@ int main(int argc, char **argv)
         catch (FpmLink::FpmConnectionClosedException &e)
         {
             cout << "Connection lost, reconnecting..." << endl;
+            /* Don't hold the last updates of the peer until it reconnects */
+            sync.flushRoutes(true);
+            pipeline.flush();
+            SWSS_LOG_DEBUG("Pipeline flushed");
         }
         catch (const exception& e)
         {
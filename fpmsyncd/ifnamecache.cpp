@@ -0,0 +1,199 @@
+#include <inttypes.h>
+#include <string.h>
+#include <netlink/msg.h>
+#include <netlink/route/link.h>
+#include "logger.h"
+#include "fpmsyncd/ifnamecache.h"
+
+using namespace std;
+using namespace std::chrono;
+using namespace swss;
+
+/* Receive buffer of the link socket, as swss::NetLink */
+#define LINK_SOCKET_BUFFER_SIZE 3145728
+
+IfNameCache::IfNameCache(milliseconds negativeTimeout) :
+    m_nl_sock(NULL), m_link_sock(NULL), m_link_cache(NULL),
+    m_negativeTimeout(negativeTimeout),
+    m_hits(0), m_misses(0), m_negativeHits(0), m_refills(0)
+{
+    m_nl_sock = nl_socket_alloc();
+    nl_connect(m_nl_sock, NETLINK_ROUTE);
+    rtnl_link_alloc_cache(m_nl_sock, AF_UNSPEC, &m_link_cache);
+
+    if (m_link_cache)
+    {
+        nl_cache_foreach(m_link_cache, addLink, this);
+    }
+    m_lastRefill = steady_clock::now();
+
+    m_link_sock = nl_socket_alloc();
+    nl_socket_disable_seq_check(m_link_sock);
+    nl_socket_modify_cb(m_link_sock, NL_CB_VALID, NL_CB_CUSTOM, onLinkMsg, this);
+
+    int err = nl_connect(m_link_sock, NETLINK_ROUTE);
+    if (err < 0 || (err = nl_socket_add_membership(m_link_sock, RTNLGRP_LINK)) < 0)
+    {
+        SWSS_LOG_ERROR("Failed to listen to link messages: %s", nl_geterror(err));
+    }
+    nl_socket_set_nonblocking(m_link_sock);
+    nl_socket_set_buffer_size(m_link_sock, LINK_SOCKET_BUFFER_SIZE, 0);
+}
+
+IfNameCache::~IfNameCache()
+{
+    if (m_link_cache)
+    {
+        nl_cache_free(m_link_cache);
+    }
+    nl_socket_free(m_link_sock);
+    nl_socket_free(m_nl_sock);
+}
+
+void IfNameCache::addLink(struct nl_object *obj, void *arg)
+{
+    auto cache = static_cast<IfNameCache *>(arg);
+    struct rtnl_link *link = (struct rtnl_link *)obj;
+
+    const char *name = rtnl_link_get_name(link);
+    if (!name)
+    {
+        return;
+    }
+
+    int if_index = rtnl_link_get_ifindex(link);
+    cache->m_names[if_index] = name;
+    cache->m_unknown.erase(if_index);
+}
+
+void IfNameCache::onMsg(int nlmsg_type, struct nl_object *obj)
+{
+    if (nlmsg_type == RTM_NEWLINK)
+    {
+        addLink(obj, this);
+    }
+    else if (nlmsg_type == RTM_DELLINK)
+    {
+        m_names.erase(rtnl_link_get_ifindex((struct rtnl_link *)obj));
+    }
+}
+
+struct LinkMsg
+{
+    IfNameCache *cache;
+    int nlmsg_type;
+};
+
+int IfNameCache::onLinkMsg(struct nl_msg *msg, void *arg)
+{
+    LinkMsg linkMsg = { static_cast<IfNameCache *>(arg), nlmsg_hdr(msg)->nlmsg_type };
+
+    nl_msg_parse(msg, [](struct nl_object *obj, void *arg) {
+        auto linkMsg = static_cast<LinkMsg *>(arg);
+        linkMsg->cache->onMsg(linkMsg->nlmsg_type, obj);
+    }, &linkMsg);
+
+    return NL_OK;
+}
+
+int IfNameCache::getFd()
+{
+    return nl_socket_get_fd(m_link_sock);
+}
+
+uint64_t IfNameCache::readData()
+{
+    int err;
+
+    do
+    {
+        err = nl_recvmsgs_default(m_link_sock);
+    }
+    while (err == -NLE_INTR);
+
+    /* ENOBUFS, the kernel dropped link messages the table may miss */
+    if (err == -NLE_NOMEM)
+    {
+        SWSS_LOG_WARN("Link socket overrun, refilling the interface names");
+        refill();
+    }
+    else if (err < 0 && err != -NLE_AGAIN)
+    {
+        SWSS_LOG_ERROR("Failed to read link messages: %s", nl_geterror(err));
+    }
+
+    return 0;
+}
+
+/* Replace the table with a full link dump from the kernel */
+void IfNameCache::refill()
+{
+    m_refills++;
+    m_lastRefill = steady_clock::now();
+
+    if (!m_link_cache || nl_cache_refill(m_nl_sock, m_link_cache) < 0)
+    {
+        SWSS_LOG_ERROR("Failed to refill the link cache");
+        return;
+    }
+
+    m_names.clear();
+    nl_cache_foreach(m_link_cache, addLink, this);
+
+    for (auto it = m_unknown.begin(); it != m_unknown.end();)
+    {
+        if (it->second <= m_lastRefill)
+        {
+            it = m_unknown.erase(it);
+        }
+        else
+        {
+            ++it;
+        }
+    }
+
+    SWSS_LOG_INFO("Refilled %zu links, hits %" PRIu64 " misses %" PRIu64 " negative hits %" PRIu64 " refills %" PRIu64,
+                  m_names.size(), m_hits, m_misses, m_negativeHits, m_refills);
+}
+
+bool IfNameCache::getIfName(int if_index, char *if_name, size_t name_len)
+{
+    if (!if_name || name_len == 0)
+    {
+        return false;
+    }
+
+    memset(if_name, 0, name_len);
+
+    auto it = m_names.find(if_index);
+    if (it == m_names.end())
+    {
+        m_misses++;
+
+        /* Only repeated misses of the same index are rate limited */
+        auto now = steady_clock::now();
+        auto unknown = m_unknown.find(if_index);
+        if (unknown != m_unknown.end() && now < unknown->second)
+        {
+            m_negativeHits++;
+            return false;
+        }
+
+        /* Cannot get interface name. Possibly the interface gets re-created. */
+        refill();
+
+        it = m_names.find(if_index);
+        if (it == m_names.end())
+        {
+            m_unknown[if_index] = now + m_negativeTimeout;
+            return false;
+        }
+    }
+    else
+    {
+        m_hits++;
+    }
+
+    strncpy(if_name, it->second.c_str(), name_len - 1);
+    return true;
+}
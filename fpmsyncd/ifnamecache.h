@@ -0,0 +1,77 @@
+#ifndef __IFNAMECACHE__
+#define __IFNAMECACHE__
+
+#include <stdint.h>
+#include <chrono>
+#include <string>
+#include <unordered_map>
+#include "netmsg.h"
+#include "selectable.h"
+
+namespace swss {
+
+/*
+ * IfNameCache maps interface/VRF indexes to names for RouteSync.
+ *
+ * The table is filled by a link dump at startup and kept current by
+ * RTM_NEWLINK/RTM_DELLINK messages, so lookups never query the kernel. An
+ * unknown index triggers a full link dump. An index still unknown after the
+ * dump is cached as unknown for the negative timeout, unless a link message
+ * announces it earlier, so only its repeated misses are rate limited.
+ *
+ * Link messages are read from a RTNLGRP_LINK socket of the cache itself. When
+ * the socket overruns, link messages were lost and the table is refilled.
+ */
+class IfNameCache : public NetMsg, public Selectable
+{
+public:
+    IfNameCache(std::chrono::milliseconds negativeTimeout = std::chrono::milliseconds(10000));
+    virtual ~IfNameCache();
+
+    /* Listen to RTM_NEWLINK, RTM_DELLINK to track interface names */
+    virtual void onMsg(int nlmsg_type, struct nl_object *obj);
+
+    /* Read the link messages of the RTNLGRP_LINK socket */
+    int getFd() override;
+    uint64_t readData() override;
+
+    /*
+     * Get interface/VRF name based on interface/VRF index
+     * @arg if_index          Interface/VRF index
+     * @arg if_name           String to store interface name
+     * @arg name_len          Length of destination string, including terminating zero byte
+     *
+     * Return true if we successfully gets the interface/VRF name.
+     */
+    bool getIfName(int if_index, char *if_name, size_t name_len);
+
+    uint64_t getHits() const { return m_hits; }
+    uint64_t getMisses() const { return m_misses; }
+    uint64_t getNegativeHits() const { return m_negativeHits; }
+    uint64_t getRefills() const { return m_refills; }
+
+private:
+    struct nl_sock     *m_nl_sock;
+    struct nl_sock     *m_link_sock;
+    struct nl_cache    *m_link_cache;
+
+    std::unordered_map<int, std::string> m_names;
+    /* Unknown index to the time its negative entry expires */
+    std::unordered_map<int, std::chrono::steady_clock::time_point> m_unknown;
+
+    std::chrono::milliseconds m_negativeTimeout;
+    std::chrono::steady_clock::time_point m_lastRefill;
+
+    uint64_t m_hits;
+    uint64_t m_misses;
+    uint64_t m_negativeHits;
+    uint64_t m_refills;
+
+    void refill();
+    static void addLink(struct nl_object *obj, void *arg);
+    static int onLinkMsg(struct nl_msg *msg, void *arg);
+};
+
+}
+
+#endif
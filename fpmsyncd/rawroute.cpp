@@ -0,0 +1,179 @@
+#include <stdio.h>
+#include <string.h>
+#include <arpa/inet.h>
+#include "fpmsyncd/rawroute.h"
+
+using namespace std;
+using namespace swss;
+
+#define IPV4_MAX_BYTE       4
+#define IPV6_MAX_BYTE      16
+
+static const unsigned char anyaddr[IPV6_MAX_BYTE] = {0};
+
+size_t RawRouteMsg::addrLen() const
+{
+    return family == AF_INET ? IPV4_MAX_BYTE : IPV6_MAX_BYTE;
+}
+
+bool RawRouteMsg::parse(const struct nlmsghdr *h)
+{
+    msg_type = h->nlmsg_type;
+    nexthops.clear();
+
+    if (msg_type != RTM_NEWROUTE && msg_type != RTM_DELROUTE)
+    {
+        return false;
+    }
+
+    if (h->nlmsg_len < NLMSG_LENGTH(sizeof(struct rtmsg)))
+    {
+        return false;
+    }
+
+    const struct rtmsg *rtm = (const struct rtmsg *)NLMSG_DATA(h);
+
+    family = rtm->rtm_family;
+    if (family != AF_INET && family != AF_INET6)
+    {
+        return false;
+    }
+
+    dst_len = rtm->rtm_dst_len;
+    if (dst_len > addrLen() * 8)
+    {
+        return false;
+    }
+
+    route_type = rtm->rtm_type;
+    table = rtm->rtm_table;
+    dst = NULL;
+
+    const struct rtattr *gateway = NULL;
+    const struct rtattr *oif = NULL;
+    const struct rtattr *multipath = NULL;
+    bool single = false;
+
+    int len = (int)(h->nlmsg_len - NLMSG_LENGTH(sizeof(struct rtmsg)));
+    for (const struct rtattr *rta = RTM_RTA(rtm); RTA_OK(rta, len); rta = RTA_NEXT(rta, len))
+    {
+        switch (rta->rta_type)
+        {
+            case RTA_DST:
+                if (RTA_PAYLOAD(rta) < addrLen())
+                {
+                    return false;
+                }
+                dst = RTA_DATA(rta);
+                break;
+            case RTA_TABLE:
+                if (RTA_PAYLOAD(rta) < sizeof(uint32_t))
+                {
+                    return false;
+                }
+                table = *(const uint32_t *)RTA_DATA(rta);
+                break;
+            case RTA_GATEWAY:
+                gateway = rta;
+                single = true;
+                break;
+            case RTA_OIF:
+                oif = rta;
+                single = true;
+                break;
+            case RTA_FLOW:
+                single = true;
+                break;
+            case RTA_MULTIPATH:
+                multipath = rta;
+                break;
+            default:
+                break;
+        }
+    }
+
+    if (multipath)
+    {
+        return parseMultipath(multipath);
+    }
+
+    if (single)
+    {
+        NextHop nh = { NULL, 0 };
+        if (gateway && RTA_PAYLOAD(gateway) >= addrLen())
+        {
+            nh.gateway = RTA_DATA(gateway);
+        }
+        if (oif && RTA_PAYLOAD(oif) >= sizeof(int))
+        {
+            nh.ifindex = *(const int *)RTA_DATA(oif);
+        }
+        nexthops.push_back(nh);
+    }
+
+    return true;
+}
+
+bool RawRouteMsg::parseMultipath(const struct rtattr *rta)
+{
+    const struct rtnexthop *rtnh = (const struct rtnexthop *)RTA_DATA(rta);
+    int len = (int)RTA_PAYLOAD(rta);
+
+    while (len >= (int)sizeof(*rtnh))
+    {
+        if (rtnh->rtnh_len < sizeof(*rtnh) || rtnh->rtnh_len > len)
+        {
+            return false;
+        }
+
+        NextHop nh = { NULL, rtnh->rtnh_ifindex };
+
+        int attrlen = (int)(rtnh->rtnh_len - sizeof(*rtnh));
+        for (const struct rtattr *attr = (const struct rtattr *)RTNH_DATA(rtnh);
+             RTA_OK(attr, attrlen); attr = RTA_NEXT(attr, attrlen))
+        {
+            if (attr->rta_type == RTA_GATEWAY && RTA_PAYLOAD(attr) >= addrLen())
+            {
+                nh.gateway = RTA_DATA(attr);
+            }
+        }
+
+        nexthops.push_back(nh);
+
+        len -= NLMSG_ALIGN(rtnh->rtnh_len);
+        rtnh = RTNH_NEXT(rtnh);
+    }
+
+    return true;
+}
+
+void RawRouteMsg::formatDst(char *buf, size_t len) const
+{
+    char addr[INET6_ADDRSTRLEN] = {0};
+    inet_ntop(family, dst ? dst : anyaddr, addr, sizeof(addr));
+
+    if (dst_len == addrLen() * 8)
+    {
+        snprintf(buf, len, "%s", addr);
+    }
+    else
+    {
+        snprintf(buf, len, "%s/%u", addr, dst_len);
+    }
+}
+
+void RawRouteMsg::formatGateways(string &out) const
+{
+    char addr[INET6_ADDRSTRLEN];
+
+    for (size_t i = 0; i < nexthops.size(); i++)
+    {
+        if (i)
+        {
+            out += ',';
+        }
+
+        inet_ntop(family, nexthops[i].gateway ? nexthops[i].gateway : anyaddr, addr, sizeof(addr));
+        out += addr;
+    }
+}
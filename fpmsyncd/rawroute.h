@@ -0,0 +1,52 @@
+#ifndef __RAWROUTE__
+#define __RAWROUTE__
+
+#include <stdint.h>
+#include <linux/netlink.h>
+#include <linux/rtnetlink.h>
+#include <string>
+#include <vector>
+
+namespace swss {
+
+/*
+ * RawRouteMsg decodes a RTM_NEWROUTE/RTM_DELROUTE message in place, without
+ * converting it to libnl objects. Addresses point into the message, which
+ * must outlive the decoded fields. The next hop vector is reused from one
+ * message to the next, so decoding does not allocate once it is warm.
+ */
+struct RawRouteMsg
+{
+    struct NextHop
+    {
+        /* Gateway address in network order, NULL if there is no gateway */
+        const void *gateway;
+        int ifindex;
+    };
+
+    uint16_t msg_type;
+    unsigned char family;
+    unsigned char dst_len;
+    unsigned char route_type;
+    uint32_t table;
+    /* Destination address in network order, NULL for the any address */
+    const void *dst;
+    std::vector<NextHop> nexthops;
+
+    /* Return false if the message is not a well formed IPv4/IPv6 route */
+    bool parse(const struct nlmsghdr *h);
+
+    /* Destination as printed by nl_addr2str, "addr" or "addr/len" */
+    void formatDst(char *buf, size_t len) const;
+
+    /* Append the gateways separated by ',', the any address for none */
+    void formatGateways(std::string &out) const;
+
+private:
+    size_t addrLen() const;
+    bool parseMultipath(const struct rtattr *rta);
+};
+
+}
+
+#endif
@@ -0,0 +1,129 @@
+#include "fpmsyncd/routecoalescer.h"
+
+using namespace std;
+using namespace std::chrono;
+using namespace swss;
+
+RouteCoalescer::RouteCoalescer(SetFn setFn, DelFn delFn) :
+    m_setFn(setFn),
+    m_delFn(delFn),
+    m_window(0),
+    m_maxBatch(0),
+    m_updates(0),
+    m_writes(0),
+    m_suppressed(0),
+    m_flushes(0)
+{
+}
+
+void RouteCoalescer::setWindow(milliseconds window, size_t maxBatch)
+{
+    flush(true);
+
+    m_window = window;
+    m_maxBatch = maxBatch;
+}
+
+RouteCoalescer::Pending &RouteCoalescer::getPending(const string &key)
+{
+    auto it = m_pending.find(key);
+    if (it != m_pending.end())
+    {
+        return it->second;
+    }
+
+    if (m_order.empty())
+    {
+        m_oldest = steady_clock::now();
+    }
+    m_order.push_back(key);
+
+    Pending &pending = m_pending[key];
+    pending.del = false;
+    pending.set = false;
+    return pending;
+}
+
+void RouteCoalescer::set(const string &key, const vector<FieldValueTuple> &values)
+{
+    m_updates++;
+
+    if (m_window.count() == 0)
+    {
+        m_writes++;
+        m_setFn(key, values);
+        return;
+    }
+
+    Pending &pending = getPending(key);
+    if (pending.set)
+    {
+        m_suppressed++;
+    }
+
+    pending.set = true;
+    pending.values = values;
+
+    flush();
+}
+
+void RouteCoalescer::del(const string &key)
+{
+    m_updates++;
+
+    if (m_window.count() == 0)
+    {
+        m_writes++;
+        m_delFn(key);
+        return;
+    }
+
+    Pending &pending = getPending(key);
+    if (pending.set)
+    {
+        m_suppressed++;
+    }
+    if (pending.del)
+    {
+        m_suppressed++;
+    }
+
+    pending.del = true;
+    pending.set = false;
+    pending.values.clear();
+
+    flush();
+}
+
+void RouteCoalescer::flush(bool force)
+{
+    if (m_order.empty())
+    {
+        return;
+    }
+
+    if (!force && (m_maxBatch == 0 || m_order.size() < m_maxBatch)
+        && steady_clock::now() - m_oldest < m_window)
+    {
+        return;
+    }
+
+    for (const auto &key : m_order)
+    {
+        auto &pending = m_pending[key];
+        if (pending.del)
+        {
+            m_writes++;
+            m_delFn(key);
+        }
+        if (pending.set)
+        {
+            m_writes++;
+            m_setFn(key, pending.values);
+        }
+    }
+
+    m_flushes++;
+    m_pending.clear();
+    m_order.clear();
+}
@@ -0,0 +1,79 @@
+#ifndef __ROUTECOALESCER__
+#define __ROUTECOALESCER__
+
+#include <stdint.h>
+#include <chrono>
+#include <functional>
+#include <string>
+#include <unordered_map>
+#include <vector>
+#include "table.h"
+
+namespace swss {
+
+/*
+ * RouteCoalescer holds route updates for a short window and keeps only the
+ * latest state of every prefix, so a prefix flapping several times within
+ * the window is written once.
+ *
+ * A delete followed by a set is kept as a delete and a set, which clears the
+ * fields of the previous route the same way as the original updates would.
+ * Pending updates are written in the order their prefix was first updated
+ * once the window has elapsed since the oldest one, or when the number of
+ * pending prefixes reaches the batch size, zero meaning no size bound. A
+ * zero window disables coalescing and every update is written right away.
+ */
+class RouteCoalescer
+{
+public:
+    typedef std::function<void(const std::string &, const std::vector<FieldValueTuple> &)> SetFn;
+    typedef std::function<void(const std::string &)> DelFn;
+
+    RouteCoalescer(SetFn setFn, DelFn delFn);
+
+    void setWindow(std::chrono::milliseconds window, size_t maxBatch);
+    std::chrono::milliseconds getWindow() const { return m_window; }
+
+    void set(const std::string &key, const std::vector<FieldValueTuple> &values);
+    void del(const std::string &key);
+
+    /* Write the pending updates if they are due, or unconditionally if forced */
+    void flush(bool force = false);
+
+    size_t pending() const { return m_order.size(); }
+
+    uint64_t getUpdates() const { return m_updates; }
+    uint64_t getWrites() const { return m_writes; }
+    uint64_t getSuppressed() const { return m_suppressed; }
+    uint64_t getFlushes() const { return m_flushes; }
+
+private:
+    struct Pending
+    {
+        bool del;
+        bool set;
+        std::vector<FieldValueTuple> values;
+    };
+
+    SetFn m_setFn;
+    DelFn m_delFn;
+
+    std::chrono::milliseconds m_window;
+    size_t m_maxBatch;
+
+    std::unordered_map<std::string, Pending> m_pending;
+    /* Prefixes in the order of their first pending update */
+    std::vector<std::string> m_order;
+    std::chrono::steady_clock::time_point m_oldest;
+
+    uint64_t m_updates;
+    uint64_t m_writes;
+    uint64_t m_suppressed;
+    uint64_t m_flushes;
+
+    Pending &getPending(const std::string &key);
+};
+
+}
+
+#endif
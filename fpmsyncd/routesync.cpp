@@ -11,9 +11,11 @@
 #include "fpmsyncd/routesync.h"
 #include "macaddress.h"
 #include <string.h>
+#include <inttypes.h>
 #include <arpa/inet.h>
 
 using namespace std;
+using namespace std::chrono;
 using namespace swss;
 
 #define VXLAN_IF_NAME_PREFIX    "Brvxlan"
@@ -43,14 +45,43 @@ using namespace swss;
 
 RouteSync::RouteSync(RedisPipeline *pipeline) :
     m_routeTable(pipeline, APP_ROUTE_TABLE_NAME, true),
+    m_routeCoalescer(
+        [this](const string &key, const vector<FieldValueTuple> &fvs) { m_routeTable.set(key, fvs); },
+        [this](const string &key) { m_routeTable.del(key); }),
     m_vnet_routeTable(pipeline, APP_VNET_RT_TABLE_NAME, true),
     m_vnet_tunnelTable(pipeline, APP_VNET_RT_TUNNEL_TABLE_NAME, true),
-    m_warmStartHelper(pipeline, &m_routeTable, APP_ROUTE_TABLE_NAME, "bgp", "bgp"),
-    m_nl_sock(NULL), m_link_cache(NULL)
+    m_warmStartHelper(pipeline, &m_routeTable, APP_ROUTE_TABLE_NAME, "bgp", "bgp")
 {
-    m_nl_sock = nl_socket_alloc();
-    nl_connect(m_nl_sock, NETLINK_ROUTE);
-    rtnl_link_alloc_cache(m_nl_sock, AF_UNSPEC, &m_link_cache);
+}
+
+void RouteSync::setCoalescing(milliseconds window, size_t maxBatch)
+{
+    SWSS_LOG_NOTICE("Route coalescing window %" PRId64 " ms, batch size %zu",
+                    (int64_t)window.count(), maxBatch);
+    m_routeCoalescer.setWindow(window, maxBatch);
+}
+
+milliseconds RouteSync::getCoalescingWindow() const
+{
+    return m_routeCoalescer.getWindow();
+}
+
+void RouteSync::flushRoutes(bool force)
+{
+    m_routeCoalescer.flush(force);
+}
+
+void RouteSync::getStats(vector<FieldValueTuple> &fvs) const
+{
+    fvs.clear();
+    fvs.emplace_back("route_updates", to_string(m_routeCoalescer.getUpdates()));
+    fvs.emplace_back("route_writes", to_string(m_routeCoalescer.getWrites()));
+    fvs.emplace_back("route_suppressed", to_string(m_routeCoalescer.getSuppressed()));
+    fvs.emplace_back("route_flushes", to_string(m_routeCoalescer.getFlushes()));
+    fvs.emplace_back("ifname_hits", to_string(m_ifNameCache.getHits()));
+    fvs.emplace_back("ifname_misses", to_string(m_ifNameCache.getMisses()));
+    fvs.emplace_back("ifname_negative_hits", to_string(m_ifNameCache.getNegativeHits()));
+    fvs.emplace_back("ifname_refills", to_string(m_ifNameCache.getRefills()));
 }
 
 char *RouteSync::prefixMac2Str(char *mac, char *buf, int size)
@@ -445,7 +476,7 @@ void RouteSync::onEvpnRouteMsg(struct nlmsghdr *h, int len)
     {
         if (!warmRestartInProgress)
         {
-            m_routeTable.del(destipprefix);
+            m_routeCoalescer.del(destipprefix);
             return;
         }
         else
@@ -522,7 +553,7 @@ void RouteSync::onEvpnRouteMsg(struct nlmsghdr *h, int len)
 
     if (!warmRestartInProgress)
     {
-        m_routeTable.set(destipprefix, fvVector);
+        m_routeCoalescer.set(destipprefix, fvVector);
         SWSS_LOG_DEBUG("RouteTable set msg: %s vtep:%s vni:%s mac:%s intf:%s",
                        destipprefix, nexthops.c_str(), vni_list.c_str(), mac_list.c_str(), intf_list.c_str());
     }
@@ -635,6 +666,125 @@ void RouteSync::onRouteMsg(int nlmsg_type, struct nl_object *obj, char *vrf)
     dip = rtnl_route_get_dst(route_obj);
     nl_addr2str(dip, destipprefix + strlen(destipprefix), MAX_ADDR_SIZE);
 
+    string nexthops;
+    string ifnames;
+    auto route_type = rtnl_route_get_type(route_obj);
+
+    if (nlmsg_type == RTM_NEWROUTE && route_type == RTN_UNICAST)
+    {
+        /* Get nexthop lists */
+        nexthops = getNextHopGw(route_obj);
+        ifnames = getNextHopIf(route_obj);
+    }
+
+    writeRoute(nlmsg_type, destipprefix, route_type, nexthops, ifnames);
+}
+
+bool RouteSync::onRouteMsgRaw(struct nlmsghdr *h)
+{
+    if (!m_rawRoute.parse(h))
+    {
+        return false;
+    }
+
+    char destipprefix[IFNAMSIZ + MAX_ADDR_SIZE + 2] = {0};
+
+    /* if the table_id is not set in the route msg then route is for default vrf. */
+    if (m_rawRoute.table)
+    {
+        char master_name[IFNAMSIZ] = {0};
+        getIfName(m_rawRoute.table, master_name, IFNAMSIZ);
+
+        /* VNET routes are handled by onMsg() */
+        if (!strncmp(master_name, VNET_PREFIX, strlen(VNET_PREFIX)))
+        {
+            return false;
+        }
+
+        /*
+         * Now vrf device name is required to start with VRF_PREFIX,
+         * it is difficult to split vrf_name:ipv6_addr.
+         */
+        if (memcmp(master_name, VRF_PREFIX, strlen(VRF_PREFIX)))
+        {
+            SWSS_LOG_ERROR("Invalid VRF name %s (ifindex %u)", master_name, m_rawRoute.table);
+            return true;
+        }
+        memcpy(destipprefix, master_name, strlen(master_name));
+        destipprefix[strlen(master_name)] = ':';
+    }
+
+    size_t offset = strlen(destipprefix);
+    m_rawRoute.formatDst(destipprefix + offset, sizeof(destipprefix) - offset);
+
+    m_rawNextHops.clear();
+    m_rawIfNames.clear();
+
+    if (m_rawRoute.msg_type == RTM_NEWROUTE && m_rawRoute.route_type == RTN_UNICAST)
+    {
+        m_rawRoute.formatGateways(m_rawNextHops);
+
+        for (size_t i = 0; i < m_rawRoute.nexthops.size(); i++)
+        {
+            char if_name[IFNAMSIZ] = "0";
+
+            /* If we cannot get the interface name */
+            if (!getIfName(m_rawRoute.nexthops[i].ifindex, if_name, IFNAMSIZ))
+            {
+                strcpy(if_name, "unknown");
+            }
+
+            if (i)
+            {
+                m_rawIfNames += ',';
+            }
+            m_rawIfNames += if_name;
+        }
+    }
+
+    writeRoute(m_rawRoute.msg_type, destipprefix, m_rawRoute.route_type, m_rawNextHops, m_rawIfNames);
+    return true;
+}
+
+/*
+ * Return true if one of the interfaces is eth0 or docker0
+ * @arg ifnames     Interface names separated by ','
+ */
+static bool hasMgmtIfName(const string &ifnames)
+{
+    size_t start = 0;
+
+    while (start <= ifnames.size())
+    {
+        size_t end = ifnames.find(',', start);
+        if (end == string::npos)
+        {
+            end = ifnames.size();
+        }
+
+        if (!ifnames.compare(start, end - start, "eth0") ||
+            !ifnames.compare(start, end - start, "docker0"))
+        {
+            return true;
+        }
+
+        start = end + 1;
+    }
+
+    return false;
+}
+
+/*
+ * Write regular route (include VRF route)
+ * @arg nlmsg_type      Netlink message type
+ * @arg destipprefix    Destination prefix, prefixed by the vrf name
+ * @arg route_type      Route type
+ * @arg nexthops        Next hop gateways, for unicast routes
+ * @arg ifnames         Next hop interfaces, for unicast routes
+ */
+void RouteSync::writeRoute(int nlmsg_type, const char *destipprefix, unsigned char route_type,
+                           const string &nexthops, const string &ifnames)
+{
     /*
      * Upon arrival of a delete msg we could either push the change right away,
      * or we could opt to defer it if we are going through a warm-reboot cycle.
@@ -645,7 +795,7 @@ void RouteSync::onRouteMsg(int nlmsg_type, struct nl_object *obj, char *vrf)
     {
         if (!warmRestartInProgress)
         {
-            m_routeTable.del(destipprefix);
+            m_routeCoalescer.del(destipprefix);
             return;
         }
         else
@@ -667,14 +817,14 @@ void RouteSync::onRouteMsg(int nlmsg_type, struct nl_object *obj, char *vrf)
         return;
     }
 
-    switch (rtnl_route_get_type(route_obj))
+    switch (route_type)
     {
         case RTN_BLACKHOLE:
         {
             vector<FieldValueTuple> fvVector;
             FieldValueTuple fv("blackhole", "true");
             fvVector.push_back(fv);
-            m_routeTable.set(destipprefix, fvVector);
+            m_routeCoalescer.set(destipprefix, fvVector);
             return;
         }
         case RTN_UNICAST:
@@ -690,30 +840,22 @@ void RouteSync::onRouteMsg(int nlmsg_type, struct nl_object *obj, char *vrf)
             return;
     }
 
-    struct nl_list_head *nhs = rtnl_route_get_nexthops(route_obj);
-    if (!nhs)
+    /* Every next hop has an interface name, "unknown" if it cannot be found */
+    if (ifnames.empty())
     {
         SWSS_LOG_INFO("Nexthop list is empty for %s", destipprefix);
         return;
     }
 
-    /* Get nexthop lists */
-    string nexthops = getNextHopGw(route_obj);
-    string ifnames = getNextHopIf(route_obj);
-
-    vector<string> alsv = tokenize(ifnames, ',');
-    for (auto alias : alsv)
+    /*
+     * An FRR behavior change from 7.2 to 7.5 makes FRR update default route to eth0 in interface
+     * up/down events. Skipping routes to eth0 or docker0 to avoid such behavior
+     */
+    if (hasMgmtIfName(ifnames))
     {
-        /*
-         * An FRR behavior change from 7.2 to 7.5 makes FRR update default route to eth0 in interface
-         * up/down events. Skipping routes to eth0 or docker0 to avoid such behavior
-         */
-        if (alias == "eth0" || alias == "docker0")
-        {
-            SWSS_LOG_DEBUG("Skip routes to eth0 or docker0: %s %s %s",
-                    destipprefix, nexthops.c_str(), ifnames.c_str());
-            return;
-        }
+        SWSS_LOG_DEBUG("Skip routes to eth0 or docker0: %s %s %s",
+                destipprefix, nexthops.c_str(), ifnames.c_str());
+        return;
     }
 
     vector<FieldValueTuple> fvVector;
@@ -725,7 +867,7 @@ void RouteSync::onRouteMsg(int nlmsg_type, struct nl_object *obj, char *vrf)
 
     if (!warmRestartInProgress)
     {
-        m_routeTable.set(destipprefix, fvVector);
+        m_routeCoalescer.set(destipprefix, fvVector);
         SWSS_LOG_DEBUG("RouteTable set msg: %s %s %s",
                        destipprefix, nexthops.c_str(), ifnames.c_str());
     }
@@ -865,25 +1007,7 @@ void RouteSync::onVnetRouteMsg(int nlmsg_type, struct nl_object *obj, string vne
  */
 bool RouteSync::getIfName(int if_index, char *if_name, size_t name_len)
 {
-    if (!if_name || name_len == 0)
-    {
-        return false;
-    }
-
-    memset(if_name, 0, name_len);
-
-    /* Cannot get interface name. Possibly the interface gets re-created. */
-    if (!rtnl_link_i2name(m_link_cache, if_index, if_name, name_len))
-    {
-        /* Trying to refill cache */
-        nl_cache_refill(m_nl_sock, m_link_cache);
-        if (!rtnl_link_i2name(m_link_cache, if_index, if_name, name_len))
-        {
-            return false;
-        }
-    }
-
-    return true;
+    return m_ifNameCache.getIfName(if_index, if_name, name_len);
 }
 
 /*
@@ -5,6 +5,9 @@
 #include "producerstatetable.h"
 #include "netmsg.h"
 #include "warmRestartHelper.h"
+#include "fpmsyncd/rawroute.h"
+#include "fpmsyncd/ifnamecache.h"
+#include "fpmsyncd/routecoalescer.h"
 #include <string.h>
 #include <bits/stdc++.h>
 
@@ -26,21 +29,49 @@ public:
     virtual void onMsg(int nlmsg_type, struct nl_object *obj);
 
     virtual void onMsgRaw(struct nlmsghdr *obj);
+
+    /*
+     * Handle a regular route (include VRF route) straight from the netlink
+     * message. Return false if the message must go through onMsg().
+     */
+    bool onRouteMsgRaw(struct nlmsghdr *h);
+
+    /* Coalesce the updates of a prefix within the window, zero disables it */
+    void setCoalescing(std::chrono::milliseconds window, size_t maxBatch);
+    std::chrono::milliseconds getCoalescingWindow() const;
+
+    /* Write the coalesced routes to the route table if they are due or forced */
+    void flushRoutes(bool force = false);
+
+    /* Route update and interface name counters */
+    void getStats(vector<FieldValueTuple> &fvs) const;
+
     WarmStartHelper  m_warmStartHelper;
+    /* Interface/VRF names, to be fed with RTM_NEWLINK/RTM_DELLINK messages */
+    IfNameCache      m_ifNameCache;
 
 private:
     /* regular route table */
     ProducerStateTable  m_routeTable;
+    /* updates to the regular route table */
+    RouteCoalescer      m_routeCoalescer;
     /* vnet route table */
     ProducerStateTable  m_vnet_routeTable;
     /* vnet vxlan tunnel table */  
     ProducerStateTable  m_vnet_tunnelTable; 
-    struct nl_cache    *m_link_cache;
-    struct nl_sock     *m_nl_sock;
+
+    /* Decoding buffers reused by onRouteMsgRaw() */
+    RawRouteMsg         m_rawRoute;
+    string              m_rawNextHops;
+    string              m_rawIfNames;
 
     /* Handle regular route (include VRF route) */
     void onRouteMsg(int nlmsg_type, struct nl_object *obj, char *vrf);
 
+    /* Write a regular route, next hops are only used by unicast routes */
+    void writeRoute(int nlmsg_type, const char *destipprefix, unsigned char route_type,
+                    const string &nexthops, const string &ifnames);
+
     void parseEncap(struct rtattr *tb, uint32_t &encap_value, string &rmac);
 
     void parseRtAttrNested(struct rtattr **tb, int max,
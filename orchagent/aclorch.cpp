@@ -1,7 +1,9 @@
 #include <inttypes.h>
 #include <limits.h>
 #include <unordered_map>
+#include <unordered_set>
 #include <algorithm>
+#include <system_error>
 #include "aclorch.h"
 #include "logger.h"
 #include "schema.h"
@@ -11,20 +13,27 @@
 #include "timer.h"
 #include "crmorch.h"
 #include "sai_serialize.h"
+#include "rediscommand.h"
+#include "redisreply.h"
+#include "batcheddbwriter.h"
 
 using namespace std;
 using namespace swss;
 
-mutex AclOrch::m_countersMutex;
 map<acl_range_properties_t, AclRange*> AclRange::m_ranges;
-condition_variable AclOrch::m_sleepGuard;
-bool AclOrch::m_bCollectCounters = true;
 sai_uint32_t AclRule::m_minPriority = 0;
 sai_uint32_t AclRule::m_maxPriority = 0;
 
 swss::DBConnector AclOrch::m_db("COUNTERS_DB", 0);
+swss::Table AclOrch::m_aclCounterRuleMap(&m_db, COUNTERS_ACL_COUNTER_RULE_MAP);
 swss::Table AclOrch::m_countersTable(&m_db, "COUNTERS");
 
+static const unordered_set<string> acl_counter_stats =
+{
+    "SAI_ACL_COUNTER_ATTR_PACKETS",
+    "SAI_ACL_COUNTER_ATTR_BYTES",
+};
+
 extern sai_acl_api_t*    sai_acl_api;
 extern sai_port_api_t*   sai_port_api;
 extern sai_switch_api_t* sai_switch_api;
@@ -657,7 +666,7 @@ AclRuleCounters AclRule::getCounters()
 {
     SWSS_LOG_ENTER();
 
-    if (!m_createCounter)
+    if (!m_createCounter || m_counterOid == SAI_NULL_OBJECT_ID)
     {
         return AclRuleCounters();
     }
@@ -792,6 +801,8 @@ bool AclRule::createCounter()
 
     gCrmOrch->incCrmAclTableUsedCounter(CrmResourceType::CRM_ACL_COUNTER, m_tableOid);
 
+    m_pAclOrch->registerFlexCounter(*this);
+
     return true;
 }
 
@@ -818,6 +829,8 @@ bool AclRule::removeCounter()
         return true;
     }
 
+    m_pAclOrch->deregisterFlexCounter(*this);
+
     if (sai_acl_api->remove_acl_counter(m_counterOid) != SAI_STATUS_SUCCESS)
     {
         SWSS_LOG_ERROR("Failed to remove ACL counter for rule %s in table %s", m_id.c_str(), m_tableId.c_str());
@@ -826,9 +839,6 @@ bool AclRule::removeCounter()
 
     gCrmOrch->decCrmAclTableUsedCounter(CrmResourceType::CRM_ACL_COUNTER, m_tableOid);
 
-    SWSS_LOG_INFO("Removing record about the counter %" PRIx64 " from the DB", m_counterOid);
-    AclOrch::getCountersTable().del(getTableId() + ":" + getId());
-
     m_counterOid = SAI_NULL_OBJECT_ID;
 
     return true;
@@ -1260,6 +1270,16 @@ bool AclRuleMirror::create()
 }
 
 bool AclRuleMirror::remove()
+{
+    if (!deactivate())
+    {
+        return false;
+    }
+
+    return AclRule::removeCounter();
+}
+
+bool AclRuleMirror::deactivate()
 {
     if (!m_state)
     {
@@ -1281,6 +1301,22 @@ bool AclRuleMirror::remove()
     return true;
 }
 
+bool AclRuleMirror::createCounter()
+{
+    if (m_counterOid != SAI_NULL_OBJECT_ID)
+    {
+        return true;
+    }
+
+    return AclRule::createCounter();
+}
+
+bool AclRuleMirror::removeCounter()
+{
+    // Released in remove() together with the rule
+    return true;
+}
+
 void AclRuleMirror::update(SubjectType type, void *cntx)
 {
     if (type != SUBJECT_TYPE_MIRROR_SESSION_CHANGE)
@@ -1302,11 +1338,8 @@ void AclRuleMirror::update(SubjectType type, void *cntx)
     }
     else
     {
-        // Store counters before deactivating ACL rule
-        counters += AclRule::getCounters();
-
         SWSS_LOG_INFO("Deactivating mirroring ACL %s for session %s", m_id.c_str(), m_sessionName.c_str());
-        remove();
+        deactivate();
     }
 }
 
@@ -1819,18 +1852,6 @@ bool AclTable::clear()
     return true;
 }
 
-AclRuleCounters AclRuleMirror::getCounters()
-{
-    AclRuleCounters cnt(counters);
-
-    if (m_state)
-    {
-        cnt += AclRule::getCounters();
-    }
-
-    return cnt;
-}
-
 AclRuleDTelFlowWatchListEntry::AclRuleDTelFlowWatchListEntry(AclOrch *aclOrch, DTelOrch *dtel, string rule, string table, acl_table_type_t type) :
         AclRule(aclOrch, rule, table, type),
         m_pDTelOrch(dtel)
@@ -2326,8 +2347,6 @@ void AclOrch::init(vector<TableConnector>& connectors, PortsOrch *portOrch, Mirr
     m_mirrorOrch->attach(this);
     gPortsOrch->attach(this);
 
-    // Should be initialized last to guaranty that object is
-    // initialized before thread start.
     auto interv = timespec { .tv_sec = COUNTERS_READ_INTERVAL, .tv_nsec = 0 };
     auto timer = new SelectableTimer(interv);
     auto executor = new ExecutableTimer(timer, this, "ACL_POLL_TIMER");
@@ -2560,7 +2579,10 @@ AclOrch::AclOrch(vector<TableConnector>& connectors, SwitchOrch *switchOrch,
         m_mirrorOrch(mirrorOrch),
         m_neighOrch(neighOrch),
         m_routeOrch(routeOrch),
-        m_dTelOrch(dtelOrch)
+        m_dTelOrch(dtelOrch),
+        m_flexCounterManager(ACL_STAT_COUNTER_FLEX_COUNTER_GROUP, StatsMode::READ,
+                ACL_COUNTER_FLEX_COUNTER_POLLING_INTERVAL_MS, true),
+        m_countersRunning(false)
 {
     SWSS_LOG_ENTER();
 
@@ -2575,6 +2597,8 @@ AclOrch::AclOrch(vector<TableConnector>& connectors, SwitchOrch *switchOrch,
 
 AclOrch::~AclOrch()
 {
+    stopCountersThread();
+
     m_mirrorOrch->detach(this);
 
     if (m_dTelOrch)
@@ -2582,9 +2606,6 @@ AclOrch::~AclOrch()
         m_dTelOrch->detach(this);
     }
 
-    m_bCollectCounters = false;
-    m_sleepGuard.notify_all();
-
     deleteDTelWatchListTables();
 }
 
@@ -2599,8 +2620,6 @@ void AclOrch::update(SubjectType type, void *cntx)
         return;
     }
 
-    unique_lock<mutex> lock(m_countersMutex);
-
     // ACL table deals with port change
     // ACL rule deals with mirror session change and int session change
     for (auto& table : m_AclTables)
@@ -2632,12 +2651,10 @@ void AclOrch::doTask(Consumer &consumer)
 
     if (table_name == CFG_ACL_TABLE_TABLE_NAME || table_name == APP_ACL_TABLE_TABLE_NAME)
     {
-        unique_lock<mutex> lock(m_countersMutex);
         doAclTableTask(consumer);
     }
     else if (table_name == CFG_ACL_RULE_TABLE_NAME || table_name == APP_ACL_RULE_TABLE_NAME)
     {
-        unique_lock<mutex> lock(m_countersMutex);
         doAclRuleTask(consumer);
     }
     else
@@ -2855,6 +2872,7 @@ bool AclOrch::addAclTable(AclTable &newTable)
     if (createBindAclTable(newTable, table_oid))
     {
         m_AclTables[table_oid] = newTable;
+        m_AclTableOids[table_id] = table_oid;
         SWSS_LOG_NOTICE("Created ACL table %s oid:%" PRIx64,
                 newTable.id.c_str(), table_oid);
 
@@ -2906,6 +2924,7 @@ bool AclOrch::removeAclTable(string table_id)
         }
 
         SWSS_LOG_NOTICE("Successfully deleted ACL table %s", table_id.c_str());
+        m_AclTableOids.erase(m_AclTables[table_oid].id);
         m_AclTables.erase(table_oid);
 
         // Clear mirror table information
@@ -3429,12 +3448,10 @@ sai_object_id_t AclOrch::getTableById(string table_id)
         return SAI_NULL_OBJECT_ID;
     }
 
-    for (auto it : m_AclTables)
+    auto it = m_AclTableOids.find(table_id);
+    if (it != m_AclTableOids.end())
     {
-        if (it.second.id == table_id)
-        {
-            return it.first;
-        }
+        return it->second;
     }
 
     // Check if the table is a mirror table and a sibling mirror table is created
@@ -3501,30 +3518,216 @@ sai_status_t AclOrch::deleteUnbindAclTable(sai_object_id_t table_oid)
     return sai_acl_api->remove_acl_table(table_oid);
 }
 
+void AclOrch::registerFlexCounter(AclRule &rule)
+{
+    SWSS_LOG_ENTER();
+
+    sai_object_id_t counter_oid = rule.getCounterOid();
+
+    m_flexCounterManager.setCounterIdList(counter_oid, CounterType::ACL_COUNTER, acl_counter_stats);
+
+    vector<FieldValueTuple> fields;
+    fields.emplace_back(rule.getTableId() + ":" + rule.getId(), sai_serialize_object_id(counter_oid));
+    m_aclCounterRuleMap.set("", fields);
+}
+
+void AclOrch::deregisterFlexCounter(AclRule &rule)
+{
+    SWSS_LOG_ENTER();
+
+    m_flexCounterManager.clearCounterIdList(rule.getCounterOid());
+    m_db.hdel(COUNTERS_ACL_COUNTER_RULE_MAP, rule.getTableId() + ":" + rule.getId());
+
+    SWSS_LOG_INFO("Removing record about the counter %" PRIx64 " from the DB", rule.getCounterOid());
+    m_countersTable.del(rule.getTableId() + ":" + rule.getId());
+}
+
+void AclOrch::startCountersThread()
+{
+    SWSS_LOG_ENTER();
+
+    if (m_countersRunning)
+    {
+        return;
+    }
+
+    m_countersRunning = true;
+    m_countersThread = thread(&AclOrch::countersThread, this);
+}
+
+void AclOrch::stopCountersThread()
+{
+    SWSS_LOG_ENTER();
+
+    if (!m_countersRunning)
+    {
+        return;
+    }
+
+    {
+        lock_guard<mutex> lock(m_countersMutex);
+        m_countersRunning = false;
+    }
+    m_countersCv.notify_one();
+    m_countersThread.join();
+}
+
+void AclOrch::countersThread()
+{
+    SWSS_LOG_ENTER();
+
+    while (true)
+    {
+        {
+            unique_lock<mutex> lock(m_countersMutex);
+            m_countersCv.wait(lock, [this]() { return !m_countersRunning || m_countersCopyPending; });
+            if (!m_countersRunning)
+            {
+                return;
+            }
+            m_countersCopyPending = false;
+        }
+
+        copyRuleCounters();
+    }
+}
+
 void AclOrch::doTask(SelectableTimer &timer)
 {
     SWSS_LOG_ENTER();
 
-    for (auto& table_it : m_AclTables)
+    if (!m_countersRunning)
     {
-        vector<swss::FieldValueTuple> values;
+        copyRuleCounters();
+        return;
+    }
 
-        for (auto rule_it : table_it.second.rules)
+    // A copy still running when the timer fires again is not queued twice
+    {
+        lock_guard<mutex> lock(m_countersMutex);
+        m_countersCopyPending = true;
+    }
+    m_countersCv.notify_one();
+}
+
+static void readHmgetReplies(redisContext *ctx, size_t count, vector<vector<shared_ptr<string>>> &replies)
+{
+    for (size_t i = 0; i < count; i++)
+    {
+        redisReply *reply = nullptr;
+        if (redisGetReply(ctx, reinterpret_cast<void **>(&reply)) != REDIS_OK)
         {
-            AclRuleCounters cnt = rule_it.second->getCounters();
+            throw system_error(make_error_code(errc::io_error), "Failed to read ACL counters");
+        }
 
-            swss::FieldValueTuple fvtp("Packets", to_string(cnt.packets));
-            values.push_back(fvtp);
-            swss::FieldValueTuple fvtb("Bytes", to_string(cnt.bytes));
-            values.push_back(fvtb);
+        RedisReply r(reply);
+        replies.emplace_back();
 
-            AclOrch::getCountersTable().set(rule_it.second->getTableId() + ":"
-                    + rule_it.second->getId(), values, "");
+        if (reply->type != REDIS_REPLY_ARRAY)
+        {
+            continue;
+        }
+
+        for (size_t j = 0; j < reply->elements; j++)
+        {
+            redisReply *element = reply->element[j];
+            replies.back().push_back(element->type == REDIS_REPLY_STRING ?
+                    make_shared<string>(element->str, element->len) :
+                    nullptr);
         }
-        values.clear();
     }
 }
 
+/*
+ * Copy the counters polled by syncd to the COUNTERS:<table>:<rule> hashes,
+ * which aclshow reads. Only COUNTERS_DB is read, never the SAI or the ACL
+ * tables, so the copy may run on its own thread. The counters of
+ * COUNTERS_READ_BATCH rules are read in one round trip and the hashes are
+ * written through the shared BatchedDbWriter.
+ */
+void AclOrch::copyRuleCounters()
+{
+    SWSS_LOG_ENTER();
+
+    if (!m_countersCopyDb)
+    {
+        m_countersCopyDb.reset(new DBConnector("COUNTERS_DB", 0));
+    }
+
+    vector<FieldValueTuple> rules;
+    Table(m_countersCopyDb.get(), COUNTERS_ACL_COUNTER_RULE_MAP).get("", rules);
+
+    redisContext *ctx = m_countersCopyDb->getContext();
+    string prefix = m_countersTable.getTableName() + m_countersTable.getTableNameSeparator();
+    auto &writer = BatchedDbWriter::get(m_countersCopyDb->getDbName());
+    set<string> written;
+
+    for (size_t begin = 0; begin < rules.size(); begin += COUNTERS_READ_BATCH)
+    {
+        size_t end = min(rules.size(), begin + COUNTERS_READ_BATCH);
+        vector<vector<shared_ptr<string>>> replies;
+
+        try
+        {
+            for (size_t i = begin; i < end; i++)
+            {
+                RedisCommand hmget;
+                hmget.format("HMGET %s %s %s", (prefix + fvValue(rules[i])).c_str(),
+                        "SAI_ACL_COUNTER_ATTR_PACKETS",
+                        "SAI_ACL_COUNTER_ATTR_BYTES");
+
+                if (redisAppendFormattedCommand(ctx, hmget.c_str(), hmget.length()) != REDIS_OK)
+                {
+                    throw system_error(make_error_code(errc::io_error), "Failed to request ACL counters");
+                }
+            }
+
+            // Every reply is read before writing any, none is left pending on the connection
+            readHmgetReplies(ctx, end - begin, replies);
+        }
+        catch (const exception &e)
+        {
+            // Replies of a failed round trip cannot be matched to their commands anymore
+            SWSS_LOG_ERROR("Failed to copy ACL counters: %s", e.what());
+            m_countersCopyDb.reset();
+            return;
+        }
+
+        for (size_t i = begin; i < end; i++)
+        {
+            const auto &values = replies[i - begin];
+            if (values.size() != 2 || (!values[0] && !values[1]))
+            {
+                // Not polled yet
+                continue;
+            }
+
+            writer.set(m_countersTable.getTableName(), fvField(rules[i]), {
+                    { "Packets", values[0] ? *values[0] : "0" },
+                    { "Bytes", values[1] ? *values[1] : "0" } });
+            written.insert(fvField(rules[i]));
+        }
+    }
+
+    // A rule removed after its name was read had its hash deleted before it was written again
+    set<string> names;
+    for (const auto &rule : rules)
+    {
+        names.insert(fvField(rule));
+    }
+
+    for (const auto &key : m_countersCopyKeys)
+    {
+        if (names.find(key) == names.end())
+        {
+            writer.del(m_countersTable.getTableName(), key);
+        }
+    }
+
+    m_countersCopyKeys.swap(written);
+    writer.flush();
+}
+
 sai_status_t AclOrch::bindAclTable(AclTable &aclTable, bool bind)
 {
     SWSS_LOG_ENTER();
@@ -3634,6 +3837,7 @@ sai_status_t AclOrch::createDTelWatchListTables()
 
     gCrmOrch->incCrmAclUsedCounter(CrmResourceType::CRM_ACL_TABLE, SAI_ACL_STAGE_INGRESS, SAI_ACL_BIND_POINT_TYPE_SWITCH);
     m_AclTables[table_oid] = flowWLTable;
+    m_AclTableOids[flowWLTable.id] = table_oid;
     SWSS_LOG_INFO("Successfully created ACL table %s, oid: %" PRIx64, flowWLTable.description.c_str(), table_oid);
 
     /* Create Drop watchlist ACL table */
@@ -3698,6 +3902,7 @@ sai_status_t AclOrch::createDTelWatchListTables()
 
     gCrmOrch->incCrmAclUsedCounter(CrmResourceType::CRM_ACL_TABLE, SAI_ACL_STAGE_INGRESS, SAI_ACL_BIND_POINT_TYPE_SWITCH);
     m_AclTables[table_oid] = dropWLTable;
+    m_AclTableOids[dropWLTable.id] = table_oid;
     SWSS_LOG_INFO("Successfully created ACL table %s, oid: %" PRIx64, dropWLTable.description.c_str(), table_oid);
 
     return SAI_STATUS_SUCCESS;
@@ -3732,6 +3937,7 @@ sai_status_t AclOrch::deleteDTelWatchListTables()
     }
 
     gCrmOrch->decCrmAclUsedCounter(CrmResourceType::CRM_ACL_TABLE, SAI_ACL_STAGE_INGRESS, SAI_ACL_BIND_POINT_TYPE_SWITCH, table_oid);
+    m_AclTableOids.erase(table_id);
     m_AclTables.erase(table_oid);
 
     table_id = TABLE_TYPE_DTEL_DROP_WATCHLIST;
@@ -3755,6 +3961,7 @@ sai_status_t AclOrch::deleteDTelWatchListTables()
     }
 
     gCrmOrch->decCrmAclUsedCounter(CrmResourceType::CRM_ACL_TABLE, SAI_ACL_STAGE_INGRESS, SAI_ACL_BIND_POINT_TYPE_SWITCH, table_oid);
+    m_AclTableOids.erase(table_id);
     m_AclTables.erase(table_oid);
 
     return SAI_STATUS_SUCCESS;
@@ -3,10 +3,12 @@
 
 #include <iostream>
 #include <sstream>
+#include <atomic>
 #include <thread>
 #include <mutex>
 #include <tuple>
 #include <map>
+#include <unordered_map>
 #include <condition_variable>
 
 #include "orch.h"
@@ -17,11 +19,17 @@
 #include "observer.h"
 
 #include "acltable.h"
+#include "flex_counter_manager.h"
 
-// ACL counters update interval in the DB
-// Value is in seconds. Should not be less than 5 seconds
-// (in worst case update of 1265 counters takes almost 5 sec)
+#define ACL_STAT_COUNTER_FLEX_COUNTER_GROUP "ACL_STAT_COUNTER"
+#define ACL_COUNTER_FLEX_COUNTER_POLLING_INTERVAL_MS 10000
+// Interval in seconds at which the polled counters are copied to the
+// COUNTERS:<table>:<rule> Packets/Bytes hashes read by aclshow
 #define COUNTERS_READ_INTERVAL 10
+// Rules whose counters are read in one round trip by the copy
+#define COUNTERS_READ_BATCH 512
+// Name map of the ACL counters in COUNTERS_DB: "<table>:<rule>" -> counter oid
+#define COUNTERS_ACL_COUNTER_RULE_MAP "ACL_COUNTER_RULE_MAP"
 
 #define RULE_PRIORITY           "PRIORITY"
 #define MATCH_IN_PORTS          "IN_PORTS"
@@ -270,13 +278,17 @@ public:
     bool create();
     bool remove();
     void update(SubjectType, void *);
-    AclRuleCounters getCounters();
 
 protected:
     bool m_state {false};
     string m_sessionName;
-    AclRuleCounters counters;
     MirrorOrch *m_pMirrorOrch {nullptr};
+
+    // The counter is kept while the mirror session is down, so the rule
+    // counts are not reset when the session flaps
+    bool createCounter();
+    bool removeCounter();
+    bool deactivate();
 };
 
 class AclRuleDTelFlowWatchListEntry: public AclRule
@@ -391,10 +403,16 @@ public:
     sai_object_id_t getTableById(string table_id);
     const AclTable* getTableByOid(sai_object_id_t oid) const;
 
-    static swss::Table& getCountersTable()
-    {
-        return m_countersTable;
-    }
+    void registerFlexCounter(AclRule &rule);
+    void deregisterFlexCounter(AclRule &rule);
+
+    /*
+     * Copy the polled counters to the aclshow hashes on a dedicated thread.
+     * The timer then only wakes the thread up, without it the copy runs on
+     * the timer.
+     */
+    void startCountersThread();
+    void stopCountersThread();
 
     // FIXME: Add getters for them? I'd better to add a common directory of orch objects and use it everywhere
     MirrorOrch *m_mirrorOrch;
@@ -423,7 +441,7 @@ public:
     static bool getAclBindPortId(Port& port, sai_object_id_t& port_id);
 
     using Orch::doTask;  // Allow access to the basic doTask
-    map<sai_object_id_t, AclTable>  getAclTables()
+    const map<sai_object_id_t, AclTable> &getAclTables() const
     {
         return m_AclTables;
     }
@@ -446,8 +464,6 @@ private:
                                       const acl_rule_attr_lookup_t& ruleAttrLookupMap,
                                       const AclActionAttrLookupT lookupMap);
 
-    static void collectCountersThread(AclOrch *pAclOrch);
-
     bool createBindAclTable(AclTable &aclTable, sai_object_id_t &table_oid);
     sai_status_t bindAclTable(AclTable &aclTable, bool bind = true);
     sai_status_t deleteUnbindAclTable(sai_object_id_t table_oid);
@@ -467,15 +483,30 @@ private:
     sai_status_t deleteDTelWatchListTables();
 
     map<sai_object_id_t, AclTable> m_AclTables;
+    /* OIDs of m_AclTables by table id */
+    unordered_map<string, sai_object_id_t> m_AclTableOids;
     // TODO: Move all ACL tables into one map: name -> instance
     map<string, AclTable> m_ctrlAclTables;
 
-    static mutex m_countersMutex;
-    static condition_variable m_sleepGuard;
-    static bool m_bCollectCounters;
+    FlexCounterManager m_flexCounterManager;
     static DBConnector m_db;
+    static Table m_aclCounterRuleMap;
     static Table m_countersTable;
 
+    /* Only used by the copy of the polled counters, on the counters thread once started */
+    unique_ptr<DBConnector> m_countersCopyDb;
+    /* Hashes written by the previous copy */
+    set<string> m_countersCopyKeys;
+
+    thread m_countersThread;
+    atomic<bool> m_countersRunning;
+    bool m_countersCopyPending = false;
+    mutex m_countersMutex;
+    condition_variable m_countersCv;
+
+    void countersThread();
+    void copyRuleCounters();
+
     map<acl_stage_type_t, string> m_mirrorTableId;
     map<acl_stage_type_t, string> m_mirrorV6TableId;
 
@@ -0,0 +1,170 @@
+#include "batcheddbwriter.h"
+#include "logger.h"
+
+using namespace std;
+using namespace swss;
+
+mutex BatchedDbWriter::m_writersMutex;
+map<string, unique_ptr<BatchedDbWriter>> BatchedDbWriter::m_writers;
+
+BatchedDbWriter::BatchedDbWriter(const string &dbName, size_t maxBatch) :
+    m_dbName(dbName),
+    m_db(new DBConnector(dbName, 0)),
+    m_maxBatch(maxBatch == 0 ? 1 : maxBatch),
+    m_pending(0),
+    m_writes(0),
+    m_roundTrips(0),
+    m_lastWrites(0),
+    m_lastRoundTrips(0),
+    m_lastStats(chrono::steady_clock::now())
+{
+    /* The pipeline never flushes on its own, every round trip is counted in flushLocked() */
+    m_pipeline.reset(new RedisPipeline(m_db.get(), m_maxBatch + 1));
+}
+
+BatchedDbWriter &BatchedDbWriter::get(const string &dbName)
+{
+    lock_guard<mutex> lock(m_writersMutex);
+
+    auto &writer = m_writers[dbName];
+    if (!writer)
+    {
+        writer.reset(new BatchedDbWriter(dbName));
+    }
+
+    return *writer;
+}
+
+void BatchedDbWriter::flushAll()
+{
+    lock_guard<mutex> lock(m_writersMutex);
+
+    for (auto &it : m_writers)
+    {
+        it.second->flush();
+    }
+}
+
+void BatchedDbWriter::dumpAllStats(vector<KeyOpFieldsValuesTuple> &stats)
+{
+    lock_guard<mutex> lock(m_writersMutex);
+
+    for (auto &it : m_writers)
+    {
+        vector<FieldValueTuple> fvs;
+        it.second->dumpStats(fvs);
+        stats.emplace_back("DB_WRITER:" + it.first, SET_COMMAND, fvs);
+    }
+}
+
+Table &BatchedDbWriter::getTable(const string &table)
+{
+    auto &t = m_tables[table];
+    if (!t)
+    {
+        t.reset(new Table(m_pipeline.get(), table, true));
+    }
+
+    return *t;
+}
+
+void BatchedDbWriter::set(const string &table, const string &key, const vector<FieldValueTuple> &values)
+{
+    if (values.empty())
+    {
+        return;
+    }
+
+    lock_guard<mutex> lock(m_mutex);
+
+    getTable(table).set(key, values);
+    written();
+}
+
+void BatchedDbWriter::hset(const string &table, const string &key, const string &field, const string &value)
+{
+    lock_guard<mutex> lock(m_mutex);
+
+    getTable(table).hset(key, field, value);
+    written();
+}
+
+void BatchedDbWriter::del(const string &table, const string &key)
+{
+    lock_guard<mutex> lock(m_mutex);
+
+    getTable(table).del(key);
+    written();
+}
+
+void BatchedDbWriter::hdel(const string &table, const string &key, const string &field)
+{
+    lock_guard<mutex> lock(m_mutex);
+
+    getTable(table).hdel(key, field);
+    written();
+}
+
+void BatchedDbWriter::written()
+{
+    m_writes++;
+
+    if (++m_pending >= m_maxBatch)
+    {
+        flushLocked();
+    }
+}
+
+void BatchedDbWriter::flush()
+{
+    lock_guard<mutex> lock(m_mutex);
+
+    flushLocked();
+}
+
+void BatchedDbWriter::flushLocked()
+{
+    if (m_pending == 0)
+    {
+        return;
+    }
+
+    m_pipeline->flush();
+    m_roundTrips++;
+    m_pending = 0;
+}
+
+uint64_t BatchedDbWriter::getWrites() const
+{
+    lock_guard<mutex> lock(m_mutex);
+
+    return m_writes;
+}
+
+uint64_t BatchedDbWriter::getRoundTrips() const
+{
+    lock_guard<mutex> lock(m_mutex);
+
+    return m_roundTrips;
+}
+
+void BatchedDbWriter::dumpStats(vector<FieldValueTuple> &fvs)
+{
+    lock_guard<mutex> lock(m_mutex);
+
+    auto now = chrono::steady_clock::now();
+    double seconds = chrono::duration<double>(now - m_lastStats).count();
+    if (seconds <= 0)
+    {
+        seconds = 1;
+    }
+
+    fvs.emplace_back("writes", to_string(m_writes));
+    fvs.emplace_back("round_trips", to_string(m_roundTrips));
+    fvs.emplace_back("writes_per_sec", to_string(static_cast<uint64_t>(static_cast<double>(m_writes - m_lastWrites) / seconds)));
+    fvs.emplace_back("round_trips_per_sec", to_string(static_cast<uint64_t>(static_cast<double>(m_roundTrips - m_lastRoundTrips) / seconds)));
+
+    m_lastWrites = m_writes;
+    m_lastRoundTrips = m_roundTrips;
+    m_lastStats = now;
+}
@@ -0,0 +1,84 @@
+#ifndef SWSS_BATCHEDDBWRITER_H
+#define SWSS_BATCHEDDBWRITER_H
+
+#include <chrono>
+#include <map>
+#include <memory>
+#include <mutex>
+#include <string>
+#include <vector>
+
+#include "dbconnector.h"
+#include "redispipeline.h"
+#include "table.h"
+
+#define DEFAULT_DB_WRITER_BATCH 512
+
+/*
+ * BatchedDbWriter buffers the writes of all orchs to one database in a
+ * shared RedisPipeline, so a periodic task writing thousands of keys costs a
+ * few Redis round trips instead of one per key.
+ *
+ * Writes are sent when the number of pending writes reaches the batch size
+ * and at the end of every event loop iteration through flushAll(). A write
+ * is therefore not visible to readers of the database before the end of the
+ * iteration which made it; callers which read their own writes back within
+ * the same iteration must flush() first.
+ *
+ * The writers are shared by the main thread and the orch worker threads,
+ * every method may be called from any thread.
+ */
+class BatchedDbWriter
+{
+public:
+    BatchedDbWriter(const std::string &dbName, size_t maxBatch = DEFAULT_DB_WRITER_BATCH);
+
+    /* Shared writer of a database, created on first use */
+    static BatchedDbWriter &get(const std::string &dbName);
+    static void flushAll();
+    static void dumpAllStats(std::vector<swss::KeyOpFieldsValuesTuple> &stats);
+
+    void set(const std::string &table, const std::string &key, const std::vector<swss::FieldValueTuple> &values);
+    void hset(const std::string &table, const std::string &key, const std::string &field, const std::string &value);
+    void del(const std::string &table, const std::string &key);
+    void hdel(const std::string &table, const std::string &key, const std::string &field);
+
+    void flush();
+
+    uint64_t getWrites() const;
+    uint64_t getRoundTrips() const;
+
+    /*
+     * Writes and round trips, in total and per second since the previous
+     * call. Without batching every write would be a round trip.
+     */
+    void dumpStats(std::vector<swss::FieldValueTuple> &fvs);
+
+private:
+    mutable std::mutex m_mutex;
+
+    std::string m_dbName;
+    std::unique_ptr<swss::DBConnector> m_db;
+    std::unique_ptr<swss::RedisPipeline> m_pipeline;
+    /* Buffered tables on m_pipeline by table name */
+    std::map<std::string, std::unique_ptr<swss::Table>> m_tables;
+
+    size_t m_maxBatch;
+    size_t m_pending;
+
+    uint64_t m_writes;
+    uint64_t m_roundTrips;
+
+    uint64_t m_lastWrites;
+    uint64_t m_lastRoundTrips;
+    std::chrono::steady_clock::time_point m_lastStats;
+
+    static std::mutex m_writersMutex;
+    static std::map<std::string, std::unique_ptr<BatchedDbWriter>> m_writers;
+
+    swss::Table &getTable(const std::string &table);
+    void written();
+    void flushLocked();
+};
+
+#endif /* SWSS_BATCHEDDBWRITER_H */
@@ -40,6 +40,40 @@ static inline bool operator==(const sai_route_entry_t& a, const sai_route_entry_
         ;
 }
 
+static inline bool operator==(const sai_fdb_entry_t& a, const sai_fdb_entry_t& b)
+{
+    return a.switch_id == b.switch_id
+        && memcmp(a.mac_address, b.mac_address, sizeof(a.mac_address)) == 0
+        && a.bv_id == b.bv_id
+        ;
+}
+
+static inline bool operator==(const sai_ip_address_t& a, const sai_ip_address_t& b)
+{
+    if (a.addr_family != b.addr_family) return false;
+
+    if (a.addr_family == SAI_IP_ADDR_FAMILY_IPV4)
+    {
+        return a.addr.ip4 == b.addr.ip4;
+    }
+    else if (a.addr_family == SAI_IP_ADDR_FAMILY_IPV6)
+    {
+        return memcmp(a.addr.ip6, b.addr.ip6, sizeof(a.addr.ip6)) == 0;
+    }
+    else
+    {
+        throw std::invalid_argument("a has invalid addr_family");
+    }
+}
+
+static inline bool operator==(const sai_neighbor_entry_t& a, const sai_neighbor_entry_t& b)
+{
+    return a.switch_id == b.switch_id
+        && a.rif_id == b.rif_id
+        && a.ip_address == b.ip_address
+        ;
+}
+
 static inline std::size_t hash_value(const sai_ip_prefix_t& a)
 {
     size_t seed = 0;
@@ -57,6 +91,21 @@ static inline std::size_t hash_value(const sai_ip_prefix_t& a)
     return seed;
 }
 
+static inline std::size_t hash_value(const sai_ip_address_t& a)
+{
+    size_t seed = 0;
+    boost::hash_combine(seed, a.addr_family);
+    if (a.addr_family == SAI_IP_ADDR_FAMILY_IPV4)
+    {
+        boost::hash_combine(seed, a.addr.ip4);
+    }
+    else if (a.addr_family == SAI_IP_ADDR_FAMILY_IPV6)
+    {
+        boost::hash_combine(seed, a.addr.ip6);
+    }
+    return seed;
+}
+
 namespace std
 {
     template <>
@@ -84,6 +133,19 @@ namespace std
             return seed;
         }
     };
+
+    template <>
+    struct hash<sai_neighbor_entry_t>
+    {
+        size_t operator()(const sai_neighbor_entry_t& a) const noexcept
+        {
+            size_t seed = 0;
+            boost::hash_combine(seed, a.switch_id);
+            boost::hash_combine(seed, a.rif_id);
+            boost::hash_combine(seed, a.ip_address);
+            return seed;
+        }
+    };
 }
 
 // SAI typedef which is not available in SAI 1.5
@@ -106,6 +168,24 @@ typedef sai_status_t (*sai_bulk_set_fdb_entry_attribute_fn)(
         _In_ const sai_attribute_t *attr_list,
         _In_ sai_bulk_op_error_mode_t mode,
         _Out_ sai_status_t *object_statuses);
+typedef sai_status_t (*sai_bulk_create_neighbor_entry_fn)(
+        _In_ uint32_t object_count,
+        _In_ const sai_neighbor_entry_t *neighbor_entry,
+        _In_ const uint32_t *attr_count,
+        _In_ const sai_attribute_t **attr_list,
+        _In_ sai_bulk_op_error_mode_t mode,
+        _Out_ sai_status_t *object_statuses);
+typedef sai_status_t (*sai_bulk_remove_neighbor_entry_fn)(
+        _In_ uint32_t object_count,
+        _In_ const sai_neighbor_entry_t *neighbor_entry,
+        _In_ sai_bulk_op_error_mode_t mode,
+        _Out_ sai_status_t *object_statuses);
+typedef sai_status_t (*sai_bulk_set_neighbor_entry_attribute_fn)(
+        _In_ uint32_t object_count,
+        _In_ const sai_neighbor_entry_t *neighbor_entry,
+        _In_ const sai_attribute_t *attr_list,
+        _In_ sai_bulk_op_error_mode_t mode,
+        _Out_ sai_status_t *object_statuses);
 
 template<typename T>
 struct SaiBulkerTraits { };
@@ -136,6 +216,33 @@ struct SaiBulkerTraits<sai_fdb_api_t>
     using bulk_set_entry_attribute_fn = sai_bulk_set_fdb_entry_attribute_fn;
 };
 
+template<>
+struct SaiBulkerTraits<sai_neighbor_api_t>
+{
+    using entry_t = sai_neighbor_entry_t;
+    using api_t = sai_neighbor_api_t;
+    using create_entry_fn = sai_create_neighbor_entry_fn;
+    using remove_entry_fn = sai_remove_neighbor_entry_fn;
+    using set_entry_attribute_fn = sai_set_neighbor_entry_attribute_fn;
+    using bulk_create_entry_fn = sai_bulk_create_neighbor_entry_fn;
+    using bulk_remove_entry_fn = sai_bulk_remove_neighbor_entry_fn;
+    using bulk_set_entry_attribute_fn = sai_bulk_set_neighbor_entry_attribute_fn;
+};
+
+template<>
+struct SaiBulkerTraits<sai_next_hop_api_t>
+{
+    using entry_t = sai_object_id_t;
+    using api_t = sai_next_hop_api_t;
+    using create_entry_fn = sai_create_next_hop_fn;
+    using remove_entry_fn = sai_remove_next_hop_fn;
+    using set_entry_attribute_fn = sai_set_next_hop_attribute_fn;
+    using bulk_create_entry_fn = sai_bulk_object_create_fn;
+    using bulk_remove_entry_fn = sai_bulk_object_remove_fn;
+    // TODO: wait until available in SAI
+    //using bulk_set_entry_attribute_fn = sai_bulk_object_set_attribute_fn;
+};
+
 template<>
 struct SaiBulkerTraits<sai_next_hop_group_api_t>
 {
@@ -440,16 +547,189 @@ inline EntityBulker<sai_route_api_t>::EntityBulker(sai_route_api_t *api)
     set_entries_attribute = api->set_route_entries_attribute;
 }
 
+/*
+ * Bulk functions on top of the per entry API of the last created bulker of
+ * the API, until the bulk functions are available in SAI. Every entry gets
+ * its own status, with SAI_BULK_OP_ERROR_MODE_STOP_ON_ERROR the entries after
+ * the first failure are SAI_STATUS_NOT_EXECUTED.
+ */
+template <typename T>
+struct SaiBulkFallback
+{
+    static T *&api()
+    {
+        static T *api = nullptr;
+        return api;
+    }
+
+protected:
+    template <typename F>
+    static sai_status_t apply(uint32_t object_count, sai_bulk_op_error_mode_t mode,
+            sai_status_t *object_statuses, F op)
+    {
+        sai_status_t status = SAI_STATUS_SUCCESS;
+        for (uint32_t i = 0; i < object_count; i++)
+        {
+            if (status != SAI_STATUS_SUCCESS && mode == SAI_BULK_OP_ERROR_MODE_STOP_ON_ERROR)
+            {
+                object_statuses[i] = SAI_STATUS_NOT_EXECUTED;
+                continue;
+            }
+
+            object_statuses[i] = op(i);
+            if (object_statuses[i] != SAI_STATUS_SUCCESS)
+            {
+                status = SAI_STATUS_FAILURE;
+            }
+        }
+        return status;
+    }
+};
+
+struct SaiFdbBulkFallback : public SaiBulkFallback<sai_fdb_api_t>
+{
+    static sai_status_t create_fdb_entries(
+            _In_ uint32_t object_count,
+            _In_ const sai_fdb_entry_t *fdb_entry,
+            _In_ const uint32_t *attr_count,
+            _In_ const sai_attribute_t **attr_list,
+            _In_ sai_bulk_op_error_mode_t mode,
+            _Out_ sai_status_t *object_statuses)
+    {
+        return apply(object_count, mode, object_statuses, [&](uint32_t i) {
+            return api()->create_fdb_entry(&fdb_entry[i], attr_count[i], attr_list[i]);
+        });
+    }
+
+    static sai_status_t remove_fdb_entries(
+            _In_ uint32_t object_count,
+            _In_ const sai_fdb_entry_t *fdb_entry,
+            _In_ sai_bulk_op_error_mode_t mode,
+            _Out_ sai_status_t *object_statuses)
+    {
+        return apply(object_count, mode, object_statuses, [&](uint32_t i) {
+            return api()->remove_fdb_entry(&fdb_entry[i]);
+        });
+    }
+
+    static sai_status_t set_fdb_entries_attribute(
+            _In_ uint32_t object_count,
+            _In_ const sai_fdb_entry_t *fdb_entry,
+            _In_ const sai_attribute_t *attr_list,
+            _In_ sai_bulk_op_error_mode_t mode,
+            _Out_ sai_status_t *object_statuses)
+    {
+        return apply(object_count, mode, object_statuses, [&](uint32_t i) {
+            return api()->set_fdb_entry_attribute(&fdb_entry[i], &attr_list[i]);
+        });
+    }
+};
+
+struct SaiNeighborBulkFallback : public SaiBulkFallback<sai_neighbor_api_t>
+{
+    static sai_status_t create_neighbor_entries(
+            _In_ uint32_t object_count,
+            _In_ const sai_neighbor_entry_t *neighbor_entry,
+            _In_ const uint32_t *attr_count,
+            _In_ const sai_attribute_t **attr_list,
+            _In_ sai_bulk_op_error_mode_t mode,
+            _Out_ sai_status_t *object_statuses)
+    {
+        return apply(object_count, mode, object_statuses, [&](uint32_t i) {
+            return api()->create_neighbor_entry(&neighbor_entry[i], attr_count[i], attr_list[i]);
+        });
+    }
+
+    static sai_status_t remove_neighbor_entries(
+            _In_ uint32_t object_count,
+            _In_ const sai_neighbor_entry_t *neighbor_entry,
+            _In_ sai_bulk_op_error_mode_t mode,
+            _Out_ sai_status_t *object_statuses)
+    {
+        return apply(object_count, mode, object_statuses, [&](uint32_t i) {
+            return api()->remove_neighbor_entry(&neighbor_entry[i]);
+        });
+    }
+
+    static sai_status_t set_neighbor_entries_attribute(
+            _In_ uint32_t object_count,
+            _In_ const sai_neighbor_entry_t *neighbor_entry,
+            _In_ const sai_attribute_t *attr_list,
+            _In_ sai_bulk_op_error_mode_t mode,
+            _Out_ sai_status_t *object_statuses)
+    {
+        return apply(object_count, mode, object_statuses, [&](uint32_t i) {
+            return api()->set_neighbor_entry_attribute(&neighbor_entry[i], &attr_list[i]);
+        });
+    }
+};
+
+struct SaiNextHopBulkFallback : public SaiBulkFallback<sai_next_hop_api_t>
+{
+    static sai_status_t create_next_hops(
+            _In_ sai_object_id_t switch_id,
+            _In_ uint32_t object_count,
+            _In_ const uint32_t *attr_count,
+            _In_ const sai_attribute_t **attr_list,
+            _In_ sai_bulk_op_error_mode_t mode,
+            _Out_ sai_object_id_t *object_id,
+            _Out_ sai_status_t *object_statuses)
+    {
+        return apply(object_count, mode, object_statuses, [&](uint32_t i) {
+            object_id[i] = SAI_NULL_OBJECT_ID;
+            return api()->create_next_hop(&object_id[i], switch_id, attr_count[i], attr_list[i]);
+        });
+    }
+
+    static sai_status_t remove_next_hops(
+            _In_ uint32_t object_count,
+            _In_ const sai_object_id_t *object_id,
+            _In_ sai_bulk_op_error_mode_t mode,
+            _Out_ sai_status_t *object_statuses)
+    {
+        return apply(object_count, mode, object_statuses, [&](uint32_t i) {
+            return api()->remove_next_hop(object_id[i]);
+        });
+    }
+};
+
+/*
+ * There is no NAT entry bulker, the API is set by its user.
+ */
+struct SaiNatBulkFallback : public SaiBulkFallback<sai_nat_api_t>
+{
+    static sai_status_t get_nat_entries_attribute(
+            _In_ uint32_t object_count,
+            _In_ const sai_nat_entry_t *nat_entry,
+            _In_ const uint32_t *attr_count,
+            _Inout_ sai_attribute_t **attr_list,
+            _In_ sai_bulk_op_error_mode_t mode,
+            _Out_ sai_status_t *object_statuses)
+    {
+        return apply(object_count, mode, object_statuses, [&](uint32_t i) {
+            return api()->get_nat_entry_attribute(&nat_entry[i], attr_count[i], attr_list[i]);
+        });
+    }
+};
+
 template <>
 inline EntityBulker<sai_fdb_api_t>::EntityBulker(sai_fdb_api_t *api)
 {
-    // TODO: implement after create_fdb_entries() is available in SAI
-    throw std::logic_error("Not implemented");
-    /*
-    create_entries = api->create_fdb_entries;
-    remove_entries = api->remove_fdb_entries;
-    set_entries_attribute = api->set_fdb_entries_attribute;
-    */
+    // TODO: use api->create_fdb_entries() after it is available in SAI
+    SaiFdbBulkFallback::api() = api;
+    create_entries = SaiFdbBulkFallback::create_fdb_entries;
+    remove_entries = SaiFdbBulkFallback::remove_fdb_entries;
+    set_entries_attribute = SaiFdbBulkFallback::set_fdb_entries_attribute;
+}
+
+template <>
+inline EntityBulker<sai_neighbor_api_t>::EntityBulker(sai_neighbor_api_t *api)
+{
+    // TODO: use api->create_neighbor_entries() after it is available in SAI
+    SaiNeighborBulkFallback::api() = api;
+    create_entries = SaiNeighborBulkFallback::create_neighbor_entries;
+    remove_entries = SaiNeighborBulkFallback::remove_neighbor_entries;
+    set_entries_attribute = SaiNeighborBulkFallback::set_neighbor_entries_attribute;
 }
 
 template <typename T>
@@ -467,18 +747,31 @@ public:
         _Out_ sai_object_id_t *object_id,
         _In_ uint32_t attr_count,
         _In_ const sai_attribute_t *attr_list)
+    {
+        return create_entry(object_id, nullptr, attr_count, attr_list);
+    }
+
+    sai_status_t create_entry(
+        _Out_ sai_object_id_t *object_id,
+        _Out_ sai_status_t *object_status,          // optional, status of the create once flushed
+        _In_ uint32_t attr_count,
+        _In_ const sai_attribute_t *attr_list)
     {
         assert(object_id);
         if (!object_id) throw std::invalid_argument("object_id is null");
         assert(attr_list);
         if (!attr_list) throw std::invalid_argument("attr_list is null");
 
-        creating_entries.emplace_back(std::piecewise_construct, std::forward_as_tuple(object_id), std::forward_as_tuple(attr_list, attr_list + attr_count));
+        creating_entries.emplace_back(object_id, object_status, std::vector<sai_attribute_t>(attr_list, attr_list + attr_count));
 
-        auto& last_attrs = std::get<1>(creating_entries.back());
+        auto& last_attrs = std::get<2>(creating_entries.back());
         SWSS_LOG_INFO("ObjectBulker.create_entry %zu, %zu, %u\n", creating_entries.size(), last_attrs.size(), last_attrs[0].id);
 
         *object_id = SAI_NULL_OBJECT_ID; // not created immediately, postponed until flush
+        if (object_status)
+        {
+            *object_status = SAI_STATUS_NOT_EXECUTED;
+        }
         return SAI_STATUS_NOT_EXECUTED;
     }
 
@@ -564,7 +857,7 @@ public:
             for (auto const& i: creating_entries)
             {
                 sai_object_id_t *pid = std::get<0>(i);
-                auto const& attrs = std::get<1>(i);
+                auto const& attrs = std::get<2>(i);
                 if (*pid == SAI_NULL_OBJECT_ID)
                 {
                     tss.push_back(attrs.data());
@@ -582,6 +875,12 @@ public:
             {
                 sai_object_id_t *pid = std::get<0>(creating_entries[i]);
                 *pid = (statuses[i] == SAI_STATUS_SUCCESS) ? object_ids[i] : SAI_NULL_OBJECT_ID;
+
+                sai_status_t *object_status = std::get<1>(creating_entries[i]);
+                if (object_status)
+                {
+                    *object_status = statuses[i];
+                }
             }
 
             creating_entries.clear();
@@ -654,8 +953,9 @@ private:
 
     sai_object_id_t                                         switch_id;
 
-    std::vector<std::pair<                                  // A vector of pair of
+    std::vector<std::tuple<                                 // A vector of tuple of
             sai_object_id_t *,                              // - object_id
+            sai_status_t *,                                 // - object_status, may be null
             std::vector<sai_attribute_t>                    // - attrs
     >>                                                      creating_entries;
 
@@ -686,3 +986,13 @@ inline ObjectBulker<sai_next_hop_group_api_t>::ObjectBulker(SaiBulkerTraits<sai_
     // TODO: wait until available in SAI
     //set_entries_attribute = ;
 }
+
+template <>
+inline ObjectBulker<sai_next_hop_api_t>::ObjectBulker(SaiBulkerTraits<sai_next_hop_api_t>::api_t *api, sai_object_id_t switch_id)
+    : switch_id(switch_id)
+{
+    // TODO: use api->create_next_hops() after it is available in SAI
+    SaiNextHopBulkFallback::api() = api;
+    create_entries = SaiNextHopBulkFallback::create_next_hops;
+    remove_entries = SaiNextHopBulkFallback::remove_next_hops;
+}
@@ -1,9 +1,11 @@
 #include <sstream>
+#include <algorithm>
 #include <inttypes.h>
 
 #include "crmorch.h"
 #include "converter.h"
 #include "timer.h"
+#include "batcheddbwriter.h"
 
 #define CRM_POLLING_INTERVAL "polling_interval"
 #define CRM_COUNTERS_TABLE_KEY "STATS"
@@ -174,7 +176,10 @@ CrmOrch::CrmOrch(DBConnector *db, string tableName):
     Orch(db, tableName),
     m_countersDb(new DBConnector("COUNTERS_DB", 0)),
     m_countersCrmTable(new Table(m_countersDb.get(), COUNTERS_CRM_TABLE)),
-    m_timer(new SelectableTimer(timespec { .tv_sec = CRM_POLLING_INTERVAL_DEFAULT, .tv_nsec = 0 }))
+    m_timer(new SelectableTimer(timespec { .tv_sec = CRM_POLLING_INTERVAL_DEFAULT, .tv_nsec = 0 })),
+    m_pollRunning(false),
+    m_pendingQuery(nullptr),
+    m_pendingResult(nullptr)
 {
     SWSS_LOG_ENTER();
 
@@ -194,6 +199,66 @@ CrmOrch::CrmOrch(DBConnector *db, string tableName):
     m_timer->start();
 }
 
+CrmOrch::~CrmOrch()
+{
+    stopPollThread();
+}
+
+void CrmOrch::startPollThread()
+{
+    SWSS_LOG_ENTER();
+
+    if (m_pollRunning)
+    {
+        return;
+    }
+
+    m_pollRunning = true;
+    m_pollThread = thread(&CrmOrch::pollThread, this);
+}
+
+void CrmOrch::stopPollThread()
+{
+    SWSS_LOG_ENTER();
+
+    if (!m_pollRunning)
+    {
+        return;
+    }
+
+    {
+        lock_guard<mutex> lock(m_pollMutex);
+        m_pollRunning = false;
+    }
+    m_pollCv.notify_one();
+    m_pollThread.join();
+
+    delete m_pendingQuery.exchange(nullptr);
+    delete m_pendingResult.exchange(nullptr);
+}
+
+void CrmOrch::pollThread()
+{
+    SWSS_LOG_ENTER();
+
+    while (m_pollRunning)
+    {
+        unique_ptr<CrmAvailQuery> query(m_pendingQuery.exchange(nullptr));
+        if (!query)
+        {
+            unique_lock<mutex> lock(m_pollMutex);
+            m_pollCv.wait(lock, [this]() { return !m_pollRunning || m_pendingQuery.load() != nullptr; });
+            continue;
+        }
+
+        auto result = new CrmAvailResult();
+        queryAvailableCounters(*query, *result);
+
+        // A result the orch did not pick up yet is outdated
+        delete m_pendingResult.exchange(result);
+    }
+}
+
 CrmOrch::CrmResourceEntry::CrmResourceEntry(string name, CrmThresholdType thresholdType, uint32_t lowThreshold, uint32_t highThreshold):
     name(name),
     thresholdType(thresholdType),
@@ -379,8 +444,8 @@ void CrmOrch::decCrmAclUsedCounter(CrmResourceType resource, sai_acl_stage_t sta
                 }
             }
 
-            // remove ACL_TABLE_STATS in crm database
-            m_countersCrmTable->del(getCrmAclTableKey(oid));
+            // remove ACL_TABLE_STATS in crm database, ordered with the batched counter writes
+            BatchedDbWriter::get("COUNTERS_DB").del(COUNTERS_CRM_TABLE, getCrmAclTableKey(oid));
         }
     }
     catch (...)
@@ -434,105 +499,353 @@ void CrmOrch::getResAvailableCounters()
 {
     SWSS_LOG_ENTER();
 
-    for (auto &res : m_resourcesMap)
+    if (m_pollRunning && m_availPolled)
     {
-        // ignore unsupported resources
-        if (res.second.resStatus != CrmResourceStatus::CRM_RES_SUPPORTED)
+        unique_ptr<CrmAvailResult> result(m_pendingResult.exchange(nullptr));
+        if (result)
         {
-            continue;
+            applyAvailResult(*result);
         }
 
-        sai_attribute_t attr;
-        attr.id = crmResSaiAvailAttrMap.at(res.first);
-
-        switch (attr.id)
-        {
-            case SAI_SWITCH_ATTR_AVAILABLE_IPV4_ROUTE_ENTRY:
-            case SAI_SWITCH_ATTR_AVAILABLE_IPV6_ROUTE_ENTRY:
-            case SAI_SWITCH_ATTR_AVAILABLE_IPV4_NEXTHOP_ENTRY:
-            case SAI_SWITCH_ATTR_AVAILABLE_IPV6_NEXTHOP_ENTRY:
-            case SAI_SWITCH_ATTR_AVAILABLE_IPV4_NEIGHBOR_ENTRY:
-            case SAI_SWITCH_ATTR_AVAILABLE_IPV6_NEIGHBOR_ENTRY:
-            case SAI_SWITCH_ATTR_AVAILABLE_NEXT_HOP_GROUP_MEMBER_ENTRY:
-            case SAI_SWITCH_ATTR_AVAILABLE_NEXT_HOP_GROUP_ENTRY:
-            case SAI_SWITCH_ATTR_AVAILABLE_FDB_ENTRY:
-            case SAI_SWITCH_ATTR_AVAILABLE_IPMC_ENTRY:
-            case SAI_SWITCH_ATTR_AVAILABLE_SNAT_ENTRY:
-            case SAI_SWITCH_ATTR_AVAILABLE_DNAT_ENTRY:
+        auto query = new CrmAvailQuery();
+        buildAvailQuery(*query);
+        delete m_pendingQuery.exchange(query);
+
+        {
+            lock_guard<mutex> lock(m_pollMutex);
+        }
+        m_pollCv.notify_one();
+        return;
+    }
+
+    // The first poll is synchronous, thresholds are never checked against unknown availability
+    CrmAvailQuery query;
+    CrmAvailResult result;
+    buildAvailQuery(query);
+    queryAvailableCounters(query, result);
+    applyAvailResult(result);
+    m_availPolled = true;
+}
+
+void CrmOrch::buildAvailQuery(CrmAvailQuery &query)
+{
+    SWSS_LOG_ENTER();
+
+    if (!m_availAttrsCached)
+    {
+        m_availAttrs = CrmAvailQuery();
+
+        for (const auto &res : m_resourcesMap)
+        {
+            // ignore unsupported resources
+            if (res.second.resStatus != CrmResourceStatus::CRM_RES_SUPPORTED)
             {
-                sai_status_t status = sai_switch_api->get_switch_attribute(gSwitchId, 1, &attr);
-                if (status != SAI_STATUS_SUCCESS)
-                {
-                    if((status == SAI_STATUS_NOT_SUPPORTED) ||
-                       (status == SAI_STATUS_NOT_IMPLEMENTED) ||
-                       SAI_STATUS_IS_ATTR_NOT_SUPPORTED(status) ||
-                       SAI_STATUS_IS_ATTR_NOT_IMPLEMENTED(status))
-                    {
-                        // mark unsupported resources
-                        res.second.resStatus = CrmResourceStatus::CRM_RES_NOT_SUPPORTED;
-                        SWSS_LOG_NOTICE("Switch attribute %u not supported", attr.id);
-                        break;
-                    }
-                    SWSS_LOG_ERROR("Failed to get switch attribute %u , rv:%d", attr.id, status);
+                continue;
+            }
+
+            sai_attr_id_t id = crmResSaiAvailAttrMap.at(res.first);
+
+            switch (res.first)
+            {
+                case CrmResourceType::CRM_ACL_ENTRY:
+                case CrmResourceType::CRM_ACL_COUNTER:
+                    m_availAttrs.aclTableAttrs.push_back(id);
                     break;
-                }
 
-                res.second.countersMap[CRM_COUNTERS_TABLE_KEY].availableCounter = attr.value.u32;
+                case CrmResourceType::CRM_ACL_TABLE:
+                case CrmResourceType::CRM_ACL_GROUP:
+                    m_availAttrs.aclResourceAttrs.insert(id);
+                    m_availAttrs.switchAttrs.push_back(id);
+                    break;
 
-                break;
+                default:
+                    m_availAttrs.switchAttrs.push_back(id);
+                    break;
+            }
+        }
+
+        m_availAttrsCached = true;
+    }
+
+    query = m_availAttrs;
+
+    for (auto resource : { CrmResourceType::CRM_ACL_ENTRY, CrmResourceType::CRM_ACL_COUNTER })
+    {
+        const auto &res = m_resourcesMap.at(resource);
+        if (res.resStatus != CrmResourceStatus::CRM_RES_SUPPORTED)
+        {
+            continue;
+        }
+
+        for (const auto &cnt : res.countersMap)
+        {
+            query.aclTables.insert(cnt.second.id);
+        }
+    }
+}
+
+static bool isAttrNotSupported(sai_status_t status)
+{
+    return (status == SAI_STATUS_NOT_SUPPORTED) ||
+           (status == SAI_STATUS_NOT_IMPLEMENTED) ||
+           SAI_STATUS_IS_ATTR_NOT_SUPPORTED(status) ||
+           SAI_STATUS_IS_ATTR_NOT_IMPLEMENTED(status);
+}
+
+/* Get the switch attributes, the ACL resource lists of a non empty resources entry are grown once if too small */
+static sai_status_t getSwitchAvailAttrs(vector<sai_attribute_t> &attrs, vector<vector<sai_acl_resource_t>> &resources)
+{
+    auto bindLists = [&]() {
+        for (size_t i = 0; i < attrs.size(); i++)
+        {
+            if (!resources[i].empty())
+            {
+                attrs[i].value.aclresource.count = static_cast<uint32_t>(resources[i].size());
+                attrs[i].value.aclresource.list = resources[i].data();
             }
+        }
+    };
 
-            case SAI_SWITCH_ATTR_AVAILABLE_ACL_TABLE:
-            case SAI_SWITCH_ATTR_AVAILABLE_ACL_TABLE_GROUP:
+    bindLists();
+    sai_status_t status = sai_switch_api->get_switch_attribute(gSwitchId, static_cast<uint32_t>(attrs.size()), attrs.data());
+    if (status == SAI_STATUS_BUFFER_OVERFLOW)
+    {
+        for (size_t i = 0; i < attrs.size(); i++)
+        {
+            if (!resources[i].empty() && attrs[i].value.aclresource.count > resources[i].size())
             {
-                vector<sai_acl_resource_t> resources(CRM_ACL_RESOURCE_COUNT);
+                resources[i].resize(attrs[i].value.aclresource.count);
+            }
+        }
+
+        bindLists();
+        status = sai_switch_api->get_switch_attribute(gSwitchId, static_cast<uint32_t>(attrs.size()), attrs.data());
+    }
 
-                attr.value.aclresource.count = CRM_ACL_RESOURCE_COUNT;
-                attr.value.aclresource.list = resources.data();
-                sai_status_t status = sai_switch_api->get_switch_attribute(gSwitchId, 1, &attr);
-                if (status == SAI_STATUS_BUFFER_OVERFLOW)
+    return status;
+}
+
+static void storeSwitchAvailAttr(const sai_attribute_t &attr, bool aclResource, CrmAvailResult &result)
+{
+    if (aclResource)
+    {
+        const auto &list = attr.value.aclresource;
+        result.aclResources[attr.id].assign(list.list, list.list + list.count);
+    }
+    else
+    {
+        result.switchCounters[attr.id] = attr.value.u32;
+    }
+}
+
+void CrmOrch::queryAvailableCounters(const CrmAvailQuery &query, CrmAvailResult &result)
+{
+    SWSS_LOG_ENTER();
+
+    if (!query.switchAttrs.empty())
+    {
+        vector<sai_attribute_t> attrs(query.switchAttrs.size());
+        vector<vector<sai_acl_resource_t>> resources(query.switchAttrs.size());
+
+        for (size_t i = 0; i < attrs.size(); i++)
+        {
+            attrs[i].id = query.switchAttrs[i];
+            if (query.aclResourceAttrs.count(attrs[i].id))
+            {
+                resources[i].resize(CRM_ACL_RESOURCE_COUNT);
+            }
+        }
+
+        sai_status_t status = getSwitchAvailAttrs(attrs, resources);
+        if (status == SAI_STATUS_SUCCESS)
+        {
+            for (size_t i = 0; i < attrs.size(); i++)
+            {
+                storeSwitchAvailAttr(attrs[i], !resources[i].empty(), result);
+            }
+        }
+        else if (attrs.size() > 1)
+        {
+            /*
+             * Some platforms fail the whole get with a generic error when one
+             * attribute is unknown, so query them one by one and keep polling
+             * the others
+             */
+            for (size_t i = 0; i < attrs.size(); i++)
+            {
+                vector<sai_attribute_t> attr(1, attrs[i]);
+                vector<vector<sai_acl_resource_t>> resource(1, resources[i]);
+
+                status = getSwitchAvailAttrs(attr, resource);
+                if (status == SAI_STATUS_SUCCESS)
                 {
-                    resources.resize(attr.value.aclresource.count);
-                    attr.value.aclresource.list = resources.data();
-                    status = sai_switch_api->get_switch_attribute(gSwitchId, 1, &attr);
+                    storeSwitchAvailAttr(attr[0], !resource[0].empty(), result);
                 }
-
-                if (status != SAI_STATUS_SUCCESS)
+                else if (isAttrNotSupported(status) && resource[0].empty())
                 {
-                    SWSS_LOG_ERROR("Failed to get switch attribute %u , rv:%d", attr.id, status);
-                    break;
+                    result.unsupported.insert(attr[0].id);
                 }
-
-                for (uint32_t i = 0; i < attr.value.aclresource.count; i++)
+                else
                 {
-                    string key = getCrmAclKey(attr.value.aclresource.list[i].stage, attr.value.aclresource.list[i].bind_point);
-                    res.second.countersMap[key].availableCounter = attr.value.aclresource.list[i].avail_num;
+                    SWSS_LOG_ERROR("Failed to get switch attribute %u , rv:%d", attr[0].id, status);
                 }
+            }
+        }
+        else if (isAttrNotSupported(status) && resources[0].empty())
+        {
+            result.unsupported.insert(attrs[0].id);
+        }
+        else
+        {
+            SWSS_LOG_ERROR("Failed to get switch attribute %u , rv:%d", attrs[0].id, status);
+        }
+    }
 
-                break;
+    if (query.aclTableAttrs.empty())
+    {
+        return;
+    }
+
+    vector<sai_attr_id_t> aclTableAttrs = query.aclTableAttrs;
+
+    for (auto table : query.aclTables)
+    {
+        if (aclTableAttrs.empty())
+        {
+            break;
+        }
+
+        vector<sai_attribute_t> attrs(aclTableAttrs.size());
+        for (size_t i = 0; i < attrs.size(); i++)
+        {
+            attrs[i].id = aclTableAttrs[i];
+        }
+
+        sai_status_t status = sai_acl_api->get_acl_table_attribute(table, static_cast<uint32_t>(attrs.size()), attrs.data());
+        if (status == SAI_STATUS_SUCCESS)
+        {
+            for (const auto &attr : attrs)
+            {
+                result.aclTableCounters[table][attr.id] = attr.value.u32;
+            }
+            continue;
+        }
+
+        if (!isAttrNotSupported(status))
+        {
+            SWSS_LOG_ERROR("Failed to get ACL table attributes, rv:%d", status);
+            continue;
+        }
+
+        /*
+         * Find the attributes that are not supported one by one, they are
+         * left out of the gets of the other tables
+         */
+        for (auto &attr : attrs)
+        {
+            if (attrs.size() > 1)
+            {
+                status = sai_acl_api->get_acl_table_attribute(table, 1, &attr);
+            }
+
+            if (status == SAI_STATUS_SUCCESS)
+            {
+                result.aclTableCounters[table][attr.id] = attr.value.u32;
+            }
+            else if (isAttrNotSupported(status))
+            {
+                result.unsupportedAclTableAttrs.insert(attr.id);
+                aclTableAttrs.erase(find(aclTableAttrs.begin(), aclTableAttrs.end(), attr.id));
             }
+            else
+            {
+                SWSS_LOG_ERROR("Failed to get ACL table attribute %u , rv:%d", attr.id, status);
+            }
+        }
+    }
+}
 
-            case SAI_ACL_TABLE_ATTR_AVAILABLE_ACL_ENTRY:
-            case SAI_ACL_TABLE_ATTR_AVAILABLE_ACL_COUNTER:
+void CrmOrch::applyAvailResult(const CrmAvailResult &result)
+{
+    SWSS_LOG_ENTER();
+
+    for (auto &res : m_resourcesMap)
+    {
+        // ignore unsupported resources
+        if (res.second.resStatus != CrmResourceStatus::CRM_RES_SUPPORTED)
+        {
+            continue;
+        }
+
+        sai_attr_id_t id = crmResSaiAvailAttrMap.at(res.first);
+
+        switch (res.first)
+        {
+            case CrmResourceType::CRM_ACL_ENTRY:
+            case CrmResourceType::CRM_ACL_COUNTER:
             {
+                if (result.unsupportedAclTableAttrs.count(id))
+                {
+                    // mark unsupported resources, the next queries skip the attribute
+                    res.second.resStatus = CrmResourceStatus::CRM_RES_NOT_SUPPORTED;
+                    auto &attrs = m_availAttrs.aclTableAttrs;
+                    attrs.erase(remove(attrs.begin(), attrs.end(), id), attrs.end());
+                    SWSS_LOG_NOTICE("ACL table attribute %u not supported", id);
+                    break;
+                }
+
                 for (auto &cnt : res.second.countersMap)
                 {
-                    sai_status_t status = sai_acl_api->get_acl_table_attribute(cnt.second.id, 1, &attr);
-                    if (status != SAI_STATUS_SUCCESS)
+                    auto table = result.aclTableCounters.find(cnt.second.id);
+                    if (table == result.aclTableCounters.end())
                     {
-                        SWSS_LOG_ERROR("Failed to get ACL table attribute %u , rv:%d", attr.id, status);
-                        break;
+                        continue;
                     }
 
-                    cnt.second.availableCounter = attr.value.u32;
+                    auto counter = table->second.find(id);
+                    if (counter != table->second.end())
+                    {
+                        cnt.second.availableCounter = counter->second;
+                    }
+                }
+                break;
+            }
+
+            case CrmResourceType::CRM_ACL_TABLE:
+            case CrmResourceType::CRM_ACL_GROUP:
+            {
+                auto resources = result.aclResources.find(id);
+                if (resources == result.aclResources.end())
+                {
+                    break;
                 }
 
+                for (const auto &resource : resources->second)
+                {
+                    string key = getCrmAclKey(resource.stage, resource.bind_point);
+                    res.second.countersMap[key].availableCounter = resource.avail_num;
+                }
                 break;
             }
 
             default:
-                SWSS_LOG_ERROR("Failed to get CRM attribute %u. Unknown attribute.\n", attr.id);
-                return;
+            {
+                if (result.unsupported.count(id))
+                {
+                    // mark unsupported resources
+                    res.second.resStatus = CrmResourceStatus::CRM_RES_NOT_SUPPORTED;
+                    m_availAttrsCached = false;
+                    SWSS_LOG_NOTICE("Switch attribute %u not supported", id);
+                    break;
+                }
+
+                auto counter = result.switchCounters.find(id);
+                if (counter != result.switchCounters.end())
+                {
+                    res.second.countersMap[CRM_COUNTERS_TABLE_KEY].availableCounter = counter->second;
+                }
+                break;
+            }
         }
     }
 }
@@ -541,6 +854,8 @@ void CrmOrch::updateCrmCountersTable()
 {
     SWSS_LOG_ENTER();
 
+    auto &writer = BatchedDbWriter::get("COUNTERS_DB");
+
     // Update CRM used counters in COUNTERS_DB
     for (const auto &i : crmUsedCntsTableMap)
     {
@@ -550,7 +865,7 @@ void CrmOrch::updateCrmCountersTable()
             {
                 FieldValueTuple attr(i.first, to_string(cnt.second.usedCounter));
                 vector<FieldValueTuple> attrs = { attr };
-                m_countersCrmTable->set(cnt.first, attrs);
+                writer.set(COUNTERS_CRM_TABLE, cnt.first, attrs);
             }
         }
         catch(const out_of_range &e)
@@ -568,7 +883,7 @@ void CrmOrch::updateCrmCountersTable()
             {
                 FieldValueTuple attr(i.first, to_string(cnt.second.availableCounter));
                 vector<FieldValueTuple> attrs = { attr };
-                m_countersCrmTable->set(cnt.first, attrs);
+                writer.set(COUNTERS_CRM_TABLE, cnt.first, attrs);
             }
         }
         catch(const out_of_range &e)
@@ -3,6 +3,10 @@
 #include <thread>
 #include <chrono>
 #include <map>
+#include <set>
+#include <atomic>
+#include <mutex>
+#include <condition_variable>
 #include "orch.h"
 #include "port.h"
 
@@ -43,10 +47,35 @@ enum class CrmResourceStatus
     CRM_RES_NOT_SUPPORTED,
 };
 
+/* Availability attributes to query in one poll */
+struct CrmAvailQuery
+{
+    /* Switch attributes of the supported resources, read with one get */
+    std::vector<sai_attr_id_t> switchAttrs;
+    /* Switch attributes holding a list of ACL resources */
+    std::set<sai_attr_id_t> aclResourceAttrs;
+    /* Per ACL table attributes, read with one get per table */
+    std::vector<sai_attr_id_t> aclTableAttrs;
+    std::set<sai_object_id_t> aclTables;
+};
+
+/* Result of a CrmAvailQuery, applied to the resources by the orch */
+struct CrmAvailResult
+{
+    std::map<sai_attr_id_t, uint32_t> switchCounters;
+    std::map<sai_attr_id_t, std::vector<sai_acl_resource_t>> aclResources;
+    std::map<sai_object_id_t, std::map<sai_attr_id_t, uint32_t>> aclTableCounters;
+    /* Switch attributes reported as not supported */
+    std::set<sai_attr_id_t> unsupported;
+    /* ACL table attributes reported as not supported */
+    std::set<sai_attr_id_t> unsupportedAclTableAttrs;
+};
+
 class CrmOrch : public Orch
 {
 public:
     CrmOrch(swss::DBConnector *db, std::string tableName);
+    ~CrmOrch();
     void incCrmResUsedCounter(CrmResourceType resource);
     void decCrmResUsedCounter(CrmResourceType resource);
     // Increment "used" counter for the ACL table/group CRM resources
@@ -58,6 +87,17 @@ public:
     // Decrement "used" counter for the per ACL table CRM resources (ACL entry/counter)
     void decCrmAclTableUsedCounter(CrmResourceType resource, sai_object_id_t tableId);
 
+    /*
+     * Query the availability counters on a dedicated thread. Every timer
+     * tick applies the result of the previous query and hands a new query
+     * to the thread, so the published counters are one interval old.
+     */
+    void startPollThread();
+    void stopPollThread();
+
+    /* Query the availability counters with as few SAI calls as possible */
+    static void queryAvailableCounters(const CrmAvailQuery &query, CrmAvailResult &result);
+
 private:
     std::shared_ptr<swss::DBConnector> m_countersDb = nullptr;
     std::shared_ptr<swss::Table> m_countersCrmTable = nullptr;
@@ -90,10 +130,27 @@ private:
 
     std::map<CrmResourceType, CrmResourceEntry> m_resourcesMap;
 
+    /* Supported availability attributes, rebuilt when a resource turns out to be unsupported */
+    bool m_availAttrsCached = false;
+    CrmAvailQuery m_availAttrs;
+    bool m_availPolled = false;
+
+    /* Handoff with the poll thread, each side takes ownership by exchanging the pointer */
+    std::thread m_pollThread;
+    std::atomic<bool> m_pollRunning;
+    std::atomic<CrmAvailQuery *> m_pendingQuery;
+    std::atomic<CrmAvailResult *> m_pendingResult;
+    /* Only used to wake up the poll thread */
+    std::mutex m_pollMutex;
+    std::condition_variable m_pollCv;
+
     void doTask(Consumer &consumer);
     void handleSetCommand(const std::string& key, const std::vector<swss::FieldValueTuple>& data);
     void doTask(swss::SelectableTimer &timer);
     void getResAvailableCounters();
+    void buildAvailQuery(CrmAvailQuery &query);
+    void applyAvailResult(const CrmAvailResult &result);
+    void pollThread();
     void updateCrmCountersTable();
     void checkCrmThresholds();
     std::string getCrmAclKey(sai_acl_stage_t stage, sai_acl_bind_point_type_t bindPoint);
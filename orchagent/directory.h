@@ -40,6 +40,12 @@ public:
         return static_cast<U>(m_values.at(type_name));
     }
 
+    template <typename U>
+    void erase()
+    {
+        m_values.erase(typeid(U).name());
+    }
+
     class iterator : public std::iterator<std::input_iterator_tag, B>
     {
     public:
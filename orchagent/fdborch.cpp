@@ -26,7 +26,9 @@ const int FdbOrch::fdborch_pri = 20;
 FdbOrch::FdbOrch(DBConnector* applDbConnector, vector<table_name_with_pri_t> appFdbTables, TableConnector stateDbFdbConnector, PortsOrch *port) :
     Orch(applDbConnector, appFdbTables),
     m_portsOrch(port),
-    m_fdbStateTable(stateDbFdbConnector.first, stateDbFdbConnector.second)
+    m_fdbStateTable(stateDbFdbConnector.first, stateDbFdbConnector.second),
+    m_stateDbWriter(BatchedDbWriter::get(stateDbFdbConnector.first->getDbName())),
+    m_fdbBulker(sai_fdb_api)
 {
     for(auto it: appFdbTables)
     {
@@ -69,9 +71,9 @@ bool FdbOrch::storeFdbEntryState(const FdbUpdate& update)
     const Port& port = update.port;
     const MacAddress& mac = entry.mac;
     string portName = port.m_alias;
-    Port vlan;
 
-    if (!m_portsOrch->getPort(entry.bv_id, vlan))
+    const Port *vlan = m_portsOrch->findPort(entry.bv_id);
+    if (vlan == nullptr)
     {
         SWSS_LOG_NOTICE("FdbOrch notification: Failed to locate \
                          vlan port from bv_id 0x%" PRIx64, entry.bv_id);
@@ -79,7 +81,7 @@ bool FdbOrch::storeFdbEntryState(const FdbUpdate& update)
     }
 
     // ref: https://github.com/Azure/sonic-swss/blob/master/doc/swss-schema.md#fdb_table
-    string key = "Vlan" + to_string(vlan.m_vlan_info.vlan_id) + ":" + mac.to_string();
+    string key = "Vlan" + to_string(vlan->m_vlan_info.vlan_id) + ":" + mac.to_string();
 
     if (update.add)
     {
@@ -106,7 +108,7 @@ bool FdbOrch::storeFdbEntryState(const FdbUpdate& update)
         fdbdata.esi = "";
         fdbdata.vni = 0;
 
-        m_entries[entry] = fdbdata;
+        setEntry(entry, fdbdata);
         SWSS_LOG_INFO("FdbOrch notification: mac %s was inserted in port %s into bv_id 0x%" PRIx64,
                         entry.mac.to_string().c_str(), portName.c_str(), entry.bv_id);
         SWSS_LOG_INFO("m_entries size=%zu mac=%s port=0x%" PRIx64,
@@ -116,7 +118,7 @@ bool FdbOrch::storeFdbEntryState(const FdbUpdate& update)
         std::vector<FieldValueTuple> fvs;
         fvs.push_back(FieldValueTuple("port", portName));
         fvs.push_back(FieldValueTuple("type", update.type));
-        m_fdbStateTable.set(key, fvs);
+        m_stateDbWriter.set(m_fdbStateTable.getTableName(), key, fvs);
 
         if (!mac_move)
         {
@@ -132,10 +134,10 @@ bool FdbOrch::storeFdbEntryState(const FdbUpdate& update)
             oldFdbData = it->second;
         }
 
-        size_t erased = m_entries.erase(entry);
+        bool erased = eraseEntry(entry);
         SWSS_LOG_DEBUG("FdbOrch notification: mac %s was removed from bv_id 0x%" PRIx64, entry.mac.to_string().c_str(), entry.bv_id);
 
-        if (erased == 0)
+        if (!erased)
         {
             return false;
         }
@@ -143,7 +145,7 @@ bool FdbOrch::storeFdbEntryState(const FdbUpdate& update)
         if (oldFdbData.origin != FDB_ORIGIN_VXLAN_ADVERTIZED)
         {
             // Remove in StateDb for non advertised mac addresses
-            m_fdbStateTable.del(key);
+            m_stateDbWriter.del(m_fdbStateTable.getTableName(), key);
         }
 
         gCrmOrch->decCrmResUsedCounter(CrmResourceType::CRM_FDB_ENTRY);
@@ -151,6 +153,77 @@ bool FdbOrch::storeFdbEntryState(const FdbUpdate& update)
     }
 }
 
+void FdbOrch::setEntry(const FdbEntry& entry, const FdbData& fdbData)
+{
+    auto it = m_entries.find(entry);
+    if (it != m_entries.end())
+    {
+        /* The entry keeps the port name it was added with */
+        it->second = fdbData;
+        return;
+    }
+
+    m_entries.emplace(entry, fdbData);
+    m_entriesByPort[entry.port_name][entry.bv_id].insert(entry.mac);
+}
+
+bool FdbOrch::eraseEntry(const FdbEntry& entry)
+{
+    auto it = m_entries.find(entry);
+    if (it == m_entries.end())
+    {
+        return false;
+    }
+
+    auto port = m_entriesByPort.find(it->first.port_name);
+    if (port != m_entriesByPort.end())
+    {
+        auto vlan = port->second.find(entry.bv_id);
+        if (vlan != port->second.end())
+        {
+            vlan->second.erase(entry.mac);
+            if (vlan->second.empty())
+            {
+                port->second.erase(vlan);
+            }
+        }
+        if (port->second.empty())
+        {
+            m_entriesByPort.erase(port);
+        }
+    }
+
+    m_entries.erase(it);
+    return true;
+}
+
+/* Entries added with the port name, in the bv_id or all of them if it is null */
+void FdbOrch::getPortEntries(const string& port_name, sai_object_id_t bv_id, vector<FdbEntry>& entries) const
+{
+    auto port = m_entriesByPort.find(port_name);
+    if (port == m_entriesByPort.end())
+    {
+        return;
+    }
+
+    for (const auto& vlan : port->second)
+    {
+        if (bv_id != SAI_NULL_OBJECT_ID && vlan.first != bv_id)
+        {
+            continue;
+        }
+
+        for (const auto& mac : vlan.second)
+        {
+            FdbEntry entry;
+            entry.mac = mac;
+            entry.bv_id = vlan.first;
+            entry.port_name = port_name;
+            entries.push_back(entry);
+        }
+    }
+}
+
 void FdbOrch::update(sai_fdb_event_t        type,
                      const sai_fdb_entry_t* entry,
                      sai_object_id_t        bridge_port_id)
@@ -161,7 +234,9 @@ void FdbOrch::update(sai_fdb_event_t        type,
     update.entry.mac = entry->mac_address;
     update.entry.bv_id = entry->bv_id;
     update.type = "dynamic";
-    Port vlan;
+    /* Ports are looked up and counted in place, update.port is a copy for the observers */
+    Port *vlan = nullptr;
+    Port *port = nullptr;
 
     SWSS_LOG_INFO("FDB event:%d, MAC: %s , BVID: 0x%" PRIx64 " , \
                    bridge port ID: 0x%" PRIx64 ".",
@@ -170,7 +245,7 @@ void FdbOrch::update(sai_fdb_event_t        type,
 
 
     if (bridge_port_id &&
-        !m_portsOrch->getPortByBridgePortId(bridge_port_id, update.port))
+        (port = m_portsOrch->findPortByBridgePortId(bridge_port_id)) == nullptr)
     {
         if (type == SAI_FDB_EVENT_FLUSHED)
         {
@@ -189,13 +264,19 @@ void FdbOrch::update(sai_fdb_event_t        type,
         return;
     }
 
+    if (port != nullptr)
+    {
+        update.port = *port;
+    }
+
     switch (type)
     {
     case SAI_FDB_EVENT_LEARNED:
     {
         SWSS_LOG_INFO("Received LEARN event for bvid=0x%" PRIx64 "mac=%s port=0x%" PRIx64, entry->bv_id, update.entry.mac.to_string().c_str(), bridge_port_id);
 
-        if (!m_portsOrch->getPort(entry->bv_id, vlan))
+        vlan = m_portsOrch->findPort(entry->bv_id);
+        if (vlan == nullptr)
         {
             SWSS_LOG_ERROR("FdbOrch LEARN notification: Failed to locate vlan port from bv_id 0x%" PRIx64, entry->bv_id);
             return;
@@ -214,10 +295,12 @@ void FdbOrch::update(sai_fdb_event_t        type,
         update.add = true;
         update.entry.port_name = update.port.m_alias;
         update.type = "dynamic";
-        update.port.m_fdb_count++;
-        m_portsOrch->setPort(update.port.m_alias, update.port);
-        vlan.m_fdb_count++;
-        m_portsOrch->setPort(vlan.m_alias, vlan);
+        if (port != nullptr)
+        {
+            port->m_fdb_count++;
+            update.port.m_fdb_count++;
+        }
+        vlan->m_fdb_count++;
 
         storeFdbEntryState(update);
         notify(SUBJECT_TYPE_FDB_CHANGE, &update);
@@ -229,7 +312,8 @@ void FdbOrch::update(sai_fdb_event_t        type,
         SWSS_LOG_INFO("Received AGE event for bvid=0x%" PRIx64 " mac=%s port=0x%" PRIx64,
                        entry->bv_id, update.entry.mac.to_string().c_str(), bridge_port_id);
 
-        if (!m_portsOrch->getPort(entry->bv_id, vlan))
+        vlan = m_portsOrch->findPort(entry->bv_id);
+        if (vlan == nullptr)
         {
             SWSS_LOG_NOTICE("FdbOrch AGE notification: Failed to locate vlan port from bv_id 0x%" PRIx64, entry->bv_id);
         }
@@ -248,10 +332,16 @@ void FdbOrch::update(sai_fdb_event_t        type,
             SWSS_LOG_INFO("FdbOrch AGE notification: Stale aging event received for mac-bv_id %s-0x%" PRIx64 " with bp=0x%" PRIx64 " existing bp=0x%" PRIx64,
                            update.entry.mac.to_string().c_str(), entry->bv_id, bridge_port_id, existing_entry->second.bridge_port_id);
             // We need to get the port for bridge-port in existing fdb
-            if (!m_portsOrch->getPortByBridgePortId(existing_entry->second.bridge_port_id, update.port))
+            Port *existing_port = m_portsOrch->findPortByBridgePortId(existing_entry->second.bridge_port_id);
+            if (existing_port == nullptr)
             {
                 SWSS_LOG_INFO("FdbOrch AGE notification: Failed to get port by bridge port ID 0x%" PRIx64, existing_entry->second.bridge_port_id);
             }
+            else
+            {
+                port = existing_port;
+                update.port = *port;
+            }
             // dont return, let it delete just to bring SONiC and SAI in sync
             // return;
         }
@@ -260,7 +350,7 @@ void FdbOrch::update(sai_fdb_event_t        type,
         {
             update.type = "static";
 
-            if (vlan.m_members.find(update.port.m_alias) == vlan.m_members.end())
+            if (vlan == nullptr || vlan->m_members.find(update.port.m_alias) == vlan->m_members.end())
             {
                 FdbData fdbData;
                 fdbData.bridge_port_id = SAI_NULL_OBJECT_ID;
@@ -270,7 +360,7 @@ void FdbOrch::update(sai_fdb_event_t        type,
                 fdbData.esi = existing_entry->second.esi;
                 fdbData.vni = existing_entry->second.vni;
         	    saved_fdb_entries[update.port.m_alias].push_back(
-                        {existing_entry->first.mac, vlan.m_vlan_info.vlan_id, fdbData});
+                        {existing_entry->first.mac, vlan ? vlan->m_vlan_info.vlan_id : (sai_vlan_id_t)0, fdbData});
             }
             else
             {
@@ -301,15 +391,14 @@ void FdbOrch::update(sai_fdb_event_t        type,
         }
 
         update.add = false;
-        if (!update.port.m_alias.empty())
+        if (port != nullptr)
         {
+            port->m_fdb_count--;
             update.port.m_fdb_count--;
-            m_portsOrch->setPort(update.port.m_alias, update.port);
         }
-        if (!vlan.m_alias.empty())
+        if (vlan != nullptr)
         {
-            vlan.m_fdb_count--;
-            m_portsOrch->setPort(vlan.m_alias, vlan);
+            vlan->m_fdb_count--;
         }
         storeFdbEntryState(update);
 
@@ -320,13 +409,14 @@ void FdbOrch::update(sai_fdb_event_t        type,
     }
     case SAI_FDB_EVENT_MOVE:
     {
-        Port port_old;
+        Port *port_old = nullptr;
         auto existing_entry = m_entries.find(update.entry);
 
         SWSS_LOG_INFO("Received MOVE event for bvid=0x%" PRIx64 " mac=%s port=0x%" PRIx64,
                        entry->bv_id, update.entry.mac.to_string().c_str(), bridge_port_id);
 
-        if (!m_portsOrch->getPort(entry->bv_id, vlan))
+        vlan = m_portsOrch->findPort(entry->bv_id);
+        if (vlan == nullptr)
         {
             SWSS_LOG_ERROR("FdbOrch MOVE notification: Failed to locate vlan port from bv_id 0x%" PRIx64, entry->bv_id);
             return;
@@ -338,25 +428,29 @@ void FdbOrch::update(sai_fdb_event_t        type,
              SWSS_LOG_WARN("FdbOrch MOVE notification: mac %s is not found in bv_id 0x%" PRIx64,
                     update.entry.mac.to_string().c_str(), entry->bv_id);
         }
-        else if (!m_portsOrch->getPortByBridgePortId(existing_entry->second.bridge_port_id, port_old))
+        else if ((port_old = m_portsOrch->findPortByBridgePortId(existing_entry->second.bridge_port_id)) == nullptr)
         {
             SWSS_LOG_ERROR("FdbOrch MOVE notification: Failed to get port by bridge port ID 0x%" PRIx64, existing_entry->second.bridge_port_id);
             return;
         }
 
         update.add = true;
-        if (!port_old.m_alias.empty())
+        Port old_port;
+        if (port_old != nullptr)
         {
-            port_old.m_fdb_count--;
-            m_portsOrch->setPort(port_old.m_alias, port_old);
+            port_old->m_fdb_count--;
+            old_port = *port_old;
+        }
+        if (port != nullptr)
+        {
+            port->m_fdb_count++;
+            update.port.m_fdb_count++;
         }
-        update.port.m_fdb_count++;
-        m_portsOrch->setPort(update.port.m_alias, update.port);
         storeFdbEntryState(update);
 
         notify(SUBJECT_TYPE_FDB_CHANGE, &update);
 
-        notifyTunnelOrch(port_old);
+        notifyTunnelOrch(old_port);
 
         break;
     }
@@ -369,15 +463,14 @@ void FdbOrch::update(sai_fdb_event_t        type,
 
         string vlanName = "-";
         if (entry->bv_id) {
-            Port vlan;
-
-            if (!m_portsOrch->getPort(entry->bv_id, vlan))
+            vlan = m_portsOrch->findPort(entry->bv_id);
+            if (vlan == nullptr)
             {
                 SWSS_LOG_NOTICE("FdbOrch notification: Failed to locate vlan\
                                 port from bv_id 0x%" PRIx64, entry->bv_id);
                 return;
             }
-            vlanName = "Vlan" + to_string(vlan.m_vlan_info.vlan_id);
+            vlanName = "Vlan" + to_string(vlan->m_vlan_info.vlan_id);
         }
 
 
@@ -414,23 +507,20 @@ void FdbOrch::update(sai_fdb_event_t        type,
                            update.entry.mac.to_string().c_str(),
                            vlanName.c_str(), update.port.m_alias.c_str());
 
-            for (auto itr = m_entries.begin(); itr != m_entries.end();)
+            vector<FdbEntry> entries;
+            getPortEntries(update.port.m_alias, SAI_NULL_OBJECT_ID, entries);
+            for (const auto& flushed : entries)
             {
-                auto next_item = std::next(itr);
-                if (itr->first.port_name == update.port.m_alias)
-                {
-                    update.entry.mac = itr->first.mac;
-                    update.entry.bv_id = itr->first.bv_id;
-                    update.add = false;
+                update.entry.mac = flushed.mac;
+                update.entry.bv_id = flushed.bv_id;
+                update.add = false;
 
-                    storeFdbEntryState(update);
+                storeFdbEntryState(update);
 
-                    for (auto observer: m_observers)
-                    {
-                        observer->update(SUBJECT_TYPE_FDB_CHANGE, &update);
-                    }
+                for (auto observer: m_observers)
+                {
+                    observer->update(SUBJECT_TYPE_FDB_CHANGE, &update);
                 }
-                itr = next_item;
             }
         }
         else if (bridge_port_id == SAI_NULL_OBJECT_ID)
@@ -533,6 +623,8 @@ void FdbOrch::doTask(Consumer& consumer)
     }
 
 
+    FdbBatch batch;
+
     auto it = consumer.m_toSync.begin();
     while (it != consumer.m_toSync.end())
     {
@@ -571,6 +663,12 @@ void FdbOrch::doTask(Consumer& consumer)
         entry.mac = MacAddress(keys[1]);
         entry.bv_id = vlan.m_vlan_info.vlan_oid;
 
+        /* Apply the pending operation on the MAC before checking the next one */
+        if (batch.entries.find(entry) != batch.entries.end())
+        {
+            flushFdbBatch(consumer, batch);
+        }
+
         if (op == SET_COMMAND)
         {
             string port = "";
@@ -651,18 +749,18 @@ void FdbOrch::doTask(Consumer& consumer)
             fdbData.remote_ip = remote_ip;
             fdbData.esi = esi;
             fdbData.vni = vni;
-            if (addFdbEntry(entry, port, fdbData))
-                it = consumer.m_toSync.erase(it);
-            else
-                it++;
+
+            batch.contexts.emplace_back();
+            batch.contexts.back().it = it;
+            bool done = addFdbEntry(entry, port, fdbData, &batch.contexts.back());
+            it = nextFdbTask(consumer, batch, it, done);
         }
         else if (op == DEL_COMMAND)
         {
-            if (removeFdbEntry(entry, origin))
-                it = consumer.m_toSync.erase(it);
-            else
-                it++;
-
+            batch.contexts.emplace_back();
+            batch.contexts.back().it = it;
+            bool done = removeFdbEntry(entry, origin, &batch.contexts.back());
+            it = nextFdbTask(consumer, batch, it, done);
         }
         else
         {
@@ -670,6 +768,61 @@ void FdbOrch::doTask(Consumer& consumer)
             it = consumer.m_toSync.erase(it);
         }
     }
+
+    flushFdbBatch(consumer, batch);
+}
+
+/* Move to the next task, a task handed to the FDB bulker is erased once its status is handled */
+SyncMap::iterator FdbOrch::nextFdbTask(Consumer& consumer, FdbBatch& batch, SyncMap::iterator it, bool done)
+{
+    if (batch.contexts.back().pending)
+    {
+        batch.entries.insert(batch.contexts.back().entry);
+        return ++it;
+    }
+
+    batch.contexts.pop_back();
+    return done ? consumer.m_toSync.erase(it) : ++it;
+}
+
+void FdbOrch::flushFdbBatch(Consumer& consumer, FdbBatch& batch)
+{
+    SWSS_LOG_ENTER();
+
+    if (batch.contexts.empty())
+    {
+        return;
+    }
+
+    // Flush the FDB bulker, so FDB entries will be written to syncd and ASIC
+    m_fdbBulker.flush();
+
+    // Go through the bulker results
+    for (const auto& ctx : batch.contexts)
+    {
+        bool done = ctx.add ? addFdbEntryPost(ctx) : removeFdbEntryPost(ctx, batch);
+        if (done)
+        {
+            consumer.m_toSync.erase(ctx.it);
+        }
+    }
+
+    /* Tunnel ports are removed after all the MACs of the batch are counted */
+    for (const auto& alias : batch.removedPorts)
+    {
+        const Port *port = m_portsOrch->findPort(alias);
+        if (port != nullptr)
+        {
+            Port tunnelPort = *port;
+            notifyTunnelOrch(tunnelPort);
+        }
+    }
+
+    SWSS_LOG_INFO("Flushed %zu FDB entries", batch.contexts.size());
+
+    batch.contexts.clear();
+    batch.entries.clear();
+    batch.removedPorts.clear();
 }
 
 void FdbOrch::doTask(NotificationConsumer& consumer)
@@ -806,19 +959,9 @@ void FdbOrch::notifyObserversFDBFlush(Port &port, sai_object_id_t& bvid)
     FdbFlushUpdate flushUpdate;
     flushUpdate.port = port;
 
-    for (auto itr = m_entries.begin(); itr != m_entries.end(); ++itr)
-    {
-        if ((itr->first.port_name == port.m_alias) &&
-            (itr->first.bv_id == bvid))
-        {
-            SWSS_LOG_INFO("Adding MAC learnt on [ port:%s , bvid:0x%" PRIx64 "]\
-                           to ARP flush", port.m_alias.c_str(), bvid);
-            FdbEntry entry;
-            entry.mac = itr->first.mac;
-            entry.bv_id = itr->first.bv_id;
-            flushUpdate.entries.push_back(entry);
-        }
-    }
+    getPortEntries(port.m_alias, bvid, flushUpdate.entries);
+    SWSS_LOG_INFO("Adding %zu MACs learnt on [ port:%s , bvid:0x%" PRIx64 "]\
+                   to ARP flush", flushUpdate.entries.size(), port.m_alias.c_str(), bvid);
 
     if (!flushUpdate.entries.empty())
     {
@@ -841,14 +984,15 @@ void FdbOrch::updatePortOperState(const PortOperStateUpdate& update)
         // and call notifyObserversFDBFlush
         for (const auto& vlan_member: p.m_vlan_members)
         {
-            swss::Port vlan;
             string vlan_alias = VLAN_PREFIX + to_string(vlan_member.first);
-            if (!m_portsOrch->getPort(vlan_alias, vlan))
+            const Port *vlan = m_portsOrch->findPort(vlan_alias);
+            if (vlan == nullptr)
             {
                 SWSS_LOG_INFO("Failed to locate VLAN %s", vlan_alias.c_str());
                 continue;
             }
-            notifyObserversFDBFlush(p, vlan.m_vlan_info.vlan_oid);
+            sai_object_id_t vlan_oid = vlan->m_vlan_info.vlan_oid;
+            notifyObserversFDBFlush(p, vlan_oid);
         }
 
     }
@@ -893,7 +1037,7 @@ void FdbOrch::updateVlanMember(const VlanMemberUpdate& update)
 }
 
 bool FdbOrch::addFdbEntry(const FdbEntry& entry, const string& port_name,
-        FdbData fdbData)
+        FdbData fdbData, FdbBulkContext *ctx)
 {
     Port vlan;
     Port port;
@@ -1111,6 +1255,18 @@ bool FdbOrch::addFdbEntry(const FdbEntry& entry, const string& port_name,
     {
         SWSS_LOG_INFO("MAC-Create %s FDB %s in %s on %s", fdbData.type.c_str(), entry.mac.to_string().c_str(), vlan.m_alias.c_str(), port_name.c_str());
 
+        if (ctx)
+        {
+            /* Created by the FDB bulker, the entry is stored by addFdbEntryPost() */
+            ctx->entry = entry;
+            ctx->fdbData = fdbData;
+            ctx->port_name = port_name;
+            ctx->add = true;
+            ctx->pending = true;
+            m_fdbBulker.create_entry(&ctx->object_status, &fdb_entry, (uint32_t)attrs.size(), attrs.data());
+            return true;
+        }
+
         status = sai_fdb_api->create_fdb_entry(&fdb_entry, (uint32_t)attrs.size(), attrs.data());
         if (status != SAI_STATUS_SUCCESS)
         {
@@ -1129,10 +1285,56 @@ bool FdbOrch::addFdbEntry(const FdbEntry& entry, const string& port_name,
         m_portsOrch->setPort(vlan.m_alias, vlan);
     }
 
+    addFdbEntryState(entry, port, vlan, fdbData, macUpdate, oldOrigin);
+
+    return true;
+}
+
+bool FdbOrch::addFdbEntryPost(const FdbBulkContext& ctx)
+{
+    SWSS_LOG_ENTER();
+
+    const FdbEntry& entry = ctx.entry;
+    const FdbData& fdbData = ctx.fdbData;
+
+    if (ctx.object_status != SAI_STATUS_SUCCESS)
+    {
+        SWSS_LOG_ERROR("Failed to create %s FDB %s bv_id 0x%" PRIx64 " on %s, rv:%d",
+                fdbData.type.c_str(), entry.mac.to_string().c_str(),
+                entry.bv_id, ctx.port_name.c_str(), ctx.object_status);
+        task_process_status handle_status = handleSaiCreateStatus(SAI_API_FDB, ctx.object_status);
+        if (handle_status != task_success)
+        {
+            return parseHandleSaiStatusFailure(handle_status);
+        }
+    }
+
+    /* Both were found when the entry was handed to the bulker */
+    Port *port = m_portsOrch->findPort(ctx.port_name);
+    Port *vlan = m_portsOrch->findPort(entry.bv_id);
+    if (port == nullptr || vlan == nullptr)
+    {
+        SWSS_LOG_ERROR("Failed to locate port %s or vlan 0x%" PRIx64 " of created FDB %s",
+                ctx.port_name.c_str(), entry.bv_id, entry.mac.to_string().c_str());
+        return true;
+    }
+
+    port->m_fdb_count++;
+    vlan->m_fdb_count++;
+
+    addFdbEntryState(entry, *port, *vlan, fdbData, false, FDB_ORIGIN_INVALID);
+
+    return true;
+}
+
+/* Store an added or updated FDB entry, and publish it to STATE_DB and the observers */
+void FdbOrch::addFdbEntryState(const FdbEntry& entry, const Port& port, const Port& vlan,
+        const FdbData& fdbData, bool macUpdate, FdbOrigin oldOrigin)
+{
     FdbData storeFdbData = fdbData;
     storeFdbData.bridge_port_id = port.m_bridge_port_id;
 
-    m_entries[entry] = storeFdbData;
+    setEntry(entry, storeFdbData);
 
     string key = "Vlan" + to_string(vlan.m_vlan_info.vlan_id) + ":" + entry.mac.to_string();
 
@@ -1141,12 +1343,12 @@ bool FdbOrch::addFdbEntry(const FdbEntry& entry, const string& port_name,
         /* State-DB is updated only for Local Mac addresses */
         // Write to StateDb
         std::vector<FieldValueTuple> fvs;
-        fvs.push_back(FieldValueTuple("port", port_name));
+        fvs.push_back(FieldValueTuple("port", port.m_alias));
         if (fdbData.type == "dynamic_local")
             fvs.push_back(FieldValueTuple("type", "dynamic"));
         else
             fvs.push_back(FieldValueTuple("type", fdbData.type));
-        m_fdbStateTable.set(key, fvs);
+        m_stateDbWriter.set(m_fdbStateTable.getTableName(), key, fvs);
     }
     else if (macUpdate && (oldOrigin != FDB_ORIGIN_VXLAN_ADVERTIZED))
     {
@@ -1154,7 +1356,7 @@ bool FdbOrch::addFdbEntry(const FdbEntry& entry, const string& port_name,
          * so delete from StateDb since we only keep local fdbs
          * in state-db
          */
-        m_fdbStateTable.del(key);
+        m_stateDbWriter.del(m_fdbStateTable.getTableName(), key);
     }
 
     if (!macUpdate)
@@ -1169,11 +1371,9 @@ bool FdbOrch::addFdbEntry(const FdbEntry& entry, const string& port_name,
     update.add = true;
 
     notify(SUBJECT_TYPE_FDB_CHANGE, &update);
-
-    return true;
 }
 
-bool FdbOrch::removeFdbEntry(const FdbEntry& entry, FdbOrigin origin)
+bool FdbOrch::removeFdbEntry(const FdbEntry& entry, FdbOrigin origin, FdbBulkContext *ctx)
 {
     Port vlan;
     Port port;
@@ -1223,14 +1423,24 @@ bool FdbOrch::removeFdbEntry(const FdbEntry& entry, FdbOrigin origin)
         return true;
     }
 
-    string key = "Vlan" + to_string(vlan.m_vlan_info.vlan_id) + ":" + entry.mac.to_string();
-
     sai_status_t status;
     sai_fdb_entry_t fdb_entry;
     fdb_entry.switch_id = gSwitchId;
     memcpy(fdb_entry.mac_address, entry.mac.getMac(), sizeof(sai_mac_t));
     fdb_entry.bv_id = entry.bv_id;
 
+    if (ctx)
+    {
+        /* Removed by the FDB bulker, the entry is erased by removeFdbEntryPost() */
+        ctx->entry = entry;
+        ctx->fdbData = fdbData;
+        ctx->port_name = port.m_alias;
+        ctx->add = false;
+        ctx->pending = true;
+        m_fdbBulker.remove_entry(&ctx->object_status, &fdb_entry);
+        return true;
+    }
+
     status = sai_fdb_api->remove_fdb_entry(&fdb_entry);
     if (status != SAI_STATUS_SUCCESS)
     {
@@ -1250,12 +1460,65 @@ bool FdbOrch::removeFdbEntry(const FdbEntry& entry, FdbOrigin origin)
     m_portsOrch->setPort(port.m_alias, port);
     vlan.m_fdb_count--;
     m_portsOrch->setPort(vlan.m_alias, vlan);
-    (void)m_entries.erase(entry);
+
+    removeFdbEntryState(entry, port, vlan, fdbData);
+
+    notifyTunnelOrch(port);
+
+    return true;
+}
+
+bool FdbOrch::removeFdbEntryPost(const FdbBulkContext& ctx, FdbBatch& batch)
+{
+    SWSS_LOG_ENTER();
+
+    const FdbEntry& entry = ctx.entry;
+
+    if (ctx.object_status != SAI_STATUS_SUCCESS)
+    {
+        SWSS_LOG_ERROR("FdbOrch RemoveFDBEntry: Failed to remove FDB entry. mac=%s, bv_id=0x%" PRIx64 ", rv:%d",
+                       entry.mac.to_string().c_str(), entry.bv_id, ctx.object_status);
+        task_process_status handle_status = handleSaiRemoveStatus(SAI_API_FDB, ctx.object_status);
+        if (handle_status != task_success)
+        {
+            return parseHandleSaiStatusFailure(handle_status);
+        }
+    }
+
+    /* Both were found when the entry was handed to the bulker */
+    Port *port = m_portsOrch->findPort(ctx.port_name);
+    Port *vlan = m_portsOrch->findPort(entry.bv_id);
+    if (port == nullptr || vlan == nullptr)
+    {
+        SWSS_LOG_ERROR("Failed to locate port %s or vlan 0x%" PRIx64 " of removed FDB %s",
+                ctx.port_name.c_str(), entry.bv_id, entry.mac.to_string().c_str());
+        return true;
+    }
+
+    SWSS_LOG_INFO("Removed mac=%s bv_id=0x%" PRIx64 " port:%s",
+            entry.mac.to_string().c_str(), entry.bv_id, port->m_alias.c_str());
+
+    port->m_fdb_count--;
+    vlan->m_fdb_count--;
+
+    removeFdbEntryState(entry, *port, *vlan, ctx.fdbData);
+
+    batch.removedPorts.insert(port->m_alias);
+
+    return true;
+}
+
+/* Erase a removed FDB entry, and withdraw it from STATE_DB and the observers */
+void FdbOrch::removeFdbEntryState(const FdbEntry& entry, const Port& port, const Port& vlan,
+        const FdbData& fdbData)
+{
+    (void)eraseEntry(entry);
 
     // Remove in StateDb
     if (fdbData.origin != FDB_ORIGIN_VXLAN_ADVERTIZED)
     {
-        m_fdbStateTable.del(key);
+        string key = "Vlan" + to_string(vlan.m_vlan_info.vlan_id) + ":" + entry.mac.to_string();
+        m_stateDbWriter.del(m_fdbStateTable.getTableName(), key);
     }
 
     gCrmOrch->decCrmResUsedCounter(CrmResourceType::CRM_FDB_ENTRY);
@@ -1267,10 +1530,6 @@ bool FdbOrch::removeFdbEntry(const FdbEntry& entry, FdbOrigin origin)
     update.add = false;
 
     notify(SUBJECT_TYPE_FDB_CHANGE, &update);
-
-    notifyTunnelOrch(update.port);
-
-    return true;
 }
 
 void FdbOrch::deleteFdbEntryFromSavedFDB(const MacAddress &mac,
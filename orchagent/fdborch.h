@@ -1,9 +1,13 @@
 #ifndef SWSS_FDBORCH_H
 #define SWSS_FDBORCH_H
 
+#include <deque>
+
 #include "orch.h"
 #include "observer.h"
 #include "portsorch.h"
+#include "bulker.h"
+#include "batcheddbwriter.h"
 
 enum FdbOrigin
 {
@@ -76,6 +80,35 @@ struct SavedFdbEntry
 
 typedef unordered_map<string, vector<SavedFdbEntry>> fdb_entries_by_port_t;
 
+/* An FDB entry of m_toSync waiting for the FDB bulker */
+struct FdbBulkContext
+{
+    SyncMap::iterator                   it;                 // m_toSync entry, erased once the status is handled
+    FdbEntry                            entry;
+    FdbData                             fdbData;
+    string                              port_name;
+    bool                                add;
+    bool                                pending;            // Create or remove handed to the bulker
+    sai_status_t                        object_status;
+
+    FdbBulkContext()
+        : add(false), pending(false), object_status(SAI_STATUS_NOT_EXECUTED)
+    {
+    }
+};
+
+/*
+ * FDB entries handed to the FDB bulker together. A MAC is in the batch at
+ * most once, as the checks of an entry depend on the result of the previous
+ * operation on the same MAC.
+ */
+struct FdbBatch
+{
+    std::deque<FdbBulkContext>          contexts;
+    std::set<FdbEntry>                  entries;
+    std::set<string>                    removedPorts;       // Ports which lost MACs, for tunnel port cleanup
+};
+
 class FdbOrch: public Orch, public Subject, public Observer
 {
 public:
@@ -92,7 +125,7 @@ public:
     void update(SubjectType type, void *cntx);
     bool getPort(const MacAddress&, uint16_t, Port&);
 
-    bool removeFdbEntry(const FdbEntry& entry, FdbOrigin origin=FDB_ORIGIN_PROVISIONED);
+    bool removeFdbEntry(const FdbEntry& entry, FdbOrigin origin=FDB_ORIGIN_PROVISIONED, FdbBulkContext *ctx=nullptr);
 
     static const int fdborch_pri;
     void flushFDBEntries(sai_object_id_t bridge_port_oid,
@@ -102,9 +135,14 @@ public:
 private:
     PortsOrch *m_portsOrch;
     map<FdbEntry, FdbData> m_entries;
+    /* MACs of m_entries by the port name and bv_id of their entry, to flush the MACs of a port */
+    unordered_map<string, map<sai_object_id_t, set<MacAddress>>> m_entriesByPort;
     fdb_entries_by_port_t saved_fdb_entries;
     vector<Table*> m_appTables;
     Table m_fdbStateTable;
+    /* STATE_DB FDB_TABLE writes are batched with the other STATE_DB writes */
+    BatchedDbWriter &m_stateDbWriter;
+    EntityBulker<sai_fdb_api_t> m_fdbBulker;
     NotificationConsumer* m_flushNotificationsConsumer;
     NotificationConsumer* m_fdbNotificationConsumer;
 
@@ -114,10 +152,21 @@ private:
     void updateVlanMember(const VlanMemberUpdate&);
     void updatePortOperState(const PortOperStateUpdate&);
 
-    bool addFdbEntry(const FdbEntry&, const string&, FdbData fdbData);
+    bool addFdbEntry(const FdbEntry&, const string&, FdbData fdbData, FdbBulkContext *ctx = nullptr);
+    bool addFdbEntryPost(const FdbBulkContext& ctx);
+    void addFdbEntryState(const FdbEntry& entry, const Port& port, const Port& vlan,
+                          const FdbData& fdbData, bool macUpdate, FdbOrigin oldOrigin);
+    bool removeFdbEntryPost(const FdbBulkContext& ctx, FdbBatch& batch);
+    void removeFdbEntryState(const FdbEntry& entry, const Port& port, const Port& vlan, const FdbData& fdbData);
+    SyncMap::iterator nextFdbTask(Consumer& consumer, FdbBatch& batch, SyncMap::iterator it, bool done);
+    void flushFdbBatch(Consumer& consumer, FdbBatch& batch);
     void deleteFdbEntryFromSavedFDB(const MacAddress &mac, const unsigned short &vlanId, FdbOrigin origin, const string portName="");
 
     bool storeFdbEntryState(const FdbUpdate& update);
+    /* Update m_entries and m_entriesByPort together */
+    void setEntry(const FdbEntry& entry, const FdbData& fdbData);
+    bool eraseEntry(const FdbEntry& entry);
+    void getPortEntries(const string& port_name, sai_object_id_t bv_id, vector<FdbEntry>& entries) const;
     void notifyTunnelOrch(Port& port);
 };
 
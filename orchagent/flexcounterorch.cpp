@@ -8,6 +8,7 @@
 #include "bufferorch.h"
 #include "flexcounterorch.h"
 #include "debugcounterorch.h"
+#include "aclorch.h"
 
 extern sai_port_api_t *sai_port_api;
 
@@ -31,6 +32,7 @@ unordered_map<string, string> flexCounterGroupMap =
     {"RIF", RIF_STAT_COUNTER_FLEX_COUNTER_GROUP},
     {"RIF_RATES", RIF_RATE_COUNTER_FLEX_COUNTER_GROUP},
     {"DEBUG_COUNTER", DEBUG_COUNTER_FLEX_COUNTER_GROUP},
+    {"ACL", ACL_STAT_COUNTER_FLEX_COUNTER_GROUP},
 };
 
 
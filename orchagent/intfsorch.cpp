@@ -1105,6 +1105,7 @@ bool IntfsOrch::addRouterIntfs(sai_object_id_t vrf_id, Port &port)
         voqSyncAddIntf(port.m_alias);
     }
 
+    Orch::notifyRetryEvent(RETRY_EVENT_RIF_ADDED, port.m_alias);
     return true;
 }
 
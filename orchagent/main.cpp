@@ -50,15 +50,21 @@ MacAddress gVxlanMacAddress;
 #define DEFAULT_BATCH_SIZE  128
 int gBatchSize = DEFAULT_BATCH_SIZE;
 
+/* Routes per pipelined bulk batch, 0 programs all pending routes in one batch */
+int gRouteBatchSize = 0;
+
 bool gSairedisRecord = true;
 bool gSwssRecord = true;
 bool gLogRotate = false;
 bool gSaiRedisLogRotate = false;
+bool gConsumerStatsDump = false;
 bool gSyncMode = false;
 sai_redis_communication_mode_t gRedisCommunicationMode = SAI_REDIS_COMMUNICATION_MODE_REDIS_ASYNC;
 string gAsicInstance;
 
 extern bool gIsNatSupported;
+extern bool gOrchWorkerThreads;
+extern bool gPfcWdNativeDetector;
 
 ofstream gRecordOfs;
 string gRecordFile;
@@ -72,7 +78,7 @@ string gMyAsicName = "";
 
 void usage()
 {
-    cout << "usage: orchagent [-h] [-r record_type] [-d record_location] [-f swss_rec_filename] [-j sairedis_rec_filename] [-b batch_size] [-m MAC] [-i INST_ID] [-s] [-z mode]" << endl;
+    cout << "usage: orchagent [-h] [-r record_type] [-d record_location] [-f swss_rec_filename] [-j sairedis_rec_filename] [-b batch_size] [-k route_batch_size] [-m MAC] [-i INST_ID] [-s] [-z mode] [-t] [-p]" << endl;
     cout << "    -h: display this message" << endl;
     cout << "    -r record_type: record orchagent logs with type (default 3)" << endl;
     cout << "                    0: do not record logs" << endl;
@@ -81,12 +87,15 @@ void usage()
     cout << "                    3: enable both above two records" << endl;
     cout << "    -d record_location: set record logs folder location (default .)" << endl;
     cout << "    -b batch_size: set consumer table pop operation batch size (default 128)" << endl;
+    cout << "    -k route_batch_size: program routes in pipelined batches of this size (default 0, disabled)" << endl;
     cout << "    -m MAC: set switch MAC address" << endl;
     cout << "    -i INST_ID: set the ASIC instance_id in multi-asic platform" << endl;
     cout << "    -s: enable synchronous mode (deprecated, use -z)" << endl;
     cout << "    -z: redis communication mode (redis_async|redis_sync|zmq_sync), default: redis_async" << endl;
     cout << "    -f swss_rec_filename: swss record log filename(default 'swss.rec')" << endl;
     cout << "    -j sairedis_rec_filename: sairedis record log filename(default sairedis.rec)" << endl;
+    cout << "    -t: run route, fdb, acl, watermark and pfcwd orchs on worker threads" << endl;
+    cout << "    -p: detect PFC storms in orchagent instead of the Redis Lua plugins (broadcom only)" << endl;
 }
 
 void sighup_handler(int signo)
@@ -98,6 +107,14 @@ void sighup_handler(int signo)
     gSaiRedisLogRotate = true;
 }
 
+void sigusr1_handler(int signo)
+{
+    /*
+     * Consumer counters are logged and published from the main loop.
+     */
+    gConsumerStatsDump = true;
+}
+
 void syncd_apply_view()
 {
     SWSS_LOG_NOTICE("Notify syncd APPLY_VIEW");
@@ -312,6 +329,12 @@ int main(int argc, char **argv)
         exit(1);
     }
 
+    if (signal(SIGUSR1, sigusr1_handler) == SIG_ERR)
+    {
+        SWSS_LOG_ERROR("failed to setup SIGUSR1 action");
+        exit(1);
+    }
+
     int opt;
     sai_status_t status;
 
@@ -319,13 +342,16 @@ int main(int argc, char **argv)
     string swss_rec_filename = "swss.rec";
     string sairedis_rec_filename = "sairedis.rec";
 
-    while ((opt = getopt(argc, argv, "b:m:r:f:j:d:i:hsz:")) != -1)
+    while ((opt = getopt(argc, argv, "b:k:m:r:f:j:d:i:hsz:tp")) != -1)
     {
         switch (opt)
         {
         case 'b':
             gBatchSize = atoi(optarg);
             break;
+        case 'k':
+            gRouteBatchSize = atoi(optarg);
+            break;
         case 'i':
             {
                 // Limit asic instance string max length
@@ -384,6 +410,14 @@ int main(int argc, char **argv)
         case 'z':
             sai_deserialize_redis_communication_mode(optarg, gRedisCommunicationMode);
             break;
+        case 't':
+            gOrchWorkerThreads = true;
+            SWSS_LOG_NOTICE("Enabling orch worker threads");
+            break;
+        case 'p':
+            gPfcWdNativeDetector = true;
+            SWSS_LOG_NOTICE("Enabling native PFC watchdog detector");
+            break;
         case 'f':
 
             if (optarg)
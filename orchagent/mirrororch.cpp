@@ -520,9 +520,8 @@ void MirrorOrch::setSessionState(const string& name, const MirrorEntry& session,
 
     if (attr.empty() || attr == MIRROR_SESSION_MONITOR_PORT)
     {
-        Port port;
-        m_portsOrch->getPort(session.neighborInfo.portId, port);
-        fvVector.emplace_back(MIRROR_SESSION_MONITOR_PORT, port.m_alias);
+        const Port *port = m_portsOrch->findPort(session.neighborInfo.portId);
+        fvVector.emplace_back(MIRROR_SESSION_MONITOR_PORT, port != nullptr ? port->m_alias : "");
     }
 
     if (attr.empty() || attr == MIRROR_SESSION_DST_MAC_ADDRESS)
@@ -24,6 +24,7 @@
 #include "logger.h"
 #include "tokenize.h"
 #include "natorch.h"
+#include "bulker.h"
 #include "notifier.h"
 #include "sai_serialize.h"
 
@@ -45,6 +46,8 @@ NatOrch::NatOrch(DBConnector *appDb, DBConnector *stateDb, vector<table_name_wit
          Orch(appDb, tableNames),
          m_neighOrch(neighOrch),
          m_routeOrch(routeOrch),
+         m_hitBitSweep(),
+         m_counterSweep(),
          m_countersDb("COUNTERS_DB", 0),
          m_countersNatTable(&m_countersDb, COUNTERS_NAT_TABLE),
          m_countersNaptTable(&m_countersDb, COUNTERS_NAPT_TABLE),
@@ -87,6 +90,9 @@ NatOrch::NatOrch(DBConnector *appDb, DBConnector *stateDb, vector<table_name_wit
     auto cleanupNotifier = new Notifier(m_cleanupNotificationConsumer, this, "NAT_DB_CLEANUP_NOTIFICATION");
     Orch::addExecutor(cleanupNotifier);
 
+    /* NAT entries are queried through the bulk attribute get */
+    SaiNatBulkFallback::api() = sai_nat_api;
+
     /* Start the timer to query NAT entry statistics every 5 secs and hitbits every 30 secs */
     SWSS_LOG_INFO("Start the HITBIT Timer ");
     auto interval      = timespec { .tv_sec = NAT_HITBIT_N_CNTRS_QUERY_PERIOD, .tv_nsec = 0 };
@@ -3135,10 +3141,19 @@ void NatOrch::doTask(SelectableTimer &timer)
 
     if (timer.getFd() == m_natQueryTimer->getFd())
     {
-        if (((natTimerTickCntr++) % NAT_HITBIT_QUERY_MULTIPLE) == 0)
+        /* Each sweep starts once the previous one is over, and queries
+         * a slice of the entries per tick */
+        if ((natTimerTickCntr % NAT_HITBIT_QUERY_MULTIPLE) == 0)
+        {
+            startQuerySweep(m_hitBitSweep, NAT_HITBIT_QUERY_SLICES);
+        }
+        if ((natTimerTickCntr % NAT_CNTRS_QUERY_MULTIPLE) == 0)
         {
-            queryHitBits();
+            startQuerySweep(m_counterSweep, NAT_CNTRS_QUERY_SLICES);
         }
+        natTimerTickCntr++;
+
+        queryHitBits();
         queryCounters();
     }
     else if (timer.getFd() == m_natTimeoutTimer->getFd())
@@ -3152,64 +3167,384 @@ void NatOrch::doTask(SelectableTimer &timer)
     }
 }
 
+/* SAI SNAT/DNAT entry of an IP address, and of an L4 port if proto isn't 0 */
+static sai_nat_entry_t getSaiNatEntry(sai_nat_type_t natType, const IpAddress &ipAddr,
+                                      uint8_t proto = 0, int l4_port = 0)
+{
+    sai_nat_entry_t nat_entry;
+
+    memset(&nat_entry, 0, sizeof(nat_entry));
+
+    nat_entry.vr_id     = gVirtualRouterId;
+    nat_entry.switch_id = gSwitchId;
+    nat_entry.nat_type  = natType;
+
+    if (natType == SAI_NAT_TYPE_DESTINATION_NAT)
+    {
+        nat_entry.data.key.dst_ip  = ipAddr.getV4Addr();
+        nat_entry.data.mask.dst_ip = 0xffffffff;
+        if (proto)
+        {
+            nat_entry.data.key.l4_dst_port  = (uint16_t)(l4_port);
+            nat_entry.data.mask.l4_dst_port = 0xffff;
+        }
+    }
+    else
+    {
+        nat_entry.data.key.src_ip  = ipAddr.getV4Addr();
+        nat_entry.data.mask.src_ip = 0xffffffff;
+        if (proto)
+        {
+            nat_entry.data.key.l4_src_port  = (uint16_t)(l4_port);
+            nat_entry.data.mask.l4_src_port = 0xffff;
+        }
+    }
+
+    if (proto)
+    {
+        nat_entry.data.key.proto  = proto;
+        nat_entry.data.mask.proto = 0xff;
+    }
+
+    return nat_entry;
+}
+
+/* SAI Twice NAT entry, and Twice NAPT entry if proto isn't 0 */
+static sai_nat_entry_t getSaiDoubleNatEntry(const IpAddress &srcIp, const IpAddress &dstIp,
+                                            uint8_t proto = 0, int src_l4_port = 0, int dst_l4_port = 0)
+{
+    sai_nat_entry_t dbl_nat_entry;
+
+    memset(&dbl_nat_entry, 0, sizeof(dbl_nat_entry));
+
+    dbl_nat_entry.vr_id = gVirtualRouterId;
+    dbl_nat_entry.switch_id = gSwitchId;
+    dbl_nat_entry.nat_type = SAI_NAT_TYPE_DOUBLE_NAT;
+    dbl_nat_entry.data.key.src_ip = srcIp.getV4Addr();
+    dbl_nat_entry.data.mask.src_ip = 0xffffffff;
+    dbl_nat_entry.data.key.dst_ip = dstIp.getV4Addr();
+    dbl_nat_entry.data.mask.dst_ip = 0xffffffff;
+
+    if (proto)
+    {
+        dbl_nat_entry.data.key.l4_src_port = (uint16_t)(src_l4_port);
+        dbl_nat_entry.data.mask.l4_src_port = 0xffff;
+        dbl_nat_entry.data.key.l4_dst_port = (uint16_t)(dst_l4_port);
+        dbl_nat_entry.data.mask.l4_dst_port = 0xffff;
+        dbl_nat_entry.data.key.proto = proto;
+        dbl_nat_entry.data.mask.proto = 0xff;
+    }
+
+    return dbl_nat_entry;
+}
+
+static uint8_t getNatProto(const string &prototype)
+{
+    return ((prototype == "TCP") ? IPPROTO_TCP : IPPROTO_UDP);
+}
+
+static void addHitBitAttrs(vector<sai_attribute_t> &attrs)
+{
+    sai_attribute_t attr;
+
+    memset(&attr, 0, sizeof(attr));
+    attr.id             = SAI_NAT_ENTRY_ATTR_HIT_BIT;  /* Get the Hit bit */
+    attr.value.booldata = 0;
+    attrs.push_back(attr);
+
+    attr.id             = SAI_NAT_ENTRY_ATTR_HIT_BIT_COR; /* clear the hit bit after returning the value */
+    attr.value.booldata = 1;
+    attrs.push_back(attr);
+}
+
+static void addCounterAttrs(vector<sai_attribute_t> &attrs)
+{
+    sai_attribute_t attr;
+
+    memset(&attr, 0, sizeof(attr));
+    attr.id = SAI_NAT_ENTRY_ATTR_BYTE_COUNT;
+    attrs.push_back(attr);
+
+    attr.id = SAI_NAT_ENTRY_ATTR_PACKET_COUNT;
+    attrs.push_back(attr);
+}
+
+/* Take the next keys of a sweep slice, at most budget of them */
+template <typename K>
+static pair<size_t, size_t> takeSlice(const vector<K> &keys, size_t &pos, size_t &budget)
+{
+    size_t begin = pos;
+    size_t end   = begin + min(budget, keys.size() - begin);
+
+    budget -= (end - begin);
+    pos     = end;
+
+    return make_pair(begin, end);
+}
+
+static uint64_t getTimeUsecs(const struct timespec &time)
+{
+    return (uint64_t)time.tv_sec * 1000000 + (uint64_t)time.tv_nsec / 1000;
+}
+
+/* Get the attributes of the NAT entries in bulk queries of NAT_BULK_QUERY_CHUNK
+ * entries, attrs holding the same number of attributes for each entry.
+ * Every entry gets its own status, a failed entry doesn't stop the others.
+ */
+void NatOrch::getNatEntriesAttribute(vector<sai_nat_entry_t> &entries, vector<sai_attribute_t> &attrs,
+                                     vector<sai_status_t> &statuses)
+{
+    statuses.assign(entries.size(), SAI_STATUS_NOT_EXECUTED);
+
+    if (entries.empty())
+    {
+        return;
+    }
+
+    uint32_t                  attr_count = (uint32_t)(attrs.size() / entries.size());
+    vector<uint32_t>          attr_counts(NAT_BULK_QUERY_CHUNK, attr_count);
+    vector<sai_attribute_t *> attr_lists(NAT_BULK_QUERY_CHUNK);
+
+    for (size_t begin = 0; begin < entries.size(); begin += NAT_BULK_QUERY_CHUNK)
+    {
+        uint32_t count = (uint32_t)min(entries.size() - begin, (size_t)NAT_BULK_QUERY_CHUNK);
+
+        for (uint32_t i = 0; i < count; i++)
+        {
+            attr_lists[i] = &attrs[(begin + i) * attr_count];
+        }
+
+        // SAI has no bulk get of NAT entries, the fallback gets them one by one
+        SaiNatBulkFallback::get_nat_entries_attribute(count, &entries[begin], attr_counts.data(), attr_lists.data(),
+                                                      SAI_BULK_OP_ERROR_MODE_IGNORE_ERROR, &statuses[begin]);
+    }
+}
+
+void NatOrch::startQuerySweep(NatQuerySweep &sweep, uint32_t slices)
+{
+    if (sweep.inProgress)
+    {
+        /* The previous sweep isn't over yet, it goes on */
+        return;
+    }
+
+    sweep.natKeys.clear();
+    sweep.naptKeys.clear();
+    sweep.twiceNatKeys.clear();
+    sweep.twiceNaptKeys.clear();
+
+    for (const auto &natEntry : m_natEntries)
+    {
+        sweep.natKeys.push_back(natEntry.first);
+    }
+    for (const auto &naptEntry : m_naptEntries)
+    {
+        sweep.naptKeys.push_back(naptEntry.first);
+    }
+    for (const auto &twiceNatEntry : m_twiceNatEntries)
+    {
+        sweep.twiceNatKeys.push_back(twiceNatEntry.first);
+    }
+    for (const auto &twiceNaptEntry : m_twiceNaptEntries)
+    {
+        sweep.twiceNaptKeys.push_back(twiceNaptEntry.first);
+    }
+
+    size_t total = sweep.natKeys.size() + sweep.naptKeys.size() + sweep.twiceNatKeys.size() + sweep.twiceNaptKeys.size();
+
+    sweep.natPos = sweep.naptPos = sweep.twiceNatPos = sweep.twiceNaptPos = 0;
+    sweep.sliceSize  = max((size_t)1, (total + slices - 1) / slices);
+    sweep.ticks      = 0;
+    sweep.usecs      = 0;
+    sweep.queried    = 0;
+    sweep.failed     = 0;
+    sweep.inProgress = true;
+}
+
+void NatOrch::endQuerySweep(NatQuerySweep &sweep, const char *name)
+{
+    if ((sweep.natPos < sweep.natKeys.size()) or (sweep.naptPos < sweep.naptKeys.size()) or
+        (sweep.twiceNatPos < sweep.twiceNatKeys.size()) or (sweep.twiceNaptPos < sweep.twiceNaptKeys.size()))
+    {
+        return;
+    }
+
+    sweep.inProgress  = false;
+    sweep.sweeps++;
+    sweep.lastUsecs   = sweep.usecs;
+    sweep.maxUsecs    = max(sweep.maxUsecs, sweep.usecs);
+    sweep.lastQueried = sweep.queried;
+    sweep.lastFailed  = sweep.failed;
+
+    if (sweep.queried)
+    {
+        SWSS_LOG_INFO("Time spent in querying %s for %" PRIu64 " NAT/NAPT entries = %" PRIu64 " msecs over %u ticks, "
+                      "%" PRIu64 " failed, max %" PRIu64 " msecs",
+                      name, sweep.queried, sweep.usecs / 1000, sweep.ticks, sweep.failed, sweep.maxUsecs / 1000);
+    }
+}
+
 void NatOrch::queryCounters(void)
 {
     SWSS_LOG_ENTER();
 
-    uint32_t         queried_entries = 0;
-    struct timespec  time_now, time_end, time_spent;
+    NatQuerySweep   &sweep = m_counterSweep;
+    struct timespec  time_now, time_end;
+
+    if (!sweep.inProgress)
+    {
+        return;
+    }
 
     if (clock_gettime (CLOCK_MONOTONIC, &time_now) < 0)
     {
         return;
     }
 
-    NatEntry::iterator natIter = m_natEntries.begin();
-    while (natIter != m_natEntries.end())
+    vector<NatEntry::iterator>       natIters;
+    vector<NaptEntry::iterator>      naptIters;
+    vector<TwiceNatEntry::iterator>  twiceNatIters;
+    vector<TwiceNaptEntry::iterator> twiceNaptIters;
+    vector<sai_nat_entry_t>          entries;
+    vector<sai_attribute_t>          attrs;
+    vector<sai_status_t>             statuses;
+    size_t                           budget = sweep.sliceSize;
+
+    /* Entries not yet added to the hardware are skipped */
+    auto slice = takeSlice(sweep.natKeys, sweep.natPos, budget);
+    for (size_t i = slice.first; i < slice.second; i++)
     {
-        getNatCounters(natIter);
+        auto natIter = m_natEntries.find(sweep.natKeys[i]);
+        if ((natIter == m_natEntries.end()) or (natIter->second.addedToHw == false))
+        {
+            continue;
+        }
 
-        queried_entries++;
-        natIter++;
+        entries.push_back(getSaiNatEntry((natIter->second.nat_type == "dnat") ? SAI_NAT_TYPE_DESTINATION_NAT : SAI_NAT_TYPE_SOURCE_NAT,
+                                         natIter->first));
+        addCounterAttrs(attrs);
+        natIters.push_back(natIter);
     }
 
-    NaptEntry::iterator naptIter = m_naptEntries.begin();
-    while (naptIter != m_naptEntries.end())
+    slice = takeSlice(sweep.naptKeys, sweep.naptPos, budget);
+    for (size_t i = slice.first; i < slice.second; i++)
     {
-        getNaptCounters(naptIter);
+        auto naptIter = m_naptEntries.find(sweep.naptKeys[i]);
+        if ((naptIter == m_naptEntries.end()) or (naptIter->second.addedToHw == false))
+        {
+            continue;
+        }
 
-        queried_entries++;
-        naptIter++;
+        const NaptEntryKey &naptKey = naptIter->first;
+        entries.push_back(getSaiNatEntry((naptIter->second.nat_type == "dnat") ? SAI_NAT_TYPE_DESTINATION_NAT : SAI_NAT_TYPE_SOURCE_NAT,
+                                         naptKey.ip_address, getNatProto(naptKey.prototype), naptKey.l4_port));
+        addCounterAttrs(attrs);
+        naptIters.push_back(naptIter);
+    }
+
+    slice = takeSlice(sweep.twiceNatKeys, sweep.twiceNatPos, budget);
+    for (size_t i = slice.first; i < slice.second; i++)
+    {
+        auto twiceNatIter = m_twiceNatEntries.find(sweep.twiceNatKeys[i]);
+        if ((twiceNatIter == m_twiceNatEntries.end()) or (twiceNatIter->second.addedToHw == false))
+        {
+            continue;
+        }
+
+        entries.push_back(getSaiDoubleNatEntry(twiceNatIter->first.src_ip, twiceNatIter->first.dst_ip));
+        addCounterAttrs(attrs);
+        twiceNatIters.push_back(twiceNatIter);
+    }
+
+    slice = takeSlice(sweep.twiceNaptKeys, sweep.twiceNaptPos, budget);
+    for (size_t i = slice.first; i < slice.second; i++)
+    {
+        auto twiceNaptIter = m_twiceNaptEntries.find(sweep.twiceNaptKeys[i]);
+        if ((twiceNaptIter == m_twiceNaptEntries.end()) or (twiceNaptIter->second.addedToHw == false))
+        {
+            continue;
+        }
+
+        const TwiceNaptEntryKey &key = twiceNaptIter->first;
+        entries.push_back(getSaiDoubleNatEntry(key.src_ip, key.dst_ip, getNatProto(key.prototype), key.src_l4_port, key.dst_l4_port));
+        addCounterAttrs(attrs);
+        twiceNaptIters.push_back(twiceNaptIter);
+    }
+
+    getNatEntriesAttribute(entries, attrs, statuses);
+
+    /* Update the Counter values in the database, 0 for the entries whose query failed */
+    size_t idx = 0;
+    auto getCounters = [&](uint64_t &bytes, uint64_t &pkts) {
+        bool ok = (statuses[idx] == SAI_STATUS_SUCCESS);
+        bytes = ok ? attrs[2 * idx].value.u64 : 0;
+        pkts  = ok ? attrs[2 * idx + 1].value.u64 : 0;
+        if (!ok)
+        {
+            sweep.failed++;
+        }
+        idx++;
+        return ok;
+    };
+    uint64_t nat_translations_pkts, nat_translations_bytes;
+
+    for (const auto &natIter : natIters)
+    {
+        if (!getCounters(nat_translations_bytes, nat_translations_pkts))
+        {
+            SWSS_LOG_ERROR("Failed to get Counters for %s entry [ip %s]", (natIter->second.nat_type == "dnat") ? "DNAT" : "SNAT",
+                           natIter->first.to_string().c_str());
+        }
+        updateNatCounters(natIter->first, nat_translations_pkts, nat_translations_bytes);
     }
-    TwiceNatEntry::iterator tnatIter = m_twiceNatEntries.begin();
-    while (tnatIter != m_twiceNatEntries.end())
+
+    for (const auto &naptIter : naptIters)
     {
-        getTwiceNatCounters(tnatIter);
+        const NaptEntryKey &naptKey = naptIter->first;
 
-        queried_entries++;
-        tnatIter++;
+        if (!getCounters(nat_translations_bytes, nat_translations_pkts))
+        {
+            SWSS_LOG_ERROR("Failed to get Counters for %s entry for [proto %s, ip %s, port %d]",
+                           (naptIter->second.nat_type == "dnat") ? "DNAPT" : "SNAPT",
+                           naptKey.prototype.c_str(), naptKey.ip_address.to_string().c_str(), naptKey.l4_port);
+        }
+        updateNaptCounters(naptKey.prototype, naptKey.ip_address, naptKey.l4_port,
+                           nat_translations_pkts, nat_translations_bytes);
     }
 
-    TwiceNaptEntry::iterator tnaptIter = m_twiceNaptEntries.begin();
-    while (tnaptIter != m_twiceNaptEntries.end())
+    for (const auto &twiceNatIter : twiceNatIters)
     {
-        getTwiceNaptCounters(tnaptIter);
+        const TwiceNatEntryKey &key = twiceNatIter->first;
 
-        queried_entries++;
-        tnaptIter++;
+        if (!getCounters(nat_translations_bytes, nat_translations_pkts))
+        {
+            SWSS_LOG_ERROR("Failed to get Counters for Twice NAT entry [src-ip %s, dst-ip %s]",
+                           key.src_ip.to_string().c_str(), key.dst_ip.to_string().c_str());
+        }
+        updateTwiceNatCounters(key, nat_translations_pkts, nat_translations_bytes);
     }
 
-    if (clock_gettime (CLOCK_MONOTONIC, &time_end) < 0)
+    for (const auto &twiceNaptIter : twiceNaptIters)
     {
-        return;
+        const TwiceNaptEntryKey &key = twiceNaptIter->first;
+
+        if (!getCounters(nat_translations_bytes, nat_translations_pkts))
+        {
+            SWSS_LOG_DEBUG("Failed to get Counters for Twice NAPT entry for [proto %s, src ip %s, src port %d, dst ip %s, dst port %d]",
+                           key.prototype.c_str(), key.src_ip.to_string().c_str(), key.src_l4_port, key.dst_ip.to_string().c_str(),
+                           key.dst_l4_port);
+        }
+        updateTwiceNaptCounters(key, nat_translations_pkts, nat_translations_bytes);
     }
-    time_spent = getTimeDiff(time_now, time_end);
 
-    if (queried_entries)
+    if (clock_gettime (CLOCK_MONOTONIC, &time_end) == 0)
     {
-        SWSS_LOG_DEBUG("Time spent in querying counters for %u NAT/NAPT entries = %lu secs, %lu msecs",
-                       queried_entries, time_spent.tv_sec, (time_spent.tv_nsec / 1000000UL));
+        sweep.usecs += getTimeUsecs(getTimeDiff(time_now, time_end));
     }
+    sweep.ticks++;
+    sweep.queried += entries.size();
+
+    endQuerySweep(sweep, "counters");
 }
 
 void NatOrch::addAllNatEntries(void)
@@ -3342,329 +3677,316 @@ void NatOrch::queryHitBits(void)
 {
     SWSS_LOG_ENTER();
 
-    uint32_t         queried_entries = 0;
-    struct timespec  time_now, time_end, time_spent;
+    NatQuerySweep   &sweep = m_hitBitSweep;
+    struct timespec  time_now, time_end;
 
-    if (clock_gettime (CLOCK_MONOTONIC, &time_now) < 0)
+    if (!sweep.inProgress)
     {
         return;
     }
 
-    /* Remove the NAT entries that are aged out.
-     * Query the NAT entries for their activity in the hardware
-     * and update the active timeout. */
-    NatEntry::iterator natIter = m_natEntries.begin();
-    while (natIter != m_natEntries.end())
+    if (clock_gettime (CLOCK_MONOTONIC, &time_now) < 0)
     {
-        if (checkIfNatEntryIsActive(natIter, time_now.tv_sec))
+        return;
+    }
+
+    time_t                           now = time_now.tv_sec;
+    vector<NatEntry::iterator>       natIters;
+    vector<NaptEntry::iterator>      naptIters;
+    vector<TwiceNatEntry::iterator>  twiceNatIters;
+    vector<TwiceNaptEntry::iterator> twiceNaptIters;
+    vector<sai_nat_entry_t>          entries, reverseEntries;
+    vector<sai_attribute_t>          attrs, reverseAttrs;
+    vector<sai_status_t>             statuses, reverseStatuses;
+    vector<size_t>                   reverseIdx;  // Index of the entry for which a reverse entry is queried
+    vector<sai_nat_entry_t>          reverse;     // DNAT/DNAPT entry, in the reverse direction of each entry
+    vector<bool>                     hasReverse;
+    size_t                           budget = sweep.sliceSize;
+
+    /* Only the dynamic SNAT/SNAPT and Twice NAT/NAPT entries added to the hardware
+     * are queried, their hit bits in the reverse direction being queried as well. Static
+     * entries are always treated active, the other ones are skipped. */
+    auto slice = takeSlice(sweep.natKeys, sweep.natPos, budget);
+    for (size_t i = slice.first; i < slice.second; i++)
+    {
+        auto natIter = m_natEntries.find(sweep.natKeys[i]);
+        if ((natIter == m_natEntries.end()) or (natIter->second.nat_type == "dnat") or
+            (natIter->second.addedToHw == false))
         {
-            /* Since the entry is active in the hardware, reset the active time */
-            natIter->second.activeTime = time_now.tv_sec;
+            continue;
         }
-        else
+
+        NatEntryValue &entry = natIter->second;
+        if (entry.entry_type == "static")
         {
-            if ((natIter->second.nat_type == "snat") and (natIter->second.addedToHw == true) and
-                (natIter->second.entry_type != "static"))
-            {
-                if (time_now.tv_sec - natIter->second.activeTime >= timeout)
-                {
-                    std::vector<FieldValueTuple> fvVector;
-                    std::string key = natIter->first.to_string();
-                    setTimeoutNotifier->send("AGEOUT-SINGLE-NAT", key, fvVector);
-                }
-            } 
+            entry.activeTime = now;
+            continue;
         }
-        queried_entries++;
-        natIter++;
+
+        entries.push_back(getSaiNatEntry(SAI_NAT_TYPE_SOURCE_NAT, natIter->first));
+        addHitBitAttrs(attrs);
+        natIters.push_back(natIter);
+
+        auto dnatIter = m_natEntries.find(entry.translated_ip);
+        hasReverse.push_back((dnatIter != m_natEntries.end()) and (dnatIter->second.addedToHw == true));
+        reverse.push_back(getSaiNatEntry(SAI_NAT_TYPE_DESTINATION_NAT, entry.translated_ip));
     }
 
-    /* Remove the NAPT entries that are aged out.
-     * Query the NAPT entries for their activity in the hardware
-     * and update the active timeout. */
-    NaptEntry::iterator naptIter = m_naptEntries.begin();
-    while (naptIter != m_naptEntries.end())
+    slice = takeSlice(sweep.naptKeys, sweep.naptPos, budget);
+    for (size_t i = slice.first; i < slice.second; i++)
     {
-        if (checkIfNaptEntryIsActive(naptIter, time_now.tv_sec))
+        auto naptIter = m_naptEntries.find(sweep.naptKeys[i]);
+        if ((naptIter == m_naptEntries.end()) or (naptIter->second.nat_type == "dnat") or
+            (naptIter->second.addedToHw == false))
         {
-            /* Since the entry is active in the hardware, reset the active time */
-            naptIter->second.activeTime = time_now.tv_sec;
+            continue;
         }
-        else
+
+        const NaptEntryKey &naptKey = naptIter->first;
+        NaptEntryValue     &entry   = naptIter->second;
+        if (entry.entry_type == "static")
         {
-            if ((naptIter->second.nat_type == "snat") and (naptIter->second.addedToHw == true) and
-                (naptIter->second.entry_type != "static"))
-            {
-                int timeout = naptIter->first.prototype == string("TCP") ? tcp_timeout : udp_timeout;
-                if (time_now.tv_sec - naptIter->second.activeTime >= timeout)
-                {
-                    std::vector<FieldValueTuple> fvVector;
-                    std::string key = (naptIter->first.prototype + ":" + naptIter->first.ip_address.to_string() + ":" + to_string(naptIter->first.l4_port));
-                    setTimeoutNotifier->send("AGEOUT-SINGLE-NAPT", key, fvVector);
-                }
-            }
+            entry.activeTime = now;
+            continue;
         }
-        queried_entries++;
-        naptIter++;
+
+        uint8_t protoType = getNatProto(naptKey.prototype);
+        entries.push_back(getSaiNatEntry(SAI_NAT_TYPE_SOURCE_NAT, naptKey.ip_address, protoType, naptKey.l4_port));
+        addHitBitAttrs(attrs);
+        naptIters.push_back(naptIter);
+
+        NaptEntryKey dnaptKey;
+        dnaptKey.ip_address = entry.translated_ip;
+        dnaptKey.l4_port    = entry.translated_l4_port;
+        dnaptKey.prototype  = naptKey.prototype;
+
+        auto dnaptIter = m_naptEntries.find(dnaptKey);
+        hasReverse.push_back((dnaptIter != m_naptEntries.end()) and (dnaptIter->second.addedToHw == true));
+        reverse.push_back(getSaiNatEntry(SAI_NAT_TYPE_DESTINATION_NAT, entry.translated_ip, protoType, entry.translated_l4_port));
     }
 
-    /* Remove the Twice NAT entries that are aged out.
-     * Query the Twice NAT entries for their activity in the hardware
-     * and update the active timeout. */
-    TwiceNatEntry::iterator twiceNatIter = m_twiceNatEntries.begin();
-    while (twiceNatIter != m_twiceNatEntries.end())
+    slice = takeSlice(sweep.twiceNatKeys, sweep.twiceNatPos, budget);
+    for (size_t i = slice.first; i < slice.second; i++)
     {
-        if (checkIfTwiceNatEntryIsActive(twiceNatIter, time_now.tv_sec))
+        auto twiceNatIter = m_twiceNatEntries.find(sweep.twiceNatKeys[i]);
+        if (twiceNatIter == m_twiceNatEntries.end())
         {
-            /* Since the entry is active in the hardware, reset the active time */
-            twiceNatIter->second.activeTime = time_now.tv_sec;
+            continue;
         }
-        else
+
+        TwiceNatEntryValue &entry = twiceNatIter->second;
+        if (entry.entry_type == "static")
         {
-            if ((twiceNatIter->second.addedToHw == true) and
-                (twiceNatIter->second.entry_type != "static"))
-            {
-                if (time_now.tv_sec - twiceNatIter->second.activeTime >= timeout)
-                {
-                    std::vector<FieldValueTuple> fvVector;
-                    std::string key = (twiceNatIter->first.src_ip.to_string() + ":" + twiceNatIter->first.dst_ip.to_string());
-                    setTimeoutNotifier->send("AGEOUT-TWICE-NAT", key, fvVector);
-                }
-            }
+            entry.activeTime = now;
+            continue;
         }
-        queried_entries++;
-        twiceNatIter++;
+        if (entry.addedToHw == false)
+        {
+            continue;
+        }
+
+        entries.push_back(getSaiDoubleNatEntry(twiceNatIter->first.src_ip, twiceNatIter->first.dst_ip));
+        addHitBitAttrs(attrs);
+        twiceNatIters.push_back(twiceNatIter);
+        hasReverse.push_back(false);
+        reverse.push_back(sai_nat_entry_t());
     }
 
-    /* Remove the Twice NAPT entries that are aged out.
-     * Query the Twice NAPT entries for their activity in the hardware
-     * and update the active timeout. */
-    TwiceNaptEntry::iterator twiceNaptIter = m_twiceNaptEntries.begin();
-    while (twiceNaptIter != m_twiceNaptEntries.end())
+    slice = takeSlice(sweep.twiceNaptKeys, sweep.twiceNaptPos, budget);
+    for (size_t i = slice.first; i < slice.second; i++)
     {
-        if (checkIfTwiceNaptEntryIsActive(twiceNaptIter, time_now.tv_sec))
+        auto twiceNaptIter = m_twiceNaptEntries.find(sweep.twiceNaptKeys[i]);
+        if ((twiceNaptIter == m_twiceNaptEntries.end()) or (twiceNaptIter->second.addedToHw == false))
         {
-            /* Since the entry is active in the hardware, reset the active time */
-            twiceNaptIter->second.activeTime = time_now.tv_sec;
+            continue;
         }
-        else
+
+        const TwiceNaptEntryKey &key   = twiceNaptIter->first;
+        TwiceNaptEntryValue     &entry = twiceNaptIter->second;
+        if (entry.entry_type == "static")
         {
-            if ((twiceNaptIter->second.addedToHw == true) and
-                (twiceNaptIter->second.entry_type != "static"))
-            {
-                int timeout = twiceNaptIter->first.prototype == string("TCP") ? tcp_timeout : udp_timeout;
-                if (time_now.tv_sec - twiceNaptIter->second.activeTime >= timeout)
-                {
-                    std::vector<FieldValueTuple> fvVector;
-                    std::string key = (twiceNaptIter->first.prototype + ":" + twiceNaptIter->first.src_ip.to_string() + ":" + to_string(twiceNaptIter->first.src_l4_port) + 
-                                       ":" + twiceNaptIter->first.dst_ip.to_string() + ":" + to_string(twiceNaptIter->first.dst_l4_port));
-                    setTimeoutNotifier->send("AGEOUT-TWICE-NAPT", key, fvVector);
-                }
-            }
+            entry.activeTime = now;
+            continue;
         }
-        queried_entries++;
-        twiceNaptIter++;
-    }
-    if (clock_gettime (CLOCK_MONOTONIC, &time_end) < 0)
-    {
-        return;
+
+        entries.push_back(getSaiDoubleNatEntry(key.src_ip, key.dst_ip, getNatProto(key.prototype), key.src_l4_port, key.dst_l4_port));
+        addHitBitAttrs(attrs);
+        twiceNaptIters.push_back(twiceNaptIter);
+        hasReverse.push_back(false);
+        reverse.push_back(sai_nat_entry_t());
     }
-    time_spent = getTimeDiff(time_now, time_end);
 
-    if (queried_entries)
+    getNatEntriesAttribute(entries, attrs, statuses);
+
+    /* If the HitBit is not set, check for the HitBit in the reverse direction */
+    vector<bool> active(entries.size(), false);
+    for (size_t i = 0; i < entries.size(); i++)
     {
-        SWSS_LOG_DEBUG("Time spent in querying hardware hit-bits for %u NAT/NAPT entries = %lu secs, %lu msecs",
-                       queried_entries, time_spent.tv_sec, (time_spent.tv_nsec / 1000000UL));
+        if (statuses[i] != SAI_STATUS_SUCCESS)
+        {
+            sweep.failed++;
+            continue;
+        }
+
+        active[i] = attrs[2 * i].value.booldata;
+        if (!active[i] and hasReverse[i])
+        {
+            reverseEntries.push_back(reverse[i]);
+            addHitBitAttrs(reverseAttrs);
+            reverseIdx.push_back(i);
+        }
     }
-}
 
-void NatOrch::updateAllConntrackEntries(void)
-{
-    SWSS_LOG_ENTER();
+    getNatEntriesAttribute(reverseEntries, reverseAttrs, reverseStatuses);
 
-    /* Send notifications for the Single NAT entries to set timeout */
-    NatEntry::iterator natIter = m_natEntries.begin();
-    while (natIter != m_natEntries.end())
+    for (size_t i = 0; i < reverseEntries.size(); i++)
     {
+        if (reverseStatuses[i] == SAI_STATUS_SUCCESS)
+        {
+            active[reverseIdx[i]] = reverseAttrs[2 * i].value.booldata;
+        }
+    }
 
-        if ((natIter->second.nat_type == "snat") and (natIter->second.addedToHw == true) and
-            (natIter->second.entry_type != "static"))
+    /* Update the active time of the entries active in the hardware,
+     * and notify the entries that are aged out. */
+    size_t idx = 0;
+    for (const auto &natIter : natIters)
+    {
+        if (active[idx++])
+        {
+            natIter->second.activeTime = now;
+            natIter->second.ageOutTime = now + timeout;
+        }
+        else if (now - natIter->second.activeTime >= timeout)
         {
-            SWSS_LOG_ERROR("Update %s NAT entry [ip %s]", natIter->second.nat_type.c_str(), natIter->first.to_string().c_str());
             std::vector<FieldValueTuple> fvVector;
             std::string key = natIter->first.to_string();
-            setTimeoutNotifier->send("SET-SINGLE-NAT", key, fvVector);
+            setTimeoutNotifier->send("AGEOUT-SINGLE-NAT", key, fvVector);
         }
-        natIter++;
     }
 
-    /* Send notifications for the Single NAPT entries to set timeout */
-    NaptEntry::iterator naptIter = m_naptEntries.begin();
-    while (naptIter != m_naptEntries.end())
+    for (const auto &naptIter : naptIters)
     {
-        if ((naptIter->second.nat_type == "snat") and (naptIter->second.addedToHw == true) and
-            (naptIter->second.entry_type != "static"))
+        int timeout = naptIter->first.prototype == string("TCP") ? tcp_timeout : udp_timeout;
+
+        if (active[idx++])
+        {
+            naptIter->second.activeTime = now;
+            naptIter->second.ageOutTime = now + timeout;
+        }
+        else if (now - naptIter->second.activeTime >= timeout)
         {
             std::vector<FieldValueTuple> fvVector;
             std::string key = (naptIter->first.prototype + ":" + naptIter->first.ip_address.to_string() + ":" + to_string(naptIter->first.l4_port));
-            setTimeoutNotifier->send("SET-SINGLE-NAPT", key, fvVector);
+            setTimeoutNotifier->send("AGEOUT-SINGLE-NAPT", key, fvVector);
         }
-        naptIter++;
     }
 
-    /* Send notifications for the Twice NAT entries to set timeout */
-    TwiceNatEntry::iterator twiceNatIter = m_twiceNatEntries.begin();
-    while (twiceNatIter != m_twiceNatEntries.end())
+    for (const auto &twiceNatIter : twiceNatIters)
     {
-        if ((twiceNatIter->second.addedToHw == true) and
-            (twiceNatIter->second.entry_type != "static"))
+        if (active[idx++])
+        {
+            twiceNatIter->second.activeTime = now;
+            twiceNatIter->second.ageOutTime = now + timeout;
+        }
+        else if (now - twiceNatIter->second.activeTime >= timeout)
         {
             std::vector<FieldValueTuple> fvVector;
             std::string key = (twiceNatIter->first.src_ip.to_string() + ":" + twiceNatIter->first.dst_ip.to_string());
-            setTimeoutNotifier->send("SET-TWICE-NAT", key, fvVector);
+            setTimeoutNotifier->send("AGEOUT-TWICE-NAT", key, fvVector);
         }
-        twiceNatIter++;
     }
-   
-    /* Send notifications for the Twice NAPT entries to set timeout */
-    TwiceNaptEntry::iterator twiceNaptIter = m_twiceNaptEntries.begin();
-    while (twiceNaptIter != m_twiceNaptEntries.end())
+
+    for (const auto &twiceNaptIter : twiceNaptIters)
     {
-        if ((twiceNaptIter->second.addedToHw == true) and
-            (twiceNaptIter->second.entry_type != "static"))
+        int timeout = twiceNaptIter->first.prototype == string("TCP") ? tcp_timeout : udp_timeout;
+
+        if (active[idx++])
+        {
+            twiceNaptIter->second.activeTime = now;
+            twiceNaptIter->second.ageOutTime = now + timeout;
+        }
+        else if (now - twiceNaptIter->second.activeTime >= timeout)
         {
             std::vector<FieldValueTuple> fvVector;
             std::string key = (twiceNaptIter->first.prototype + ":" + twiceNaptIter->first.src_ip.to_string() + ":" + to_string(twiceNaptIter->first.src_l4_port) +
                                ":" + twiceNaptIter->first.dst_ip.to_string() + ":" + to_string(twiceNaptIter->first.dst_l4_port));
-            setTimeoutNotifier->send("SET-TWICE-NAPT", key, fvVector);
+            setTimeoutNotifier->send("AGEOUT-TWICE-NAPT", key, fvVector);
         }
-        twiceNaptIter++;
     }
-}
 
-bool NatOrch::getNatCounters(const NatEntry::iterator &iter)
-{
-    const IpAddress   &ipAddr = iter->first;
-    NatEntryValue     &entry  = iter->second;
-    uint32_t          attr_count;
-    sai_attribute_t   nat_entry_attr[4];
-    sai_nat_entry_t   nat_entry;
-    sai_status_t      status;
-    uint64_t          nat_translations_pkts = 0, nat_translations_bytes = 0;
-
-    if (entry.addedToHw == false)
+    if (clock_gettime (CLOCK_MONOTONIC, &time_end) == 0)
     {
-        SWSS_LOG_DEBUG("Skip get Counters for %s NAT entry [ip %s], as not yet added to HW", entry.nat_type.c_str(), ipAddr.to_string().c_str());
-        return 0;
+        sweep.usecs += getTimeUsecs(getTimeDiff(time_now, time_end));
     }
+    sweep.ticks++;
+    sweep.queried += entries.size() + reverseEntries.size();
 
-    memset(nat_entry_attr, 0, sizeof(nat_entry_attr));
-    nat_entry_attr[0].id   = SAI_NAT_ENTRY_ATTR_BYTE_COUNT;
-    nat_entry_attr[1].id   = SAI_NAT_ENTRY_ATTR_PACKET_COUNT;
-
-    attr_count = 2;
-
-    memset(&nat_entry, 0, sizeof(nat_entry));
+    endQuerySweep(sweep, "hardware hit-bits");
+}
 
-    nat_entry.vr_id       = gVirtualRouterId;
-    nat_entry.switch_id   = gSwitchId;
+void NatOrch::updateAllConntrackEntries(void)
+{
+    SWSS_LOG_ENTER();
 
-    if (entry.nat_type == "dnat")
-    {
-        nat_entry.nat_type = SAI_NAT_TYPE_DESTINATION_NAT;
-        nat_entry.data.key.dst_ip = ipAddr.getV4Addr();   
-        nat_entry.data.mask.dst_ip = 0xffffffff;
-    }
-    else
+    /* Send notifications for the Single NAT entries to set timeout */
+    NatEntry::iterator natIter = m_natEntries.begin();
+    while (natIter != m_natEntries.end())
     {
-        nat_entry.nat_type = SAI_NAT_TYPE_SOURCE_NAT;
-        nat_entry.data.key.src_ip = ipAddr.getV4Addr();
-        nat_entry.data.mask.src_ip = 0xffffffff;
-    }
 
-    status = sai_nat_api->get_nat_entry_attribute(&nat_entry, attr_count, nat_entry_attr);
-    if (entry.nat_type == "snat")
-    {
-        if (status != SAI_STATUS_SUCCESS)
-        {
-            SWSS_LOG_ERROR("Failed to get Counters for SNAT entry [src-ip %s], bytes = %" PRIu64 ", pkts = %" PRIu64 "", ipAddr.to_string().c_str(),
-                           nat_entry_attr[0].value.u64, nat_entry_attr[1].value.u64);
-        }
-        else
+        if ((natIter->second.nat_type == "snat") and (natIter->second.addedToHw == true) and
+            (natIter->second.entry_type != "static"))
         {
-            nat_translations_bytes = nat_entry_attr[0].value.u64;
-            nat_translations_pkts  = nat_entry_attr[1].value.u64;
+            SWSS_LOG_ERROR("Update %s NAT entry [ip %s]", natIter->second.nat_type.c_str(), natIter->first.to_string().c_str());
+            std::vector<FieldValueTuple> fvVector;
+            std::string key = natIter->first.to_string();
+            setTimeoutNotifier->send("SET-SINGLE-NAT", key, fvVector);
         }
+        natIter++;
     }
-    else if (entry.nat_type == "dnat")
+
+    /* Send notifications for the Single NAPT entries to set timeout */
+    NaptEntry::iterator naptIter = m_naptEntries.begin();
+    while (naptIter != m_naptEntries.end())
     {
-        if (status != SAI_STATUS_SUCCESS)
-        {
-            SWSS_LOG_ERROR("Failed to get Counters for DNAT entry [dst-ip %s], bytes = %" PRIu64 ", pkts = %" PRIu64 "", ipAddr.to_string().c_str(),
-                           nat_entry_attr[0].value.u64, nat_entry_attr[1].value.u64);
-        }
-        else
+        if ((naptIter->second.nat_type == "snat") and (naptIter->second.addedToHw == true) and
+            (naptIter->second.entry_type != "static"))
         {
-            nat_translations_bytes = nat_entry_attr[0].value.u64;
-            nat_translations_pkts  = nat_entry_attr[1].value.u64;
+            std::vector<FieldValueTuple> fvVector;
+            std::string key = (naptIter->first.prototype + ":" + naptIter->first.ip_address.to_string() + ":" + to_string(naptIter->first.l4_port));
+            setTimeoutNotifier->send("SET-SINGLE-NAPT", key, fvVector);
         }
+        naptIter++;
     }
 
-    /* Update the Counter values in the database */
-    updateNatCounters(ipAddr, nat_translations_pkts, nat_translations_bytes);
-
-    return 0;
-}
-
-bool NatOrch::getTwiceNatCounters(const TwiceNatEntry::iterator &iter)
-{
-    const TwiceNatEntryKey   &key = iter->first;
-    TwiceNatEntryValue       &entry  = iter->second;
-    uint32_t          attr_count;
-    sai_attribute_t   nat_entry_attr[4];
-    sai_nat_entry_t   dbl_nat_entry;
-    sai_status_t      status;
-    uint64_t          nat_translations_pkts = 0, nat_translations_bytes = 0;
-
-    if (entry.addedToHw == false)
-    {
-        SWSS_LOG_DEBUG("Skip get Counters for Twice NAT entry [src ip %s, dst ip %s], as not yet added to HW",
-                        key.src_ip.to_string().c_str(), key.dst_ip.to_string().c_str());
-        return 0;
-    }
-
-    memset(nat_entry_attr, 0, sizeof(nat_entry_attr));
-    nat_entry_attr[0].id   = SAI_NAT_ENTRY_ATTR_BYTE_COUNT;
-    nat_entry_attr[1].id   = SAI_NAT_ENTRY_ATTR_PACKET_COUNT;
-
-    attr_count = 2;
-
-    memset(&dbl_nat_entry, 0, sizeof(dbl_nat_entry));
-
-    dbl_nat_entry.vr_id = gVirtualRouterId;
-    dbl_nat_entry.switch_id = gSwitchId;
-    dbl_nat_entry.nat_type = SAI_NAT_TYPE_DOUBLE_NAT;
-    dbl_nat_entry.data.key.src_ip = key.src_ip.getV4Addr();
-    dbl_nat_entry.data.mask.src_ip = 0xffffffff;
-    dbl_nat_entry.data.key.dst_ip = key.dst_ip.getV4Addr();
-    dbl_nat_entry.data.mask.dst_ip = 0xffffffff;
-
-    status = sai_nat_api->get_nat_entry_attribute(&dbl_nat_entry, attr_count, nat_entry_attr);
-    if (status != SAI_STATUS_SUCCESS)
+    /* Send notifications for the Twice NAT entries to set timeout */
+    TwiceNatEntry::iterator twiceNatIter = m_twiceNatEntries.begin();
+    while (twiceNatIter != m_twiceNatEntries.end())
     {
-        SWSS_LOG_ERROR("Failed to get Counters for Twice NAT entry [src-ip %s, dst-ip %s], bytes = %" PRIu64 ", pkts = %" PRIu64 "",
-                        key.src_ip.to_string().c_str(), key.dst_ip.to_string().c_str(),
-                        nat_entry_attr[0].value.u64, nat_entry_attr[1].value.u64);
+        if ((twiceNatIter->second.addedToHw == true) and
+            (twiceNatIter->second.entry_type != "static"))
+        {
+            std::vector<FieldValueTuple> fvVector;
+            std::string key = (twiceNatIter->first.src_ip.to_string() + ":" + twiceNatIter->first.dst_ip.to_string());
+            setTimeoutNotifier->send("SET-TWICE-NAT", key, fvVector);
+        }
+        twiceNatIter++;
     }
-    else
+   
+    /* Send notifications for the Twice NAPT entries to set timeout */
+    TwiceNaptEntry::iterator twiceNaptIter = m_twiceNaptEntries.begin();
+    while (twiceNaptIter != m_twiceNaptEntries.end())
     {
-        nat_translations_bytes = nat_entry_attr[0].value.u64;
-        nat_translations_pkts  = nat_entry_attr[1].value.u64;
+        if ((twiceNaptIter->second.addedToHw == true) and
+            (twiceNaptIter->second.entry_type != "static"))
+        {
+            std::vector<FieldValueTuple> fvVector;
+            std::string key = (twiceNaptIter->first.prototype + ":" + twiceNaptIter->first.src_ip.to_string() + ":" + to_string(twiceNaptIter->first.src_l4_port) +
+                               ":" + twiceNaptIter->first.dst_ip.to_string() + ":" + to_string(twiceNaptIter->first.dst_l4_port));
+            setTimeoutNotifier->send("SET-TWICE-NAPT", key, fvVector);
+        }
+        twiceNaptIter++;
     }
-
-    /* Update the Counter values in the database */
-    updateTwiceNatCounters(key, nat_translations_pkts, nat_translations_bytes);
-
-    return 0;
 }
 
 bool NatOrch::setNatCounters(const NatEntry::iterator &iter)
@@ -3749,152 +4071,6 @@ bool NatOrch::setNatCounters(const NatEntry::iterator &iter)
     return 0;
 }
 
-bool NatOrch::getNaptCounters(const NaptEntry::iterator &iter)
-{
-    const NaptEntryKey &naptKey    = iter->first;
-    NaptEntryValue     &entry      = iter->second;
-    uint8_t            protoType   = ((naptKey.prototype == "TCP") ? IPPROTO_TCP : IPPROTO_UDP);
-    uint32_t           attr_count;
-    sai_attribute_t    nat_entry_attr[4];
-    sai_nat_entry_t    nat_entry;
-    sai_status_t       status;
-    uint64_t           nat_translations_pkts = 0, nat_translations_bytes = 0;
-
-    if (entry.addedToHw == false)
-    {
-        SWSS_LOG_DEBUG("Skip get Counters for %s NAPT entry for [proto %s, ip %s, port %d], as not yet added to HW",
-                       entry.nat_type.c_str(), naptKey.prototype.c_str(), naptKey.ip_address.to_string().c_str(), naptKey.l4_port);
-        return 0;
-    }
-
-    memset(nat_entry_attr, 0, sizeof(nat_entry_attr));
-    nat_entry_attr[0].id   = SAI_NAT_ENTRY_ATTR_BYTE_COUNT;
-    nat_entry_attr[1].id   = SAI_NAT_ENTRY_ATTR_PACKET_COUNT;
-
-    attr_count = 2;
-
-    memset(&nat_entry, 0, sizeof(nat_entry));
-
-    nat_entry.vr_id       = gVirtualRouterId;
-    nat_entry.switch_id   = gSwitchId;
-
-    if (entry.nat_type == "dnat")
-    {
-        nat_entry.nat_type = SAI_NAT_TYPE_DESTINATION_NAT;
-        nat_entry.data.key.dst_ip      = naptKey.ip_address.getV4Addr();
-        nat_entry.data.key.l4_dst_port = (uint16_t)(naptKey.l4_port);
-        nat_entry.data.mask.dst_ip      = 0xffffffff;
-        nat_entry.data.mask.l4_dst_port = 0xffff;
-    }
-    else if (entry.nat_type == "snat")
-    {
-        nat_entry.nat_type = SAI_NAT_TYPE_SOURCE_NAT;
-        nat_entry.data.key.src_ip      = naptKey.ip_address.getV4Addr();
-        nat_entry.data.key.l4_src_port = (uint16_t)(naptKey.l4_port);
-        nat_entry.data.mask.src_ip      = 0xffffffff;
-        nat_entry.data.mask.l4_src_port = 0xffff;
-    }
-
-    nat_entry.data.key.proto        = protoType;
-    nat_entry.data.mask.proto       = 0xff;
-
-    status = sai_nat_api->get_nat_entry_attribute(&nat_entry, attr_count, nat_entry_attr);
-
-    if (entry.nat_type == "snat")
-    { 
-        if (status != SAI_STATUS_SUCCESS)
-        {
-            SWSS_LOG_ERROR("Failed to get Counters for SNAPT entry for [proto %s, src-ip %s, src-port %d], bytes = %" PRIu64 ", pkts = %" PRIu64 "",
-                           naptKey.prototype.c_str(), naptKey.ip_address.to_string().c_str(), naptKey.l4_port,
-                           nat_entry_attr[0].value.u64, nat_entry_attr[1].value.u64);
-        }
-        else
-        {
-            nat_translations_bytes = nat_entry_attr[0].value.u64;
-            nat_translations_pkts  = nat_entry_attr[1].value.u64;
-        }
-    }
-    else if (entry.nat_type == "dnat")
-    {
-        if (status != SAI_STATUS_SUCCESS)
-        {
-            SWSS_LOG_ERROR("Failed to get Counters for DNAPT entry for [proto %s, dst-ip %s, dst-port %d], bytes = %" PRIu64 ", pkts = %" PRIu64 "",
-                           naptKey.prototype.c_str(), naptKey.ip_address.to_string().c_str(), naptKey.l4_port,
-                           nat_entry_attr[0].value.u64, nat_entry_attr[1].value.u64);
-        }
-        else
-        {
-            nat_translations_bytes = nat_entry_attr[0].value.u64;
-            nat_translations_pkts  = nat_entry_attr[1].value.u64;
-        }
-    }
-
-    /* Update the Counter values in the database */
-    updateNaptCounters(naptKey.prototype, naptKey.ip_address, naptKey.l4_port,
-                       nat_translations_pkts, nat_translations_bytes);
-    return 0;
-}
-
-bool NatOrch::getTwiceNaptCounters(const TwiceNaptEntry::iterator &iter)
-{
-    const TwiceNaptEntryKey &key    = iter->first;
-    TwiceNaptEntryValue     &entry      = iter->second;
-    uint8_t            protoType   = ((key.prototype == "TCP") ? IPPROTO_TCP : IPPROTO_UDP);
-    uint32_t           attr_count;
-    sai_attribute_t    nat_entry_attr[4];
-    sai_nat_entry_t    dbl_nat_entry;
-    sai_status_t       status;
-    uint64_t           nat_translations_pkts = 0, nat_translations_bytes = 0;
-
-    if (entry.addedToHw == false)
-    {
-        SWSS_LOG_DEBUG("Skip get Counters for Twice NAPT entry for [proto %s, src ip %s, src port %d, dst ip %s, dst port %d], as not yet added to HW",
-                       key.prototype.c_str(), key.src_ip.to_string().c_str(), key.src_l4_port, key.dst_ip.to_string().c_str(),
-                       key.dst_l4_port);
-        return 0;
-    }
-
-    memset(nat_entry_attr, 0, sizeof(nat_entry_attr));
-    nat_entry_attr[0].id   = SAI_NAT_ENTRY_ATTR_BYTE_COUNT;
-    nat_entry_attr[1].id   = SAI_NAT_ENTRY_ATTR_PACKET_COUNT;
-
-    attr_count = 2;
-
-    memset(&dbl_nat_entry, 0, sizeof(dbl_nat_entry));
-
-    dbl_nat_entry.vr_id = gVirtualRouterId;
-    dbl_nat_entry.switch_id = gSwitchId;
-    dbl_nat_entry.nat_type = SAI_NAT_TYPE_DOUBLE_NAT;
-    dbl_nat_entry.data.key.src_ip = key.src_ip.getV4Addr();
-    dbl_nat_entry.data.mask.src_ip = 0xffffffff;
-    dbl_nat_entry.data.key.l4_src_port = (uint16_t)(key.src_l4_port);
-    dbl_nat_entry.data.mask.l4_src_port = 0xffff;
-    dbl_nat_entry.data.key.dst_ip = key.dst_ip.getV4Addr();
-    dbl_nat_entry.data.mask.dst_ip = 0xffffffff;
-    dbl_nat_entry.data.key.l4_dst_port = (uint16_t)(key.dst_l4_port);
-    dbl_nat_entry.data.mask.l4_dst_port = 0xffff;
-    dbl_nat_entry.data.key.proto = protoType;
-    dbl_nat_entry.data.mask.proto = 0xff;
-
-    status = sai_nat_api->get_nat_entry_attribute(&dbl_nat_entry, attr_count, nat_entry_attr);
-
-    if (status != SAI_STATUS_SUCCESS)
-    {
-        SWSS_LOG_DEBUG("Failed to get Counters for Twice NAPT entry for [proto %s, src ip %s, src port %d, dst ip %s, dst port %d], as not yet added to HW",
-                       key.prototype.c_str(), key.src_ip.to_string().c_str(), key.src_l4_port, key.dst_ip.to_string().c_str(),
-                       key.dst_l4_port);
-    }
-    else
-    {
-        nat_translations_bytes = nat_entry_attr[0].value.u64;
-        nat_translations_pkts  = nat_entry_attr[1].value.u64;
-    }
-
-    /* Update the Counter values in the database */
-    updateTwiceNaptCounters(key, nat_translations_pkts, nat_translations_bytes);
-    return 0;
-}
-
 bool NatOrch::setNaptCounters(const NaptEntry::iterator &iter)
 {
     const NaptEntryKey &naptKey    = iter->first;
@@ -4198,329 +4374,6 @@ void NatOrch::updateTwiceNaptCounters(const TwiceNaptEntryKey &key,
     m_countersTwiceNaptTable.set(naptKey, values);
 }
 
-bool NatOrch::checkIfNatEntryIsActive(const NatEntry::iterator &iter, time_t now)
-{
-    const IpAddress   &ipAddr = iter->first;
-    NatEntryValue     &entry  = iter->second;
-    uint32_t          attr_count;
-    IpAddress         srcIp;
-    sai_attribute_t   nat_entry_attr[4];
-    sai_nat_entry_t   snat_entry, dnat_entry;
-    sai_status_t      status;
-
-    if (entry.nat_type == "dnat")
-    {
-        /* Hitbits are queried for both directions when SNAT entry is checked */
-        return 0;
-    }
-
-    if (entry.addedToHw == false)
-    {
-        SWSS_LOG_DEBUG("Skip get hitbits for %s NAT entry [ip %s], as not yet added to HW", entry.nat_type.c_str(), ipAddr.to_string().c_str());
-        return 0;
-    }
-
-    if (entry.entry_type == "static")
-    {
-        /* Static NAT entries are always treated active */ 
-        return 1;
-    }
-
-    memset(nat_entry_attr, 0, sizeof(nat_entry_attr));
-    nat_entry_attr[0].id             = SAI_NAT_ENTRY_ATTR_HIT_BIT;  /* Get the Hit bit */
-    nat_entry_attr[0].value.booldata = 0;
-    nat_entry_attr[1].id             = SAI_NAT_ENTRY_ATTR_HIT_BIT_COR; /* clear the hit bit after returning the value */
-    nat_entry_attr[1].value.booldata = 1;
-
-    attr_count = 2;
-
-    memset(&snat_entry, 0, sizeof(snat_entry));
-
-    snat_entry.vr_id                 = gVirtualRouterId;
-    snat_entry.switch_id             = gSwitchId;
-    snat_entry.nat_type              = SAI_NAT_TYPE_SOURCE_NAT;
-    srcIp     = ipAddr;
-    snat_entry.data.key.src_ip   = srcIp.getV4Addr();
-    snat_entry.data.mask.src_ip  = 0xffffffff;
-
-    status = sai_nat_api->get_nat_entry_attribute(&snat_entry, attr_count, nat_entry_attr);
-    if (status == SAI_STATUS_SUCCESS)
-    {
-        SWSS_LOG_DEBUG("SNAT HIT BIT for src-ip %s = %d", srcIp.to_string().c_str(),
-                      nat_entry_attr[0].value.booldata);
-
-        if (nat_entry_attr[0].value.booldata)
-        {
-            entry.ageOutTime = now + timeout;
-            return 1;
-        }
-        else
-        {
-            auto dnatIter = m_natEntries.find(entry.translated_ip);
-            if (dnatIter == m_natEntries.end())
-            {
-                return 0;
-            }
-            if ((dnatIter->second).addedToHw == false)
-            {
-                return 0;
-            }
-
-            /* If SNAT HitBit is not set, check for the HitBit in the reverse direction */
-            memset(&dnat_entry, 0, sizeof(dnat_entry));
-
-            dnat_entry.vr_id             = gVirtualRouterId;
-            dnat_entry.switch_id         = gSwitchId;
-            dnat_entry.nat_type          = SAI_NAT_TYPE_DESTINATION_NAT;
-            dnat_entry.data.key.dst_ip   = entry.translated_ip.getV4Addr();
-            dnat_entry.data.mask.dst_ip  = 0xffffffff;
-
-            status = sai_nat_api->get_nat_entry_attribute(&dnat_entry, attr_count, nat_entry_attr);
-            if (status == SAI_STATUS_SUCCESS)
-            {
-                SWSS_LOG_DEBUG("DNAT HIT BIT for dst-ip %s = %d", entry.translated_ip.to_string().c_str(),
-                                nat_entry_attr[0].value.booldata);
-                if (nat_entry_attr[0].value.booldata)
-                {
-                    entry.ageOutTime = now + timeout;
-                    return 1;
-                }
-            }
-        }
-    }
-    return 0;
-}
-
-bool NatOrch::checkIfNaptEntryIsActive(const NaptEntry::iterator &iter, time_t now)
-{
-    const NaptEntryKey &naptKey    = iter->first;
-    NaptEntryValue     &entry      = iter->second;
-    int                protoType   = ((naptKey.prototype == "TCP") ? IPPROTO_TCP : IPPROTO_UDP);
-    uint32_t           attr_count;
-    IpAddress          srcIp;
-    uint16_t           srcPort;
-    sai_attribute_t    nat_entry_attr[4];
-    sai_nat_entry_t    snat_entry, dnat_entry;
-    sai_status_t       status;
-
-    if (entry.nat_type == "dnat")
-    {
-        /* Hitbits are queried for both directions when SNAT entry is checked */
-        return 0;
-    }
-
-    if (entry.addedToHw == false)
-    {
-        SWSS_LOG_DEBUG("Skip get hitbits for %s NAPT entry for [proto %s, ip %s, port %d], as not yet added to HW",
-                       entry.nat_type.c_str(), naptKey.prototype.c_str(), naptKey.ip_address.to_string().c_str(), naptKey.l4_port);
-        return 0;
-    }
-
-    if (entry.entry_type == "static")
-    {
-        /* Static NAPT entries are always treated active */
-        return 1;
-    }
-
-    memset(nat_entry_attr, 0, sizeof(nat_entry_attr));
-    nat_entry_attr[0].id             = SAI_NAT_ENTRY_ATTR_HIT_BIT;  /* Get the Hit bit */
-    nat_entry_attr[0].value.booldata = 0;
-    nat_entry_attr[1].id             = SAI_NAT_ENTRY_ATTR_HIT_BIT_COR; /* clear the hit bit after returning the value */
-    nat_entry_attr[1].value.booldata = 1;
-
-    attr_count = 2;
-
-    memset(&snat_entry, 0, sizeof(snat_entry));
-
-    snat_entry.vr_id                 = gVirtualRouterId;
-    snat_entry.switch_id             = gSwitchId;
-    snat_entry.nat_type              = SAI_NAT_TYPE_SOURCE_NAT;
-
-    srcIp     = naptKey.ip_address;
-    srcPort   = (uint16_t)(naptKey.l4_port);
-    snat_entry.data.key.src_ip       = srcIp.getV4Addr();
-    snat_entry.data.key.l4_src_port  = srcPort;
-
-    snat_entry.data.mask.src_ip      = 0xffffffff;
-    snat_entry.data.mask.l4_src_port = 0xffff;
-    snat_entry.data.key.proto        = (uint8_t)protoType;
-    snat_entry.data.mask.proto       = 0xff;
-
-    status = sai_nat_api->get_nat_entry_attribute(&snat_entry, attr_count, nat_entry_attr);
-    if (status == SAI_STATUS_SUCCESS)
-    {
-        SWSS_LOG_DEBUG("SNAPT HIT BIT for proto %s, src-ip %s, src-port %d = %d", naptKey.prototype.c_str(),
-                      srcIp.to_string().c_str(), srcPort, nat_entry_attr[0].value.booldata);
-        if (nat_entry_attr[0].value.booldata)
-        {
-            entry.ageOutTime = now + ((protoType == IPPROTO_TCP) ? tcp_timeout : udp_timeout);
-            return 1;
-        }
-        else
-        {
-            NaptEntryKey dnaptKey;
-            dnaptKey.ip_address = entry.translated_ip;
-            dnaptKey.l4_port    = entry.translated_l4_port;
-            dnaptKey.prototype  = naptKey.prototype;
-
-            auto dnaptIter = m_naptEntries.find(dnaptKey);
-            if (dnaptIter == m_naptEntries.end())
-            {
-                return 0;
-            }
-            if ((dnaptIter->second).addedToHw == false)
-            {
-                return 0;
-            }
-
-
-            /* If SNAPT HitBit is not set, check for the HitBit in the reverse direction */
-            memset(&dnat_entry, 0, sizeof(dnat_entry));
-
-            dnat_entry.vr_id                 = gVirtualRouterId;
-            dnat_entry.switch_id             = gSwitchId;
-            dnat_entry.nat_type              = SAI_NAT_TYPE_DESTINATION_NAT;
-
-            dnat_entry.data.key.dst_ip       = entry.translated_ip.getV4Addr();
-            dnat_entry.data.key.l4_dst_port  = (uint16_t)(entry.translated_l4_port);
-
-            dnat_entry.data.mask.dst_ip      = 0xffffffff;
-            dnat_entry.data.mask.l4_dst_port = 0xffff;
-            dnat_entry.data.key.proto        = (uint8_t)protoType;
-            dnat_entry.data.mask.proto       = 0xff;
-
-            status = sai_nat_api->get_nat_entry_attribute(&dnat_entry, attr_count, nat_entry_attr);
-            if (status == SAI_STATUS_SUCCESS)
-            {
-                SWSS_LOG_DEBUG("DNAPT HIT BIT for proto %s, dst-ip %s, dst-port %d = %d", naptKey.prototype.c_str(),
-                              entry.translated_ip.to_string().c_str(), entry.translated_l4_port, nat_entry_attr[0].value.booldata);
-                if (nat_entry_attr[0].value.booldata)
-                {
-                    entry.ageOutTime = now + ((protoType == IPPROTO_TCP) ? tcp_timeout : udp_timeout);
-                    return 1;
-                }
-            }
-        }
-    }
-    return 0;
-}
-
-bool NatOrch::checkIfTwiceNatEntryIsActive(const TwiceNatEntry::iterator &iter, time_t now)
-{
-    const TwiceNatEntryKey &key    = iter->first;
-    TwiceNatEntryValue     &entry  = iter->second;
-    uint32_t           attr_count;
-    sai_attribute_t    nat_entry_attr[4];
-    sai_nat_entry_t    dbl_nat_entry;
-    sai_status_t       status;
-
-    if (entry.entry_type == "static")
-    {
-        /* Static NAPT entries are always treated active */
-        return 1;
-    }
-
-    if (entry.addedToHw == false)
-    {
-        SWSS_LOG_DEBUG("Skip get hitbits for Twice NAPT entry for [src ip %s, dst-ip %s], as not yet added to HW",
-                       key.src_ip.to_string().c_str(), key.dst_ip.to_string().c_str());
-        return 0;
-    }
-
-    memset(nat_entry_attr, 0, sizeof(nat_entry_attr));
-    nat_entry_attr[0].id             = SAI_NAT_ENTRY_ATTR_HIT_BIT;  /* Get the Hit bit */
-    nat_entry_attr[0].value.booldata = 0;
-    nat_entry_attr[1].id             = SAI_NAT_ENTRY_ATTR_HIT_BIT_COR; /* clear the hit bit after returning the value */
-    nat_entry_attr[1].value.booldata = 1;
-
-    attr_count = 2;
-
-    memset(&dbl_nat_entry, 0, sizeof(dbl_nat_entry));
-
-    dbl_nat_entry.vr_id = gVirtualRouterId;
-    dbl_nat_entry.switch_id = gSwitchId;
-    dbl_nat_entry.nat_type = SAI_NAT_TYPE_DOUBLE_NAT;
-    dbl_nat_entry.data.key.src_ip = key.src_ip.getV4Addr();
-    dbl_nat_entry.data.mask.src_ip = 0xffffffff;
-    dbl_nat_entry.data.key.dst_ip = key.dst_ip.getV4Addr();
-    dbl_nat_entry.data.mask.dst_ip = 0xffffffff;
-
-    status = sai_nat_api->get_nat_entry_attribute(&dbl_nat_entry, attr_count, nat_entry_attr);
-    if (status == SAI_STATUS_SUCCESS)
-    {
-        SWSS_LOG_DEBUG("Twice NAT HIT BIT for src-ip %s, dst-ip %s = %d",
-                       key.src_ip.to_string().c_str(), key.dst_ip.to_string().c_str(), nat_entry_attr[0].value.booldata);
-        if (nat_entry_attr[0].value.booldata)
-        {
-            entry.ageOutTime = now + timeout;
-            return 1;
-        }
-    }
-    return 0;
-}
-
-bool NatOrch::checkIfTwiceNaptEntryIsActive(const TwiceNaptEntry::iterator &iter, time_t now)
-{
-    const TwiceNaptEntryKey &key   = iter->first;
-    TwiceNaptEntryValue     &entry = iter->second;
-    uint8_t            protoType   = ((key.prototype == "TCP") ? IPPROTO_TCP : IPPROTO_UDP);
-    uint32_t           attr_count;
-    sai_attribute_t    nat_entry_attr[4];
-    sai_nat_entry_t    dbl_nat_entry;
-    sai_status_t       status;
-
-    if (entry.addedToHw == false)
-    {
-        SWSS_LOG_DEBUG("Skip get hitbits for Twice NAPT entry for [proto %s, src ip %s, src port %d, dst ip %s, dst port %d], as not yet added to HW",
-                        key.prototype.c_str(), key.src_ip.to_string().c_str(), key.src_l4_port, key.dst_ip.to_string().c_str(), key.dst_l4_port);
-        return 0;
-    }
-
-    if (entry.entry_type == "static")
-    {
-        /* Static NAPT entries are always treated active */
-        return 1;
-    }
-
-    memset(nat_entry_attr, 0, sizeof(nat_entry_attr));
-    nat_entry_attr[0].id             = SAI_NAT_ENTRY_ATTR_HIT_BIT;  /* Get the Hit bit */
-    nat_entry_attr[0].value.booldata = 0;
-    nat_entry_attr[1].id             = SAI_NAT_ENTRY_ATTR_HIT_BIT_COR; /* clear the hit bit after returning the value */
-    nat_entry_attr[1].value.booldata = 1;
-
-    attr_count = 2;
-
-    memset(&dbl_nat_entry, 0, sizeof(dbl_nat_entry));
-
-    dbl_nat_entry.vr_id = gVirtualRouterId;
-    dbl_nat_entry.switch_id = gSwitchId;
-    dbl_nat_entry.nat_type = SAI_NAT_TYPE_DOUBLE_NAT;
-    dbl_nat_entry.data.key.src_ip = key.src_ip.getV4Addr();
-    dbl_nat_entry.data.mask.src_ip = 0xffffffff;
-    dbl_nat_entry.data.key.l4_src_port = (uint16_t)(key.src_l4_port);
-    dbl_nat_entry.data.mask.l4_src_port = 0xffff;
-    dbl_nat_entry.data.key.dst_ip = key.dst_ip.getV4Addr();
-    dbl_nat_entry.data.mask.dst_ip = 0xffffffff;
-    dbl_nat_entry.data.key.l4_dst_port = (uint16_t)(key.dst_l4_port);
-    dbl_nat_entry.data.mask.l4_dst_port = 0xffff;
-    dbl_nat_entry.data.key.proto = protoType;
-    dbl_nat_entry.data.mask.proto = 0xff;
-
-    status = sai_nat_api->get_nat_entry_attribute(&dbl_nat_entry, attr_count, nat_entry_attr);
-    if (status == SAI_STATUS_SUCCESS)
-    {
-        SWSS_LOG_DEBUG("Twice NAPT HIT BIT for [proto %s, src ip %s, src port %d, dst ip %s, dst port %d] = %d",
-                        key.prototype.c_str(), key.src_ip.to_string().c_str(), key.src_l4_port, key.dst_ip.to_string().c_str(), key.dst_l4_port,
-                        nat_entry_attr[0].value.booldata);
-        if (nat_entry_attr[0].value.booldata)
-        {
-            entry.ageOutTime = now + ((protoType == IPPROTO_TCP) ? tcp_timeout : udp_timeout);
-            return 1;
-        }
-    }
-    return 0;
-}
-
 void NatOrch::doTask(NotificationConsumer& consumer)
 {
     SWSS_LOG_ENTER();
@@ -4715,6 +4568,12 @@ void NatOrch::debugdumpALL()
     SWSS_DEBUG_PRINT(m_dbgCompName, "    Total Snat Entries              : %d", totalSnatEntries);
     SWSS_DEBUG_PRINT(m_dbgCompName, "    Total Dnat Entries              : %d", totalDnatEntries);
     SWSS_DEBUG_PRINT(m_dbgCompName, "    Max allowed NAT entries         : %d", maxAllowedSNatEntries);
+    SWSS_DEBUG_PRINT(m_dbgCompName, "    Hit-bit sweeps                  : %" PRIu64 ", last %" PRIu64 " entries, %" PRIu64 " failed, %" PRIu64 " msecs, max %" PRIu64 " msecs",
+                     m_hitBitSweep.sweeps, m_hitBitSweep.lastQueried, m_hitBitSweep.lastFailed,
+                     m_hitBitSweep.lastUsecs / 1000, m_hitBitSweep.maxUsecs / 1000);
+    SWSS_DEBUG_PRINT(m_dbgCompName, "    Counter sweeps                  : %" PRIu64 ", last %" PRIu64 " entries, %" PRIu64 " failed, %" PRIu64 " msecs, max %" PRIu64 " msecs",
+                     m_counterSweep.sweeps, m_counterSweep.lastQueried, m_counterSweep.lastFailed,
+                     m_counterSweep.lastUsecs / 1000, m_counterSweep.maxUsecs / 1000);
 
     SWSS_DEBUG_PRINT(m_dbgCompName, "\n\nNatOrch NAT entries Cache");
     SWSS_DEBUG_PRINT(m_dbgCompName, "--------------------------");
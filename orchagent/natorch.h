@@ -37,6 +37,10 @@
 #define NAT_HITBIT_N_CNTRS_QUERY_PERIOD   5        // 5 secs
 #define NAT_CONNTRACK_TIMEOUT_PERIOD      86400    // 1 day
 #define NAT_HITBIT_QUERY_MULTIPLE         6        // Hit bits are queried every 30 secs
+#define NAT_HITBIT_QUERY_SLICES           6        // Hit bits sweep is spread over 6 ticks
+#define NAT_CNTRS_QUERY_MULTIPLE          1        // Counters are queried every 5 secs
+#define NAT_CNTRS_QUERY_SLICES            1        // Counters sweep is done in a single tick
+#define NAT_BULK_QUERY_CHUNK              1024     // NAT entries per bulk attribute query
 
 struct NatEntryValue
 {
@@ -176,6 +180,35 @@ struct DnatEntries
 
 typedef std::map<IpAddress, DnatEntries> DnatNhResolvCache;
 
+/* Walk of all the NAT entries to query their hit bits or counters.
+ * The keys are taken when the sweep starts and a slice of them is queried
+ * on every timer tick, the entries removed meanwhile being skipped.
+ */
+struct NatQuerySweep
+{
+    vector<IpAddress>          natKeys;
+    vector<NaptEntryKey>       naptKeys;
+    vector<TwiceNatEntryKey>   twiceNatKeys;
+    vector<TwiceNaptEntryKey>  twiceNaptKeys;
+    size_t                     natPos;
+    size_t                     naptPos;
+    size_t                     twiceNatPos;
+    size_t                     twiceNaptPos;
+    size_t                     sliceSize;       // Keys queried per tick
+    bool                       inProgress;
+
+    uint32_t                   ticks;           // Ticks of the current sweep
+    uint64_t                   usecs;           // Time spent querying in the current sweep
+    uint64_t                   queried;         // Entries queried in the current sweep
+    uint64_t                   failed;          // Entries whose query failed in the current sweep
+
+    uint64_t                   sweeps;          // Completed sweeps
+    uint64_t                   lastUsecs;       // Time spent querying in the last completed sweep
+    uint64_t                   maxUsecs;        // Longest sweep
+    uint64_t                   lastQueried;
+    uint64_t                   lastFailed;
+};
+
 class NatOrch: public Orch, public Subject, public Observer
 {
 public:
@@ -202,6 +235,8 @@ private:
     TwiceNaptEntry          m_twiceNaptEntries;
     SelectableTimer        *m_natQueryTimer;
     SelectableTimer        *m_natTimeoutTimer;
+    NatQuerySweep           m_hitBitSweep;
+    NatQuerySweep           m_counterSweep;
     DBConnector             m_countersDb;
     Table                   m_countersNatTable;
     Table                   m_countersNaptTable;
@@ -289,11 +324,6 @@ private:
     bool addHwDnatPoolEntry(const IpAddress &dstIp);
     bool removeHwDnatPoolEntry(const IpAddress &dstIp);
 
-    bool checkIfNatEntryIsActive(const NatEntry::iterator &iter, time_t now);
-    bool checkIfNaptEntryIsActive(const NaptEntry::iterator &iter, time_t now);
-    bool checkIfTwiceNatEntryIsActive(const TwiceNatEntry::iterator &iter, time_t now);
-    bool checkIfTwiceNaptEntryIsActive(const TwiceNaptEntry::iterator &iter, time_t now);
-
     void enableNatFeature(void);
     void disableNatFeature(void);
     void addAllNatEntries(void);
@@ -301,13 +331,13 @@ private:
     void clearAllDnatEntries(void);
     void cleanupAppDbEntries(void);
     void clearCounters(void);
+    void startQuerySweep(NatQuerySweep &sweep, uint32_t slices);
+    void endQuerySweep(NatQuerySweep &sweep, const char *name);
     void queryCounters(void);
     void queryHitBits(void);
     bool isNatEnabled(void);
-    bool getNatCounters(const NatEntry::iterator &iter);
-    bool getTwiceNatCounters(const TwiceNatEntry::iterator &iter);
-    bool getNaptCounters(const NaptEntry::iterator &iter);
-    bool getTwiceNaptCounters(const TwiceNaptEntry::iterator &iter);
+    void getNatEntriesAttribute(vector<sai_nat_entry_t> &entries, vector<sai_attribute_t> &attrs,
+                                vector<sai_status_t> &statuses);
     bool setNatCounters(const NatEntry::iterator &iter);
     bool setTwiceNatCounters(const TwiceNatEntry::iterator &iter);
     bool setNaptCounters(const NaptEntry::iterator &iter);
@@ -27,7 +27,9 @@ NeighOrch::NeighOrch(DBConnector *appDb, string tableName, IntfsOrch *intfsOrch,
         m_intfsOrch(intfsOrch),
         m_fdbOrch(fdbOrch),
         m_portsOrch(portsOrch),
-        m_appNeighResolveProducer(appDb, APP_NEIGH_RESOLVE_TABLE_NAME)
+        m_appNeighResolveProducer(appDb, APP_NEIGH_RESOLVE_TABLE_NAME),
+        m_neighborBulker(sai_neighbor_api),
+        m_nextHopBulker(sai_next_hop_api, gSwitchId)
 {
     SWSS_LOG_ENTER();
 
@@ -55,6 +57,52 @@ NeighOrch::~NeighOrch()
     }
 }
 
+void NeighOrch::setSyncdNeighbor(const NeighborEntry &neighborEntry, const MacAddress &mac, bool hw_configured)
+{
+    auto it = m_syncdNeighbors.find(neighborEntry);
+    if (it != m_syncdNeighbors.end())
+    {
+        if (it->second.mac != mac)
+        {
+            eraseNeighborByMac(neighborEntry, it->second.mac);
+        }
+        it->second = { mac, hw_configured };
+    }
+    else
+    {
+        m_syncdNeighbors[neighborEntry] = { mac, hw_configured };
+    }
+
+    m_neighborsByMac[make_pair(neighborEntry.alias, mac)].insert(neighborEntry);
+}
+
+void NeighOrch::eraseSyncdNeighbor(const NeighborEntry &neighborEntry)
+{
+    auto it = m_syncdNeighbors.find(neighborEntry);
+    if (it == m_syncdNeighbors.end())
+    {
+        return;
+    }
+
+    eraseNeighborByMac(neighborEntry, it->second.mac);
+    m_syncdNeighbors.erase(it);
+}
+
+void NeighOrch::eraseNeighborByMac(const NeighborEntry &neighborEntry, const MacAddress &mac)
+{
+    auto it = m_neighborsByMac.find(make_pair(neighborEntry.alias, mac));
+    if (it == m_neighborsByMac.end())
+    {
+        return;
+    }
+
+    it->second.erase(neighborEntry);
+    if (it->second.empty())
+    {
+        m_neighborsByMac.erase(it);
+    }
+}
+
 bool NeighOrch::resolveNeighborEntry(const NeighborEntry &entry, const MacAddress &mac)
 {
     vector<FieldValueTuple>    data;
@@ -92,26 +140,28 @@ void NeighOrch::processFDBFlushUpdate(const FdbFlushUpdate& update)
     for (auto entry : update.entries)
     {
         // Get Vlan object
-        Port vlan;
-        if (!m_portsOrch->getPort(entry.bv_id, vlan))
+        const Port *vlan = m_portsOrch->findPort(entry.bv_id);
+        if (vlan == nullptr)
         {
             SWSS_LOG_NOTICE("FdbOrch notification: Failed to locate vlan port \
                              from bv_id 0x%" PRIx64 ".", entry.bv_id);
             continue;
         }
         SWSS_LOG_INFO("Flushing ARP for port: %s, VLAN: %s",
-                      vlan.m_alias.c_str(), update.port.m_alias.c_str());
+                      vlan->m_alias.c_str(), update.port.m_alias.c_str());
 
         // If the FDB entry MAC matches with neighbor/ARP entry MAC,
         // and ARP entry incoming interface matches with VLAN name,
         // flush neighbor/arp entry.
-        for (const auto &neighborEntry : m_syncdNeighbors)
+        auto neighbors = m_neighborsByMac.find(make_pair(vlan->m_alias, entry.mac));
+        if (neighbors == m_neighborsByMac.end())
         {
-            if (neighborEntry.first.alias == vlan.m_alias &&
-                neighborEntry.second.mac == entry.mac)
-            {
-                resolveNeighborEntry(neighborEntry.first, neighborEntry.second.mac);
-            }
+            continue;
+        }
+
+        for (const auto &neighborEntry : neighbors->second)
+        {
+            resolveNeighborEntry(neighborEntry, entry.mac);
         }
     }
     return;
@@ -150,7 +200,7 @@ bool NeighOrch::hasNextHop(const NextHopKey &nexthop)
     return m_syncdNextHops.find(nexthop) != m_syncdNextHops.end();
 }
 
-bool NeighOrch::addNextHop(const IpAddress &ipAddress, const string &alias)
+bool NeighOrch::addNextHop(const IpAddress &ipAddress, const string &alias, NeighborBulkContext *ctx)
 {
     SWSS_LOG_ENTER();
 
@@ -199,6 +249,17 @@ bool NeighOrch::addNextHop(const IpAddress &ipAddress, const string &alias)
     next_hop_attr.value.oid = rif_id;
     next_hop_attrs.push_back(next_hop_attr);
 
+    bool port_down = p.m_oper_status == SAI_PORT_OPER_STATUS_DOWN;
+
+    if (ctx)
+    {
+        ctx->nexthop = nexthop;
+        ctx->port_down = port_down;
+        m_nextHopBulker.create_entry(&ctx->next_hop_id, &ctx->next_hop_status, (uint32_t)next_hop_attrs.size(), next_hop_attrs.data());
+        ctx->nexthop_pending = true;
+        return true;
+    }
+
     sai_object_id_t next_hop_id;
     sai_status_t status = sai_next_hop_api->create_next_hop(&next_hop_id, gSwitchId, (uint32_t)next_hop_attrs.size(), next_hop_attrs.data());
     if (status != SAI_STATUS_SUCCESS)
@@ -215,6 +276,43 @@ bool NeighOrch::addNextHop(const IpAddress &ipAddress, const string &alias)
     SWSS_LOG_NOTICE("Created next hop %s on %s",
                     ipAddress.to_string().c_str(), alias.c_str());
 
+    addNextHopState(nexthop, next_hop_id, alias, port_down);
+    return true;
+}
+
+/* Complete a neighbor of the batch once the next hop bulker is flushed */
+bool NeighOrch::addNextHopPost(NeighborBulkContext &ctx)
+{
+    SWSS_LOG_ENTER();
+
+    const IpAddress &ipAddress = ctx.entry.ip_address;
+    const string &alias = ctx.entry.alias;
+
+    sai_status_t status = ctx.next_hop_status;
+    if (status != SAI_STATUS_SUCCESS)
+    {
+        SWSS_LOG_ERROR("Failed to create next hop %s on %s, rv:%d",
+                       ipAddress.to_string().c_str(), alias.c_str(), status);
+        task_process_status handle_status = handleSaiCreateStatus(SAI_API_NEXT_HOP, status);
+        if (handle_status != task_success && !parseHandleSaiStatusFailure(handle_status))
+        {
+            return revertNeighbor(ctx.entry, ctx.mac, ctx.neighbor_entry);
+        }
+    }
+    else
+    {
+        SWSS_LOG_NOTICE("Created next hop %s on %s",
+                        ipAddress.to_string().c_str(), alias.c_str());
+
+        addNextHopState(ctx.nexthop, ctx.next_hop_id, alias, ctx.port_down);
+    }
+
+    addNeighborState(ctx.entry, ctx.mac, true, ctx.neighbor_entry);
+    return true;
+}
+
+void NeighOrch::addNextHopState(const NextHopKey &nexthop, sai_object_id_t next_hop_id, const string &alias, bool port_down)
+{
     NextHopEntry next_hop_entry;
     next_hop_entry.next_hop_id = next_hop_id;
     next_hop_entry.ref_count = 0;
@@ -223,7 +321,7 @@ bool NeighOrch::addNextHop(const IpAddress &ipAddress, const string &alias)
 
     m_intfsOrch->increaseRouterIntfsRefCount(alias);
 
-    if (ipAddress.isV4())
+    if (nexthop.ip_address.isV4())
     {
         gCrmOrch->incCrmResUsedCounter(CrmResourceType::CRM_IPV4_NEXTHOP);
     }
@@ -238,15 +336,16 @@ bool NeighOrch::addNextHop(const IpAddress &ipAddress, const string &alias)
     // flag should be set on it.
     // This scenario may happen under race condition where buffered neighbor event
     // is processed after incoming port is down.
-    if (p.m_oper_status == SAI_PORT_OPER_STATUS_DOWN)
+    if (port_down)
     {
         if (setNextHopFlag(nexthop, NHFLAGS_IFDOWN) == false)
         {
             SWSS_LOG_WARN("Failed to set NHFLAGS_IFDOWN on nexthop %s for interface %s",
-                ipAddress.to_string().c_str(), alias.c_str());
+                nexthop.ip_address.to_string().c_str(), alias.c_str());
         }
     }
-    return true;
+
+    Orch::notifyRetryEvent(RETRY_EVENT_NEXTHOP_ADDED, nexthop.to_string());
 }
 
 bool NeighOrch::setNextHopFlag(const NextHopKey &nexthop, const uint32_t nh_flag)
@@ -505,6 +604,8 @@ void NeighOrch::doTask(Consumer &consumer)
         return;
     }
 
+    NeighborBatch batch;
+
     auto it = consumer.m_toSync.begin();
     while (it != consumer.m_toSync.end())
     {
@@ -548,6 +649,12 @@ void NeighOrch::doTask(Consumer &consumer)
 
         NeighborEntry neighbor_entry = { ip_address, alias };
 
+        /* Apply the pending operation on the neighbor before checking the next one */
+        if (batch.entries.find(neighbor_entry) != batch.entries.end())
+        {
+            flushNeighborBatch(consumer, batch);
+        }
+
         if (op == SET_COMMAND)
         {
             Port p;
@@ -561,6 +668,7 @@ void NeighOrch::doTask(Consumer &consumer)
             if (!p.m_rif_id)
             {
                 SWSS_LOG_INFO("Router interface doesn't exist on %s", alias.c_str());
+                consumer.parkUntil(key, make_pair(RETRY_EVENT_RIF_ADDED, alias));
                 it++;
                 continue;
             }
@@ -576,7 +684,19 @@ void NeighOrch::doTask(Consumer &consumer)
             if (m_syncdNeighbors.find(neighbor_entry) == m_syncdNeighbors.end()
                     || m_syncdNeighbors[neighbor_entry].mac != mac_address)
             {
-                if (addNeighbor(neighbor_entry, mac_address))
+                batch.contexts.emplace_back();
+                batch.contexts.back().it = it;
+                bool done = addNeighbor(neighbor_entry, mac_address, &batch.contexts.back());
+                if (batch.contexts.back().pending)
+                {
+                    /* Erased with the remaining DEL operation once the batch is flushed */
+                    batch.entries.insert(neighbor_entry);
+                    it++;
+                    continue;
+                }
+                batch.contexts.pop_back();
+
+                if (done)
                 {
                     it = consumer.m_toSync.erase(it);
                 }
@@ -592,16 +712,7 @@ void NeighOrch::doTask(Consumer &consumer)
                 it = consumer.m_toSync.erase(it);
             }
 
-            /* Remove remaining DEL operation in m_toSync for the same neighbor.
-             * Since DEL operation is supposed to be executed before SET for the same neighbor
-             * A remaining DEL after the SET operation means the DEL operation failed previously and should not be executed anymore
-             */
-            auto rit = make_reverse_iterator(it);
-            while (rit != consumer.m_toSync.rend() && rit->first == key && kfvOp(rit->second) == DEL_COMMAND)
-            {
-                consumer.m_toSync.erase(next(rit).base());
-                SWSS_LOG_NOTICE("Removed pending neighbor DEL operation for %s after SET operation", key.c_str());
-            }
+            removePendingDel(consumer, it, key);
         }
         else if (op == DEL_COMMAND)
         {
@@ -626,9 +737,65 @@ void NeighOrch::doTask(Consumer &consumer)
             it = consumer.m_toSync.erase(it);
         }
     }
+
+    flushNeighborBatch(consumer, batch);
+}
+
+/*
+ * Remove remaining DEL operation in m_toSync for the same neighbor, it points
+ * behind the SET operation.
+ * Since DEL operation is supposed to be executed before SET for the same neighbor
+ * A remaining DEL after the SET operation means the DEL operation failed previously and should not be executed anymore
+ */
+void NeighOrch::removePendingDel(Consumer &consumer, SyncMap::iterator it, const string &key)
+{
+    auto rit = make_reverse_iterator(it);
+    while (rit != consumer.m_toSync.rend() && rit->first == key && kfvOp(rit->second) == DEL_COMMAND)
+    {
+        consumer.m_toSync.erase(next(rit).base());
+        SWSS_LOG_NOTICE("Removed pending neighbor DEL operation for %s after SET operation", key.c_str());
+    }
+}
+
+void NeighOrch::flushNeighborBatch(Consumer &consumer, NeighborBatch &batch)
+{
+    SWSS_LOG_ENTER();
+
+    if (batch.contexts.empty())
+    {
+        return;
+    }
+
+    // Flush the neighbor bulker, then queue the next hops of the created neighbors
+    m_neighborBulker.flush();
+    for (auto &ctx : batch.contexts)
+    {
+        ctx.done = addNeighborPost(ctx);
+    }
+
+    // Flush the next hop bulker, then complete the neighbors
+    m_nextHopBulker.flush();
+    for (auto &ctx : batch.contexts)
+    {
+        if (ctx.nexthop_pending)
+        {
+            ctx.done = addNextHopPost(ctx);
+        }
+
+        if (ctx.done)
+        {
+            string key = ctx.it->first;
+            removePendingDel(consumer, consumer.m_toSync.erase(ctx.it), key);
+        }
+    }
+
+    SWSS_LOG_INFO("Flushed %zu neighbors", batch.contexts.size());
+
+    batch.contexts.clear();
+    batch.entries.clear();
 }
 
-bool NeighOrch::addNeighbor(const NeighborEntry &neighborEntry, const MacAddress &macAddress)
+bool NeighOrch::addNeighbor(const NeighborEntry &neighborEntry, const MacAddress &macAddress, NeighborBulkContext *ctx)
 {
     SWSS_LOG_ENTER();
 
@@ -668,6 +835,17 @@ bool NeighOrch::addNeighbor(const NeighborEntry &neighborEntry, const MacAddress
             }
         }
 
+        if (ctx)
+        {
+            ctx->entry = neighborEntry;
+            ctx->mac = macAddress;
+            ctx->neighbor_entry = neighbor_entry;
+            m_neighborBulker.create_entry(&ctx->neighbor_status, &ctx->neighbor_entry,
+                                          (uint32_t)neighbor_attrs.size(), neighbor_attrs.data());
+            ctx->pending = true;
+            return true;
+        }
+
         status = sai_neighbor_api->create_neighbor_entry(&neighbor_entry,
                                    (uint32_t)neighbor_attrs.size(), neighbor_attrs.data());
         if (status != SAI_STATUS_SUCCESS)
@@ -692,42 +870,11 @@ bool NeighOrch::addNeighbor(const NeighborEntry &neighborEntry, const MacAddress
         }
         SWSS_LOG_NOTICE("Created neighbor ip %s, %s on %s", ip_address.to_string().c_str(),
                 macAddress.to_string().c_str(), alias.c_str());
-        m_intfsOrch->increaseRouterIntfsRefCount(alias);
-
-        if (neighbor_entry.ip_address.addr_family == SAI_IP_ADDR_FAMILY_IPV4)
-        {
-            gCrmOrch->incCrmResUsedCounter(CrmResourceType::CRM_IPV4_NEIGHBOR);
-        }
-        else
-        {
-            gCrmOrch->incCrmResUsedCounter(CrmResourceType::CRM_IPV6_NEIGHBOR);
-        }
+        updateNeighborCounters(neighborEntry, true);
 
         if (!addNextHop(ip_address, alias))
         {
-            status = sai_neighbor_api->remove_neighbor_entry(&neighbor_entry);
-            if (status != SAI_STATUS_SUCCESS)
-            {
-                SWSS_LOG_ERROR("Failed to remove neighbor %s on %s, rv:%d",
-                               macAddress.to_string().c_str(), alias.c_str(), status);
-                task_process_status handle_status = handleSaiRemoveStatus(SAI_API_NEIGHBOR, status);
-                if (handle_status != task_success)
-                {
-                    return parseHandleSaiStatusFailure(handle_status);
-                }
-            }
-            m_intfsOrch->decreaseRouterIntfsRefCount(alias);
-
-            if (neighbor_entry.ip_address.addr_family == SAI_IP_ADDR_FAMILY_IPV4)
-            {
-                gCrmOrch->decCrmResUsedCounter(CrmResourceType::CRM_IPV4_NEIGHBOR);
-            }
-            else
-            {
-                gCrmOrch->decCrmResUsedCounter(CrmResourceType::CRM_IPV6_NEIGHBOR);
-            }
-
-            return false;
+            return revertNeighbor(neighborEntry, macAddress, neighbor_entry);
         }
         hw_config = true;
     }
@@ -747,7 +894,57 @@ bool NeighOrch::addNeighbor(const NeighborEntry &neighborEntry, const MacAddress
         SWSS_LOG_NOTICE("Updated neighbor %s on %s", macAddress.to_string().c_str(), alias.c_str());
     }
 
-    m_syncdNeighbors[neighborEntry] = { macAddress, hw_config };
+    addNeighborState(neighborEntry, macAddress, hw_config, neighbor_entry);
+    return true;
+}
+
+/* Handle the status of a neighbor of the batch once the neighbor bulker is flushed */
+bool NeighOrch::addNeighborPost(NeighborBulkContext &ctx)
+{
+    SWSS_LOG_ENTER();
+
+    const IpAddress &ip_address = ctx.entry.ip_address;
+    const string &alias = ctx.entry.alias;
+
+    sai_status_t status = ctx.neighbor_status;
+    if (status != SAI_STATUS_SUCCESS)
+    {
+        if (status == SAI_STATUS_ITEM_ALREADY_EXISTS)
+        {
+            SWSS_LOG_ERROR("Entry exists: neighbor %s on %s, rv:%d",
+                       ctx.mac.to_string().c_str(), alias.c_str(), status);
+            /* Returning True so as to skip retry */
+            return true;
+        }
+        else
+        {
+            SWSS_LOG_ERROR("Failed to create neighbor %s on %s, rv:%d",
+                       ctx.mac.to_string().c_str(), alias.c_str(), status);
+            task_process_status handle_status = handleSaiCreateStatus(SAI_API_NEIGHBOR, status);
+            if (handle_status != task_success)
+            {
+                return parseHandleSaiStatusFailure(handle_status);
+            }
+        }
+    }
+    SWSS_LOG_NOTICE("Created neighbor ip %s, %s on %s", ip_address.to_string().c_str(),
+            ctx.mac.to_string().c_str(), alias.c_str());
+    updateNeighborCounters(ctx.entry, true);
+
+    if (!addNextHop(ip_address, alias, &ctx))
+    {
+        return revertNeighbor(ctx.entry, ctx.mac, ctx.neighbor_entry);
+    }
+
+    return true;
+}
+
+void NeighOrch::addNeighborState(const NeighborEntry &neighborEntry, const MacAddress &macAddress, bool hw_config, sai_neighbor_entry_t &neighbor_entry)
+{
+    IpAddress ip_address = neighborEntry.ip_address;
+    string alias = neighborEntry.alias;
+
+    setSyncdNeighbor(neighborEntry, macAddress, hw_config);
 
     NeighborUpdate update = { neighborEntry, macAddress, true };
     notify(SUBJECT_TYPE_NEIGH_CHANGE, static_cast<void *>(&update));
@@ -757,8 +954,43 @@ bool NeighOrch::addNeighbor(const NeighborEntry &neighborEntry, const MacAddress
         //Sync the neighbor to add to the CHASSIS_APP_DB
         voqSyncAddNeigh(alias, ip_address, macAddress, neighbor_entry);
     }
+}
 
-    return true;
+/* Update the router interface reference and the CRM counter of a created or removed neighbor */
+void NeighOrch::updateNeighborCounters(const NeighborEntry &neighborEntry, bool add)
+{
+    CrmResourceType resource = neighborEntry.ip_address.isV4() ?
+            CrmResourceType::CRM_IPV4_NEIGHBOR : CrmResourceType::CRM_IPV6_NEIGHBOR;
+
+    if (add)
+    {
+        m_intfsOrch->increaseRouterIntfsRefCount(neighborEntry.alias);
+        gCrmOrch->incCrmResUsedCounter(resource);
+    }
+    else
+    {
+        m_intfsOrch->decreaseRouterIntfsRefCount(neighborEntry.alias);
+        gCrmOrch->decCrmResUsedCounter(resource);
+    }
+}
+
+/* Remove a created neighbor whose next hop could not be created */
+bool NeighOrch::revertNeighbor(const NeighborEntry &neighborEntry, const MacAddress &macAddress, sai_neighbor_entry_t &neighbor_entry)
+{
+    sai_status_t status = sai_neighbor_api->remove_neighbor_entry(&neighbor_entry);
+    if (status != SAI_STATUS_SUCCESS)
+    {
+        SWSS_LOG_ERROR("Failed to remove neighbor %s on %s, rv:%d",
+                       macAddress.to_string().c_str(), neighborEntry.alias.c_str(), status);
+        task_process_status handle_status = handleSaiRemoveStatus(SAI_API_NEIGHBOR, status);
+        if (handle_status != task_success)
+        {
+            return parseHandleSaiStatusFailure(handle_status);
+        }
+    }
+    updateNeighborCounters(neighborEntry, false);
+
+    return false;
 }
 
 bool NeighOrch::removeNeighbor(const NeighborEntry &neighborEntry, bool disable)
@@ -882,7 +1114,7 @@ bool NeighOrch::removeNeighbor(const NeighborEntry &neighborEntry, bool disable)
         return true;
     }
 
-    m_syncdNeighbors.erase(neighborEntry);
+    eraseSyncdNeighbor(neighborEntry);
 
     NeighborUpdate update = { neighborEntry, MacAddress(), false };
     notify(SUBJECT_TYPE_NEIGH_CHANGE, static_cast<void *>(&update));
@@ -1068,6 +1300,7 @@ void NeighOrch::doVoqSystemNeighTask(Consumer &consumer)
             if (!p.m_rif_id)
             {
                 SWSS_LOG_INFO("Router interface doesn't exist on %s", alias.c_str());
+                consumer.parkUntil(key, make_pair(RETRY_EVENT_RIF_ADDED, alias));
                 it++;
                 continue;
             }
@@ -1,11 +1,14 @@
 #ifndef SWSS_NEIGHORCH_H
 #define SWSS_NEIGHORCH_H
 
+#include <deque>
+
 #include "orch.h"
 #include "observer.h"
 #include "portsorch.h"
 #include "intfsorch.h"
 #include "fdborch.h"
+#include "bulker.h"
 
 #include "ipaddress.h"
 #include "nexthopkey.h"
@@ -41,6 +44,40 @@ struct NeighborUpdate
     bool add;
 };
 
+struct NeighborBulkContext
+{
+    SyncMap::iterator                   it;                 // m_toSync entry, erased once the neighbor is handled
+    NeighborEntry                       entry;
+    MacAddress                          mac;
+    sai_neighbor_entry_t                neighbor_entry;
+    sai_status_t                        neighbor_status;
+    NextHopKey                          nexthop;
+    sai_object_id_t                     next_hop_id;
+    sai_status_t                        next_hop_status;
+    bool                                port_down;          // Set NHFLAGS_IFDOWN on the next hop once created
+    bool                                pending;            // Neighbor create handed to the bulker
+    bool                                nexthop_pending;    // Next hop create handed to the bulker
+    bool                                done;
+
+    NeighborBulkContext()
+        : neighbor_status(SAI_STATUS_NOT_EXECUTED), next_hop_id(SAI_NULL_OBJECT_ID),
+          next_hop_status(SAI_STATUS_NOT_EXECUTED), port_down(false), pending(false), nexthop_pending(false), done(false)
+    {
+    }
+};
+
+/*
+ * Neighbors created together. The neighbor entries are flushed first, then
+ * the next hops of the created neighbors. A neighbor is in the batch at most
+ * once, as the checks of an entry depend on the result of the previous
+ * operation on the same neighbor.
+ */
+struct NeighborBatch
+{
+    std::deque<NeighborBulkContext>     contexts;
+    std::set<NeighborEntry>             entries;
+};
+
 class NeighOrch : public Orch, public Subject, public Observer
 {
 public:
@@ -82,11 +119,22 @@ private:
 
     NeighborTable m_syncdNeighbors;
     NextHopTable m_syncdNextHops;
+    /* Neighbors of m_syncdNeighbors by interface alias and MAC, to find the neighbors of a flushed FDB entry */
+    map<pair<string, MacAddress>, set<NeighborEntry>> m_neighborsByMac;
 
-    bool addNextHop(const IpAddress&, const string&);
+    EntityBulker<sai_neighbor_api_t> m_neighborBulker;
+    ObjectBulker<sai_next_hop_api_t> m_nextHopBulker;
+
+    bool addNextHop(const IpAddress&, const string&, NeighborBulkContext *ctx = nullptr);
+    bool addNextHopPost(NeighborBulkContext&);
+    void addNextHopState(const NextHopKey&, sai_object_id_t, const string&, bool port_down);
     bool removeNextHop(const IpAddress&, const string&);
 
-    bool addNeighbor(const NeighborEntry&, const MacAddress&);
+    bool addNeighbor(const NeighborEntry&, const MacAddress&, NeighborBulkContext *ctx = nullptr);
+    bool addNeighborPost(NeighborBulkContext&);
+    void addNeighborState(const NeighborEntry&, const MacAddress&, bool hw_config, sai_neighbor_entry_t&);
+    void updateNeighborCounters(const NeighborEntry&, bool add);
+    bool revertNeighbor(const NeighborEntry&, const MacAddress&, sai_neighbor_entry_t&);
     bool removeNeighbor(const NeighborEntry&, bool disable = false);
 
     bool setNextHopFlag(const NextHopKey &, const uint32_t);
@@ -95,8 +143,15 @@ private:
     void processFDBFlushUpdate(const FdbFlushUpdate &);
     bool resolveNeighborEntry(const NeighborEntry &, const MacAddress &);
 
+    /* Update m_syncdNeighbors and m_neighborsByMac together */
+    void setSyncdNeighbor(const NeighborEntry &, const MacAddress &, bool hw_configured);
+    void eraseSyncdNeighbor(const NeighborEntry &);
+    void eraseNeighborByMac(const NeighborEntry &, const MacAddress &);
+
     void doTask(Consumer &consumer);
     void doVoqSystemNeighTask(Consumer &consumer);
+    void flushNeighborBatch(Consumer &consumer, NeighborBatch &batch);
+    void removePendingDel(Consumer &consumer, SyncMap::iterator it, const string &key);
 
     unique_ptr<Table> m_tableVoqSystemNeighTable;
     unique_ptr<Table> m_stateSystemNeighTable;
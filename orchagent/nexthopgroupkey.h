@@ -1,11 +1,119 @@
 #ifndef SWSS_NEXTHOPGROUPKEY_H
 #define SWSS_NEXTHOPGROUPKEY_H
 
+#include <algorithm>
+#include <deque>
+#include <functional>
+#include <iterator>
+#include <map>
+#include <memory>
+#include <mutex>
+#include <set>
+#include <string>
+#include <vector>
+
 #include "nexthopkey.h"
 
+/*
+ * NextHopKeyPool interns next hop keys, every distinct next hop is stored
+ * once and identified by a small integer. Identifiers are never reused, so
+ * the pool grows with the number of distinct next hops ever seen, which is
+ * bounded by the neighbors and tunnel endpoints of the switch.
+ */
+class NextHopKeyPool
+{
+public:
+    static NextHopKeyPool &getInstance()
+    {
+        static NextHopKeyPool pool;
+        return pool;
+    }
+
+    /*
+     * Return the identifier of the next hop, adding it to the pool if needed.
+     * key points to the pooled next hop, it stays valid for the lifetime of
+     * the process.
+     */
+    uint32_t intern(const NextHopKey &nh, const NextHopKey *&key)
+    {
+        std::lock_guard<std::mutex> lock(m_mutex);
+
+        auto it = m_ids.find(nh);
+        if (it != m_ids.end())
+        {
+            key = &m_keys[it->second];
+            return it->second;
+        }
+
+        uint32_t id = static_cast<uint32_t>(m_keys.size());
+        m_keys.push_back(nh);
+        m_ids.emplace(nh, id);
+        key = &m_keys.back();
+        return id;
+    }
+
+    /* Return false if the next hop was never interned */
+    bool find(const NextHopKey &nh, uint32_t &id) const
+    {
+        std::lock_guard<std::mutex> lock(m_mutex);
+
+        auto it = m_ids.find(nh);
+        if (it == m_ids.end())
+        {
+            return false;
+        }
+
+        id = it->second;
+        return true;
+    }
+
+    size_t size() const
+    {
+        std::lock_guard<std::mutex> lock(m_mutex);
+        return m_keys.size();
+    }
+
+private:
+    NextHopKeyPool() = default;
+
+    mutable std::mutex m_mutex;
+    std::deque<NextHopKey> m_keys;
+    std::map<NextHopKey, uint32_t> m_ids;
+};
+
+/*
+ * NextHopGroupKey keeps the interned identifiers of its next hops in a
+ * sorted vector with a cached hash, so comparing and hashing group keys
+ * never touches the next hop strings. Groups are ordered by identifiers,
+ * not by next hops. Next hops are iterated and printed in NextHopKey order,
+ * as if they were kept in a std::set<NextHopKey>.
+ */
 class NextHopGroupKey
 {
 public:
+    /* Iterator over the pooled next hops of the group, in NextHopKey order */
+    class const_iterator
+    {
+    public:
+        using iterator_category = std::forward_iterator_tag;
+        using value_type = NextHopKey;
+        using difference_type = std::ptrdiff_t;
+        using pointer = const NextHopKey *;
+        using reference = const NextHopKey &;
+
+        explicit const_iterator(std::vector<const NextHopKey *>::const_iterator it) : m_it(it) {}
+
+        reference operator*() const { return **m_it; }
+        pointer operator->() const { return *m_it; }
+        const_iterator &operator++() { ++m_it; return *this; }
+        const_iterator operator++(int) { auto it = *this; ++m_it; return it; }
+        bool operator==(const const_iterator &o) const { return m_it == o.m_it; }
+        bool operator!=(const const_iterator &o) const { return m_it != o.m_it; }
+
+    private:
+        std::vector<const NextHopKey *>::const_iterator m_it;
+    };
+
     NextHopGroupKey() = default;
 
     /* ip_string@if_alias separated by ',' */
@@ -15,7 +123,7 @@ public:
         auto nhv = tokenize(nexthops, NHG_DELIMITER);
         for (const auto &nh : nhv)
         {
-            m_nexthops.insert(nh);
+            insert(NextHopKey(nh));
         }
     }
 
@@ -26,29 +134,50 @@ public:
         auto nhv = tokenize(nexthops, NHG_DELIMITER);
         for (const auto &nh_str : nhv)
         {
-            auto nh = NextHopKey(nh_str, overlay_nh);
-            m_nexthops.insert(nh);
+            insert(NextHopKey(nh_str, overlay_nh));
         }
     }
 
-    inline const std::set<NextHopKey> &getNextHops() const
+    const_iterator begin() const
+    {
+        return const_iterator(m_nexthops.begin());
+    }
+
+    const_iterator end() const
     {
-        return m_nexthops;
+        return const_iterator(m_nexthops.end());
+    }
+
+    /* Copy of the next hops, iterate over the group when a copy isn't needed */
+    inline std::set<NextHopKey> getNextHops() const
+    {
+        return std::set<NextHopKey>(begin(), end());
+    }
+
+    /* The lowest next hop in NextHopKey order, the group must not be empty */
+    const NextHopKey &getFirstNextHop() const
+    {
+        return *m_nexthops.front();
     }
 
     inline size_t getSize() const
     {
-        return m_nexthops.size();
+        return m_ids.size();
+    }
+
+    inline size_t getHash() const
+    {
+        return m_hash;
     }
 
     inline bool operator<(const NextHopGroupKey &o) const
     {
-        return m_nexthops < o.m_nexthops;
+        return m_ids < o.m_ids;
     }
 
     inline bool operator==(const NextHopGroupKey &o) const
     {
-        return m_nexthops == o.m_nexthops;
+        return m_hash == o.m_hash && m_ids == o.m_ids;
     }
 
     inline bool operator!=(const NextHopGroupKey &o) const
@@ -58,52 +187,49 @@ public:
 
     void add(const std::string &ip, const std::string &alias)
     {
-        m_nexthops.emplace(ip, alias);
+        insert(NextHopKey(ip, alias));
     }
 
     void add(const std::string &nh)
     {
-        m_nexthops.insert(nh);
+        insert(NextHopKey(nh));
     }
 
     void add(const NextHopKey &nh)
     {
-        m_nexthops.insert(nh);
+        insert(nh);
     }
 
     bool contains(const std::string &ip, const std::string &alias) const
     {
-        NextHopKey nh(ip, alias);
-        return m_nexthops.find(nh) != m_nexthops.end();
+        return contains(NextHopKey(ip, alias));
     }
 
     bool contains(const std::string &nh) const
     {
-        return m_nexthops.find(nh) != m_nexthops.end();
+        return contains(NextHopKey(nh));
     }
 
     bool contains(const NextHopKey &nh) const
     {
-        return m_nexthops.find(nh) != m_nexthops.end();
+        uint32_t id;
+        if (!NextHopKeyPool::getInstance().find(nh, id))
+        {
+            return false;
+        }
+        return std::binary_search(m_ids.begin(), m_ids.end(), id);
     }
 
     bool contains(const NextHopGroupKey &nhs) const
     {
-        for (const auto &nh : nhs.getNextHops())
-        {
-            if (!contains(nh))
-            {
-                return false;
-            }
-        }
-        return true;
+        return std::includes(m_ids.begin(), m_ids.end(), nhs.m_ids.begin(), nhs.m_ids.end());
     }
 
     bool hasIntfNextHop() const
     {
-        for (const auto &nh : m_nexthops)
+        for (auto nh : m_nexthops)
         {
-            if (nh.isIntfNextHop())
+            if (nh->isIntfNextHop())
             {
                 return true;
             }
@@ -113,38 +239,44 @@ public:
 
     void remove(const std::string &ip, const std::string &alias)
     {
-        NextHopKey nh(ip, alias);
-        m_nexthops.erase(nh);
+        erase(NextHopKey(ip, alias));
     }
 
     void remove(const std::string &nh)
     {
-        m_nexthops.erase(nh);
+        erase(NextHopKey(nh));
     }
 
     void remove(const NextHopKey &nh)
     {
-        m_nexthops.erase(nh);
+        erase(nh);
     }
 
-    const std::string to_string() const
+    /* Built on the first call, and shared by the copies made after it */
+    const std::string &to_string() const
     {
-        string nhs_str;
+        if (m_string)
+        {
+            return *m_string;
+        }
 
-        for (auto it = m_nexthops.begin(); it != m_nexthops.end(); ++it)
+        auto nhs_str = std::make_shared<std::string>();
+
+        for (auto it = begin(); it != end(); ++it)
         {
-            if (it != m_nexthops.begin())
+            if (it != begin())
             {
-                nhs_str += NHG_DELIMITER;
+                *nhs_str += NHG_DELIMITER;
             }
             if (m_overlay_nexthops) {
-                nhs_str += it->to_string(m_overlay_nexthops);
+                *nhs_str += it->to_string(m_overlay_nexthops);
             } else {
-                nhs_str += it->to_string();
+                *nhs_str += it->to_string();
             }
         }
 
-        return nhs_str;
+        m_string = nhs_str;
+        return *m_string;
     }
 
     inline bool is_overlay_nexthop() const
@@ -154,12 +286,78 @@ public:
 
     void clear()
     {
+        m_ids.clear();
         m_nexthops.clear();
+        m_string.reset();
+        m_hash = 0;
     }
 
 private:
-    std::set<NextHopKey> m_nexthops;
-    bool m_overlay_nexthops;
+    /* Interned next hop identifiers in ascending order */
+    std::vector<uint32_t> m_ids;
+    /* The pooled next hops, in NextHopKey order */
+    std::vector<const NextHopKey *> m_nexthops;
+    mutable std::shared_ptr<const std::string> m_string;
+    size_t m_hash = 0;
+    bool m_overlay_nexthops = false;
+
+    static bool lessNextHop(const NextHopKey *nh, const NextHopKey &other)
+    {
+        return *nh < other;
+    }
+
+    void insert(const NextHopKey &nh)
+    {
+        const NextHopKey *key;
+        uint32_t id = NextHopKeyPool::getInstance().intern(nh, key);
+        auto it = std::lower_bound(m_ids.begin(), m_ids.end(), id);
+        if (it == m_ids.end() || *it != id)
+        {
+            m_ids.insert(it, id);
+            m_nexthops.insert(std::lower_bound(m_nexthops.begin(), m_nexthops.end(), *key, lessNextHop), key);
+            m_string.reset();
+            rehash();
+        }
+    }
+
+    void erase(const NextHopKey &nh)
+    {
+        uint32_t id;
+        if (!NextHopKeyPool::getInstance().find(nh, id))
+        {
+            return;
+        }
+
+        auto it = std::lower_bound(m_ids.begin(), m_ids.end(), id);
+        if (it != m_ids.end() && *it == id)
+        {
+            m_ids.erase(it);
+            m_nexthops.erase(std::lower_bound(m_nexthops.begin(), m_nexthops.end(), nh, lessNextHop));
+            m_string.reset();
+            rehash();
+        }
+    }
+
+    void rehash()
+    {
+        m_hash = 0;
+        for (auto id : m_ids)
+        {
+            m_hash ^= std::hash<uint32_t>()(id) + 0x9e3779b9 + (m_hash << 6) + (m_hash >> 2);
+        }
+    }
 };
 
+namespace std
+{
+    template <>
+    struct hash<NextHopGroupKey>
+    {
+        size_t operator()(const NextHopGroupKey &key) const
+        {
+            return key.getHash();
+        }
+    };
+}
+
 #endif /* SWSS_NEXTHOPGROUPKEY_H */
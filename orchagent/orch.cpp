@@ -1,5 +1,7 @@
+#include <algorithm>
 #include <fstream>
 #include <iostream>
+#include <mutex>
 #include <inttypes.h>
 #include <sys/time.h>
 #include "timestamp.h"
@@ -16,6 +18,13 @@ using namespace swss;
 
 extern int gBatchSize;
 
+/* Parked consumers are re-driven by the retry loop at least this often */
+#define RETRY_PARK_TIMEOUT std::chrono::seconds(1)
+
+/* Consumers waiting for each constraint, guarded by retryWaitersMutex */
+static map<RetryConstraint, set<Consumer *>> retryWaiters;
+static std::mutex retryWaitersMutex;
+
 extern bool gSwssRecord;
 extern ofstream gRecordOfs;
 extern bool gLogRotate;
@@ -69,12 +78,27 @@ vector<Selectable *> Orch::getSelectables()
 }
 
 void Consumer::addToSync(const KeyOpFieldsValuesTuple &entry)
+{
+    addToSync(KeyOpFieldsValuesTuple(entry));
+}
+
+Consumer::~Consumer()
+{
+    for (const auto &it : m_retryWaits)
+    {
+        Orch::removeRetryWaiter(it.first, this);
+    }
+}
+
+void Consumer::addToSync(KeyOpFieldsValuesTuple &&entry)
 {
     SWSS_LOG_ENTER();
 
+    /* New data may allow the pending tasks to make progress */
+    m_parked = false;
 
-    string key = kfvKey(entry);
-    string op  = kfvOp(entry);
+    const string &key = kfvKey(entry);
+    const string &op = kfvOp(entry);
 
     /* Record incoming tasks */
     if (gSwssRecord)
@@ -83,76 +107,59 @@ void Consumer::addToSync(const KeyOpFieldsValuesTuple &entry)
     }
 
     /*
-    * m_toSync is a multimap which will allow one key with multiple values,
-    * Also, the order of the key-value pairs whose keys compare equivalent
-    * is the order of insertion and does not change. (since C++11)
+    * m_toSync keeps at most two entries per key, adjacent to each other.
+    * In case there is one entry, it should be DEL or SET
+    * In case there are two entries, it should be DEL then SET
     */
+    auto iter = m_toSync.find(key);
 
-    /* If a new task comes we directly put it into getConsumerTable().m_toSync map */
-    if (m_toSync.find(key) == m_toSync.end())
+    /* If a new task comes we directly put it into m_toSync */
+    if (iter == m_toSync.end())
     {
-        m_toSync.emplace(key, entry);
+        m_toSync.emplace(std::move(entry));
+        return;
     }
 
-    /* if a DEL task comes, we overwrite the old key */
-    else if (op == DEL_COMMAND)
+    /* if a DEL task comes, it overwrites all pending tasks of the key */
+    if (op == DEL_COMMAND)
     {
-        m_toSync.erase(key);
-        m_toSync.emplace(key, entry);
-    }
-    else
-    {
-        /*
-        * Now we are trying to add the key-value with SET.
-        * We maintain maximum two values per key.
-        * In case there is one key-value, it should be DEL or SET
-        * In case there are two key-value pairs, it should be DEL then SET
-        * The code logic is following:
-        * We iterate the values with the key, we skip the value with DEL and then
-        * check if that was the only one (I,E, the iter pointer now points to end or next key),
-        * in such case, we insert the key-value with SET.
-        * If there was a SET already (I,E, the pointer still points to the same key), we combine the kfv.
-        */
-        auto ret = m_toSync.equal_range(key);
-        auto iter = ret.first;
-        for (; iter != ret.second; ++iter)
-        {
-            auto old_op = kfvOp(iter->second);
-            if (old_op == SET_COMMAND)
-                break;
-        }
-        if (iter == ret.second)
+        auto next = std::next(iter);
+        while (next != m_toSync.end() && next->first == key)
         {
-            m_toSync.emplace(key, entry);
+            next = m_toSync.erase(next);
         }
-        else
-        {
-            KeyOpFieldsValuesTuple existing_data = iter->second;
-
-            auto new_values = kfvFieldsValues(entry);
-            auto existing_values = kfvFieldsValues(existing_data);
+        iter->second = std::move(entry);
+        return;
+    }
 
+    /*
+    * Now we are trying to add the key-value with SET.
+    * We skip the pending DEL, if there is no pending SET after it, the
+    * new SET is inserted behind the DEL, otherwise we merge the fields
+    * into the pending SET.
+    */
+    for (; iter != m_toSync.end() && iter->first == key; ++iter)
+    {
+        if (kfvOp(iter->second) == SET_COMMAND)
+            break;
+    }
+    if (iter == m_toSync.end() || iter->first != key)
+    {
+        m_toSync.emplace(std::move(entry));
+        return;
+    }
 
-            for (auto it : new_values)
-            {
-                string field = fvField(it);
-                string value = fvValue(it);
+    auto &existing_values = kfvFieldsValues(iter->second);
+    for (auto &fv : kfvFieldsValues(entry))
+    {
+        const string &field = fvField(fv);
 
-                auto iu = existing_values.begin();
-                while (iu != existing_values.end())
-                {
-                    string ofield = fvField(*iu);
-                    if (field == ofield)
-                        iu = existing_values.erase(iu);
-                    else
-                        iu++;
-                }
-                existing_values.push_back(FieldValueTuple(field, value));
-            }
-            iter->second = KeyOpFieldsValuesTuple(key, op, existing_values);
-        }
+        existing_values.erase(
+            std::remove_if(existing_values.begin(), existing_values.end(),
+                [&field](const FieldValueTuple &ofv) { return fvField(ofv) == field; }),
+            existing_values.end());
+        existing_values.push_back(std::move(fv));
     }
-
 }
 
 size_t Consumer::addToSync(const std::deque<KeyOpFieldsValuesTuple> &entries)
@@ -167,6 +174,18 @@ size_t Consumer::addToSync(const std::deque<KeyOpFieldsValuesTuple> &entries)
     return entries.size();
 }
 
+size_t Consumer::addToSync(std::deque<KeyOpFieldsValuesTuple> &&entries)
+{
+    SWSS_LOG_ENTER();
+
+    for (auto& entry: entries)
+    {
+        addToSync(std::move(entry));
+    }
+
+    return entries.size();
+}
+
 // TODO: Table should be const
 size_t Consumer::refillToSync(Table* table)
 {
@@ -184,10 +203,10 @@ size_t Consumer::refillToSync(Table* table)
         {
             continue;
         }
-        entries.push_back(kco);
+        entries.push_back(std::move(kco));
     }
 
-    return addToSync(entries);
+    return addToSync(std::move(entries));
 }
 
 size_t Consumer::refillToSync()
@@ -199,7 +218,7 @@ size_t Consumer::refillToSync()
     {
         std::deque<KeyOpFieldsValuesTuple> entries;
         subTable->pops(entries);
-        return addToSync(entries);
+        return addToSync(std::move(entries));
     }
     else
     {
@@ -218,15 +237,175 @@ void Consumer::execute()
     std::deque<KeyOpFieldsValuesTuple> entries;
     getConsumerTable()->pops(entries);
 
-    addToSync(entries);
+    m_popped += entries.size();
+    addToSync(std::move(entries));
 
-    drain();
+    if (!m_parked)
+    {
+        process();
+    }
 }
 
 void Consumer::drain()
 {
-    if (!m_toSync.empty())
-        m_orch->doTask(*this);
+    if (m_toSync.empty())
+        return;
+
+    if (m_parked && std::chrono::steady_clock::now() - m_parkTime < RETRY_PARK_TIMEOUT)
+    {
+        m_retrySkipped++;
+        return;
+    }
+
+    m_retryAttempts++;
+    m_retried += m_toSync.size();
+    process();
+}
+
+void Consumer::process()
+{
+    if (m_toSync.empty())
+        return;
+
+    m_woken = false;
+    m_parkedKeys.clear();
+
+    size_t pending = m_toSync.size();
+    m_maxPending = std::max(m_maxPending, pending);
+
+    auto start = std::chrono::steady_clock::now();
+    m_orch->doTask(*this);
+    auto elapsed = std::chrono::steady_clock::now() - start;
+
+    m_doTaskCalls++;
+    m_doTaskTime += elapsed;
+    m_doTaskLatency.add(elapsed);
+    if (m_toSync.size() < pending)
+    {
+        m_processed += pending - m_toSync.size();
+    }
+
+    updateParked();
+}
+
+void Consumer::updateParked()
+{
+    m_parked = false;
+
+    /* Stop waiting for the constraints of the tasks that are done or erased */
+    auto wait = m_retryWaits.begin();
+    while (wait != m_retryWaits.end())
+    {
+        auto &keys = wait->second;
+        for (auto key = keys.begin(); key != keys.end();)
+        {
+            key = (m_toSync.find(*key) == m_toSync.end()) ? keys.erase(key) : std::next(key);
+        }
+
+        if (keys.empty())
+        {
+            Orch::removeRetryWaiter(wait->first, this);
+            wait = m_retryWaits.erase(wait);
+        }
+        else
+        {
+            wait++;
+        }
+    }
+
+    /* A constraint resolved while processing, the parked tasks may progress now */
+    if (m_woken || m_parkedKeys.empty() || m_toSync.empty())
+    {
+        m_parkedKeys.clear();
+        return;
+    }
+
+    /* Park only if every pending task waits for a constraint */
+    size_t parked = 0;
+    for (const auto &key : m_parkedKeys)
+    {
+        if (m_toSync.find(key) != m_toSync.end())
+        {
+            parked++;
+        }
+    }
+
+    if (parked == m_toSync.keyCount())
+    {
+        m_parked = true;
+        m_parkTime = std::chrono::steady_clock::now();
+    }
+}
+
+void Consumer::parkUntil(const string &key, const RetryConstraint &constraint)
+{
+    m_parkedKeys.insert(key);
+    m_retryWaits[constraint].insert(key);
+    Orch::addRetryWaiter(constraint, this);
+}
+
+void Consumer::wakeUp()
+{
+    m_woken = true;
+
+    if (m_parked)
+    {
+        m_parked = false;
+        m_retryWakeups++;
+    }
+}
+
+void Consumer::dumpStats(vector<FieldValueTuple> &fvs) const
+{
+    fvs.emplace_back("pending", to_string(m_toSync.size()));
+    fvs.emplace_back("parked", m_parked ? "true" : "false");
+    fvs.emplace_back("retry_attempts", to_string(m_retryAttempts));
+    fvs.emplace_back("retry_skipped", to_string(m_retrySkipped));
+    fvs.emplace_back("retry_wakeups", to_string(m_retryWakeups));
+    fvs.emplace_back("max_pending", to_string(m_maxPending));
+    fvs.emplace_back("popped", to_string(m_popped));
+    fvs.emplace_back("processed", to_string(m_processed));
+    fvs.emplace_back("retried", to_string(m_retried));
+    fvs.emplace_back("dotask_calls", to_string(m_doTaskCalls));
+    fvs.emplace_back("dotask_time_us", to_string(std::chrono::duration_cast<std::chrono::microseconds>(m_doTaskTime).count()));
+    fvs.emplace_back("dotask_p50_us", to_string(m_doTaskLatency.percentile(50)));
+    fvs.emplace_back("dotask_p99_us", to_string(m_doTaskLatency.percentile(99)));
+}
+
+void LatencyHistogram::add(std::chrono::nanoseconds duration)
+{
+    auto us = std::chrono::duration_cast<std::chrono::microseconds>(duration).count();
+
+    /* Bucket i holds durations below 2^i us */
+    size_t bucket = 0;
+    if (us > 0)
+    {
+        bucket = std::min(m_buckets.size() - 1, (size_t)(64 - __builtin_clzll((unsigned long long)us)));
+    }
+
+    m_buckets[bucket]++;
+    m_count++;
+}
+
+uint64_t LatencyHistogram::percentile(unsigned int pct) const
+{
+    if (m_count == 0)
+    {
+        return 0;
+    }
+
+    uint64_t rank = (m_count * pct + 99) / 100;
+    uint64_t seen = 0;
+    for (size_t i = 0; i < m_buckets.size(); i++)
+    {
+        seen += m_buckets[i];
+        if (seen >= rank)
+        {
+            return 1ULL << i;
+        }
+    }
+
+    return 1ULL << (m_buckets.size() - 1);
 }
 
 string Consumer::dumpTuple(const KeyOpFieldsValuesTuple &tuple)
@@ -511,6 +690,72 @@ void Orch::doTask()
     }
 }
 
+void Orch::notifyRetryEvent(retry_event_t event, const string &object)
+{
+    std::lock_guard<std::mutex> lock(retryWaitersMutex);
+
+    auto it = retryWaiters.find(make_pair(event, object));
+    if (it == retryWaiters.end())
+    {
+        return;
+    }
+
+    for (auto consumer : it->second)
+    {
+        consumer->wakeUp();
+    }
+
+    retryWaiters.erase(it);
+}
+
+void Orch::addRetryWaiter(const RetryConstraint &constraint, Consumer *consumer)
+{
+    std::lock_guard<std::mutex> lock(retryWaitersMutex);
+
+    retryWaiters[constraint].insert(consumer);
+}
+
+void Orch::removeRetryWaiter(const RetryConstraint &constraint, Consumer *consumer)
+{
+    std::lock_guard<std::mutex> lock(retryWaitersMutex);
+
+    auto it = retryWaiters.find(constraint);
+    if (it == retryWaiters.end())
+    {
+        return;
+    }
+
+    it->second.erase(consumer);
+    if (it->second.empty())
+    {
+        retryWaiters.erase(it);
+    }
+}
+
+size_t Orch::getRetryWaiterCount(const RetryConstraint &constraint)
+{
+    std::lock_guard<std::mutex> lock(retryWaitersMutex);
+
+    auto it = retryWaiters.find(constraint);
+    return it == retryWaiters.end() ? 0 : it->second.size();
+}
+
+void Orch::dumpConsumerStats(vector<KeyOpFieldsValuesTuple> &stats)
+{
+    for (auto &it : m_consumerMap)
+    {
+        Consumer* consumer = dynamic_cast<Consumer *>(it.second.get());
+        if (consumer == NULL)
+        {
+            continue;
+        }
+
+        vector<FieldValueTuple> fvs;
+        consumer->dumpStats(fvs);
+        stats.emplace_back(consumer->getDbName() + ":" + consumer->getTableName(), SET_COMMAND, fvs);
+    }
+}
+
 void Orch::dumpPendingTasks(vector<string> &ts)
 {
     for (auto &it : m_consumerMap)
@@ -547,8 +792,13 @@ void Orch::logfileReopen()
 
 void Orch::recordTuple(Consumer &consumer, const KeyOpFieldsValuesTuple &tuple)
 {
+    /* Consumers of offloaded orchs record from their worker threads */
+    static std::mutex recordMutex;
+
     string s = consumer.dumpTuple(tuple);
 
+    std::lock_guard<std::mutex> lock(recordMutex);
+
     gRecordOfs << getTimestamp() << "|" << s << endl;
 
     if (gLogRotate)
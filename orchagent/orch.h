@@ -1,6 +1,8 @@
 #ifndef SWSS_ORCH_H
 #define SWSS_ORCH_H
 
+#include <array>
+#include <chrono>
 #include <unordered_map>
 #include <unordered_set>
 #include <map>
@@ -20,6 +22,7 @@ extern "C" {
 #include "notificationconsumer.h"
 #include "selectabletimer.h"
 #include "macaddress.h"
+#include "syncmap.h"
 
 const char delimiter           = ':';
 const char list_item_delimiter = ',';
@@ -71,15 +74,39 @@ typedef std::map<std::string, object_reference_map*> type_map;
 typedef std::map<std::string, sai_object_id_t> object_map;
 typedef std::pair<std::string, sai_object_id_t> object_map_pair;
 
-// Use multimap to support multiple OpFieldsValues for the same key (e,g, DEL and SET)
-// The order of the key-value pairs whose keys compare equivalent is the order of
-// insertion and does not change. (since C++11)
-typedef std::multimap<std::string, swss::KeyOpFieldsValuesTuple> SyncMap;
-
 typedef std::pair<std::string, int> table_name_with_pri_t;
 
+/* Object events which may allow a pending task to make progress */
+typedef enum
+{
+    RETRY_EVENT_NEXTHOP_ADDED,
+    RETRY_EVENT_VRF_ADDED,
+    RETRY_EVENT_RIF_ADDED
+} retry_event_t;
+
+/* Event type and the name of the object a pending task is waiting for */
+typedef std::pair<retry_event_t, std::string> RetryConstraint;
+
 class Orch;
 
+/*
+ * Histogram of durations with power of two microsecond buckets, cheap enough
+ * to be updated on every doTask() call. Percentiles are reported as the upper
+ * bound of the bucket they fall in.
+ */
+class LatencyHistogram
+{
+public:
+    void add(std::chrono::nanoseconds duration);
+    uint64_t count() const { return m_count; }
+    /* Percentile in microseconds, 0 if nothing was recorded */
+    uint64_t percentile(unsigned int pct) const;
+
+private:
+    std::array<uint64_t, 32> m_buckets {};
+    uint64_t m_count = 0;
+};
+
 // Design assumption
 // 1. one Orch can have one or more Executor
 // 2. one Executor must belong to one and only one Orch
@@ -134,6 +161,8 @@ public:
     {
     }
 
+    ~Consumer();
+
     swss::ConsumerTableBase *getConsumerTable() const
     {
         return static_cast<swss::ConsumerTableBase *>(getSelectable());
@@ -167,9 +196,54 @@ public:
     SyncMap m_toSync;
 
     void addToSync(const swss::KeyOpFieldsValuesTuple &entry);
+    void addToSync(swss::KeyOpFieldsValuesTuple &&entry);
 
     // Returns: the number of entries added to m_toSync
     size_t addToSync(const std::deque<swss::KeyOpFieldsValuesTuple> &entries);
+    size_t addToSync(std::deque<swss::KeyOpFieldsValuesTuple> &&entries);
+
+    /*
+     * Declare that the pending task of the key can only make progress after
+     * the constraint is resolved, see Orch::notifyRetryEvent(). When all the
+     * pending tasks of the consumer are parked, the consumer is not re-driven
+     * by the retry loop until new data arrives, one of the constraints is
+     * resolved, or RETRY_PARK_TIMEOUT has passed.
+     * Should be called from doTask(Consumer&) while the task is left in m_toSync.
+     */
+    void parkUntil(const std::string &key, const RetryConstraint &constraint);
+    void wakeUp();
+    bool isParked() const { return m_parked; }
+
+    /* Drains run by the retry loop, skipped because the consumer was parked, and wakeups by resolved constraints */
+    uint64_t m_retryAttempts = 0;
+    uint64_t m_retrySkipped = 0;
+    uint64_t m_retryWakeups = 0;
+
+    /*
+     * Entries popped from the table, removed from m_toSync by doTask(), and
+     * presented again by the retry loop, doTask() calls and time spent in them
+     */
+    uint64_t m_popped = 0;
+    uint64_t m_processed = 0;
+    uint64_t m_retried = 0;
+    uint64_t m_doTaskCalls = 0;
+    std::chrono::nanoseconds m_doTaskTime {0};
+    LatencyHistogram m_doTaskLatency;
+    size_t m_maxPending = 0;
+
+    void dumpStats(std::vector<swss::FieldValueTuple> &fvs) const;
+
+private:
+    void process();
+    void updateParked();
+
+    bool m_parked = false;
+    bool m_woken = false;
+    std::chrono::steady_clock::time_point m_parkTime;
+    std::unordered_set<std::string> m_parkedKeys;
+
+    /* Constraints waited for, with the keys of the pending tasks waiting for each */
+    std::map<RetryConstraint, std::unordered_set<std::string>> m_retryWaits;
 };
 
 typedef std::map<std::string, std::shared_ptr<Executor>> ConsumerMap;
@@ -217,7 +291,16 @@ public:
     /* TODO: refactor recording */
     static void recordTuple(Consumer &consumer, const swss::KeyOpFieldsValuesTuple &tuple);
 
+    /* Wake up the consumers with pending tasks parked on the constraint */
+    static void notifyRetryEvent(retry_event_t event, const std::string &object);
+    static void addRetryWaiter(const RetryConstraint &constraint, Consumer *consumer);
+    static void removeRetryWaiter(const RetryConstraint &constraint, Consumer *consumer);
+    static size_t getRetryWaiterCount(const RetryConstraint &constraint);
+
     void dumpPendingTasks(std::vector<std::string> &ts);
+
+    /* Key is <db name>:<table name> of each consumer */
+    void dumpConsumerStats(std::vector<swss::KeyOpFieldsValuesTuple> &stats);
 protected:
     ConsumerMap m_consumerMap;
 
@@ -16,10 +16,14 @@ using namespace swss;
 /* select() function timeout retry time */
 #define SELECT_TIMEOUT 1000
 #define PFC_WD_POLL_MSECS 100
+/* Consumer counters publish interval */
+#define CONSUMER_STATS_INTERVAL std::chrono::seconds(10)
+#define STATE_ORCH_CONSUMER_TABLE_NAME "ORCH_CONSUMER_TABLE"
 
 extern sai_switch_api_t*           sai_switch_api;
 extern sai_object_id_t             gSwitchId;
 extern bool                        gSaiRedisLogRotate;
+extern bool                        gConsumerStatsDump;
 
 extern void syncd_apply_view();
 /*
@@ -41,12 +45,14 @@ NatOrch *gNatOrch;
 MACsecOrch *gMacsecOrch;
 
 bool gIsNatSupported = false;
+bool gOrchWorkerThreads = false;
 
 OrchDaemon::OrchDaemon(DBConnector *applDb, DBConnector *configDb, DBConnector *stateDb, DBConnector *chassisAppDb) :
         m_applDb(applDb),
         m_configDb(configDb),
         m_stateDb(stateDb),
-        m_chassisAppDb(chassisAppDb)
+        m_chassisAppDb(chassisAppDb),
+        m_consumerStatsTable(new Table(stateDb, STATE_ORCH_CONSUMER_TABLE_NAME))
 {
     SWSS_LOG_ENTER();
 }
@@ -103,8 +109,8 @@ bool OrchDaemon::init()
 
     gCrmOrch = new CrmOrch(m_configDb, CFG_CRM_TABLE_NAME);
     gPortsOrch = new PortsOrch(m_applDb, ports_tables, m_chassisAppDb);
-    TableConnector stateDbFdb(m_stateDb, STATE_FDB_TABLE_NAME);
-    gFdbOrch = new FdbOrch(m_applDb, app_fdb_tables, stateDbFdb, gPortsOrch);
+    TableConnector stateDbFdb(getWorkerDb(m_stateDb), STATE_FDB_TABLE_NAME);
+    gFdbOrch = new FdbOrch(getWorkerDb(m_applDb), app_fdb_tables, stateDbFdb, gPortsOrch);
 
     vector<string> vnet_tables = {
             APP_VNET_RT_TABLE_NAME,
@@ -146,7 +152,7 @@ bool OrchDaemon::init()
 
     gFgNhgOrch = new FgNhgOrch(m_configDb, m_applDb, m_stateDb, fgnhg_tables, gNeighOrch, gIntfsOrch, vrf_orch);
     gDirectory.set(gFgNhgOrch);
-    gRouteOrch = new RouteOrch(m_applDb, APP_ROUTE_TABLE_NAME, gSwitchOrch, gNeighOrch, gIntfsOrch, vrf_orch, gFgNhgOrch);
+    gRouteOrch = new RouteOrch(getWorkerDb(m_applDb), APP_ROUTE_TABLE_NAME, gSwitchOrch, gNeighOrch, gIntfsOrch, vrf_orch, gFgNhgOrch);
 
     CoppOrch  *copp_orch  = new CoppOrch(m_applDb, APP_COPP_TABLE_NAME);
     TunnelDecapOrch *tunnel_decap_orch = new TunnelDecapOrch(m_applDb, APP_TUNNEL_DECAP_TABLE_NAME);
@@ -195,10 +201,12 @@ bool OrchDaemon::init()
     TableConnector confDbMirrorSession(m_configDb, CFG_MIRROR_SESSION_TABLE_NAME);
     gMirrorOrch = new MirrorOrch(stateDbMirrorSession, confDbMirrorSession, gPortsOrch, gRouteOrch, gNeighOrch, gFdbOrch, policer_orch);
 
-    TableConnector confDbAclTable(m_configDb, CFG_ACL_TABLE_TABLE_NAME);
-    TableConnector confDbAclRuleTable(m_configDb, CFG_ACL_RULE_TABLE_NAME);
-    TableConnector appDbAclTable(m_applDb, APP_ACL_TABLE_TABLE_NAME);
-    TableConnector appDbAclRuleTable(m_applDb, APP_ACL_RULE_TABLE_NAME);
+    DBConnector *aclConfigDb = getWorkerDb(m_configDb);
+    DBConnector *aclApplDb = getWorkerDb(m_applDb);
+    TableConnector confDbAclTable(aclConfigDb, CFG_ACL_TABLE_TABLE_NAME);
+    TableConnector confDbAclRuleTable(aclConfigDb, CFG_ACL_RULE_TABLE_NAME);
+    TableConnector appDbAclTable(aclApplDb, APP_ACL_TABLE_TABLE_NAME);
+    TableConnector appDbAclRuleTable(aclApplDb, APP_ACL_RULE_TABLE_NAME);
 
     vector<TableConnector> acl_table_connectors = {
         confDbAclTable,
@@ -220,7 +228,7 @@ bool OrchDaemon::init()
         CFG_FLEX_COUNTER_TABLE_NAME
     };
 
-    WatermarkOrch *wm_orch = new WatermarkOrch(m_configDb, wm_tables);
+    WatermarkOrch *wm_orch = new WatermarkOrch(getWorkerDb(m_configDb), wm_tables);
 
     vector<string> sflow_tables = {
             APP_SFLOW_TABLE_NAME,
@@ -313,6 +321,7 @@ bool OrchDaemon::init()
         m_orchList.push_back(dtel_orch);
     }
     gAclOrch = new AclOrch(acl_table_connectors, gSwitchOrch, gPortsOrch, gMirrorOrch, gNeighOrch, gRouteOrch, dtel_orch);
+    gAclOrch->startCountersThread();
 
     m_orchList.push_back(gFdbOrch);
     m_orchList.push_back(gMirrorOrch);
@@ -345,6 +354,9 @@ bool OrchDaemon::init()
         CFG_PFC_WD_TABLE_NAME
     };
 
+    DBConnector *pfcwd_db = getWorkerDb(m_configDb);
+    Orch *pfcwd_orch = nullptr;
+
     if (platform == MLNX_PLATFORM_SUBSTRING)
     {
 
@@ -376,13 +388,14 @@ bool OrchDaemon::init()
 
         static const vector<sai_queue_attr_t> queueAttrIds;
 
-        m_orchList.push_back(new PfcWdSwOrch<PfcWdZeroBufferHandler, PfcWdLossyHandler>(
-                    m_configDb,
+        pfcwd_orch = new PfcWdSwOrch<PfcWdZeroBufferHandler, PfcWdLossyHandler>(
+                    pfcwd_db,
                     pfc_wd_tables,
                     portStatIds,
                     queueStatIds,
                     queueAttrIds,
-                    PFC_WD_POLL_MSECS));
+                    PFC_WD_POLL_MSECS);
+        m_orchList.push_back(pfcwd_orch);
     }
     else if ((platform == INVM_PLATFORM_SUBSTRING)
              || (platform == BFN_PLATFORM_SUBSTRING)
@@ -419,23 +432,25 @@ bool OrchDaemon::init()
 
         if ((platform == INVM_PLATFORM_SUBSTRING) || (platform == NPS_PLATFORM_SUBSTRING))
         {
-            m_orchList.push_back(new PfcWdSwOrch<PfcWdZeroBufferHandler, PfcWdLossyHandler>(
-                        m_configDb,
+            pfcwd_orch = new PfcWdSwOrch<PfcWdZeroBufferHandler, PfcWdLossyHandler>(
+                        pfcwd_db,
                         pfc_wd_tables,
                         portStatIds,
                         queueStatIds,
                         queueAttrIds,
-                        PFC_WD_POLL_MSECS));
+                        PFC_WD_POLL_MSECS);
+            m_orchList.push_back(pfcwd_orch);
         }
         else if (platform == BFN_PLATFORM_SUBSTRING)
         {
-            m_orchList.push_back(new PfcWdSwOrch<PfcWdAclHandler, PfcWdLossyHandler>(
-                        m_configDb,
+            pfcwd_orch = new PfcWdSwOrch<PfcWdAclHandler, PfcWdLossyHandler>(
+                        pfcwd_db,
                         pfc_wd_tables,
                         portStatIds,
                         queueStatIds,
                         queueAttrIds,
-                        PFC_WD_POLL_MSECS));
+                        PFC_WD_POLL_MSECS);
+            m_orchList.push_back(pfcwd_orch);
         }
     }
     else if (platform == BRCM_PLATFORM_SUBSTRING)
@@ -471,17 +486,24 @@ bool OrchDaemon::init()
             SAI_QUEUE_ATTR_PAUSE_STATUS,
         };
 
-        m_orchList.push_back(new PfcWdSwOrch<PfcWdAclHandler, PfcWdLossyHandler>(
-                    m_configDb,
+        pfcwd_orch = new PfcWdSwOrch<PfcWdAclHandler, PfcWdLossyHandler>(
+                    pfcwd_db,
                     pfc_wd_tables,
                     portStatIds,
                     queueStatIds,
                     queueAttrIds,
-                    PFC_WD_POLL_MSECS));
+                    PFC_WD_POLL_MSECS);
+        m_orchList.push_back(pfcwd_orch);
     }
 
     m_orchList.push_back(&CounterCheckOrch::getInstance(m_configDb));
 
+    if (gOrchWorkerThreads)
+    {
+        initScheduler(wm_orch, pfcwd_orch);
+        gCrmOrch->startPollThread();
+    }
+
     if (WarmStart::isWarmStart())
     {
         bool suc = warmRestoreAndSyncUp();
@@ -494,6 +516,96 @@ bool OrchDaemon::init()
     return true;
 }
 
+/*
+ * Orchs running on a worker thread must not share a redis connection with
+ * orchs running on other threads, give them a dedicated one.
+ */
+DBConnector *OrchDaemon::getWorkerDb(DBConnector *db)
+{
+    if (!gOrchWorkerThreads)
+    {
+        return db;
+    }
+
+    m_workerDbs.emplace_back(db->newConnector(0));
+    return m_workerDbs.back().get();
+}
+
+/*
+ * Declare which orchs are used by the orchs running on worker threads.
+ * Observers notified by an orch are dependencies as well, since they
+ * are called from the thread of the notifying orch.
+ */
+void OrchDaemon::initScheduler(Orch *wm_orch, Orch *pfcwd_orch)
+{
+    SWSS_LOG_ENTER();
+
+    m_scheduler = unique_ptr<OrchScheduler>(new OrchScheduler(m_orchList));
+
+    Orch *vrf_orch = gDirectory.get<VRFOrch*>();
+    Orch *vxlan_tunnel_orch = gDirectory.get<VxlanTunnelOrch*>();
+    Orch *evpn_nvo_orch = gDirectory.get<EvpnNvoOrch*>();
+    Orch *mux_orch = gDirectory.get<MuxOrch*>();
+    Orch *dtel_orch = nullptr;
+    for (Orch *o : m_orchList)
+    {
+        if (dynamic_cast<DTelOrch *>(o))
+        {
+            dtel_orch = o;
+        }
+    }
+
+    /* RouteOrch */
+    m_scheduler->addDependency(gRouteOrch, gNeighOrch);
+    m_scheduler->addDependency(gRouteOrch, gIntfsOrch);
+    m_scheduler->addDependency(gRouteOrch, vrf_orch);
+    m_scheduler->addDependency(gRouteOrch, gFgNhgOrch);
+    m_scheduler->addDependency(gRouteOrch, gSwitchOrch);
+    m_scheduler->addDependency(gRouteOrch, gCrmOrch);
+    m_scheduler->addDependency(gRouteOrch, gMirrorOrch);
+    m_scheduler->addDependency(gRouteOrch, gNatOrch);
+    m_scheduler->addDependency(gRouteOrch, gPortsOrch, true);
+    m_scheduler->addDependency(gRouteOrch, vxlan_tunnel_orch, true);
+    m_scheduler->addDependency(gRouteOrch, evpn_nvo_orch, true);
+
+    /* FdbOrch */
+    m_scheduler->addDependency(gFdbOrch, gPortsOrch);
+    m_scheduler->addDependency(gFdbOrch, gCrmOrch);
+    m_scheduler->addDependency(gFdbOrch, gNeighOrch);
+    m_scheduler->addDependency(gFdbOrch, gMirrorOrch);
+    m_scheduler->addDependency(gFdbOrch, mux_orch);
+    m_scheduler->addDependency(gFdbOrch, vxlan_tunnel_orch, true);
+
+    /* AclOrch */
+    m_scheduler->addDependency(gAclOrch, gPortsOrch);
+    m_scheduler->addDependency(gAclOrch, gCrmOrch);
+    m_scheduler->addDependency(gAclOrch, gMirrorOrch);
+    m_scheduler->addDependency(gAclOrch, gSwitchOrch);
+    m_scheduler->addDependency(gAclOrch, gNeighOrch, true);
+    m_scheduler->addDependency(gAclOrch, gRouteOrch, true);
+    if (dtel_orch)
+    {
+        m_scheduler->addDependency(gAclOrch, dtel_orch);
+    }
+
+    /* WatermarkOrch */
+    m_scheduler->addDependency(wm_orch, gPortsOrch, true);
+    m_scheduler->addDependency(wm_orch, gBufferOrch, true);
+
+    m_scheduler->offload(gRouteOrch, "RouteOrch");
+    m_scheduler->offload(gFdbOrch, "FdbOrch");
+    m_scheduler->offload(gAclOrch, "AclOrch");
+    m_scheduler->offload(wm_orch, "WatermarkOrch");
+
+    /* PfcWdOrch, the storm handlers program ACLs and port PFC */
+    if (pfcwd_orch)
+    {
+        m_scheduler->addDependency(pfcwd_orch, gPortsOrch);
+        m_scheduler->addDependency(pfcwd_orch, gAclOrch);
+        m_scheduler->offload(pfcwd_orch, "PfcWdOrch");
+    }
+}
+
 /* Flush redis through sairedis interface */
 void OrchDaemon::flush()
 {
@@ -508,6 +620,8 @@ void OrchDaemon::flush()
         exit(EXIT_FAILURE);
     }
 
+    BatchedDbWriter::flushAll();
+
     // check if logroate is requested
     if (gSaiRedisLogRotate)
     {
@@ -522,15 +636,69 @@ void OrchDaemon::flush()
     }
 }
 
+void OrchDaemon::publishConsumerStats()
+{
+    SWSS_LOG_ENTER();
+
+    /* SIGUSR1 asks for the counters to be published and logged right away */
+    bool dump = gConsumerStatsDump;
+
+    auto now = chrono::steady_clock::now();
+    if (!dump && now - m_lastConsumerStats < CONSUMER_STATS_INTERVAL)
+    {
+        return;
+    }
+    m_lastConsumerStats = now;
+    gConsumerStatsDump = false;
+
+    unique_ptr<OrchScheduler::LockGuard> guard;
+    if (m_scheduler)
+    {
+        guard.reset(new OrchScheduler::LockGuard(m_scheduler->lockAll()));
+    }
+
+    vector<KeyOpFieldsValuesTuple> stats;
+    for (Orch *o : m_orchList)
+    {
+        o->dumpConsumerStats(stats);
+    }
+    BatchedDbWriter::dumpAllStats(stats);
+
+    for (const auto &entry : stats)
+    {
+        m_consumerStatsTable->set(kfvKey(entry), kfvFieldsValues(entry));
+
+        if (dump)
+        {
+            string counters;
+            for (const auto &fv : kfvFieldsValues(entry))
+            {
+                counters += " " + fvField(fv) + ":" + fvValue(fv);
+            }
+            SWSS_LOG_NOTICE("%s%s", kfvKey(entry).c_str(), counters.c_str());
+        }
+    }
+}
+
 void OrchDaemon::start()
 {
     SWSS_LOG_ENTER();
 
     for (Orch *o : m_orchList)
     {
+        if (m_scheduler && m_scheduler->isOffloaded(o))
+        {
+            continue;
+        }
+
         m_select->addSelectables(o->getSelectables());
     }
 
+    if (m_scheduler)
+    {
+        m_scheduler->start();
+    }
+
     while (true)
     {
         Selectable *s;
@@ -544,6 +712,8 @@ void OrchDaemon::start()
             continue;
         }
 
+        publishConsumerStats();
+
         if (ret == Select::TIMEOUT)
         {
             /* Let sairedis to flush all SAI function call to ASIC DB.
@@ -555,6 +725,16 @@ void OrchDaemon::start()
             continue;
         }
 
+        /*
+         * Orchs on the main thread have no declared dependencies, hold all
+         * locks while they run so that no worker thread runs concurrently.
+         */
+        unique_ptr<OrchScheduler::LockGuard> guard;
+        if (m_scheduler)
+        {
+            guard.reset(new OrchScheduler::LockGuard(m_scheduler->lockAll()));
+        }
+
         auto *c = (Executor *)s;
         c->execute();
 
@@ -563,7 +743,17 @@ void OrchDaemon::start()
 
         /* TODO: Abstract Orch class to have a specific todo list */
         for (Orch *o : m_orchList)
+        {
+            if (m_scheduler && m_scheduler->isOffloaded(o))
+            {
+                continue;
+            }
+
             o->doTask();
+        }
+
+        /* Send the batched DB writes of this iteration */
+        BatchedDbWriter::flushAll();
 
         /*
          * Asked to check warm restart readiness.
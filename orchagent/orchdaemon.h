@@ -33,6 +33,8 @@
 #include "natorch.h"
 #include "muxorch.h"
 #include "macsecorch.h"
+#include "orchscheduler.h"
+#include "batcheddbwriter.h"
 
 using namespace swss;
 
@@ -58,6 +60,19 @@ private:
     std::vector<Orch *> m_orchList;
     Select *m_select;
 
+    /* Only used when orchs run on worker threads */
+    std::unique_ptr<OrchScheduler> m_scheduler;
+    std::vector<std::unique_ptr<DBConnector>> m_workerDbs;
+
+    DBConnector *getWorkerDb(DBConnector *db);
+    void initScheduler(Orch *wm_orch, Orch *pfcwd_orch);
+
+    /* Per consumer queue, retry and latency counters, see Consumer::dumpStats(), and DB writer counters */
+    std::unique_ptr<Table> m_consumerStatsTable;
+    std::chrono::steady_clock::time_point m_lastConsumerStats;
+
+    void publishConsumerStats();
+
     void flush();
 };
 
@@ -0,0 +1,276 @@
+#include <errno.h>
+#include <string.h>
+#include "orchscheduler.h"
+#include "batcheddbwriter.h"
+#include "select.h"
+#include "logger.h"
+
+using namespace std;
+using namespace swss;
+
+/* select() function timeout retry time */
+#define WORKER_SELECT_TIMEOUT 1000
+
+OrchScheduler::LockGuard::LockGuard(OrchScheduler *scheduler, const map<size_t, bool> &lockSet) :
+    m_scheduler(scheduler),
+    m_lockSet(lockSet)
+{
+    lock_guard<mutex> gate(m_scheduler->m_gate);
+
+    /* std::map iterates in index order, which is the global lock order */
+    for (const auto &it : m_lockSet)
+    {
+        if (it.second)
+        {
+            m_scheduler->m_locks[it.first]->lock();
+        }
+        else
+        {
+            m_scheduler->m_locks[it.first]->lock_shared();
+        }
+    }
+}
+
+OrchScheduler::LockGuard::LockGuard(LockGuard &&other) :
+    m_scheduler(other.m_scheduler),
+    m_lockSet(move(other.m_lockSet))
+{
+    other.m_lockSet.clear();
+}
+
+OrchScheduler::LockGuard::~LockGuard()
+{
+    for (auto it = m_lockSet.rbegin(); it != m_lockSet.rend(); ++it)
+    {
+        if (it->second)
+        {
+            m_scheduler->m_locks[it->first]->unlock();
+        }
+        else
+        {
+            m_scheduler->m_locks[it->first]->unlock_shared();
+        }
+    }
+}
+
+OrchScheduler::OrchScheduler(const vector<Orch *> &orchs) :
+    m_running(false)
+{
+    SWSS_LOG_ENTER();
+
+    for (Orch *orch : orchs)
+    {
+        if (m_orchIndex.find(orch) != m_orchIndex.end())
+        {
+            continue;
+        }
+
+        m_orchIndex[orch] = m_orchs.size();
+        m_orchs.push_back(orch);
+        m_locks.emplace_back(new shared_timed_mutex());
+    }
+}
+
+OrchScheduler::~OrchScheduler()
+{
+    stop();
+}
+
+void OrchScheduler::addDependency(Orch *orch, Orch *dependency, bool readOnly)
+{
+    SWSS_LOG_ENTER();
+
+    auto orchIt = m_orchIndex.find(orch);
+    auto depIt = m_orchIndex.find(dependency);
+    if (orchIt == m_orchIndex.end() || depIt == m_orchIndex.end())
+    {
+        SWSS_LOG_ERROR("Failed to add dependency, orch is not scheduled");
+        return;
+    }
+
+    auto &lockSet = m_lockSets[orch];
+    lockSet[orchIt->second] = true;
+
+    /* An exclusive dependency is never downgraded by a read-only declaration */
+    auto found = lockSet.find(depIt->second);
+    if (found == lockSet.end())
+    {
+        lockSet[depIt->second] = !readOnly;
+    }
+    else
+    {
+        found->second = found->second || !readOnly;
+    }
+}
+
+bool OrchScheduler::offload(Orch *orch, const string &name)
+{
+    SWSS_LOG_ENTER();
+
+    if (m_running)
+    {
+        SWSS_LOG_ERROR("Failed to offload %s, scheduler is already running", name.c_str());
+        return false;
+    }
+
+    if (m_lockSets.find(orch) == m_lockSets.end())
+    {
+        SWSS_LOG_WARN("Not offloading %s, it has no declared dependencies", name.c_str());
+        return false;
+    }
+
+    if (isOffloaded(orch))
+    {
+        return true;
+    }
+
+    unique_ptr<Worker> worker(new Worker());
+    worker->orch = orch;
+    worker->name = name;
+    m_workers.push_back(move(worker));
+
+    SWSS_LOG_NOTICE("Offload %s to a worker thread", name.c_str());
+    return true;
+}
+
+bool OrchScheduler::isOffloaded(Orch *orch) const
+{
+    for (const auto &worker : m_workers)
+    {
+        if (worker->orch == orch)
+        {
+            return true;
+        }
+    }
+
+    return false;
+}
+
+map<size_t, bool> OrchScheduler::getLockSet(Orch *orch) const
+{
+    auto found = m_lockSets.find(orch);
+    if (found != m_lockSets.end())
+    {
+        return found->second;
+    }
+
+    map<size_t, bool> lockSet;
+    for (size_t i = 0; i < m_locks.size(); i++)
+    {
+        lockSet[i] = true;
+    }
+
+    return lockSet;
+}
+
+bool OrchScheduler::isConflicting(Orch *orch1, Orch *orch2) const
+{
+    auto lockSet1 = getLockSet(orch1);
+    auto lockSet2 = getLockSet(orch2);
+
+    for (const auto &it : lockSet1)
+    {
+        auto found = lockSet2.find(it.first);
+        if (found != lockSet2.end() && (it.second || found->second))
+        {
+            return true;
+        }
+    }
+
+    return false;
+}
+
+OrchScheduler::LockGuard OrchScheduler::lock(Orch *orch)
+{
+    return LockGuard(this, getLockSet(orch));
+}
+
+OrchScheduler::LockGuard OrchScheduler::lockAll()
+{
+    return LockGuard(this, getLockSet(nullptr));
+}
+
+void OrchScheduler::start()
+{
+    SWSS_LOG_ENTER();
+
+    if (m_running)
+    {
+        return;
+    }
+
+    m_running = true;
+
+    for (auto &worker : m_workers)
+    {
+        worker->thread = thread(&OrchScheduler::runWorker, this, worker.get());
+    }
+}
+
+void OrchScheduler::stop()
+{
+    SWSS_LOG_ENTER();
+
+    if (!m_running)
+    {
+        return;
+    }
+
+    m_running = false;
+
+    for (auto &worker : m_workers)
+    {
+        if (worker->thread.joinable())
+        {
+            worker->thread.join();
+        }
+    }
+}
+
+void OrchScheduler::runWorker(Worker *worker)
+{
+    SWSS_LOG_ENTER();
+
+    SWSS_LOG_NOTICE("Worker thread for %s started", worker->name.c_str());
+
+    /*
+     * Selectables read their data through their own subscription
+     * connection, so waiting for events does not need any lock.
+     */
+    Select select;
+    select.addSelectables(worker->orch->getSelectables());
+
+    while (m_running)
+    {
+        Selectable *s;
+        int ret;
+
+        ret = select.select(&s, WORKER_SELECT_TIMEOUT);
+
+        if (ret == Select::ERROR)
+        {
+            SWSS_LOG_NOTICE("%s worker error: %s!", worker->name.c_str(), strerror(errno));
+            continue;
+        }
+
+        auto guard = lock(worker->orch);
+
+        /*
+         * Tasks of this orch may wait for state of orchs running on other
+         * threads, retry them when idle as the main loop retries its orchs
+         * after every event.
+         */
+        if (ret != Select::TIMEOUT)
+        {
+            auto *c = (Executor *)s;
+            c->execute();
+        }
+
+        /* Retry the remaining tasks of this orch only */
+        worker->orch->doTask();
+
+        BatchedDbWriter::flushAll();
+    }
+
+    SWSS_LOG_NOTICE("Worker thread for %s stopped", worker->name.c_str());
+}
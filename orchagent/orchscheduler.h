@@ -0,0 +1,98 @@
+#ifndef SWSS_ORCHSCHEDULER_H
+#define SWSS_ORCHSCHEDULER_H
+
+#include <atomic>
+#include <map>
+#include <memory>
+#include <mutex>
+#include <shared_mutex>
+#include <string>
+#include <thread>
+#include <vector>
+
+#include "orch.h"
+
+/*
+ * OrchScheduler runs selected orchs on their own worker thread.
+ *
+ * Every orch owns a reader/writer lock. Before an orch executes a task it
+ * takes its own lock exclusively and the locks of the orchs it depends on,
+ * shared for read-only dependencies and exclusively otherwise. Locks are
+ * always taken in registration order, so lock sets never deadlock.
+ *
+ * An orch that did not declare its dependencies locks every orch
+ * exclusively, which keeps the single threaded semantics for all orchs
+ * which are not explicitly prepared for concurrency. Only orchs with
+ * declared dependencies may be offloaded to a worker thread.
+ *
+ * Dependencies must cover every orch that is called directly, through
+ * gDirectory, or as an observer of a subject. A read-only dependency may
+ * only be used for lookups which neither modify state nor access a
+ * database connector.
+ */
+class OrchScheduler
+{
+public:
+    class LockGuard
+    {
+    public:
+        LockGuard(OrchScheduler *scheduler, const std::map<size_t, bool> &lockSet);
+        LockGuard(LockGuard &&other);
+        ~LockGuard();
+
+        LockGuard(const LockGuard&) = delete;
+        LockGuard& operator=(const LockGuard&) = delete;
+
+    private:
+        OrchScheduler *m_scheduler;
+        /* Lock index to exclusive flag */
+        std::map<size_t, bool> m_lockSet;
+    };
+
+    OrchScheduler(const std::vector<Orch *> &orchs);
+    ~OrchScheduler();
+
+    void addDependency(Orch *orch, Orch *dependency, bool readOnly = false);
+
+    /* Run all executors of the orch on a dedicated worker thread */
+    bool offload(Orch *orch, const std::string &name);
+    bool isOffloaded(Orch *orch) const;
+
+    /* Whether both orchs may never execute at the same time */
+    bool isConflicting(Orch *orch1, Orch *orch2) const;
+
+    LockGuard lock(Orch *orch);
+    LockGuard lockAll();
+
+    void start();
+    void stop();
+
+private:
+    struct Worker
+    {
+        Orch *orch;
+        std::string name;
+        std::thread thread;
+    };
+
+    std::vector<Orch *> m_orchs;
+    std::map<Orch *, size_t> m_orchIndex;
+    std::vector<std::unique_ptr<std::shared_timed_mutex>> m_locks;
+
+    /*
+     * Lock sets are acquired one at a time, so a guard waiting for an
+     * exclusive lock is not starved by a stream of shared holders.
+     */
+    std::mutex m_gate;
+
+    /* Orch to declared lock set, orchs without declaration lock everything */
+    std::map<Orch *, std::map<size_t, bool>> m_lockSets;
+
+    std::vector<std::unique_ptr<Worker>> m_workers;
+    std::atomic<bool> m_running;
+
+    std::map<size_t, bool> getLockSet(Orch *orch) const;
+    void runWorker(Worker *worker);
+};
+
+#endif /* SWSS_ORCHSCHEDULER_H */
@@ -3,6 +3,7 @@
 #include "logger.h"
 #include "sai_serialize.h"
 #include "portsorch.h"
+#include "batcheddbwriter.h"
 #include <vector>
 #include <inttypes.h>
 
@@ -55,7 +56,7 @@ void PfcWdActionHandler::initCounters(void)
         return;
     }
 
-    auto wdQueueStats = getQueueStats(m_countersTable, sai_serialize_object_id(m_queue));
+    auto &wdQueueStats = getStats();
     // initCounters() is called when the event channel receives
     // a storm signal. This can happen when there is a true new storm or
     // when there is an existing storm ongoing before warm-reboot. In the latter case,
@@ -74,6 +75,7 @@ void PfcWdActionHandler::initCounters(void)
     wdQueueStats.operational = false;
 
     updateWdCounters(sai_serialize_object_id(m_queue), wdQueueStats);
+    BatchedDbWriter::get("COUNTERS_DB").flush();
 }
 
 void PfcWdActionHandler::commitCounters(bool periodic /* = false */)
@@ -87,7 +89,7 @@ void PfcWdActionHandler::commitCounters(bool periodic /* = false */)
         return;
     }
 
-    auto finalStats = getQueueStats(m_countersTable, sai_serialize_object_id(m_queue));
+    auto &finalStats = getStats();
 
     if (!periodic)
     {
@@ -108,6 +110,26 @@ void PfcWdActionHandler::commitCounters(bool periodic /* = false */)
     m_hwStats = hwStats;
 
     updateWdCounters(sai_serialize_object_id(m_queue), finalStats);
+
+    // Periodic updates go out with the rest of the iteration writes,
+    // the final one lands before the caller cleans up the queue entry
+    if (!periodic)
+    {
+        BatchedDbWriter::get("COUNTERS_DB").flush();
+    }
+}
+
+PfcWdActionHandler::PfcWdQueueStats &PfcWdActionHandler::getStats(void)
+{
+    SWSS_LOG_ENTER();
+
+    if (!m_statsLoaded)
+    {
+        m_stats = getQueueStats(m_countersTable, sai_serialize_object_id(m_queue));
+        m_statsLoaded = true;
+    }
+
+    return m_stats;
 }
 
 PfcWdActionHandler::PfcWdQueueStats PfcWdActionHandler::getQueueStats(shared_ptr<Table> countersTable, const string &queueIdStr)
@@ -216,7 +238,7 @@ void PfcWdActionHandler::updateWdCounters(const string& queueIdStr, const PfcWdQ
                                                      PFC_WD_QUEUE_STATUS_OPERATIONAL :
                                                      PFC_WD_QUEUE_STATUS_STORMED);
 
-    m_countersTable->set(queueIdStr, resultFvValues);
+    BatchedDbWriter::get("COUNTERS_DB").set(m_countersTable->getTableName(), queueIdStr, resultFvValues);
 }
 
 PfcWdAclHandler::PfcWdAclHandler(sai_object_id_t port, sai_object_id_t queue,
@@ -365,16 +387,16 @@ void PfcWdAclHandler::createPfcAclRule(shared_ptr<AclRulePfcwd> rule, uint8_t qu
     // Add MATCH_IN_PORTS as match criteria for ingress table
     if (strTable == INGRESS_TABLE_DROP) 
     {
-        Port p;
         attr_name = MATCH_IN_PORTS;
 
-        if (!gPortsOrch->getPort(portOid, p))
+        const Port *p = gPortsOrch->findPort(portOid);
+        if (p == nullptr)
         {
             SWSS_LOG_ERROR("Failed to get port structure from port oid 0x%" PRIx64, portOid);
             return;
         }
 
-        attr_value = p.m_alias;
+        attr_value = p->m_alias;
         rule->validateAddMatch(attr_name, attr_value);
     }
 
@@ -459,14 +481,19 @@ bool PfcWdLossyHandler::getHwCounters(PfcWdHwStats& counters)
     }
 
     // PG counters not yet supported in Mellanox platform
-    Port portInstance;
-    if (!gPortsOrch->getPort(getPort(), portInstance))
+    if (m_pg == SAI_NULL_OBJECT_ID)
     {
-        SWSS_LOG_ERROR("Cannot get port by ID 0x%" PRIx64, getPort());
-        return false;
+        Port portInstance;
+        if (!gPortsOrch->getPort(getPort(), portInstance))
+        {
+            SWSS_LOG_ERROR("Cannot get port by ID 0x%" PRIx64, getPort());
+            return false;
+        }
+
+        m_pg = portInstance.m_priority_group_ids[static_cast <size_t> (getQueueId())];
     }
 
-    sai_object_id_t pg = portInstance.m_priority_group_ids[static_cast <size_t> (getQueueId())];
+    sai_object_id_t pg = m_pg;
     vector<uint64_t> pgStats;
     pgStats.resize(pgStatIds.size());
 
@@ -75,6 +75,7 @@ class PfcWdActionHandler
 
         static PfcWdQueueStats getQueueStats(shared_ptr<Table> countersTable, const string &queueIdStr);
         void updateWdCounters(const string& queueIdStr, const PfcWdQueueStats& stats);
+        PfcWdQueueStats &getStats(void);
 
         sai_object_id_t m_port = SAI_NULL_OBJECT_ID;
         sai_object_id_t m_queue = SAI_NULL_OBJECT_ID;
@@ -82,6 +83,10 @@ class PfcWdActionHandler
         string m_portAlias;
         shared_ptr<Table> m_countersTable = nullptr;
         PfcWdHwStats m_hwStats;
+
+        // Stats of the queue are read from COUNTERS_DB once, then only written
+        PfcWdQueueStats m_stats;
+        bool m_statsLoaded = false;
 };
 
 // Pfc queue that implements forward action by disabling PFC on queue
@@ -92,6 +97,9 @@ class PfcWdLossyHandler: public PfcWdActionHandler
                 uint8_t queueId, shared_ptr<Table> countersTable);
         virtual ~PfcWdLossyHandler(void);
         virtual bool getHwCounters(PfcWdHwStats& counters);
+
+    private:
+        sai_object_id_t m_pg = SAI_NULL_OBJECT_ID;
 };
 
 class PfcWdAclHandler: public PfcWdLossyHandler
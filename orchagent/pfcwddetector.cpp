@@ -0,0 +1,189 @@
+#include <algorithm>
+
+#include "pfcwddetector.h"
+
+using namespace std;
+
+void PfcWdDetector::addQueue(sai_object_id_t queueId, sai_object_id_t portId, uint8_t index,
+        uint32_t detectionTime, uint32_t restorationTime, bool alert)
+{
+    auto it = m_slots.find(queueId);
+    if (it != m_slots.end())
+    {
+        size_t slot = it->second;
+
+        m_detectionTime[slot] = detectionTime;
+        m_restorationTime[slot] = restorationTime;
+        m_flags[slot] = static_cast<uint8_t>(alert ? (m_flags[slot] | FLAG_ALERT) : (m_flags[slot] & ~FLAG_ALERT));
+        return;
+    }
+
+    m_slots[queueId] = m_queueIds.size();
+
+    m_queueIds.push_back(queueId);
+    m_portIds.push_back(portId);
+    m_indexes.push_back(index);
+    m_flags.push_back(alert ? FLAG_ALERT : 0);
+
+    m_detectionTime.push_back(detectionTime);
+    m_restorationTime.push_back(restorationTime);
+    m_detectionTimeLeft.push_back(detectionTime);
+    m_restorationTimeLeft.push_back(restorationTime);
+
+    m_packetsLast.push_back(0);
+    m_pfcRxPacketsLast.push_back(0);
+    m_pfcOn2OffRxPacketsLast.push_back(0);
+}
+
+void PfcWdDetector::removeQueue(sai_object_id_t queueId)
+{
+    auto it = m_slots.find(queueId);
+    if (it == m_slots.end())
+    {
+        return;
+    }
+
+    /* Fill the hole with the last slot */
+    size_t slot = it->second;
+    size_t last = m_queueIds.size() - 1;
+    m_slots.erase(it);
+
+    if (slot != last)
+    {
+        moveSlot(last, slot);
+        m_slots[m_queueIds[slot]] = slot;
+    }
+
+    m_queueIds.pop_back();
+    m_portIds.pop_back();
+    m_indexes.pop_back();
+    m_flags.pop_back();
+
+    m_detectionTime.pop_back();
+    m_restorationTime.pop_back();
+    m_detectionTimeLeft.pop_back();
+    m_restorationTimeLeft.pop_back();
+
+    m_packetsLast.pop_back();
+    m_pfcRxPacketsLast.pop_back();
+    m_pfcOn2OffRxPacketsLast.pop_back();
+}
+
+void PfcWdDetector::moveSlot(size_t from, size_t to)
+{
+    m_queueIds[to] = m_queueIds[from];
+    m_portIds[to] = m_portIds[from];
+    m_indexes[to] = m_indexes[from];
+    m_flags[to] = m_flags[from];
+
+    m_detectionTime[to] = m_detectionTime[from];
+    m_restorationTime[to] = m_restorationTime[from];
+    m_detectionTimeLeft[to] = m_detectionTimeLeft[from];
+    m_restorationTimeLeft[to] = m_restorationTimeLeft[from];
+
+    m_packetsLast[to] = m_packetsLast[from];
+    m_pfcRxPacketsLast[to] = m_pfcRxPacketsLast[from];
+    m_pfcOn2OffRxPacketsLast[to] = m_pfcOn2OffRxPacketsLast[from];
+}
+
+void PfcWdDetector::process(const vector<PfcWdQueueCounters> &counters, uint32_t pollTime,
+        vector<pair<sai_object_id_t, PfcWdDetectorEvent>> &events)
+{
+    size_t count = min(counters.size(), m_queueIds.size());
+
+    for (size_t slot = 0; slot < count; slot++)
+    {
+        const auto &c = counters[slot];
+
+        /*
+         * The detection plugin skips the queues without all their counters,
+         * the restoration plugin only reads the PFC RX counter
+         */
+        if (c.operational || (m_flags[slot] & FLAG_ALERT))
+        {
+            if (c.valid)
+            {
+                detect(slot, c, pollTime, events);
+            }
+        }
+        else if (m_restorationTime[slot] != 0 && c.pfcRxValid)
+        {
+            restore(slot, c, pollTime, events);
+        }
+    }
+}
+
+void PfcWdDetector::detect(size_t slot, const PfcWdQueueCounters &c, uint32_t pollTime,
+        vector<pair<sai_object_id_t, PfcWdDetectorEvent>> &events)
+{
+    uint8_t &flags = m_flags[slot];
+    uint32_t &timeLeft = m_detectionTimeLeft[slot];
+
+    /* Nothing to compare with on the first run */
+    if ((flags & FLAG_DETECT_LAST) && (flags & FLAG_PFC_RX_LAST))
+    {
+        bool pfcRx = c.pfcRxPackets > m_pfcRxPacketsLast[slot];
+        bool storm =
+            (c.occupancyBytes > 0 && c.packets == m_packetsLast[slot] && pfcRx) ||
+            c.debugStorm ||
+            (c.occupancyBytes == 0 && pfcRx && c.pfcOn2OffRxPackets == m_pfcOn2OffRxPacketsLast[slot] &&
+             (flags & FLAG_PAUSED_LAST) && c.paused);
+
+        if (storm)
+        {
+            if (timeLeft <= pollTime)
+            {
+                events.emplace_back(m_queueIds[slot], PfcWdDetectorEvent::STORM);
+                timeLeft = m_detectionTime[slot];
+            }
+            else
+            {
+                timeLeft -= pollTime;
+            }
+        }
+        else
+        {
+            if ((flags & FLAG_ALERT) && !c.operational)
+            {
+                events.emplace_back(m_queueIds[slot], PfcWdDetectorEvent::RESTORE);
+            }
+            timeLeft = m_detectionTime[slot];
+        }
+    }
+
+    m_packetsLast[slot] = c.packets;
+    m_pfcRxPacketsLast[slot] = c.pfcRxPackets;
+    m_pfcOn2OffRxPacketsLast[slot] = c.pfcOn2OffRxPackets;
+    flags = static_cast<uint8_t>((flags & ~FLAG_PAUSED_LAST) | FLAG_DETECT_LAST | FLAG_PFC_RX_LAST |
+            (c.paused ? FLAG_PAUSED_LAST : 0));
+}
+
+void PfcWdDetector::restore(size_t slot, const PfcWdQueueCounters &c, uint32_t pollTime,
+        vector<pair<sai_object_id_t, PfcWdDetectorEvent>> &events)
+{
+    uint8_t &flags = m_flags[slot];
+    uint32_t &timeLeft = m_restorationTimeLeft[slot];
+
+    if (flags & FLAG_PFC_RX_LAST)
+    {
+        if (c.pfcRxPackets == m_pfcRxPacketsLast[slot] && !c.debugStorm)
+        {
+            if (timeLeft <= pollTime)
+            {
+                events.emplace_back(m_queueIds[slot], PfcWdDetectorEvent::RESTORE);
+                timeLeft = m_restorationTime[slot];
+            }
+            else
+            {
+                timeLeft -= pollTime;
+            }
+        }
+        else
+        {
+            timeLeft = m_restorationTime[slot];
+        }
+    }
+
+    m_pfcRxPacketsLast[slot] = c.pfcRxPackets;
+    flags = static_cast<uint8_t>(flags | FLAG_PFC_RX_LAST);
+}
@@ -0,0 +1,116 @@
+#ifndef SWSS_PFCWDDETECTOR_H
+#define SWSS_PFCWDDETECTOR_H
+
+#include <unordered_map>
+#include <utility>
+#include <vector>
+
+extern "C" {
+#include "sai.h"
+}
+
+/* One poll of the counters of a watched queue */
+struct PfcWdQueueCounters
+{
+    /* All the counters below were found in COUNTERS_DB, needed by the detection */
+    bool valid = false;
+    /* pfcRxPackets was found, the only counter the restoration needs */
+    bool pfcRxValid = false;
+
+    uint64_t occupancyBytes = 0;
+    uint64_t packets = 0;
+    bool paused = false;
+
+    /* PFC counters of the queue priority on its port */
+    uint64_t pfcRxPackets = 0;
+    uint64_t pfcOn2OffRxPackets = 0;
+
+    /* DEBUG_STORM field of the queue, forces the storm condition */
+    bool debugStorm = false;
+
+    /* PFC_WD_STATUS of the queue is operational, no storm action is running */
+    bool operational = true;
+};
+
+enum class PfcWdDetectorEvent
+{
+    STORM,
+    RESTORE,
+};
+
+/*
+ * In process implementation of pfc_detect_broadcom.lua and pfc_restore.lua.
+ *
+ * The state the plugins keep in the *_last and *_LEFT fields of
+ * COUNTERS_DB is kept here in one array per field, indexed by the slot of
+ * the queue. A poll reads the counters of all the queues at once and
+ * returns the storm and restore events the plugins would have published.
+ *
+ * Detection, restoration and poll times only need to share one unit.
+ */
+class PfcWdDetector
+{
+public:
+    /* Adding a watched queue again only updates its configuration */
+    void addQueue(sai_object_id_t queueId, sai_object_id_t portId, uint8_t index,
+            uint32_t detectionTime, uint32_t restorationTime, bool alert);
+    void removeQueue(sai_object_id_t queueId);
+
+    size_t size() const
+    {
+        return m_queueIds.size();
+    }
+
+    sai_object_id_t getQueueId(size_t slot) const
+    {
+        return m_queueIds[slot];
+    }
+
+    sai_object_id_t getPortId(size_t slot) const
+    {
+        return m_portIds[slot];
+    }
+
+    uint8_t getIndex(size_t slot) const
+    {
+        return m_indexes[slot];
+    }
+
+    /* counters[i] is the poll of the queue in slot i */
+    void process(const std::vector<PfcWdQueueCounters> &counters, uint32_t pollTime,
+            std::vector<std::pair<sai_object_id_t, PfcWdDetectorEvent>> &events);
+
+private:
+    enum : uint8_t
+    {
+        FLAG_ALERT = 1 << 0,
+        /* Packets, PFC ON2OFF and pause status of the previous detection */
+        FLAG_DETECT_LAST = 1 << 1,
+        FLAG_PFC_RX_LAST = 1 << 2,
+        FLAG_PAUSED_LAST = 1 << 3,
+    };
+
+    void detect(size_t slot, const PfcWdQueueCounters &counters, uint32_t pollTime,
+            std::vector<std::pair<sai_object_id_t, PfcWdDetectorEvent>> &events);
+    void restore(size_t slot, const PfcWdQueueCounters &counters, uint32_t pollTime,
+            std::vector<std::pair<sai_object_id_t, PfcWdDetectorEvent>> &events);
+    void moveSlot(size_t from, size_t to);
+
+    std::unordered_map<sai_object_id_t, size_t> m_slots;
+
+    std::vector<sai_object_id_t> m_queueIds;
+    std::vector<sai_object_id_t> m_portIds;
+    std::vector<uint8_t> m_indexes;
+    std::vector<uint8_t> m_flags;
+
+    std::vector<uint32_t> m_detectionTime;
+    std::vector<uint32_t> m_restorationTime;
+    std::vector<uint32_t> m_detectionTimeLeft;
+    std::vector<uint32_t> m_restorationTimeLeft;
+
+    std::vector<uint64_t> m_packetsLast;
+    std::vector<uint64_t> m_pfcRxPacketsLast;
+    std::vector<uint64_t> m_pfcOn2OffRxPacketsLast;
+};
+
+#endif /* SWSS_PFCWDDETECTOR_H */
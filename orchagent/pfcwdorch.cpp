@@ -10,6 +10,8 @@
 #include "notifier.h"
 #include "schema.h"
 #include "subscriberstatetable.h"
+#include "rediscommand.h"
+#include "redisreply.h"
 
 #define PFC_WD_GLOBAL                   "GLOBAL"
 #define PFC_WD_ACTION                   "action"
@@ -26,12 +28,16 @@
 #define SAI_PORT_STAT_PFC_PREFIX        "SAI_PORT_STAT_PFC_"
 #define PFC_WD_TC_MAX 8
 #define COUNTER_CHECK_POLL_TIMEOUT_SEC  1
+#define PFC_WD_NATIVE_DETECTOR_PLATFORM "broadcom"
 
 extern sai_port_api_t *sai_port_api;
 extern sai_queue_api_t *sai_queue_api;
 
 extern PortsOrch *gPortsOrch;
 
+/* Detect PFC storms in orchagent instead of the Redis Lua plugins */
+bool gPfcWdNativeDetector = false;
+
 template <typename DropHandler, typename ForwardHandler>
 PfcWdOrch<DropHandler, ForwardHandler>::PfcWdOrch(DBConnector *db, vector<string> &tableNames):
     Orch(db, tableNames),
@@ -301,6 +307,23 @@ task_process_status PfcWdSwOrch<DropHandler, ForwardHandler>::createEntry(const
                 vector<FieldValueTuple> fieldValues;
                 fieldValues.emplace_back(POLL_INTERVAL_FIELD, value);
                 m_flexCounterGroupTable->set(PFC_WD_FLEX_COUNTER_GROUP, fieldValues);
+
+                if (m_detectTimer != nullptr)
+                {
+                    try
+                    {
+                        m_pollInterval = static_cast<int>(to_uint<uint32_t>(value, 1, INT_MAX));
+                    }
+                    catch (const exception &e)
+                    {
+                        SWSS_LOG_ERROR("Invalid PFC watchdog poll interval %s: %s", value.c_str(), e.what());
+                        continue;
+                    }
+
+                    auto interv = timespec { .tv_sec = m_pollInterval / 1000, .tv_nsec = (m_pollInterval % 1000) * 1000000 };
+                    m_detectTimer->setInterval(interv);
+                    m_detectTimer->reset();
+                }
             }
             else if (field == BIG_RED_SWITCH_FIELD)
             {
@@ -548,6 +571,12 @@ bool PfcWdSwOrch<DropHandler, ForwardHandler>::registerInWdDb(const Port& port,
         // Create internal entry
         m_entryMap.emplace(queueId, PfcWdQueueEntry(action, port.m_port_id, i, port.m_alias));
 
+        if (m_detectTimer != nullptr)
+        {
+            m_detector.addQueue(queueId, port.m_port_id, i, detectionTime, restorationTime,
+                    action == PfcWdAction::PFC_WD_ACTION_ALERT);
+        }
+
         string key = getFlexCounterTableKey(queueIdStr);
         m_flexCounterTable->set(key, queueFieldValues);
 
@@ -628,6 +657,7 @@ void PfcWdSwOrch<DropHandler, ForwardHandler>::unregisterFromWdDb(const Port& po
         }
 
         m_entryMap.erase(queueId);
+        m_detector.removeQueue(queueId);
 
         // Clean up
         string countersKey = this->getCountersTable()->getTableName() + this->getCountersTable()->getTableNameSeparator() + sai_serialize_object_id(queueId);
@@ -664,31 +694,50 @@ PfcWdSwOrch<DropHandler, ForwardHandler>::PfcWdSwOrch(
         return;
     }
 
-    string detectSha, restoreSha;
-    string detectPluginName = "pfc_detect_" + platform + ".lua";
-    string restorePluginName = "pfc_restore.lua";
-
-    try
+    bool nativeDetector = gPfcWdNativeDetector && platform == PFC_WD_NATIVE_DETECTOR_PLATFORM;
+    if (gPfcWdNativeDetector && !nativeDetector)
     {
-        string detectLuaScript = swss::loadLuaScript(detectPluginName);
-        detectSha = swss::loadRedisScript(
-                this->getCountersDb().get(),
-                detectLuaScript);
+        SWSS_LOG_WARN("No native PFC watchdog detector for platform %s, using Lua plugins", platform.c_str());
+    }
 
-        string restoreLuaScript = swss::loadLuaScript(restorePluginName);
-        restoreSha = swss::loadRedisScript(
-                this->getCountersDb().get(),
-                restoreLuaScript);
+    if (nativeDetector)
+    {
+        // syncd still polls the counters, storms are detected in detectStorms()
+        m_detectorDb.reset(this->getCountersDb()->newConnector(0));
 
         vector<FieldValueTuple> fieldValues;
-        fieldValues.emplace_back(QUEUE_PLUGIN_FIELD, detectSha + "," + restoreSha);
         fieldValues.emplace_back(POLL_INTERVAL_FIELD, to_string(m_pollInterval));
         fieldValues.emplace_back(STATS_MODE_FIELD, STATS_MODE_READ);
         m_flexCounterGroupTable->set(PFC_WD_FLEX_COUNTER_GROUP, fieldValues);
     }
-    catch (...)
+    else
     {
-        SWSS_LOG_WARN("Lua scripts and polling interval for PFC watchdog were not set successfully");
+        string detectSha, restoreSha;
+        string detectPluginName = "pfc_detect_" + platform + ".lua";
+        string restorePluginName = "pfc_restore.lua";
+
+        try
+        {
+            string detectLuaScript = swss::loadLuaScript(detectPluginName);
+            detectSha = swss::loadRedisScript(
+                    this->getCountersDb().get(),
+                    detectLuaScript);
+
+            string restoreLuaScript = swss::loadLuaScript(restorePluginName);
+            restoreSha = swss::loadRedisScript(
+                    this->getCountersDb().get(),
+                    restoreLuaScript);
+
+            vector<FieldValueTuple> fieldValues;
+            fieldValues.emplace_back(QUEUE_PLUGIN_FIELD, detectSha + "," + restoreSha);
+            fieldValues.emplace_back(POLL_INTERVAL_FIELD, to_string(m_pollInterval));
+            fieldValues.emplace_back(STATS_MODE_FIELD, STATS_MODE_READ);
+            m_flexCounterGroupTable->set(PFC_WD_FLEX_COUNTER_GROUP, fieldValues);
+        }
+        catch (...)
+        {
+            SWSS_LOG_WARN("Lua scripts and polling interval for PFC watchdog were not set successfully");
+        }
     }
 
     auto consumer = new swss::NotificationConsumer(
@@ -697,6 +746,19 @@ PfcWdSwOrch<DropHandler, ForwardHandler>::PfcWdSwOrch(
     auto wdNotification = new Notifier(consumer, this, "PFC_WD_ACTION");
     Orch::addExecutor(wdNotification);
 
+    if (nativeDetector)
+    {
+        SWSS_LOG_NOTICE("Detecting PFC storms in orchagent every %d ms", m_pollInterval);
+
+        m_actionNotifier = make_shared<NotificationProducer>(this->getCountersDb().get(), "PFC_WD_ACTION");
+
+        auto detectInterv = timespec { .tv_sec = m_pollInterval / 1000, .tv_nsec = (m_pollInterval % 1000) * 1000000 };
+        m_detectTimer = new SelectableTimer(detectInterv);
+        auto detectExecutor = new ExecutableTimer(m_detectTimer, this, "PFC_WD_DETECT");
+        Orch::addExecutor(detectExecutor);
+        m_detectTimer->start();
+    }
+
     auto interv = timespec { .tv_sec = COUNTER_CHECK_POLL_TIMEOUT_SEC, .tv_nsec = 0 };
     auto timer = new SelectableTimer(interv);
     auto executor = new ExecutableTimer(timer, this, "PFC_WD_COUNTERS_POLL");
@@ -882,6 +944,12 @@ void PfcWdSwOrch<DropHandler, ForwardHandler>::doTask(SelectableTimer &timer)
 {
     SWSS_LOG_ENTER();
 
+    if (&timer == m_detectTimer)
+    {
+        detectStorms();
+        return;
+    }
+
     for (auto& handlerPair : m_entryMap)
     {
         if (handlerPair.second.handler != nullptr)
@@ -892,6 +960,160 @@ void PfcWdSwOrch<DropHandler, ForwardHandler>::doTask(SelectableTimer &timer)
 
 }
 
+template <typename DropHandler, typename ForwardHandler>
+void PfcWdSwOrch<DropHandler, ForwardHandler>::detectStorms(void)
+{
+    SWSS_LOG_ENTER();
+
+    // The plugins skip the queues in BIG_RED_SWITCH mode
+    if (m_bigRedSwitchFlag || m_detector.size() == 0)
+    {
+        return;
+    }
+
+    vector<PfcWdQueueCounters> counters;
+    readDetectorCounters(counters);
+
+    vector<pair<sai_object_id_t, PfcWdDetectorEvent>> events;
+    m_detector.process(counters, static_cast<uint32_t>(m_pollInterval), events);
+
+    // Publish the events as the plugins do, they are handled by doTask(NotificationConsumer&)
+    for (const auto &event : events)
+    {
+        vector<FieldValueTuple> values;
+        m_actionNotifier->send(
+                sai_serialize_object_id(event.first),
+                event.second == PfcWdDetectorEvent::STORM ? PFC_WD_IN_STORM : "restore",
+                values);
+    }
+}
+
+static vector<shared_ptr<string>> popHmgetReply(redisContext *ctx)
+{
+    redisReply *reply = nullptr;
+    if (redisGetReply(ctx, reinterpret_cast<void **>(&reply)) != REDIS_OK)
+    {
+        throw system_error(make_error_code(errc::io_error), "Failed to read PFC watchdog counters");
+    }
+
+    RedisReply r(reply);
+    vector<shared_ptr<string>> values;
+
+    if (reply->type != REDIS_REPLY_ARRAY)
+    {
+        return values;
+    }
+
+    for (size_t i = 0; i < reply->elements; i++)
+    {
+        redisReply *element = reply->element[i];
+        values.push_back(element->type == REDIS_REPLY_STRING ?
+                make_shared<string>(element->str, element->len) :
+                nullptr);
+    }
+
+    return values;
+}
+
+template <typename DropHandler, typename ForwardHandler>
+void PfcWdSwOrch<DropHandler, ForwardHandler>::readDetectorCounters(vector<PfcWdQueueCounters> &counters)
+{
+    SWSS_LOG_ENTER();
+
+    redisContext *ctx = m_detectorDb->getContext();
+    string prefix = this->getCountersTable()->getTableName() + this->getCountersTable()->getTableNameSeparator();
+    size_t count = m_detector.size();
+    vector<vector<shared_ptr<string>>> replies;
+
+    // Queue and port counters of all the queues in one round trip
+    try
+    {
+        for (size_t i = 0; i < count; i++)
+        {
+            string queueKey = prefix + sai_serialize_object_id(m_detector.getQueueId(i));
+            string portKey = prefix + sai_serialize_object_id(m_detector.getPortId(i));
+            string pfcKey = SAI_PORT_STAT_PFC_PREFIX + to_string(m_detector.getIndex(i));
+
+            RedisCommand queueCmd;
+            queueCmd.format("HMGET %s %s %s %s %s %s", queueKey.c_str(),
+                    "SAI_QUEUE_STAT_CURR_OCCUPANCY_BYTES",
+                    "SAI_QUEUE_STAT_PACKETS",
+                    "SAI_QUEUE_ATTR_PAUSE_STATUS",
+                    "DEBUG_STORM",
+                    "PFC_WD_STATUS");
+
+            RedisCommand portCmd;
+            portCmd.format("HMGET %s %s %s", portKey.c_str(),
+                    (pfcKey + "_RX_PKTS").c_str(),
+                    (pfcKey + "_ON2OFF_RX_PKTS").c_str());
+
+            if (redisAppendFormattedCommand(ctx, queueCmd.c_str(), queueCmd.length()) != REDIS_OK ||
+                    redisAppendFormattedCommand(ctx, portCmd.c_str(), portCmd.length()) != REDIS_OK)
+            {
+                throw system_error(make_error_code(errc::io_error), "Failed to request PFC watchdog counters");
+            }
+        }
+
+        // Every reply is read before parsing any, none is left pending on the connection
+        replies.reserve(2 * count);
+        for (size_t i = 0; i < 2 * count; i++)
+        {
+            replies.push_back(popHmgetReply(ctx));
+        }
+    }
+    catch (...)
+    {
+        // Replies of a failed round trip cannot be matched to their commands anymore
+        m_detectorDb.reset(this->getCountersDb()->newConnector(0));
+        throw;
+    }
+
+    counters.assign(count, PfcWdQueueCounters());
+
+    for (size_t i = 0; i < count; i++)
+    {
+        const auto &queueValues = replies[2 * i];
+        const auto &portValues = replies[2 * i + 1];
+
+        auto &c = counters[i];
+
+        if (queueValues.size() != 5 || portValues.size() != 2)
+        {
+            continue;
+        }
+
+        // The plugins check the status the storm actions write, not the handlers
+        c.operational = queueValues[4] && *queueValues[4] == "operational";
+        c.debugStorm = queueValues[3] && *queueValues[3] == "enabled";
+
+        try
+        {
+            if (portValues[0])
+            {
+                c.pfcRxPackets = to_uint<uint64_t>(*portValues[0]);
+                c.pfcRxValid = true;
+            }
+
+            if (!c.pfcRxValid || !queueValues[0] || !queueValues[1] || !queueValues[2] || !portValues[1])
+            {
+                continue;
+            }
+
+            c.occupancyBytes = to_uint<uint64_t>(*queueValues[0]);
+            c.packets = to_uint<uint64_t>(*queueValues[1]);
+            c.pfcOn2OffRxPackets = to_uint<uint64_t>(*portValues[1]);
+        }
+        catch (const exception &e)
+        {
+            SWSS_LOG_ERROR("Invalid PFC watchdog counters of queue 0x%" PRIx64 ": %s", m_detector.getQueueId(i), e.what());
+            continue;
+        }
+
+        c.paused = *queueValues[2] == "true";
+        c.valid = true;
+    }
+}
+
 template <typename DropHandler, typename ForwardHandler>
 bool PfcWdSwOrch<DropHandler, ForwardHandler>::startWdActionOnQueue(const string &event, sai_object_id_t queueId)
 {
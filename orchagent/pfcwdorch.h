@@ -6,7 +6,9 @@
 #include "pfcactionhandler.h"
 #include "producertable.h"
 #include "notificationconsumer.h"
+#include "notificationproducer.h"
 #include "timer.h"
+#include "pfcwddetector.h"
 
 extern "C" {
 #include "sai.h"
@@ -117,6 +119,9 @@ private:
     void enableBigRedSwitchMode();
     void setBigRedSwitchMode(string value);
 
+    void detectStorms(void);
+    void readDetectorCounters(vector<PfcWdQueueCounters> &counters);
+
     map<sai_object_id_t, PfcWdQueueEntry> m_entryMap;
     map<sai_object_id_t, PfcWdQueueEntry> m_brsEntryMap;
 
@@ -131,6 +136,13 @@ private:
     bool m_bigRedSwitchFlag = false;
     int m_pollInterval;
 
+    // Native storm detection, replaces the Lua plugins when set
+    PfcWdDetector m_detector;
+    // Connection of readDetectorCounters() only, its pipelined reads never interleave with other commands
+    shared_ptr<DBConnector> m_detectorDb = nullptr;
+    SelectableTimer *m_detectTimer = nullptr;
+    shared_ptr<NotificationProducer> m_actionNotifier = nullptr;
+
     shared_ptr<DBConnector> m_applDb = nullptr;
     // Track queues in storm
     shared_ptr<Table> m_applTable = nullptr;
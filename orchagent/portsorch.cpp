@@ -5,6 +5,7 @@
 #include "gearboxutils.h"
 #include "vxlanorch.h"
 #include "directory.h"
+#include "batcheddbwriter.h"
 
 #include <inttypes.h>
 #include <cassert>
@@ -611,38 +612,106 @@ bool PortsOrch::getPort(sai_object_id_t id, Port &port)
 {
     SWSS_LOG_ENTER();
 
-    for (const auto& portIter: m_portList)
+    Port *p = findPort(id);
+    if (p == nullptr)
     {
-        switch (portIter.second.m_type)
+        return false;
+    }
+
+    port = *p;
+    return true;
+}
+
+static bool matchPortId(const Port &port, sai_object_id_t id)
+{
+    switch (port.m_type)
+    {
+    case Port::PHY:
+    case Port::SYSTEM:
+        return port.m_port_id == id;
+    case Port::LAG:
+        return port.m_lag_id == id;
+    case Port::VLAN:
+        return port.m_vlan_info.vlan_oid == id;
+    default:
+        return false;
+    }
+}
+
+static bool matchBridgePortId(const Port &port, sai_object_id_t id)
+{
+    return port.m_bridge_port_id == id;
+}
+
+static bool matchRifId(const Port &port, sai_object_id_t id)
+{
+    return port.m_rif_id == id;
+}
+
+static bool matchVlanId(const Port &port, sai_object_id_t id)
+{
+    return port.m_type == Port::VLAN && port.m_vlan_info.vlan_id == id;
+}
+
+Port *PortsOrch::findIndexedPort(PortIndex &index, sai_object_id_t id, bool (*match)(const Port &, sai_object_id_t))
+{
+    auto it = index.find(id);
+    if (it != index.end())
+    {
+        auto port = m_portList.find(it->second);
+        if (port != m_portList.end() && match(port->second, id))
         {
-        case Port::PHY:
-        case Port::SYSTEM:
-            if(portIter.second.m_port_id == id)
-            {
-                port = portIter.second;
-                return true;
-            }
-            break;
-        case Port::LAG:
-            if(portIter.second.m_lag_id == id)
-            {
-                port = portIter.second;
-                return true;
-            }
-            break;
-        case Port::VLAN:
-            if (portIter.second.m_vlan_info.vlan_oid == id)
+            return &port->second;
+        }
+        index.erase(it);
+    }
+
+    for (auto &port : m_portList)
+    {
+        if (match(port.second, id))
+        {
+            /* Many ports may have no OID of the kind, don't index them */
+            if (id != SAI_NULL_OBJECT_ID)
             {
-                port = portIter.second;
-                return true;
+                index[id] = port.first;
             }
-            break;
-        default:
-            continue;
+            return &port.second;
         }
     }
 
-    return false;
+    return nullptr;
+}
+
+Port *PortsOrch::findPort(const string &alias)
+{
+    auto it = m_portList.find(alias);
+    if (it == m_portList.end())
+    {
+        return nullptr;
+    }
+
+    return &it->second;
+}
+
+Port *PortsOrch::findPort(sai_object_id_t id)
+{
+    return findIndexedPort(m_portIdIndex, id, matchPortId);
+}
+
+Port *PortsOrch::findPortByBridgePortId(sai_object_id_t bridge_port_id)
+{
+    return findIndexedPort(m_bridgePortIdIndex, bridge_port_id, matchBridgePortId);
+}
+
+Port *PortsOrch::findPortByRifId(sai_object_id_t rif_id)
+{
+    return findIndexedPort(m_rifIdIndex, rif_id, matchRifId);
+}
+
+Port *PortsOrch::findVlanByVlanId(sai_vlan_id_t vlan_id)
+{
+    /* The VLAN ID is never 0, so it can share the OID index code */
+    return findIndexedPort(m_vlanIdIndex, vlan_id, matchVlanId);
 }
 
 void PortsOrch::increasePortRefCount(const string &alias)
@@ -661,16 +730,14 @@ bool PortsOrch::getPortByBridgePortId(sai_object_id_t bridge_port_id, Port &port
 {
     SWSS_LOG_ENTER();
 
-    for (auto &it: m_portList)
+    Port *p = findPortByBridgePortId(bridge_port_id);
+    if (p == nullptr)
     {
-        if (it.second.m_bridge_port_id == bridge_port_id)
-        {
-            port = it.second;
-            return true;
-        }
+        return false;
     }
 
-    return false;
+    port = *p;
+    return true;
 }
 
 bool PortsOrch::addSubPort(Port &port, const string &alias, const bool &adminUp, const uint32_t &mtu)
@@ -1946,7 +2013,9 @@ void PortsOrch::updateDbPortOperStatus(const Port& port, sai_port_oper_status_t
     vector<FieldValueTuple> tuples;
     FieldValueTuple tuple("oper_status", oper_status_strings.at(status));
     tuples.push_back(tuple);
-    m_portTable->set(port.m_alias, tuples);
+
+    /* A link flap updates many ports at once, batch the writes */
+    BatchedDbWriter::get("APPL_DB").set(APP_PORT_TABLE_NAME, port.m_alias, tuples);
 }
 
 bool PortsOrch::addPort(const set<int> &lane_set, uint32_t speed, int an, string fec_mode)
@@ -2238,6 +2307,14 @@ void PortsOrch::doPortTask(Consumer &consumer)
 {
     SWSS_LOG_ENTER();
 
+    /*
+     * PortConfigDone and PortInitDone must be handled after the port keys
+     * received along with them, m_toSync being in arrival order. E.g. at warm
+     * restart the table is replayed in getKeys() order.
+     */
+    consumer.m_toSync.moveToBack("PortConfigDone");
+    consumer.m_toSync.moveToBack("PortInitDone");
+
     auto it = consumer.m_toSync.begin();
     while (it != consumer.m_toSync.end())
     {
@@ -3941,16 +4018,14 @@ bool PortsOrch::getVlanByVlanId(sai_vlan_id_t vlan_id, Port &vlan)
 {
     SWSS_LOG_ENTER();
 
-    for (auto &it: m_portList)
+    Port *p = findVlanByVlanId(vlan_id);
+    if (p == nullptr)
     {
-        if (it.second.m_type == Port::VLAN && it.second.m_vlan_info.vlan_id == vlan_id)
-        {
-            vlan = it.second;
-            return true;
-        }
+        return false;
     }
 
-    return false;
+    vlan = *p;
+    return true;
 }
 
 bool PortsOrch::addVlanMember(Port &vlan, Port &port, string &tagging_mode)
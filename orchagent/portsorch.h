@@ -91,6 +91,19 @@ public:
     void increasePortRefCount(const string &alias);
     void decreasePortRefCount(const string &alias);
     bool getPortByBridgePortId(sai_object_id_t bridge_port_id, Port &port);
+
+    /*
+     * Lookups without copying the port, through indexes of the port, LAG,
+     * VLAN, bridge port and router interface OIDs and of the VLAN IDs.
+     * Return null if there is no such port. The port may be updated in place
+     * and stays valid until it is removed from PortsOrch.
+     */
+    Port *findPort(const string &alias);
+    Port *findPort(sai_object_id_t id);
+    Port *findPortByBridgePortId(sai_object_id_t bridge_port_id);
+    Port *findPortByRifId(sai_object_id_t rif_id);
+    Port *findVlanByVlanId(sai_vlan_id_t vlan_id);
+
     void setPort(string alias, Port port);
     void getCpuPort(Port &port);
     bool getInbandPort(Port &port);
@@ -207,6 +220,15 @@ private:
     map<set<int>, sai_object_id_t> m_portListLaneMap;
     map<set<int>, tuple<string, uint32_t, int, string, int>> m_lanesAliasSpeedMap;
     map<string, Port> m_portList;
+    /*
+     * Secondary indexes of m_portList to the port alias, an entry is checked
+     * against the port on lookup and refreshed by a scan if it is stale
+     */
+    typedef unordered_map<sai_object_id_t, string> PortIndex;
+    PortIndex m_portIdIndex;
+    PortIndex m_bridgePortIdIndex;
+    PortIndex m_rifIdIndex;
+    PortIndex m_vlanIdIndex;
     unordered_map<sai_object_id_t, int> m_portOidToIndex;
     map<string, uint32_t> m_port_ref_count;
     unordered_set<string> m_pendingPortSet;
@@ -284,6 +306,9 @@ private:
     bool setPortFecMode(sai_object_id_t id, int fec);
 
     bool getPortOperStatus(const Port& port, sai_port_oper_status_t& status) const;
+
+    Port *findIndexedPort(PortIndex &index, sai_object_id_t id, bool (*match)(const Port &, sai_object_id_t));
+
     void updatePortOperStatus(Port &port, sai_port_oper_status_t status);
 
     void getPortSerdesVal(const std::string& s, std::vector<uint32_t> &lane_values);
@@ -1,6 +1,7 @@
 #include <assert.h>
 #include <inttypes.h>
 #include <algorithm>
+#include <future>
 #include "routeorch.h"
 #include "logger.h"
 #include "swssnet.h"
@@ -17,6 +18,7 @@ extern sai_switch_api_t*            sai_switch_api;
 extern PortsOrch *gPortsOrch;
 extern CrmOrch *gCrmOrch;
 extern Directory<Orch*> gDirectory;
+extern int gRouteBatchSize;
 
 /* Default maximum number of next hop groups */
 #define DEFAULT_NUMBER_OF_ECMP_GROUPS   128
@@ -404,370 +406,487 @@ void RouteOrch::doTask(Consumer& consumer)
     }
 
     auto it = consumer.m_toSync.begin();
-    while (it != consumer.m_toSync.end())
+    unique_ptr<RouteBatch> batch(new RouteBatch());
+
+    while (true)
     {
-        // Route bulk results will be stored in a map
-        std::map<
-                std::pair<
-                        std::string,            // Key
-                        std::string             // Op
-                >,
-                RouteBulkContext
-        >                                       toBulk;
+        if (batch->entries.empty())
+        {
+            if (it == consumer.m_toSync.end())
+            {
+                break;
+            }
+
+            /* Resync adds new tasks to m_toSync, so it is handled between batches */
+            if (kfvKey(it->second) == "resync")
+            {
+                it = doResyncTask(consumer, it);
+            }
+            else
+            {
+                it = parseRouteBatch(consumer, it, *batch);
+            }
+            continue;
+        }
+
+        size_t first = batch->applied;
 
         // Add or remove routes with a route bulker
-        while (it != consumer.m_toSync.end())
+        applyRouteBatch(consumer, *batch);
+
+        bool done = batch->applied == batch->entries.size();
+
+        unique_ptr<RouteBatch> next(new RouteBatch());
+        if (done && gRouteBatchSize > 0 && it != consumer.m_toSync.end())
+        {
+            /*
+             * Parse the next batch while the route bulker writes the
+             * current one to syncd. Parsing only reads m_toSync entries
+             * which are not part of the current batch, all the route and
+             * next hop group state is still updated in batch order, so at
+             * most one batch is in flight and one is parsed ahead.
+             */
+            auto flushed = async(launch::async, [this]() { gRouteBulker.flush(); });
+            it = parseRouteBatch(consumer, it, *next);
+            flushed.get();
+        }
+        else
         {
-            KeyOpFieldsValuesTuple t = it->second;
+            // Flush the route bulker, so routes will be written to syncd and ASIC
+            gRouteBulker.flush();
+        }
+
+        // Go through the bulker results
+        postRouteBatch(consumer, *batch, first);
+
+        if (!done)
+        {
+            // Released next hop groups are removed by now, apply the rest of the batch
+            continue;
+        }
+
+        batch = move(next);
+    }
+}
 
-            string key = kfvKey(t);
-            string op = kfvOp(t);
+SyncMap::iterator RouteOrch::doResyncTask(Consumer& consumer, SyncMap::iterator it)
+{
+    SWSS_LOG_ENTER();
 
-            auto rc = toBulk.emplace(std::piecewise_construct,
-                    std::forward_as_tuple(key, op),
-                    std::forward_as_tuple());
+    /* Get notification from application */
+    /* resync application:
+     * When routeorch receives 'resync' message, it marks all current
+     * routes as dirty and waits for 'resync complete' message. For all
+     * newly received routes, if they match current dirty routes, it unmarks
+     * them dirty. After receiving 'resync complete' message, it creates all
+     * newly added routes and removes all dirty routes.
+     */
+    if (kfvOp(it->second) == "SET")
+    {
+        /* Mark all current routes as dirty (DEL) in consumer.m_toSync map */
+        SWSS_LOG_NOTICE("Start resync routes\n");
+        for (auto j : m_syncdRoutes)
+        {
+            string vrf;
 
-            bool inserted = rc.second;
-            auto& ctx = rc.first->second;
-            if (!inserted)
+            if (j.first != gVirtualRouterId)
             {
-                ctx.clear();
+                vrf = m_vrfOrch->getVRFname(j.first) + ":";
             }
 
-            /* Get notification from application */
-            /* resync application:
-             * When routeorch receives 'resync' message, it marks all current
-             * routes as dirty and waits for 'resync complete' message. For all
-             * newly received routes, if they match current dirty routes, it unmarks
-             * them dirty. After receiving 'resync complete' message, it creates all
-             * newly added routes and removes all dirty routes.
-             */
-            if (key == "resync")
+            for (auto i : j.second)
             {
-                if (op == "SET")
-                {
-                    /* Mark all current routes as dirty (DEL) in consumer.m_toSync map */
-                    SWSS_LOG_NOTICE("Start resync routes\n");
-                    for (auto j : m_syncdRoutes)
-                    {
-                        string vrf;
+                vector<FieldValueTuple> v;
+                string key = vrf + i.first.to_string();
+                auto x = KeyOpFieldsValuesTuple(key, DEL_COMMAND, v);
+                consumer.addToSync(x);
+            }
+        }
+        m_resync = true;
+    }
+    else
+    {
+        SWSS_LOG_NOTICE("Complete resync routes\n");
+        m_resync = false;
+    }
 
-                        if (j.first != gVirtualRouterId)
-                        {
-                            vrf = m_vrfOrch->getVRFname(j.first) + ":";
-                        }
+    return consumer.m_toSync.erase(it);
+}
 
-                        for (auto i : j.second)
-                        {
-                            vector<FieldValueTuple> v;
-                            key = vrf + i.first.to_string();
-                            auto x = KeyOpFieldsValuesTuple(key, DEL_COMMAND, v);
-                            consumer.addToSync(x);
-                        }
-                    }
-                    m_resync = true;
-                }
-                else
-                {
-                    SWSS_LOG_NOTICE("Complete resync routes\n");
-                    m_resync = false;
-                }
+SyncMap::iterator RouteOrch::parseRouteBatch(Consumer& consumer, SyncMap::iterator it, RouteBatch& batch)
+{
+    SWSS_LOG_ENTER();
 
-                it = consumer.m_toSync.erase(it);
-                continue;
-            }
+    size_t batch_size = gRouteBatchSize > 0 ? (size_t)gRouteBatchSize : SIZE_MAX;
 
-            if (m_resync)
-            {
-                it++;
-                continue;
-            }
+    while (it != consumer.m_toSync.end())
+    {
+        const KeyOpFieldsValuesTuple& t = it->second;
 
-            sai_object_id_t& vrf_id = ctx.vrf_id;
-            IpPrefix& ip_prefix = ctx.ip_prefix;
+        if (kfvKey(t) == "resync")
+        {
+            break;
+        }
 
-            if (!key.compare(0, strlen(VRF_PREFIX), VRF_PREFIX))
-            {
-                size_t found = key.find(':');
-                string vrf_name = key.substr(0, found);
+        /*
+         * A DEL and SET of the same prefix may end up in consecutive
+         * batches, the SET is then applied after the removal completed.
+         */
+        if (batch.entries.size() >= batch_size)
+        {
+            break;
+        }
 
-                if (!m_vrfOrch->isVRFexists(vrf_name))
-                {
-                    it++;
-                    continue;
-                }
-                vrf_id = m_vrfOrch->getVRFid(vrf_name);
-                ip_prefix = IpPrefix(key.substr(found+1));
-            }
-            else
-            {
-                vrf_id = gVirtualRouterId;
-                ip_prefix = IpPrefix(key);
-            }
+        batch.entries.push_back(it);
+        batch.contexts.emplace_back();
+        parseRoute(t, batch.contexts.back());
+        it++;
+    }
 
-            if (op == SET_COMMAND)
-            {
-                string ips;
-                string aliases;
-                string vni_labels;
-                string remote_macs;
-                bool& excp_intfs_flag = ctx.excp_intfs_flag;
-                bool overlay_nh = false;
-
-                for (auto i : kfvFieldsValues(t))
-                {
-                    if (fvField(i) == "nexthop")
-                        ips = fvValue(i);
+    return it;
+}
 
-                    if (fvField(i) == "ifname")
-                        aliases = fvValue(i);
+void RouteOrch::parseRoute(const KeyOpFieldsValuesTuple& t, RouteBulkContext& ctx)
+{
+    SWSS_LOG_ENTER();
 
-                    if (fvField(i) == "vni_label") {
-                        vni_labels = fvValue(i);
-                        overlay_nh = true;
-                    }
+    const string& key = kfvKey(t);
+    const string& op = kfvOp(t);
 
-                    if (fvField(i) == "router_mac")
-                        remote_macs = fvValue(i);
-                }
+    IpPrefix& ip_prefix = ctx.ip_prefix;
 
-                vector<string>& ipv = ctx.ipv;
-                ipv = tokenize(ips, ',');
-                vector<string> alsv = tokenize(aliases, ',');
-                vector<string> vni_labelv = tokenize(vni_labels, ',');
-                vector<string> rmacv = tokenize(remote_macs, ',');
+    if (!key.compare(0, strlen(VRF_PREFIX), VRF_PREFIX))
+    {
+        size_t found = key.find(':');
+        ctx.vrf_name = key.substr(0, found);
+        ip_prefix = IpPrefix(key.substr(found+1));
+    }
+    else
+    {
+        ip_prefix = IpPrefix(key);
+    }
 
-                /*
-                 * For backward compatibility, adjust ip string from old format to
-                 * new format. Meanwhile it can deal with some abnormal cases.
-                 */
+    if (op != SET_COMMAND)
+    {
+        return;
+    }
 
-                /* Resize the ip vector to match ifname vector
-                 * as tokenize(",", ',') will miss the last empty segment. */
-                if (alsv.size() == 0)
-                {
-                    SWSS_LOG_WARN("Skip the route %s, for it has an empty ifname field.", key.c_str());
-                    it = consumer.m_toSync.erase(it);
-                    continue;
-                }
-                else if (alsv.size() != ipv.size())
-                {
-                    SWSS_LOG_NOTICE("Route %s: resize ipv to match alsv, %zd -> %zd.", key.c_str(), ipv.size(), alsv.size());
-                    ipv.resize(alsv.size());
-                }
+    string ips;
+    string aliases;
+    string vni_labels;
+    string remote_macs;
+    bool& excp_intfs_flag = ctx.excp_intfs_flag;
+    bool overlay_nh = false;
 
-                /* Set the empty ip(s) to zero
-                 * as IpAddress("") will construct a incorrect ip. */
-                for (auto &ip : ipv)
-                {
-                    if (ip.empty())
-                    {
-                        SWSS_LOG_NOTICE("Route %s: set the empty nexthop ip to zero.", key.c_str());
-                        ip = ip_prefix.isV4() ? "0.0.0.0" : "::";
-                    }
-                }
+    for (auto i : kfvFieldsValues(t))
+    {
+        if (fvField(i) == "nexthop")
+            ips = fvValue(i);
 
-                for (auto alias : alsv)
-                {
-                    /* skip route to management, docker, loopback
-                     * TODO: for route to loopback interface, the proper
-                     * way is to create loopback interface and then create
-                     * route pointing to it, so that we can traps packets to
-                     * CPU */
-                    if (alias == "eth0" || alias == "docker0" || alias == "tun0" ||
-                        alias == "lo" || !alias.compare(0, strlen(LOOPBACK_PREFIX), LOOPBACK_PREFIX))
-                    {
-                        excp_intfs_flag = true;
-                        break;
-                    }
-                }
+        if (fvField(i) == "ifname")
+            aliases = fvValue(i);
 
-                // TODO: cannot trust m_portsOrch->getPortIdByAlias because sometimes alias is empty
-                if (excp_intfs_flag)
-                {
-                    /* If any existing routes are updated to point to the
-                     * above interfaces, remove them from the ASIC. */
-                    if (removeRoute(ctx))
-                        it = consumer.m_toSync.erase(it);
-                    else
-                        it++;
-                    continue;
-                }
+        if (fvField(i) == "vni_label") {
+            vni_labels = fvValue(i);
+            overlay_nh = true;
+        }
 
-                string nhg_str = "";
-                NextHopGroupKey& nhg = ctx.nhg;
+        if (fvField(i) == "router_mac")
+            remote_macs = fvValue(i);
+    }
 
-                if (overlay_nh == false)
-                {
-                    nhg_str = ipv[0] + NH_DELIMITER + alsv[0];
+    vector<string>& ipv = ctx.ipv;
+    ipv = tokenize(ips, ',');
+    vector<string>& alsv = ctx.alsv;
+    alsv = tokenize(aliases, ',');
+    vector<string> vni_labelv = tokenize(vni_labels, ',');
+    vector<string> rmacv = tokenize(remote_macs, ',');
 
-                    for (uint32_t i = 1; i < ipv.size(); i++)
-                    {
-                        nhg_str += NHG_DELIMITER + ipv[i] + NH_DELIMITER + alsv[i];
-                    }
+    /*
+     * For backward compatibility, adjust ip string from old format to
+     * new format. Meanwhile it can deal with some abnormal cases.
+     */
+
+    /* Resize the ip vector to match ifname vector
+     * as tokenize(",", ',') will miss the last empty segment. */
+    if (alsv.size() == 0)
+    {
+        /* Skipped when the route is applied */
+        return;
+    }
+    else if (alsv.size() != ipv.size())
+    {
+        SWSS_LOG_NOTICE("Route %s: resize ipv to match alsv, %zd -> %zd.", key.c_str(), ipv.size(), alsv.size());
+        ipv.resize(alsv.size());
+    }
 
-                    nhg = NextHopGroupKey(nhg_str);
+    /* Set the empty ip(s) to zero
+     * as IpAddress("") will construct a incorrect ip. */
+    for (auto &ip : ipv)
+    {
+        if (ip.empty())
+        {
+            SWSS_LOG_NOTICE("Route %s: set the empty nexthop ip to zero.", key.c_str());
+            ip = ip_prefix.isV4() ? "0.0.0.0" : "::";
+        }
+    }
 
-                }
-                else
-                {
-                    nhg_str = ipv[0] + NH_DELIMITER + "vni" + alsv[0] + NH_DELIMITER + vni_labelv[0] + NH_DELIMITER + rmacv[0];
-                    for (uint32_t i = 1; i < ipv.size(); i++)
-                    {
-                        nhg_str += NHG_DELIMITER + ipv[i] + NH_DELIMITER + "vni" + alsv[i] + NH_DELIMITER + vni_labelv[i] + NH_DELIMITER + rmacv[i];
-                    }
+    for (auto alias : alsv)
+    {
+        /* skip route to management, docker, loopback
+         * TODO: for route to loopback interface, the proper
+         * way is to create loopback interface and then create
+         * route pointing to it, so that we can traps packets to
+         * CPU */
+        if (alias == "eth0" || alias == "docker0" || alias == "tun0" ||
+            alias == "lo" || !alias.compare(0, strlen(LOOPBACK_PREFIX), LOOPBACK_PREFIX))
+        {
+            excp_intfs_flag = true;
+            break;
+        }
+    }
+
+    if (excp_intfs_flag)
+    {
+        return;
+    }
+
+    string nhg_str = "";
+    NextHopGroupKey& nhg = ctx.nhg;
+
+    if (overlay_nh == false)
+    {
+        nhg_str = ipv[0] + NH_DELIMITER + alsv[0];
+
+        for (uint32_t i = 1; i < ipv.size(); i++)
+        {
+            nhg_str += NHG_DELIMITER + ipv[i] + NH_DELIMITER + alsv[i];
+        }
+
+        nhg = NextHopGroupKey(nhg_str);
+
+    }
+    else
+    {
+        nhg_str = ipv[0] + NH_DELIMITER + "vni" + alsv[0] + NH_DELIMITER + vni_labelv[0] + NH_DELIMITER + rmacv[0];
+        for (uint32_t i = 1; i < ipv.size(); i++)
+        {
+            nhg_str += NHG_DELIMITER + ipv[i] + NH_DELIMITER + "vni" + alsv[i] + NH_DELIMITER + vni_labelv[i] + NH_DELIMITER + rmacv[i];
+        }
+
+        nhg = NextHopGroupKey(nhg_str, overlay_nh);
+    }
+}
+
+void RouteOrch::applyRouteBatch(Consumer& consumer, RouteBatch& batch)
+{
+    SWSS_LOG_ENTER();
+
+    while (batch.applied < batch.entries.size())
+    {
+        auto& it = batch.entries[batch.applied];
+        auto& ctx = batch.contexts[batch.applied];
+        batch.applied++;
+
+        string key = kfvKey(it->second);
+        string op = kfvOp(it->second);
+
+        if (m_resync)
+        {
+            continue;
+        }
+
+        sai_object_id_t& vrf_id = ctx.vrf_id;
+        const IpPrefix& ip_prefix = ctx.ip_prefix;
+
+        if (!ctx.vrf_name.empty())
+        {
+            if (!m_vrfOrch->isVRFexists(ctx.vrf_name))
+            {
+                consumer.parkUntil(key, make_pair(RETRY_EVENT_VRF_ADDED, ctx.vrf_name));
+                continue;
+            }
+            vrf_id = m_vrfOrch->getVRFid(ctx.vrf_name);
+        }
+        else
+        {
+            vrf_id = gVirtualRouterId;
+        }
+
+        bool erase = false;
+
+        if (op == SET_COMMAND)
+        {
+            const vector<string>& ipv = ctx.ipv;
+            const vector<string>& alsv = ctx.alsv;
+
+            if (alsv.size() == 0)
+            {
+                SWSS_LOG_WARN("Skip the route %s, for it has an empty ifname field.", key.c_str());
+                consumer.m_toSync.erase(it);
+                it = consumer.m_toSync.end();
+                continue;
+            }
 
-                    nhg = NextHopGroupKey(nhg_str, overlay_nh);
+            // TODO: cannot trust m_portsOrch->getPortIdByAlias because sometimes alias is empty
+            if (ctx.excp_intfs_flag)
+            {
+                /* If any existing routes are updated to point to the
+                 * above interfaces, remove them from the ASIC. */
+                if (removeRoute(ctx))
+                {
+                    consumer.m_toSync.erase(it);
+                    it = consumer.m_toSync.end();
                 }
+                continue;
+            }
 
-                if (ipv.size() == 1 && IpAddress(ipv[0]).isZero())
+            const NextHopGroupKey& nhg = ctx.nhg;
+
+            if (ipv.size() == 1 && IpAddress(ipv[0]).isZero())
+            {
+                /* blackhole to be done */
+                if (alsv[0] == "unknown")
                 {
-                    /* blackhole to be done */
-                    if (alsv[0] == "unknown")
-                    {
-                        /* add addBlackholeRoute or addRoute support empty nhg */
-                        it = consumer.m_toSync.erase(it);
-                    }
-                    /* directly connected route to VRF interface which come from kernel */
-                    else if (!alsv[0].compare(0, strlen(VRF_PREFIX), VRF_PREFIX))
-                    {
-                        it = consumer.m_toSync.erase(it);
-                    }
-                    /* skip prefix which is linklocal or multicast */
-                    else if (ip_prefix.getIp().getAddrScope() != IpAddress::GLOBAL_SCOPE)
-                    {
-                        it = consumer.m_toSync.erase(it);
-                    }
-                    /* fullmask subnet route is same as ip2me route */
-                    else if (ip_prefix.isFullMask() && m_intfsOrch->isPrefixSubnet(ip_prefix, alsv[0]))
-                    {
-                        it = consumer.m_toSync.erase(it);
-                    }
-                    /* subnet route, vrf leaked route, etc */
-                    else
-                    {
-                        if (addRoute(ctx, nhg))
-                            it = consumer.m_toSync.erase(it);
-                        else
-                            it++;
-                    }
+                    /* add addBlackholeRoute or addRoute support empty nhg */
+                    erase = true;
                 }
-                else if (m_syncdRoutes.find(vrf_id) == m_syncdRoutes.end() ||
-                    m_syncdRoutes.at(vrf_id).find(ip_prefix) == m_syncdRoutes.at(vrf_id).end() ||
-                    m_syncdRoutes.at(vrf_id).at(ip_prefix) != nhg)
+                /* directly connected route to VRF interface which come from kernel */
+                else if (!alsv[0].compare(0, strlen(VRF_PREFIX), VRF_PREFIX))
                 {
-                    if (addRoute(ctx, nhg))
-                        it = consumer.m_toSync.erase(it);
-                    else
-                        it++;
+                    erase = true;
+                }
+                /* skip prefix which is linklocal or multicast */
+                else if (ip_prefix.getIp().getAddrScope() != IpAddress::GLOBAL_SCOPE)
+                {
+                    erase = true;
                 }
+                /* fullmask subnet route is same as ip2me route */
+                else if (ip_prefix.isFullMask() && m_intfsOrch->isPrefixSubnet(ip_prefix, alsv[0]))
+                {
+                    erase = true;
+                }
+                /* subnet route, vrf leaked route, etc */
                 else
-                    /* Duplicate entry */
-                    it = consumer.m_toSync.erase(it);
-
-                // If already exhaust the nexthop groups, and there are pending removing routes in bulker,
-                // flush the bulker and possibly collect some released nexthop groups
-                if (m_nextHopGroupCount >= m_maxNextHopGroupCount && gRouteBulker.removing_entries_count() > 0)
                 {
-                    break;
+                    erase = addRoute(ctx, nhg);
+                    if (!erase && ctx.park)
+                        consumer.parkUntil(key, ctx.retry_constraint);
                 }
             }
-            else if (op == DEL_COMMAND)
+            else if (m_syncdRoutes.find(vrf_id) == m_syncdRoutes.end() ||
+                m_syncdRoutes.at(vrf_id).find(ip_prefix) == m_syncdRoutes.at(vrf_id).end() ||
+                m_syncdRoutes.at(vrf_id).at(ip_prefix) != nhg)
             {
-                if (removeRoute(ctx))
-                    it = consumer.m_toSync.erase(it);
-                else
-                    it++;
+                erase = addRoute(ctx, nhg);
+                if (!erase && ctx.park)
+                    consumer.parkUntil(key, ctx.retry_constraint);
             }
             else
+                /* Duplicate entry */
+                erase = true;
+
+            if (erase)
             {
-                SWSS_LOG_ERROR("Unknown operation type %s\n", op.c_str());
-                it = consumer.m_toSync.erase(it);
+                consumer.m_toSync.erase(it);
+                it = consumer.m_toSync.end();
             }
-        }
-
-        // Flush the route bulker, so routes will be written to syncd and ASIC
-        gRouteBulker.flush();
-
-        // Go through the bulker results
-        auto it_prev = consumer.m_toSync.begin();
-        m_bulkNhgReducedRefCnt.clear();
-        while (it_prev != it)
-        {
-            KeyOpFieldsValuesTuple t = it_prev->second;
 
-            string key = kfvKey(t);
-            string op = kfvOp(t);
-            auto found = toBulk.find(make_pair(key, op));
-            if (found == toBulk.end())
+            // If already exhaust the nexthop groups, and there are pending removing routes in bulker,
+            // flush the bulker and possibly collect some released nexthop groups
+            if (m_nextHopGroupCount >= m_maxNextHopGroupCount && gRouteBulker.removing_entries_count() > 0)
             {
-                it_prev++;
-                continue;
+                break;
             }
-
-            const auto& ctx = found->second;
-            const auto& object_statuses = ctx.object_statuses;
-            if (object_statuses.empty())
+        }
+        else if (op == DEL_COMMAND)
+        {
+            if (removeRoute(ctx))
             {
-                it_prev++;
-                continue;
+                consumer.m_toSync.erase(it);
+                it = consumer.m_toSync.end();
             }
+        }
+        else
+        {
+            SWSS_LOG_ERROR("Unknown operation type %s\n", op.c_str());
+            consumer.m_toSync.erase(it);
+            it = consumer.m_toSync.end();
+        }
+    }
+}
 
-            const sai_object_id_t& vrf_id = ctx.vrf_id;
-            const IpPrefix& ip_prefix = ctx.ip_prefix;
+void RouteOrch::postRouteBatch(Consumer& consumer, RouteBatch& batch, size_t first)
+{
+    SWSS_LOG_ENTER();
 
-            if (op == SET_COMMAND)
-            {
-                const bool& excp_intfs_flag = ctx.excp_intfs_flag;
-                const vector<string>& ipv = ctx.ipv;
+    m_bulkNhgReducedRefCnt.clear();
+    for (size_t i = first; i < batch.applied; i++)
+    {
+        auto& it = batch.entries[i];
+        if (it == consumer.m_toSync.end())
+        {
+            continue;
+        }
 
-                if (excp_intfs_flag)
-                {
-                    /* If any existing routes are updated to point to the
-                     * above interfaces, remove them from the ASIC. */
-                    if (removeRoutePost(ctx))
-                        it_prev = consumer.m_toSync.erase(it_prev);
-                    else
-                        it_prev++;
-                    continue;
-                }
+        const auto& ctx = batch.contexts[i];
+        const auto& object_statuses = ctx.object_statuses;
+        if (object_statuses.empty())
+        {
+            continue;
+        }
 
+        const string& op = kfvOp(it->second);
+        const sai_object_id_t& vrf_id = ctx.vrf_id;
+        const IpPrefix& ip_prefix = ctx.ip_prefix;
+        bool erase = false;
+
+        if (op == SET_COMMAND)
+        {
+            const bool& excp_intfs_flag = ctx.excp_intfs_flag;
+            const vector<string>& ipv = ctx.ipv;
+
+            if (excp_intfs_flag)
+            {
+                /* If any existing routes are updated to point to the
+                 * above interfaces, remove them from the ASIC. */
+                erase = removeRoutePost(ctx);
+            }
+            else
+            {
                 const NextHopGroupKey& nhg = ctx.nhg;
 
                 if (ipv.size() == 1 && IpAddress(ipv[0]).isZero())
                 {
-                    if (addRoutePost(ctx, nhg))
-                        it_prev = consumer.m_toSync.erase(it_prev);
-                    else
-                        it_prev++;
+                    erase = addRoutePost(ctx, nhg);
                 }
                 else if (m_syncdRoutes.find(vrf_id) == m_syncdRoutes.end() ||
                     m_syncdRoutes.at(vrf_id).find(ip_prefix) == m_syncdRoutes.at(vrf_id).end() ||
                     m_syncdRoutes.at(vrf_id).at(ip_prefix) != nhg)
                 {
-                    if (addRoutePost(ctx, nhg))
-                        it_prev = consumer.m_toSync.erase(it_prev);
-                    else
-                        it_prev++;
+                    erase = addRoutePost(ctx, nhg);
                 }
             }
-            else if (op == DEL_COMMAND)
-            {
-                /* Cannot locate the route or remove succeed */
-                if (removeRoutePost(ctx))
-                    it_prev = consumer.m_toSync.erase(it_prev);
-                else
-                    it_prev++;
-            }
+        }
+        else if (op == DEL_COMMAND)
+        {
+            /* Cannot locate the route or remove succeed */
+            erase = removeRoutePost(ctx);
         }
 
-        /* Remove next hop group if the reference count decreases to zero */
-        for (auto it_nhg = m_bulkNhgReducedRefCnt.begin(); it_nhg != m_bulkNhgReducedRefCnt.end(); it_nhg++)
+        if (erase)
         {
-            if (m_syncdNextHopGroups[*it_nhg].ref_count == 0)
-            {
-                removeNextHopGroup(*it_nhg);
-            }
+            consumer.m_toSync.erase(it);
+            it = consumer.m_toSync.end();
+        }
+    }
+
+    /* Remove next hop group if the reference count decreases to zero */
+    for (auto it_nhg = m_bulkNhgReducedRefCnt.begin(); it_nhg != m_bulkNhgReducedRefCnt.end(); it_nhg++)
+    {
+        if (m_syncdNextHopGroups[*it_nhg].ref_count == 0)
+        {
+            removeNextHopGroup(*it_nhg);
         }
     }
 }
@@ -1007,12 +1126,11 @@ bool RouteOrch::addNextHopGroup(const NextHopGroupKey &nexthops)
     }
 
     vector<sai_object_id_t> next_hop_ids;
-    set<NextHopKey> next_hop_set = nexthops.getNextHops();
     std::map<sai_object_id_t, NextHopKey> nhopgroup_members_set;
 
     /* Assert each IP address exists in m_syncdNextHops table,
      * and add the corresponding next_hop_id to next_hop_ids. */
-    for (auto it : next_hop_set)
+    for (const auto &it : nexthops)
     {
         if (!m_neighOrch->hasNextHop(it))
         {
@@ -1108,7 +1226,7 @@ bool RouteOrch::addNextHopGroup(const NextHopGroupKey &nexthops)
     }
 
     /* Increment the ref_count for the next hops used by the next hop group. */
-    for (auto it : next_hop_set)
+    for (const auto &it : nexthops)
         m_neighOrch->increaseNextHopRefCount(it);
 
     /*
@@ -1194,8 +1312,7 @@ bool RouteOrch::removeNextHopGroup(const NextHopGroupKey &nexthops)
     m_nextHopGroupCount --;
     gCrmOrch->decCrmResUsedCounter(CrmResourceType::CRM_NEXTHOP_GROUP);
 
-    set<NextHopKey> next_hop_set = nexthops.getNextHops();
-    for (auto it : next_hop_set)
+    for (const auto &it : nexthops)
     {
         m_neighOrch->decreaseNextHopRefCount(it);
         if (overlay_nh && !m_neighOrch->getNextHopRefCount(it))
@@ -1225,47 +1342,106 @@ bool RouteOrch::removeNextHopGroup(const NextHopGroupKey &nexthops)
 bool RouteOrch::updateNextHopRoutes(const NextHopKey& nextHop, uint32_t& numRoutes)
 {
     numRoutes = 0;
-    sai_route_entry_t route_entry;
+
+    /* Only routes pointing to this single next hop are affected, ECMP routes
+     * are updated through their next hop group members */
+    auto it_routes = m_nextHopRoutes.find(nextHop);
+    if (it_routes == m_nextHopRoutes.end())
+    {
+        return true;
+    }
+
     sai_attribute_t route_attr;
-    sai_object_id_t next_hop_id;
+    route_attr.id = SAI_ROUTE_ENTRY_ATTR_NEXT_HOP_ID;
+    route_attr.value.oid = m_neighOrch->getNextHopId(nextHop);
+
+    /* The bulker keeps pointers to the statuses until it is flushed */
+    std::deque<sai_status_t> statuses;
+
+    for (const auto& route : it_routes->second)
+    {
+        SWSS_LOG_INFO("Updating route %s during nexthop status change",
+                       route.second.to_string().c_str());
+
+        sai_route_entry_t route_entry;
+        route_entry.vr_id = route.first;
+        route_entry.switch_id = gSwitchId;
+        copy(route_entry.destination, route.second);
+
+        statuses.emplace_back();
+        gRouteBulker.set_entry_attribute(&statuses.back(), &route_entry, &route_attr);
+    }
+
+    gRouteBulker.flush();
 
-    for (auto rt_table : m_syncdRoutes)
+    bool success = true;
+    auto it_status = statuses.begin();
+    for (const auto& route : it_routes->second)
     {
-        for (auto rt_entry : rt_table.second)
+        sai_status_t status = *it_status++;
+        if (status != SAI_STATUS_SUCCESS)
         {
-            // Skip routes with ecmp nexthops
-            if (rt_entry.second.getSize() > 1)
-            {
-                continue;
-            }
+            SWSS_LOG_ERROR("Failed to update route %s, rv:%d",
+                            route.second.to_string().c_str(), status);
+            success = false;
+            continue;
+        }
 
-            if (rt_entry.second.contains(nextHop))
-            {
-                SWSS_LOG_INFO("Updating route %s during nexthop status change",
-                               rt_entry.first.to_string().c_str());
-                next_hop_id = m_neighOrch->getNextHopId(nextHop);
+        ++numRoutes;
+    }
+
+    return success;
+}
 
-                route_entry.vr_id = rt_table.first;
-                route_entry.switch_id = gSwitchId;
-                copy(route_entry.destination, rt_entry.first);
+const std::set<RouteKey>* RouteOrch::getNextHopGroupRoutes(const NextHopGroupKey& nexthops) const
+{
+    auto it_routes = m_nextHopGroupRoutes.find(nexthops);
+    if (it_routes == m_nextHopGroupRoutes.end())
+    {
+        return nullptr;
+    }
 
-                route_attr.id = SAI_ROUTE_ENTRY_ATTR_NEXT_HOP_ID;
-                route_attr.value.oid = next_hop_id;
+    return &it_routes->second;
+}
 
-                sai_status_t status = sai_route_api->set_route_entry_attribute(&route_entry, &route_attr);
-                if (status != SAI_STATUS_SUCCESS)
-                {
-                    SWSS_LOG_ERROR("Failed to update route %s, rv:%d",
-                                    rt_entry.first.to_string().c_str(), status);
-                    return false;
-                }
+void RouteOrch::addRouteIndex(sai_object_id_t vrf_id, const IpPrefix& ipPrefix, const NextHopGroupKey& nextHops)
+{
+    if (nextHops.getSize() == 1)
+    {
+        m_nextHopRoutes[nextHops.getFirstNextHop()].emplace(vrf_id, ipPrefix);
+    }
+    else if (nextHops.getSize() > 1)
+    {
+        m_nextHopGroupRoutes[nextHops].emplace(vrf_id, ipPrefix);
+    }
+}
 
-                ++numRoutes;
+void RouteOrch::removeRouteIndex(sai_object_id_t vrf_id, const IpPrefix& ipPrefix, const NextHopGroupKey& nextHops)
+{
+    if (nextHops.getSize() == 1)
+    {
+        auto it_routes = m_nextHopRoutes.find(nextHops.getFirstNextHop());
+        if (it_routes != m_nextHopRoutes.end())
+        {
+            it_routes->second.erase(make_pair(vrf_id, ipPrefix));
+            if (it_routes->second.empty())
+            {
+                m_nextHopRoutes.erase(it_routes);
+            }
+        }
+    }
+    else if (nextHops.getSize() > 1)
+    {
+        auto it_routes = m_nextHopGroupRoutes.find(nextHops);
+        if (it_routes != m_nextHopGroupRoutes.end())
+        {
+            it_routes->second.erase(make_pair(vrf_id, ipPrefix));
+            if (it_routes->second.empty())
+            {
+                m_nextHopGroupRoutes.erase(it_routes);
             }
         }
     }
-
-    return true;
 }
 
 void RouteOrch::addTempRoute(RouteBulkContext& ctx, const NextHopGroupKey &nextHops)
@@ -1366,6 +1542,8 @@ bool RouteOrch::addRoute(RouteBulkContext& ctx, const NextHopGroupKey &nextHops)
             {
                 SWSS_LOG_INFO("Failed to get next hop %s for %s",
                         nextHops.to_string().c_str(), ipPrefix.to_string().c_str());
+                ctx.park = true;
+                ctx.retry_constraint = make_pair(RETRY_EVENT_RIF_ADDED, nexthop.alias);
                 return false;
             }
         }
@@ -1397,6 +1575,8 @@ bool RouteOrch::addRoute(RouteBulkContext& ctx, const NextHopGroupKey &nextHops)
                 {
                     SWSS_LOG_INFO("Failed to get next hop %s for %s",
                             nextHops.to_string().c_str(), ipPrefix.to_string().c_str());
+                    ctx.park = true;
+                    ctx.retry_constraint = make_pair(RETRY_EVENT_NEXTHOP_ADDED, nexthop.to_string());
                     return false;
                 }
             }
@@ -1745,7 +1925,13 @@ bool RouteOrch::addRoutePost(const RouteBulkContext& ctx, const NextHopGroupKey
                 ipPrefix.to_string().c_str(), nextHops.to_string().c_str());
     }
 
+    if (it_route != m_syncdRoutes.at(vrf_id).end())
+    {
+        removeRouteIndex(vrf_id, ipPrefix, it_route->second);
+    }
+
     m_syncdRoutes[vrf_id][ipPrefix] = nextHops;
+    addRouteIndex(vrf_id, ipPrefix, nextHops);
 
     notifyNextHopChangeObservers(vrf_id, ipPrefix, nextHops, true);
     return true;
@@ -1906,6 +2092,8 @@ bool RouteOrch::removeRoutePost(const RouteBulkContext& ctx)
     SWSS_LOG_INFO("Remove route %s with next hop(s) %s",
             ipPrefix.to_string().c_str(), it_route->second.to_string().c_str());
 
+    removeRouteIndex(vrf_id, ipPrefix, it_route->second);
+
     if (ipPrefix.isDefaultRoute())
     {
         it_route_table->second[ipPrefix] = NextHopGroupKey();
@@ -1977,7 +2165,7 @@ bool RouteOrch::removeOverlayNextHops(sai_object_id_t vrf_id, const NextHopGroup
     bool status = false;
 
     SWSS_LOG_NOTICE("Remove overlay Nexthop %s", ol_nextHops.to_string().c_str());
-    for (auto &tunnel_nh : ol_nextHops.getNextHops())
+    for (const auto &tunnel_nh : ol_nextHops)
     {
         if (!m_neighOrch->getNextHopRefCount(tunnel_nh))
         {
@@ -14,7 +14,10 @@
 #include "nexthopgroupkey.h"
 #include "bulker.h"
 #include "fgnhgorch.h"
+#include <deque>
 #include <map>
+#include <set>
+#include <unordered_map>
 
 /* Maximum next hop group number */
 #define NHGRP_MAX_SIZE 128
@@ -43,11 +46,17 @@ struct NextHopUpdate
 struct NextHopObserverEntry;
 
 /* NextHopGroupTable: NextHopGroupKey, NextHopGroupEntry */
-typedef std::map<NextHopGroupKey, NextHopGroupEntry> NextHopGroupTable;
+typedef std::unordered_map<NextHopGroupKey, NextHopGroupEntry> NextHopGroupTable;
 /* RouteTable: destination network, NextHopGroupKey */
 typedef std::map<IpPrefix, NextHopGroupKey> RouteTable;
 /* RouteTables: vrf_id, RouteTable */
 typedef std::map<sai_object_id_t, RouteTable> RouteTables;
+/* RouteKey: vrf_id, destination network */
+typedef std::pair<sai_object_id_t, IpPrefix> RouteKey;
+/* NextHopRouteTable: next hop, routes pointing to the single next hop */
+typedef std::map<NextHopKey, std::set<RouteKey>> NextHopRouteTable;
+/* NextHopGroupRouteTable: next hop group, routes pointing to the group */
+typedef std::map<NextHopGroupKey, std::set<RouteKey>> NextHopGroupRouteTable;
 /* Host: vrf_id, IpAddress */
 typedef std::pair<sai_object_id_t, IpAddress> Host;
 /* NextHopObserverTable: Host, next hop observer entry */
@@ -68,9 +77,13 @@ struct RouteBulkContext
     IpPrefix                            ip_prefix;
     bool                                excp_intfs_flag;
     std::vector<string>                 ipv;
+    std::vector<string>                 alsv;
+    string                              vrf_name;           // Empty for the default VRF
+    bool                                park;               // Route waits for retry_constraint
+    RetryConstraint                     retry_constraint;
 
     RouteBulkContext()
-        : excp_intfs_flag(false)
+        : excp_intfs_flag(false), park(false)
     {
     }
 
@@ -84,11 +97,25 @@ struct RouteBulkContext
         tmp_next_hop.clear();
         nhg.clear();
         ipv.clear();
+        alsv.clear();
+        vrf_name.clear();
         excp_intfs_flag = false;
         vrf_id = SAI_NULL_OBJECT_ID;
+        park = false;
     }
 };
 
+/*
+ * Routes of m_toSync handed to the route bulker together.
+ * Contexts are kept in a deque so the bulker may keep pointers to them.
+ */
+struct RouteBatch
+{
+    std::deque<SyncMap::iterator>       entries;            // End iterator once the entry is erased
+    std::deque<RouteBulkContext>        contexts;
+    size_t                              applied = 0;        // Entries already handed to the bulker
+};
+
 class RouteOrch : public Orch, public Subject
 {
 public:
@@ -108,6 +135,7 @@ public:
     bool removeNextHopGroup(const NextHopGroupKey&);
 
     bool updateNextHopRoutes(const NextHopKey&, uint32_t&);
+    const std::set<RouteKey>* getNextHopGroupRoutes(const NextHopGroupKey&) const;
 
     bool validnexthopinNextHopGroup(const NextHopKey&, uint32_t&);
     bool invalidnexthopinNextHopGroup(const NextHopKey&, uint32_t&);
@@ -135,6 +163,10 @@ private:
     RouteTables m_syncdRoutes;
     NextHopGroupTable m_syncdNextHopGroups;
 
+    /* Reverse indexes of m_syncdRoutes, routes without next hop are not indexed */
+    NextHopRouteTable m_nextHopRoutes;
+    NextHopGroupRouteTable m_nextHopGroupRoutes;
+
     std::set<NextHopGroupKey> m_bulkNhgReducedRefCnt;
 
     NextHopObserverTable m_nextHopObservers;
@@ -142,6 +174,15 @@ private:
     EntityBulker<sai_route_api_t>           gRouteBulker;
     ObjectBulker<sai_next_hop_group_api_t>  gNextHopGroupMemberBulker;
 
+    SyncMap::iterator doResyncTask(Consumer& consumer, SyncMap::iterator it);
+    SyncMap::iterator parseRouteBatch(Consumer& consumer, SyncMap::iterator it, RouteBatch& batch);
+    void parseRoute(const KeyOpFieldsValuesTuple& t, RouteBulkContext& ctx);
+    void applyRouteBatch(Consumer& consumer, RouteBatch& batch);
+    void postRouteBatch(Consumer& consumer, RouteBatch& batch, size_t first);
+
+    void addRouteIndex(sai_object_id_t vrf_id, const IpPrefix& ipPrefix, const NextHopGroupKey& nextHops);
+    void removeRouteIndex(sai_object_id_t vrf_id, const IpPrefix& ipPrefix, const NextHopGroupKey& nextHops);
+
     void addTempRoute(RouteBulkContext& ctx, const NextHopGroupKey&);
     bool addRoute(RouteBulkContext& ctx, const NextHopGroupKey&);
     bool removeRoute(RouteBulkContext& ctx);
@@ -0,0 +1,217 @@
+#ifndef SWSS_SYNCMAP_H
+#define SWSS_SYNCMAP_H
+
+#include <functional>
+#include <iterator>
+#include <list>
+#include <string>
+#include <unordered_map>
+#include <utility>
+
+#include "table.h"
+
+/*
+ * SyncMap keeps the pending tasks of a Consumer.
+ *
+ * Entries are kept in a list in the order their key was first seen, and all
+ * entries of the same key (at most a DEL followed by a SET) are adjacent. A
+ * hash index points to the first entry of every key, so lookups do not depend
+ * on the number of pending tasks. The index does not own a copy of the key,
+ * it refers to the key stored in the list node.
+ *
+ * The interface mirrors the subset of std::multimap used by the orchs:
+ * iterating, erasing with iterators returned by begin()/find(), and reverse
+ * iteration over adjacent entries of one key. Iterators stay valid until the
+ * entry they point to is erased.
+ *
+ * Erased nodes are parked in a small free list and reused by later inserts
+ * to avoid an allocation per task during bursts.
+ */
+class SyncMap
+{
+public:
+    typedef std::string key_type;
+    typedef swss::KeyOpFieldsValuesTuple mapped_type;
+    typedef std::pair<std::string, swss::KeyOpFieldsValuesTuple> value_type;
+    typedef std::list<value_type>::iterator iterator;
+    typedef std::list<value_type>::const_iterator const_iterator;
+    typedef std::list<value_type>::reverse_iterator reverse_iterator;
+    typedef std::list<value_type>::const_reverse_iterator const_reverse_iterator;
+    typedef size_t size_type;
+
+    static const size_t MAX_FREE_NODES = 1024;
+
+    iterator begin() { return m_list.begin(); }
+    iterator end() { return m_list.end(); }
+    const_iterator begin() const { return m_list.begin(); }
+    const_iterator end() const { return m_list.end(); }
+    reverse_iterator rbegin() { return m_list.rbegin(); }
+    reverse_iterator rend() { return m_list.rend(); }
+    const_reverse_iterator rbegin() const { return m_list.rbegin(); }
+    const_reverse_iterator rend() const { return m_list.rend(); }
+
+    bool empty() const { return m_list.empty(); }
+    size_t size() const { return m_list.size(); }
+
+    /* Number of distinct keys with pending tasks */
+    size_t keyCount() const { return m_index.size(); }
+
+    void reserve(size_t count) { m_index.reserve(count); }
+
+    /* Return the first pending entry of the key */
+    iterator find(const std::string &key)
+    {
+        auto found = m_index.find(std::cref(key));
+        return found == m_index.end() ? m_list.end() : found->second;
+    }
+
+    const_iterator find(const std::string &key) const
+    {
+        auto found = m_index.find(std::cref(key));
+        return found == m_index.end() ? m_list.cend() : const_iterator(found->second);
+    }
+
+    size_t count(const std::string &key) const
+    {
+        size_t n = 0;
+        for (auto it = find(key); it != m_list.end() && it->first == key; ++it)
+        {
+            n++;
+        }
+        return n;
+    }
+
+    std::pair<iterator, iterator> equal_range(const std::string &key)
+    {
+        auto first = find(key);
+        auto last = first;
+        while (last != m_list.end() && last->first == key)
+        {
+            ++last;
+        }
+        return std::make_pair(first, last);
+    }
+
+    /*
+     * Append the entry behind the pending entries of the same key,
+     * or at the tail if the key has no pending entry.
+     */
+    iterator emplace(mapped_type &&entry)
+    {
+        const std::string &key = kfvKey(entry);
+
+        auto found = m_index.find(std::cref(key));
+        if (found == m_index.end())
+        {
+            auto it = allocate(m_list.end(), std::move(entry));
+            m_index.emplace(std::cref(it->first), it);
+            return it;
+        }
+
+        auto pos = found->second;
+        while (pos != m_list.end() && pos->first == key)
+        {
+            ++pos;
+        }
+        return allocate(pos, std::move(entry));
+    }
+
+    iterator emplace(const mapped_type &entry)
+    {
+        return emplace(mapped_type(entry));
+    }
+
+    iterator erase(iterator pos)
+    {
+        auto next = std::next(pos);
+
+        auto found = m_index.find(std::cref(pos->first));
+        if (found != m_index.end() && found->second == pos)
+        {
+            m_index.erase(found);
+            if (next != m_list.end() && next->first == pos->first)
+            {
+                m_index.emplace(std::cref(next->first), next);
+            }
+        }
+
+        release(pos);
+        return next;
+    }
+
+    size_t erase(const std::string &key)
+    {
+        auto found = m_index.find(std::cref(key));
+        if (found == m_index.end())
+        {
+            return 0;
+        }
+
+        auto it = found->second;
+        m_index.erase(found);
+
+        size_t n = 0;
+        while (it != m_list.end() && it->first == key)
+        {
+            auto next = std::next(it);
+            release(it);
+            it = next;
+            n++;
+        }
+        return n;
+    }
+
+    /*
+     * Move the pending entries of the key behind all the other ones,
+     * iterators to them stay valid.
+     */
+    void moveToBack(const std::string &key)
+    {
+        auto range = equal_range(key);
+        if (range.first != range.second)
+        {
+            m_list.splice(m_list.end(), m_list, range.first, range.second);
+        }
+    }
+
+    void clear()
+    {
+        m_index.clear();
+        m_list.clear();
+    }
+
+private:
+    typedef std::reference_wrapper<const std::string> key_ref;
+
+    std::list<value_type> m_list;
+    std::list<value_type> m_free;
+    std::unordered_map<key_ref, iterator, std::hash<std::string>, std::equal_to<std::string>> m_index;
+
+    iterator allocate(iterator pos, mapped_type &&entry)
+    {
+        if (m_free.empty())
+        {
+            return m_list.emplace(pos, kfvKey(entry), std::move(entry));
+        }
+
+        auto node = m_free.begin();
+        node->first = kfvKey(entry);
+        node->second = std::move(entry);
+        m_list.splice(pos, m_free, node);
+        return node;
+    }
+
+    void release(iterator pos)
+    {
+        if (m_free.size() < MAX_FREE_NODES)
+        {
+            m_free.splice(m_free.begin(), m_list, pos);
+        }
+        else
+        {
+            m_list.erase(pos);
+        }
+    }
+};
+
+#endif /* SWSS_SYNCMAP_H */
@@ -110,6 +110,8 @@ bool VRFOrch::addOperation(const Request& request)
         }
         m_stateVrfObjectTable.hset(vrf_name, "state", "ok");
         SWSS_LOG_NOTICE("VRF '%s' was added", vrf_name.c_str());
+
+        Orch::notifyRetryEvent(RETRY_EVENT_VRF_ADDED, vrf_name);
     }
     else
     {
@@ -4,6 +4,7 @@
 #include "notifier.h"
 #include "converter.h"
 #include "bufferorch.h"
+#include "batcheddbwriter.h"
 #include <inttypes.h>
 
 #define DEFAULT_TELEMETRY_INTERVAL 120
@@ -28,9 +29,6 @@ WatermarkOrch::WatermarkOrch(DBConnector *db, const vector<string> &tables):
     m_countersDb = make_shared<DBConnector>("COUNTERS_DB", 0);
     m_appDb = make_shared<DBConnector>("APPL_DB", 0);
     m_countersTable = make_shared<Table>(m_countersDb.get(), COUNTERS_TABLE);
-    m_periodicWatermarkTable = make_shared<Table>(m_countersDb.get(), PERIODIC_WATERMARKS_TABLE);
-    m_persistentWatermarkTable = make_shared<Table>(m_countersDb.get(), PERSISTENT_WATERMARKS_TABLE);
-    m_userWatermarkTable = make_shared<Table>(m_countersDb.get(), USER_WATERMARKS_TABLE);
 
     m_clearNotificationConsumer = new swss::NotificationConsumer(
             m_appDb.get(),
@@ -165,15 +163,15 @@ void WatermarkOrch::doTask(NotificationConsumer &consumer)
 
     consumer.pop(op, data, values);
 
-    Table * table = NULL;
+    string table;
 
     if (op == "PERSISTENT")
     {
-        table = m_persistentWatermarkTable.get();
+        table = PERSISTENT_WATERMARKS_TABLE;
     }
     else if (op == "USER")
     {
-        table = m_userWatermarkTable.get();
+        table = USER_WATERMARKS_TABLE;
     }
     else
     {
@@ -256,25 +254,25 @@ void WatermarkOrch::doTask(SelectableTimer &timer)
             m_telemetryTimer->stop();
         }
 
-        clearSingleWm(m_periodicWatermarkTable.get(),
+        clearSingleWm(PERIODIC_WATERMARKS_TABLE,
                       "SAI_INGRESS_PRIORITY_GROUP_STAT_XOFF_ROOM_WATERMARK_BYTES",
                       m_pg_ids);
-        clearSingleWm(m_periodicWatermarkTable.get(),
+        clearSingleWm(PERIODIC_WATERMARKS_TABLE,
                       "SAI_INGRESS_PRIORITY_GROUP_STAT_SHARED_WATERMARK_BYTES",
                       m_pg_ids);
-        clearSingleWm(m_periodicWatermarkTable.get(),
+        clearSingleWm(PERIODIC_WATERMARKS_TABLE,
                       "SAI_QUEUE_STAT_SHARED_WATERMARK_BYTES",
                       m_unicast_queue_ids);
-        clearSingleWm(m_periodicWatermarkTable.get(),
+        clearSingleWm(PERIODIC_WATERMARKS_TABLE,
                       "SAI_QUEUE_STAT_SHARED_WATERMARK_BYTES",
                       m_multicast_queue_ids);
-        clearSingleWm(m_periodicWatermarkTable.get(),
+        clearSingleWm(PERIODIC_WATERMARKS_TABLE,
                       "SAI_QUEUE_STAT_SHARED_WATERMARK_BYTES",
                       m_all_queue_ids);
-        clearSingleWm(m_periodicWatermarkTable.get(),
+        clearSingleWm(PERIODIC_WATERMARKS_TABLE,
                       "SAI_BUFFER_POOL_STAT_WATERMARK_BYTES",
                       gBufferOrch->getBufferPoolNameOidMap());
-        clearSingleWm(m_periodicWatermarkTable.get(),
+        clearSingleWm(PERIODIC_WATERMARKS_TABLE,
                       "SAI_BUFFER_POOL_STAT_XOFF_ROOM_WATERMARK_BYTES",
                       gBufferOrch->getBufferPoolNameOidMap());
         SWSS_LOG_DEBUG("Periodic watermark cleared by timer!");
@@ -320,29 +318,31 @@ void WatermarkOrch::init_queue_ids()
     }
 }
 
-void WatermarkOrch::clearSingleWm(Table *table, string wm_name, vector<sai_object_id_t> &obj_ids)
+void WatermarkOrch::clearSingleWm(const string &table, string wm_name, vector<sai_object_id_t> &obj_ids)
 {
     /* Zero-out some WM in some table for some vector of object ids*/
     SWSS_LOG_ENTER();
     SWSS_LOG_DEBUG("clear WM %s, for %zu obj ids", wm_name.c_str(), obj_ids.size());
 
     vector<FieldValueTuple> vfvt = {{wm_name, "0"}};
+    auto &writer = BatchedDbWriter::get("COUNTERS_DB");
 
     for (sai_object_id_t id: obj_ids)
     {
-        table->set(sai_serialize_object_id(id), vfvt);
+        writer.set(table, sai_serialize_object_id(id), vfvt);
     }
 }
 
-void WatermarkOrch::clearSingleWm(Table *table, string wm_name, const object_reference_map &nameOidMap)
+void WatermarkOrch::clearSingleWm(const string &table, string wm_name, const object_reference_map &nameOidMap)
 {
     SWSS_LOG_ENTER();
     SWSS_LOG_DEBUG("clear WM %s, for %zu obj ids", wm_name.c_str(), nameOidMap.size());
 
     vector<FieldValueTuple> fvTuples = {{wm_name, "0"}};
+    auto &writer = BatchedDbWriter::get("COUNTERS_DB");
 
     for (const auto &it : nameOidMap)
     {
-        table->set(sai_serialize_object_id(it.second.m_saiObjectId), fvTuples);
+        writer.set(table, sai_serialize_object_id(it.second.m_saiObjectId), fvTuples);
     }
 }
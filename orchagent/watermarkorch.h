@@ -34,8 +34,8 @@ public:
     void handleWmConfigUpdate(const std::string &key, const std::vector<swss::FieldValueTuple> &fvt);
     void handleFcConfigUpdate(const std::string &key, const std::vector<swss::FieldValueTuple> &fvt);
 
-    void clearSingleWm(swss::Table *table, std::string wm_name, std::vector<sai_object_id_t> &obj_ids);
-    void clearSingleWm(swss::Table *table, std::string wm_name, const object_reference_map &nameOidMap);
+    void clearSingleWm(const std::string &table, std::string wm_name, std::vector<sai_object_id_t> &obj_ids);
+    void clearSingleWm(const std::string &table, std::string wm_name, const object_reference_map &nameOidMap);
 
     std::shared_ptr<swss::Table> getCountersTable(void)
     {
@@ -59,9 +59,6 @@ private:
     std::shared_ptr<swss::DBConnector> m_countersDb = nullptr;
     std::shared_ptr<swss::DBConnector> m_appDb = nullptr;
     std::shared_ptr<swss::Table> m_countersTable = nullptr;
-    std::shared_ptr<swss::Table> m_periodicWatermarkTable = nullptr;
-    std::shared_ptr<swss::Table> m_persistentWatermarkTable = nullptr;
-    std::shared_ptr<swss::Table> m_userWatermarkTable = nullptr;
 
     swss::NotificationConsumer* m_clearNotificationConsumer = nullptr;
     swss::SelectableTimer* m_telemetryTimer = nullptr;
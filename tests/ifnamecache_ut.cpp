@@ -0,0 +1,97 @@
+#include <net/if.h>
+#include <netlink/route/link.h>
+
+#include "gtest/gtest.h"
+#include "ifnamecache.h"
+
+using namespace std;
+using namespace std::chrono;
+using namespace swss;
+
+namespace ifnamecache_test
+{
+    static void sendLinkMsg(IfNameCache &cache, int nlmsg_type, int if_index, const char *name)
+    {
+        struct rtnl_link *link = rtnl_link_alloc();
+        rtnl_link_set_ifindex(link, if_index);
+        rtnl_link_set_name(link, name);
+        cache.onMsg(nlmsg_type, (struct nl_object *)link);
+        rtnl_link_put(link);
+    }
+
+    TEST(IfNameCache, LinkMessages)
+    {
+        IfNameCache cache;
+        char if_name[IFNAMSIZ];
+
+        // Filled by the link dump at startup
+        ASSERT_TRUE(cache.getIfName(1, if_name, IFNAMSIZ));
+        ASSERT_STREQ(if_name, "lo");
+
+        sendLinkMsg(cache, RTM_NEWLINK, 100000, "Vrf1");
+        ASSERT_TRUE(cache.getIfName(100000, if_name, IFNAMSIZ));
+        ASSERT_STREQ(if_name, "Vrf1");
+
+        sendLinkMsg(cache, RTM_NEWLINK, 100000, "Vrf2");
+        ASSERT_TRUE(cache.getIfName(100000, if_name, IFNAMSIZ));
+        ASSERT_STREQ(if_name, "Vrf2");
+        ASSERT_EQ(cache.getHits(), 3u);
+
+        // A first miss refills, even right after startup
+        sendLinkMsg(cache, RTM_DELLINK, 100000, "Vrf2");
+        ASSERT_FALSE(cache.getIfName(100000, if_name, IFNAMSIZ));
+        ASSERT_STREQ(if_name, "");
+        ASSERT_EQ(cache.getMisses(), 1u);
+        ASSERT_EQ(cache.getNegativeHits(), 0u);
+        ASSERT_EQ(cache.getRefills(), 1u);
+    }
+
+    TEST(IfNameCache, NegativeCache)
+    {
+        IfNameCache cache(milliseconds(60000));
+        char if_name[IFNAMSIZ];
+
+        // Unknown index refills once, then is cached as unknown
+        ASSERT_FALSE(cache.getIfName(100001, if_name, IFNAMSIZ));
+        ASSERT_FALSE(cache.getIfName(100001, if_name, IFNAMSIZ));
+        ASSERT_EQ(cache.getMisses(), 2u);
+        ASSERT_EQ(cache.getNegativeHits(), 1u);
+        ASSERT_EQ(cache.getRefills(), 1u);
+
+        // Another unknown index may refill again
+        ASSERT_FALSE(cache.getIfName(100002, if_name, IFNAMSIZ));
+        ASSERT_EQ(cache.getRefills(), 2u);
+
+        // Link messages override the negative entry
+        sendLinkMsg(cache, RTM_NEWLINK, 100001, "Ethernet0");
+        ASSERT_TRUE(cache.getIfName(100001, if_name, IFNAMSIZ));
+        ASSERT_STREQ(if_name, "Ethernet0");
+        ASSERT_EQ(cache.getRefills(), 2u);
+
+        // The refill keeps the names of the kernel
+        ASSERT_TRUE(cache.getIfName(1, if_name, IFNAMSIZ));
+        ASSERT_STREQ(if_name, "lo");
+    }
+
+    TEST(IfNameCache, NegativeTimeout)
+    {
+        IfNameCache cache(milliseconds(0));
+        char if_name[IFNAMSIZ];
+
+        // Repeated misses refill again once the negative entry expired
+        ASSERT_FALSE(cache.getIfName(100001, if_name, IFNAMSIZ));
+        ASSERT_FALSE(cache.getIfName(100001, if_name, IFNAMSIZ));
+        ASSERT_EQ(cache.getNegativeHits(), 0u);
+        ASSERT_EQ(cache.getRefills(), 2u);
+    }
+
+    TEST(IfNameCache, LinkSocket)
+    {
+        IfNameCache cache;
+
+        // Nothing to read, the table is kept
+        ASSERT_GE(cache.getFd(), 0);
+        cache.readData();
+        ASSERT_EQ(cache.getRefills(), 0u);
+    }
+}
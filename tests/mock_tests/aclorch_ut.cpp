@@ -1,4 +1,8 @@
 #include "ut_helper.h"
+#include "mock_hiredis.h"
+
+#include <chrono>
+#include <iostream>
 
 extern sai_object_id_t gSwitchId;
 
@@ -160,6 +164,11 @@ namespace aclorch_test
             static_cast<Orch *>(m_aclOrch)->doTask(*consumer);
         }
 
+        void doAclCountersTask()
+        {
+            m_aclOrch->getExecutor("ACL_POLL_TIMER")->execute();
+        }
+
         void doAclRuleTask(const deque<KeyOpFieldsValuesTuple> &entries)
         {
             auto consumer = unique_ptr<Consumer>(new Consumer(
@@ -178,6 +187,11 @@ namespace aclorch_test
         {
             return Portal::AclOrchInternal::getAclTables(m_aclOrch);
         }
+
+        const unordered_map<string, sai_object_id_t> &getAclTableOids() const
+        {
+            return Portal::AclOrchInternal::getAclTableOids(m_aclOrch);
+        }
     };
 
     struct AclOrchTest : public AclTest
@@ -990,6 +1004,82 @@ namespace aclorch_test
         }
     }
 
+    // The table name index used by getTableById() follows the tables as they
+    // are created and removed.
+    TEST_F(AclOrchTest, ACL_Table_Index)
+    {
+        auto orch = createAclOrch();
+
+        auto validateIndex = [&orch]() {
+            const auto &acl_tables = orch->getAclTables();
+            const auto &acl_table_oids = orch->getAclTableOids();
+
+            if (acl_tables.size() != acl_table_oids.size())
+            {
+                return false;
+            }
+
+            for (const auto &id_oid : acl_table_oids)
+            {
+                auto it = acl_tables.find(id_oid.second);
+                if (it == acl_tables.end() || it->second.id != id_oid.first)
+                {
+                    return false;
+                }
+            }
+
+            return true;
+        };
+
+        auto getAclTableTuple = [](const string &acl_table_id, const string &op) {
+            if (op == DEL_COMMAND)
+            {
+                return KeyOpFieldsValuesTuple{ acl_table_id, DEL_COMMAND, {} };
+            }
+
+            return KeyOpFieldsValuesTuple{ acl_table_id,
+                                           SET_COMMAND,
+                                           { { ACL_TABLE_DESCRIPTION, "index" },
+                                             { ACL_TABLE_TYPE, TABLE_TYPE_L3 },
+                                             { ACL_TABLE_STAGE, STAGE_INGRESS },
+                                             { ACL_TABLE_PORTS, "1,2" } } };
+        };
+
+        orch->doAclTableTask({ getAclTableTuple("acl_table_1", SET_COMMAND),
+                               getAclTableTuple("acl_table_2", SET_COMMAND),
+                               getAclTableTuple("acl_table_3", SET_COMMAND) });
+
+        ASSERT_EQ(orch->getAclTables().size(), 3u);
+        ASSERT_TRUE(validateIndex());
+
+        auto oid = orch->getTableById("acl_table_2");
+        ASSERT_NE(oid, SAI_NULL_OBJECT_ID);
+
+        // Remove a table in the middle, the others keep their entries
+        orch->doAclTableTask({ getAclTableTuple("acl_table_2", DEL_COMMAND) });
+
+        ASSERT_EQ(orch->getAclTables().size(), 2u);
+        ASSERT_TRUE(validateIndex());
+        ASSERT_EQ(orch->getTableById("acl_table_2"), SAI_NULL_OBJECT_ID);
+        ASSERT_NE(orch->getTableById("acl_table_1"), SAI_NULL_OBJECT_ID);
+        ASSERT_NE(orch->getTableById("acl_table_3"), SAI_NULL_OBJECT_ID);
+
+        // Add it back, the name maps to the new table
+        orch->doAclTableTask({ getAclTableTuple("acl_table_2", SET_COMMAND) });
+
+        ASSERT_EQ(orch->getAclTables().size(), 3u);
+        ASSERT_TRUE(validateIndex());
+        ASSERT_NE(orch->getTableById("acl_table_2"), SAI_NULL_OBJECT_ID);
+
+        orch->doAclTableTask({ getAclTableTuple("acl_table_1", DEL_COMMAND),
+                               getAclTableTuple("acl_table_2", DEL_COMMAND),
+                               getAclTableTuple("acl_table_3", DEL_COMMAND) });
+
+        ASSERT_TRUE(orch->getAclTables().empty());
+        ASSERT_TRUE(orch->getAclTableOids().empty());
+        ASSERT_TRUE(validateLowerLayerDb(orch.get()));
+    }
+
     // When received ACL rule SET_COMMAND, orchagent can create corresponding ACL rule.
     // When received ACL rule DEL_COMMAND, orchagent can delete corresponding ACL rule.
     //
@@ -1064,6 +1154,33 @@ namespace aclorch_test
             ASSERT_TRUE(validateAclRuleByConfOp(*it_rule->second, kfvFieldsValues(kvfAclRule.front())));
             ASSERT_TRUE(validateLowerLayerDb(orch.get()));
 
+            // validate the rule counter is published in the ACL counter name map ...
+
+            swss::DBConnector counters_db("COUNTERS_DB", 0);
+            swss::Table acl_counter_rule_map(&counters_db, COUNTERS_ACL_COUNTER_RULE_MAP);
+            string counter_oid;
+            ASSERT_TRUE(acl_counter_rule_map.hget("", acl_table_id + ":" + acl_rule_id, counter_oid));
+            ASSERT_EQ(counter_oid, sai_serialize_object_id(it_rule->second->getCounterOid()));
+
+            // validate the polled counter values reach the hash read by aclshow ...
+
+            testing_redis::gCapture = true;
+            testing_redis::gReplies = { testing_redis::arrayReply({ testing_redis::stringReply("10"),
+                                                                    testing_redis::stringReply("1000") }) };
+            orch->doAclCountersTask();
+
+            ASSERT_EQ(testing_redis::gCommands.size(), 1u);
+            ASSERT_NE(testing_redis::gCommands[0].find("COUNTERS:" + counter_oid), string::npos);
+            testing_redis::reset();
+
+            swss::Table counters_table(&counters_db, "COUNTERS");
+
+            string packets, bytes;
+            ASSERT_TRUE(counters_table.hget(acl_table_id + ":" + acl_rule_id, "Packets", packets));
+            ASSERT_TRUE(counters_table.hget(acl_table_id + ":" + acl_rule_id, "Bytes", bytes));
+            ASSERT_EQ(packets, "10");
+            ASSERT_EQ(bytes, "1000");
+
             // delete acl rule ...
 
             kvfAclRule = deque<KeyOpFieldsValuesTuple>({ { acl_table_id + "|" + acl_rule_id,
@@ -1077,6 +1194,9 @@ namespace aclorch_test
             it_rule = acl_table.rules.find(acl_rule_id);
             ASSERT_EQ(it_rule, acl_table.rules.end());
             ASSERT_TRUE(validateLowerLayerDb(orch.get()));
+
+            vector<FieldValueTuple> values;
+            ASSERT_FALSE(counters_table.get(acl_table_id + ":" + acl_rule_id, values));
         }
     }
 
@@ -1170,4 +1290,77 @@ namespace aclorch_test
         }
     }
 
+    //
+    // Rules per second against the virtual switch SAI, 50k rules spread over
+    // a growing number of tables. The time per rule should not grow with the
+    // table count.
+    // Run with --gtest_also_run_disabled_tests.
+    //
+    TEST_F(AclOrchTest, DISABLED_RuleProgrammingBenchmark)
+    {
+        const size_t rule_count = 50000;
+
+        for (size_t table_count : { 1, 10, 100, 500 })
+        {
+            auto orch = createAclOrch();
+
+            deque<KeyOpFieldsValuesTuple> kvfAclTables;
+            for (size_t i = 0; i < table_count; i++)
+            {
+                kvfAclTables.push_back({ "acl_table_" + to_string(i),
+                                         SET_COMMAND,
+                                         { { ACL_TABLE_DESCRIPTION, "benchmark" },
+                                           { ACL_TABLE_TYPE, TABLE_TYPE_L3 },
+                                           { ACL_TABLE_STAGE, STAGE_INGRESS },
+                                           { ACL_TABLE_PORTS, "1,2" } } });
+            }
+            orch->doAclTableTask(kvfAclTables);
+            ASSERT_EQ(orch->getAclTables().size(), table_count);
+
+            deque<KeyOpFieldsValuesTuple> kvfAclRules;
+            for (size_t i = 0; i < rule_count; i++)
+            {
+                string src_ip = "10." + to_string((i >> 16) & 0xff) + "." + to_string((i >> 8) & 0xff) + "." + to_string(i & 0xff);
+                kvfAclRules.push_back({ "acl_table_" + to_string(i % table_count) + "|acl_rule_" + to_string(i),
+                                        SET_COMMAND,
+                                        { { ACTION_PACKET_ACTION, PACKET_ACTION_DROP },
+                                          { MATCH_SRC_IP, src_ip } } });
+            }
+
+            auto start = chrono::steady_clock::now();
+            orch->doAclRuleTask(kvfAclRules);
+            auto added = chrono::steady_clock::now();
+
+            size_t rules = 0;
+            for (const auto &kv : orch->getAclTables())
+            {
+                rules += kv.second.rules.size();
+            }
+            ASSERT_EQ(rules, rule_count);
+
+            for (auto &kvf : kvfAclRules)
+            {
+                kfvOp(kvf) = DEL_COMMAND;
+                kfvFieldsValues(kvf).clear();
+            }
+            orch->doAclRuleTask(kvfAclRules);
+            auto removed = chrono::steady_clock::now();
+
+            for (auto &kvf : kvfAclTables)
+            {
+                kfvOp(kvf) = DEL_COMMAND;
+                kfvFieldsValues(kvf).clear();
+            }
+            orch->doAclTableTask(kvfAclTables);
+            ASSERT_TRUE(orch->getAclTables().empty());
+            ASSERT_EQ(orch->getTableById("acl_table_0"), SAI_NULL_OBJECT_ID);
+
+            auto add_us = chrono::duration_cast<chrono::microseconds>(added - start).count();
+            auto del_us = chrono::duration_cast<chrono::microseconds>(removed - added).count();
+
+            cout << rule_count << " rules in " << table_count << " tables: add "
+                 << (double)add_us / (double)rule_count << " us/rule, remove "
+                 << (double)del_us / (double)rule_count << " us/rule" << endl;
+        }
+    }
 } // namespace nsAclOrchTest
@@ -0,0 +1,117 @@
+#include "ut_helper.h"
+#include "mock_table.h"
+#include "batcheddbwriter.h"
+
+#include <chrono>
+#include <iostream>
+#include <thread>
+
+namespace batcheddbwriter_test
+{
+    using namespace std;
+
+    struct BatchedDbWriterTest : public ::testing::Test
+    {
+        void SetUp() override
+        {
+            ::testing_db::reset();
+        }
+    };
+
+    TEST_F(BatchedDbWriterTest, RoundTripsPerBatch)
+    {
+        BatchedDbWriter writer("COUNTERS_DB", 100);
+
+        for (int i = 0; i < 250; i++)
+        {
+            writer.set("PERIODIC_WATERMARKS", "oid:" + to_string(i), { { "SAI_QUEUE_STAT_SHARED_WATERMARK_BYTES", "0" } });
+        }
+
+        // Two full batches were sent, the rest waits for the end of the iteration
+        ASSERT_EQ(writer.getWrites(), 250u);
+        ASSERT_EQ(writer.getRoundTrips(), 2u);
+
+        writer.flush();
+        ASSERT_EQ(writer.getRoundTrips(), 3u);
+
+        // Nothing pending, no round trip
+        writer.flush();
+        ASSERT_EQ(writer.getRoundTrips(), 3u);
+
+        swss::DBConnector db("COUNTERS_DB", 0);
+        swss::Table table(&db, "PERIODIC_WATERMARKS");
+        string value;
+        ASSERT_TRUE(table.hget("oid:249", "SAI_QUEUE_STAT_SHARED_WATERMARK_BYTES", value));
+        ASSERT_EQ(value, "0");
+    }
+
+    TEST_F(BatchedDbWriterTest, Stats)
+    {
+        BatchedDbWriter writer("STATE_DB", 10);
+
+        for (int i = 0; i < 20; i++)
+        {
+            writer.del("FDB_TABLE", "Vlan2:00:00:00:00:00:" + to_string(i % 10));
+        }
+
+        vector<swss::FieldValueTuple> fvs;
+        writer.dumpStats(fvs);
+
+        map<string, string> stats(fvs.begin(), fvs.end());
+        ASSERT_EQ(stats["writes"], "20");
+        ASSERT_EQ(stats["round_trips"], "2");
+    }
+
+    TEST_F(BatchedDbWriterTest, SharedWriters)
+    {
+        auto &writer = BatchedDbWriter::get("STATE_DB");
+        ASSERT_EQ(&writer, &BatchedDbWriter::get("STATE_DB"));
+        ASSERT_NE(&writer, &BatchedDbWriter::get("COUNTERS_DB"));
+
+        uint64_t roundTrips = writer.getRoundTrips();
+        writer.set("FDB_TABLE", "Vlan2:00:00:00:00:00:01", { { "port", "Ethernet0" } });
+        BatchedDbWriter::flushAll();
+        ASSERT_EQ(writer.getRoundTrips(), roundTrips + 1);
+    }
+
+    TEST_F(BatchedDbWriterTest, ConcurrentWriters)
+    {
+        const uint64_t writes = 10000;
+        BatchedDbWriter writer("COUNTERS_DB", 64);
+
+        auto worker = [&](const string &table) {
+            for (uint64_t i = 0; i < writes; i++)
+            {
+                writer.set(table, "oid:" + to_string(i % 100), { { "SAI_QUEUE_STAT_SHARED_WATERMARK_BYTES", "0" } });
+            }
+        };
+
+        thread t1(worker, "PERIODIC_WATERMARKS");
+        thread t2(worker, "USER_WATERMARKS");
+        t1.join();
+        t2.join();
+        writer.flush();
+
+        ASSERT_EQ(writer.getWrites(), 2 * writes);
+        ASSERT_EQ(writer.getRoundTrips(), (2 * writes + 63) / 64);
+    }
+
+    // Run with --gtest_also_run_disabled_tests.
+    TEST_F(BatchedDbWriterTest, DISABLED_WatermarkClearBenchmark)
+    {
+        // Periodic clear of 7 watermarks over 512 queues and PGs of 4 ASICs
+        const int keys = 7 * 512 * 4;
+        BatchedDbWriter writer("COUNTERS_DB");
+
+        auto start = chrono::steady_clock::now();
+        for (int i = 0; i < keys; i++)
+        {
+            writer.set("PERIODIC_WATERMARKS", "oid:" + to_string(i), { { "SAI_QUEUE_STAT_SHARED_WATERMARK_BYTES", "0" } });
+        }
+        writer.flush();
+        auto elapsed = chrono::duration_cast<chrono::microseconds>(chrono::steady_clock::now() - start).count();
+
+        cout << keys << " writes in " << writer.getRoundTrips() << " round trips (" << keys
+             << " unbatched), " << elapsed << " us" << endl;
+    }
+}
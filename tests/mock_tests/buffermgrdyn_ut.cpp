@@ -0,0 +1,139 @@
+#include "ut_helper.h"
+#include "mock_table.h"
+
+#define private public
+#include "buffermgrdyn.h"
+#undef private
+
+namespace buffermgrdyn_test
+{
+    using namespace std;
+
+    struct BufferMgrDynTest : public ::testing::Test
+    {
+        const int ports = 128;
+
+        shared_ptr<swss::DBConnector> m_config_db;
+        shared_ptr<swss::DBConnector> m_state_db;
+        shared_ptr<swss::BufferMgrDynamic> m_bufferMgr;
+
+        void SetUp() override
+        {
+            ::testing_db::reset();
+
+            m_config_db = make_shared<swss::DBConnector>("CONFIG_DB", 0);
+            m_state_db = make_shared<swss::DBConnector>("STATE_DB", 0);
+
+            // Owned by the buffer manager
+            auto appl_db = new swss::DBConnector("APPL_DB", 0);
+
+            vector<TableConnector> tables = {
+                TableConnector(m_config_db.get(), CFG_PORT_TABLE_NAME),
+                TableConnector(m_config_db.get(), CFG_PORT_CABLE_LEN_TABLE_NAME),
+                TableConnector(m_config_db.get(), CFG_BUFFER_POOL_TABLE_NAME),
+                TableConnector(m_config_db.get(), CFG_BUFFER_PROFILE_TABLE_NAME),
+                TableConnector(m_config_db.get(), CFG_BUFFER_PG_TABLE_NAME),
+                TableConnector(m_config_db.get(), CFG_BUFFER_QUEUE_TABLE_NAME),
+                TableConnector(m_config_db.get(), CFG_BUFFER_PORT_INGRESS_PROFILE_LIST_NAME),
+                TableConnector(m_config_db.get(), CFG_BUFFER_PORT_EGRESS_PROFILE_LIST_NAME),
+                TableConnector(m_config_db.get(), CFG_DEFAULT_LOSSLESS_BUFFER_PARAMETER),
+                TableConnector(m_config_db.get(), CFG_LOSSLESS_TRAFFIC_PATTERN_TABLE_NAME),
+                TableConnector(m_state_db.get(), STATE_BUFFER_MAXIMUM_VALUE_TABLE)
+            };
+
+            swss::Table asicTable(m_state_db.get(), "ASIC_TABLE");
+            asicTable.set("MELLANOX-SPECTRUM-2", { { "cell_size", "144" },
+                                                   { "pipeline_latency", "19" },
+                                                   { "mac_phy_delay", "0.8" },
+                                                   { "peer_response_time", "3.8" } });
+
+            swss::Table trafficPatternTable(m_config_db.get(), CFG_LOSSLESS_TRAFFIC_PATTERN_TABLE_NAME);
+            trafficPatternTable.set("AZURE", { { "mtu", "1024" }, { "small_packet_percentage", "100" } });
+
+            m_bufferMgr = make_shared<swss::BufferMgrDynamic>(m_config_db.get(), m_state_db.get(), appl_db, tables, nullptr);
+
+            // ASIC_VENDOR isn't defined in the test, install the formula so that the headroom can be calculated
+            m_bufferMgr->m_bufferFormula = swss::BufferVendorFormula::create("mellanox");
+
+            swss::Table portTable(appl_db, APP_PORT_TABLE_NAME);
+            portTable.set("PortInitDone", { { "lanes", "0" } });
+        }
+
+        void apply(const string &table, const deque<KeyOpFieldsValuesTuple> &entries)
+        {
+            auto consumer = dynamic_cast<Consumer *>(m_bufferMgr->getExecutor(table));
+            consumer->addToSync(entries);
+            static_cast<Orch *>(m_bufferMgr.get())->doTask(*consumer);
+        }
+
+        void setCableLength(const string &length)
+        {
+            vector<FieldValueTuple> fvs;
+            for (int i = 0; i < ports; i++)
+            {
+                fvs.emplace_back("Ethernet" + to_string(i * 4), length);
+            }
+            apply(CFG_PORT_CABLE_LEN_TABLE_NAME, { { "AZURE", SET_COMMAND, fvs } });
+        }
+    };
+
+    TEST_F(BufferMgrDynTest, OnePoolUpdatePerCableLengthChange)
+    {
+        apply(STATE_BUFFER_MAXIMUM_VALUE_TABLE, { { "global", SET_COMMAND, { { "mmu_size", "13945824" } } } });
+        apply(CFG_BUFFER_POOL_TABLE_NAME, { { "ingress_lossless_pool", SET_COMMAND, { { "type", "ingress" }, { "mode", "dynamic" } } } });
+        apply(CFG_DEFAULT_LOSSLESS_BUFFER_PARAMETER, { { "AZURE", SET_COMMAND, { { "default_dynamic_th", "0" } } } });
+
+        deque<KeyOpFieldsValuesTuple> portEntries, pgEntries;
+        for (int i = 0; i < ports; i++)
+        {
+            string port = "Ethernet" + to_string(i * 4);
+            portEntries.push_back({ port, SET_COMMAND, { { "speed", "100000" }, { "mtu", "9100" }, { "admin_status", "up" } } });
+            pgEntries.push_back({ port + "|3-4", SET_COMMAND, { { "profile", "NULL" } } });
+        }
+
+        apply(CFG_PORT_TABLE_NAME, portEntries);
+        setCableLength("5m");
+        ASSERT_EQ(m_bufferMgr->m_portInfoLookup["Ethernet508"].state, swss::PORT_READY);
+
+        // All the PGs are added by one batch
+        uint64_t recalculations = m_bufferMgr->m_bufferPoolRecalculations;
+        apply(CFG_BUFFER_PG_TABLE_NAME, pgEntries);
+        ASSERT_EQ(m_bufferMgr->m_portPgLookup.size(), static_cast<size_t>(ports));
+        ASSERT_EQ(m_bufferMgr->m_bufferPoolRecalculations, recalculations + 1);
+
+        // Cable length of all the ports is updated by one CABLE_LENGTH entry
+        recalculations = m_bufferMgr->m_bufferPoolRecalculations;
+        uint64_t updates = m_bufferMgr->m_bufferPoolDirtyCount;
+        setCableLength("40m");
+
+        ASSERT_EQ(m_bufferMgr->m_bufferPoolDirtyCount, updates + ports);
+        ASSERT_EQ(m_bufferMgr->m_bufferPoolRecalculations, recalculations + 1);
+        ASSERT_FALSE(m_bufferMgr->m_bufferPoolDirty);
+        ASSERT_EQ(m_bufferMgr->m_portPgLookup["Ethernet0"]["Ethernet0:3-4"].running_profile_name, "pg_lossless_100000_40m_profile");
+        ASSERT_EQ(m_bufferMgr->m_bufferProfileLookup["pg_lossless_100000_40m_profile"].size, "63488");
+        ASSERT_EQ(m_bufferMgr->m_bufferProfileLookup.count("pg_lossless_100000_5m_profile"), 0);
+
+        // Nothing to recalculate if nothing changed
+        setCableLength("40m");
+        ASSERT_EQ(m_bufferMgr->m_bufferPoolRecalculations, recalculations + 1);
+    }
+
+    TEST_F(BufferMgrDynTest, LosslessTrafficPatternUpdate)
+    {
+        auto &params = m_bufferMgr->m_bufferModelParams;
+
+        ASSERT_TRUE(m_bufferMgr->loadBufferModelParams());
+        ASSERT_EQ(params.lossless_mtu, "1024");
+        ASSERT_EQ(params.small_packet_percentage, "100");
+
+        apply(CFG_LOSSLESS_TRAFFIC_PATTERN_TABLE_NAME, { { "AZURE", SET_COMMAND, { { "mtu", "1500" }, { "small_packet_percentage", "50" } } } });
+        ASSERT_TRUE(m_bufferMgr->loadBufferModelParams());
+        ASSERT_EQ(params.lossless_mtu, "1500");
+        ASSERT_EQ(params.small_packet_percentage, "50");
+
+        // The headroom can't be calculated until the pattern is configured again
+        swss::Table(m_config_db.get(), CFG_LOSSLESS_TRAFFIC_PATTERN_TABLE_NAME).del("AZURE");
+        apply(CFG_LOSSLESS_TRAFFIC_PATTERN_TABLE_NAME, { { "AZURE", DEL_COMMAND, {} } });
+        ASSERT_FALSE(m_bufferMgr->loadBufferModelParams());
+    }
+}
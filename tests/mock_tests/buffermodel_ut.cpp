@@ -0,0 +1,662 @@
+#include "ut_helper.h"
+#include "buffermodel.h"
+
+#include <algorithm>
+#include <cmath>
+#include <random>
+
+namespace buffermodel_test
+{
+    using namespace std;
+    using namespace swss;
+
+    const string APPL_DB = "0";
+    const string CONFIG_DB = "4";
+    const string STATE_DB = "6";
+
+    /*
+     * buffer_headroom_<vendor>.lua and buffer_pool_<vendor>.lua statement by
+     * statement, on maps standing for the databases. The mellanox and vs
+     * plugins are the same.
+     *
+     * This is a hand transcription, the formulas are checked against it and
+     * not against the scripts themselves, which need a Redis server to run.
+     * A change to the plugins has to be carried over here.
+     */
+    struct LuaPlugins
+    {
+        map<string, map<string, map<string, string>>> dbs;
+        string selected;
+
+        void select(const string &db)
+        {
+            selected = db;
+        }
+
+        vector<string> keys(const string &prefix)
+        {
+            vector<string> result;
+            for (auto &it : dbs[selected])
+            {
+                if (it.first.compare(0, prefix.size(), prefix) == 0)
+                {
+                    result.push_back(it.first);
+                }
+            }
+            return result;
+        }
+
+        const string *hget(const string &key, const string &field)
+        {
+            auto &db = dbs[selected];
+            auto hash = db.find(key);
+            if (hash == db.end())
+            {
+                return nullptr;
+            }
+
+            auto value = hash->second.find(field);
+            return value == hash->second.end() ? nullptr : &value->second;
+        }
+
+        // tonumber(), false standing for nil
+        static bool tonumber(const string *str, double &value)
+        {
+            if (!str || str->empty())
+            {
+                return false;
+            }
+
+            char *end = nullptr;
+            value = strtod(str->c_str(), &end);
+            return end != str->c_str() && *end == '\0';
+        }
+
+        static string str(double value)
+        {
+            char buf[32];
+            snprintf(buf, sizeof(buf), "%.14g", value);
+            return buf;
+        }
+
+        vector<string> headroom(const string &speed, const string &cable, const string &mtu, const string &gearbox)
+        {
+            double lossless_mtu = 0, small_packet_percentage = 0, cell_size = 0;
+            double pipeline_latency = 0, mac_phy_delay = 0, peer_response_time = 0;
+
+            double port_speed, cable_length, port_mtu, gearbox_delay;
+            string cable_str = cable.substr(0, cable.size() - 1);
+            tonumber(&speed, port_speed);
+            tonumber(&cable_str, cable_length);
+            tonumber(&mtu, port_mtu);
+            if (!tonumber(&gearbox, gearbox_delay))
+            {
+                gearbox_delay = 0;
+            }
+
+            vector<string> ret;
+
+            select(STATE_DB);
+            auto asic_keys = keys("ASIC_TABLE");
+            for (auto &fv : dbs[selected][asic_keys[0]])
+            {
+                double value;
+                tonumber(&fv.second, value);
+                if (fv.first == "cell_size")
+                    cell_size = value;
+                if (fv.first == "pipeline_latency")
+                    pipeline_latency = value * 1024;
+                if (fv.first == "mac_phy_delay")
+                    mac_phy_delay = value * 1024;
+                if (fv.first == "peer_response_time")
+                    peer_response_time = value * 1024;
+            }
+
+            select(CONFIG_DB);
+            auto lossless_traffic_keys = keys("LOSSLESS_TRAFFIC_PATTERN");
+            for (auto &fv : dbs[selected][lossless_traffic_keys[0]])
+            {
+                double value;
+                tonumber(&fv.second, value);
+                if (fv.first == "mtu")
+                    lossless_mtu = value;
+                if (fv.first == "small_packet_percentage")
+                    small_packet_percentage = value;
+            }
+
+            auto default_lossless_param_keys = keys("DEFAULT_LOSSLESS_BUFFER_PARAMETER");
+            double over_subscribe_ratio;
+            bool has_ratio = tonumber(hget(default_lossless_param_keys[0], "over_subscribe_ratio"), over_subscribe_ratio);
+
+            double shp_size;
+            bool has_shp_size = tonumber(hget("BUFFER_POOL|ingress_lossless_pool", "xoff"), shp_size);
+
+            bool shp_enabled = (has_shp_size && shp_size != 0) || (has_ratio && over_subscribe_ratio != 0);
+
+            double speed_of_light = 198000000;
+            double minimal_packet_size = 64;
+            double cell_occupancy, worst_case_factor, propagation_delay, bytes_on_cable, bytes_on_gearbox;
+            double xoff_value, xon_value, headroom_size, speed_overhead;
+
+            if (port_speed == 400000)
+            {
+                pipeline_latency = 37 * 1024;
+                speed_overhead = port_mtu;
+            }
+            else
+            {
+                speed_overhead = 0;
+            }
+
+            if (cell_size > 2 * minimal_packet_size)
+                worst_case_factor = cell_size / minimal_packet_size;
+            else
+                worst_case_factor = (2 * cell_size) / (1 + cell_size);
+
+            cell_occupancy = (100 - small_packet_percentage + small_packet_percentage * worst_case_factor) / 100;
+
+            if (gearbox_delay == 0)
+                bytes_on_gearbox = 0;
+            else
+                bytes_on_gearbox = port_speed * gearbox_delay / (8 * 1024);
+
+            bytes_on_cable = 2 * cable_length * port_speed * 1000000000 / speed_of_light / (8 * 1024);
+            propagation_delay = port_mtu + bytes_on_cable + 2 * bytes_on_gearbox + mac_phy_delay + peer_response_time;
+
+            xoff_value = lossless_mtu + propagation_delay * cell_occupancy;
+            xoff_value = ceil(xoff_value / 1024) * 1024;
+            xon_value = pipeline_latency;
+            xon_value = ceil(xon_value / 1024) * 1024;
+
+            if (shp_enabled)
+                headroom_size = xon_value;
+            else
+                headroom_size = xoff_value + xon_value + speed_overhead;
+            headroom_size = ceil(headroom_size / 1024) * 1024;
+
+            ret.push_back("xon:" + str(ceil(xon_value)));
+            ret.push_back("xoff:" + str(ceil(xoff_value)));
+            ret.push_back("size:" + str(ceil(headroom_size)));
+
+            return ret;
+        }
+
+        vector<string> pool()
+        {
+            double lossypg_reserved = 19 * 1024;
+            double lossypg_reserved_400g = 37 * 1024;
+            double lossypg_400g = 0;
+
+            vector<string> result;
+            vector<pair<string, double>> profiles;
+
+            double total_port = 0;
+
+            double mgmt_pool_size = 256 * 1024;
+            double egress_mirror_headroom = 10 * 1024;
+
+            auto find_profile = [&](const string &ref) -> size_t {
+                string name = ref.substr(1, ref.size() - 2);
+                for (size_t i = 0; i < profiles.size(); i++)
+                {
+                    if (profiles[i].first == name)
+                        return i + 1;
+                }
+                return 0;
+            };
+
+            auto iterate_all_items = [&](vector<string> all_items) -> int {
+                sort(all_items.begin(), all_items.end());
+                for (auto &item : all_items)
+                {
+                    // string.match(item, "Ethernet%d+")
+                    auto pos = item.find("Ethernet");
+                    if (pos == string::npos || pos + 8 >= item.size() || !isdigit(item[pos + 8]))
+                        continue;
+                    auto end = pos + 8;
+                    while (end < item.size() && isdigit(item[end]))
+                        end++;
+                    string port = item.substr(pos, end - pos);
+                    string range = item.substr(end + 1);
+
+                    const string *profile = hget(item, "profile");
+                    size_t index = profile ? find_profile(*profile) : 0;
+                    if (index == 0)
+                        return 1;
+
+                    double size;
+                    if (range.size() == 1)
+                        size = 1;
+                    else
+                        size = 1 + (range.back() - '0') - (range.front() - '0');
+                    profiles[index - 1].second += size;
+                    auto speed = hget("PORT_TABLE:" + port, "speed");
+                    if (speed && *speed == "400000" && *profile == "[BUFFER_PROFILE_TABLE:ingress_lossy_profile]")
+                        lossypg_400g += size;
+                }
+                return 0;
+            };
+
+            select(CONFIG_DB);
+
+            total_port = static_cast<double>(keys("PORT|").size());
+
+            const string *egress_lossless_pool_size = hget("BUFFER_POOL|egress_lossless_pool", "size");
+
+            auto default_lossless_param_keys = keys("DEFAULT_LOSSLESS_BUFFER_PARAMETER");
+            double over_subscribe_ratio;
+            bool has_ratio = tonumber(hget(default_lossless_param_keys[0], "over_subscribe_ratio"), over_subscribe_ratio);
+
+            double shp_size;
+            bool has_shp_size = tonumber(hget("BUFFER_POOL|ingress_lossless_pool", "xoff"), shp_size);
+
+            bool shp_enabled = false;
+            if (has_ratio && over_subscribe_ratio != 0)
+                shp_enabled = true;
+
+            if (has_shp_size && shp_size != 0)
+                shp_enabled = true;
+            else
+                shp_size = 0;
+
+            select(APPL_DB);
+
+            for (auto &key : keys("BUFFER_PROFILE"))
+                profiles.emplace_back(key, 0);
+
+            int fail_count = 0;
+            fail_count += iterate_all_items(keys("BUFFER_PG"));
+            fail_count += iterate_all_items(keys("BUFFER_QUEUE"));
+            if (fail_count > 0)
+                return {};
+
+            double accumulative_occupied_buffer = 0;
+            double accumulative_xoff = 0;
+            for (auto &profile : profiles)
+            {
+                double size;
+                if (tonumber(hget(profile.first, "size"), size))
+                {
+                    if (profile.first == "BUFFER_PROFILE_TABLE:ingress_lossy_profile")
+                        size = size + lossypg_reserved;
+                    if (profile.first == "BUFFER_PROFILE_TABLE:egress_lossy_profile")
+                        profile.second = total_port;
+                    if (size != 0)
+                    {
+                        if (shp_enabled && shp_size == 0)
+                        {
+                            double xon, xoff;
+                            if (tonumber(hget(profile.first, "xon"), xon) && tonumber(hget(profile.first, "xoff"), xoff) && xon + xoff > size)
+                                accumulative_xoff = accumulative_xoff + (xon + xoff - size) * profile.second;
+                        }
+                        accumulative_occupied_buffer = accumulative_occupied_buffer + size * profile.second;
+                    }
+                }
+            }
+
+            double lossypg_extra_for_400g = (lossypg_reserved_400g - lossypg_reserved) * lossypg_400g;
+            accumulative_occupied_buffer = accumulative_occupied_buffer + lossypg_extra_for_400g;
+
+            double accumulative_egress_mirror_overhead = total_port * egress_mirror_headroom;
+            accumulative_occupied_buffer = accumulative_occupied_buffer + accumulative_egress_mirror_overhead + mgmt_pool_size;
+
+            select(STATE_DB);
+            double mmu_size;
+            if (!tonumber(hget("BUFFER_MAX_PARAM_TABLE|global", "mmu_size"), mmu_size))
+                tonumber(egress_lossless_pool_size, mmu_size);
+            auto asic_keys = keys("ASIC_TABLE");
+            double cell_size;
+            tonumber(hget(asic_keys[0], "cell_size"), cell_size);
+
+            double number_of_cells = floor(mmu_size / cell_size);
+            double ceiling_mmu_size = number_of_cells * cell_size;
+
+            select(CONFIG_DB);
+
+            vector<string> pools_need_update;
+            int ingress_pool_count = 0;
+            bool has_ingress_lossless_pool_size = false;
+            double ingress_lossless_pool_size = 0;
+            for (auto &ipool : keys("BUFFER_POOL|ingress"))
+            {
+                double size;
+                if (!tonumber(hget(ipool, "size"), size))
+                {
+                    pools_need_update.push_back(ipool);
+                    ingress_pool_count++;
+                }
+                else if (ipool == "BUFFER_POOL|ingress_lossless_pool" && shp_enabled && shp_size == 0)
+                {
+                    has_ingress_lossless_pool_size = true;
+                    ingress_lossless_pool_size = size;
+                }
+            }
+
+            for (auto &epool : keys("BUFFER_POOL|egress"))
+            {
+                if (!hget(epool, "size"))
+                    pools_need_update.push_back(epool);
+            }
+
+            if (shp_enabled && shp_size == 0)
+                shp_size = ceil(accumulative_xoff / over_subscribe_ratio);
+
+            double pool_size;
+            accumulative_occupied_buffer = accumulative_occupied_buffer + shp_size;
+            if (ingress_pool_count == 1)
+                pool_size = mmu_size - accumulative_occupied_buffer;
+            else
+                pool_size = (mmu_size - accumulative_occupied_buffer) / 2;
+
+            if (pool_size > ceiling_mmu_size)
+                pool_size = ceiling_mmu_size;
+
+            bool shp_deployed = false;
+            for (auto &key : pools_need_update)
+            {
+                string pool_name = key.substr(string("BUFFER_POOL|").size());
+                if (shp_size != 0 && pool_name == "ingress_lossless_pool")
+                {
+                    result.push_back(pool_name + ":" + str(ceil(pool_size)) + ":" + str(ceil(shp_size)));
+                    shp_deployed = true;
+                }
+                else
+                {
+                    result.push_back(pool_name + ":" + str(ceil(pool_size)));
+                }
+            }
+
+            if (!shp_deployed && shp_size != 0 && has_ingress_lossless_pool_size)
+                result.push_back("ingress_lossless_pool:" + str(ceil(ingress_lossless_pool_size)) + ":" + str(ceil(shp_size)));
+
+            return result;
+        }
+    };
+
+    // Pool sizes, without the debug lines
+    vector<string> poolSizes(const vector<string> &result)
+    {
+        vector<string> sizes;
+        for (auto &line : result)
+        {
+            if (line.compare(0, 6, "debug:") != 0)
+            {
+                sizes.push_back(line);
+            }
+        }
+        sort(sizes.begin(), sizes.end());
+        return sizes;
+    }
+
+    vector<string> headroomLines(const buffer_headroom_t &headroom)
+    {
+        return { "xon:" + headroom.xon, "xoff:" + headroom.xoff, "size:" + headroom.size };
+    }
+
+    /*
+     * Applies every update to the databases of the lua plugins and to the
+     * buffer model the way buffermgrd does.
+     */
+    struct BufferModelTest : public ::testing::Test
+    {
+        LuaPlugins lua;
+        BufferPoolModel model;
+        buffer_model_params_t params;
+        unique_ptr<BufferVendorFormula> formula = BufferVendorFormula::create("mellanox");
+
+        void SetUp() override
+        {
+            setAsic("144");
+            lua.dbs[CONFIG_DB]["LOSSLESS_TRAFFIC_PATTERN|AZURE"] = { { "mtu", "1024" }, { "small_packet_percentage", "100" } };
+            params.lossless_mtu = "1024";
+            params.small_packet_percentage = "100";
+            setOverSubscribeRatio("0");
+        }
+
+        void setAsic(const string &cellSize)
+        {
+            lua.dbs[STATE_DB]["ASIC_TABLE|MELLANOX-SPECTRUM"] = {
+                { "cell_size", cellSize }, { "pipeline_latency", "18" }, { "mac_phy_delay", "0.8" }, { "peer_response_time", "3.8" } };
+            params.cell_size = cellSize;
+            params.pipeline_latency = "18";
+            params.mac_phy_delay = "0.8";
+            params.peer_response_time = "3.8";
+        }
+
+        void setOverSubscribeRatio(const string &ratio)
+        {
+            lua.dbs[CONFIG_DB]["DEFAULT_LOSSLESS_BUFFER_PARAMETER|AZURE"] = { { "default_dynamic_th", "0" }, { "over_subscribe_ratio", ratio } };
+            params.over_subscribe_ratio = ratio;
+        }
+
+        void setMmuSize(const string &size)
+        {
+            lua.dbs[STATE_DB]["BUFFER_MAX_PARAM_TABLE|global"]["mmu_size"] = size;
+            params.mmu_size = size;
+        }
+
+        void setPool(const string &name, const string &size, const string &xoff = "")
+        {
+            auto &pool = lua.dbs[CONFIG_DB]["BUFFER_POOL|" + name];
+            pool = { { "mode", "dynamic" } };
+            if (!size.empty())
+                pool["size"] = size;
+            if (!xoff.empty())
+                pool["xoff"] = xoff;
+            model.setPool(name, size);
+            if (name == "ingress_lossless_pool")
+                params.shared_headroom_pool_size = xoff;
+        }
+
+        void setPort(const string &port, const string &speed)
+        {
+            lua.dbs[CONFIG_DB]["PORT|" + port] = { { "speed", speed } };
+            lua.dbs[APPL_DB]["PORT_TABLE:" + port] = { { "speed", speed } };
+            model.setPortSpeed(port, speed);
+        }
+
+        void setProfile(const string &name, const string &size, const string &xon = "", const string &xoff = "")
+        {
+            auto &profile = lua.dbs[APPL_DB]["BUFFER_PROFILE_TABLE:" + name];
+            profile = { { "size", size } };
+            if (!xon.empty())
+                profile["xon"] = xon;
+            if (!xoff.empty())
+                profile["xoff"] = xoff;
+            model.setProfile(name, size, xon, xoff);
+        }
+
+        void removeProfile(const string &name)
+        {
+            lua.dbs[APPL_DB].erase("BUFFER_PROFILE_TABLE:" + name);
+            model.removeProfile(name);
+        }
+
+        void setPg(const string &key, const string &profile)
+        {
+            lua.dbs[APPL_DB]["BUFFER_PG_TABLE:" + key] = { { "profile", "[BUFFER_PROFILE_TABLE:" + profile + "]" } };
+            model.setPriorityGroup(key, profile);
+        }
+
+        void removePg(const string &key)
+        {
+            lua.dbs[APPL_DB].erase("BUFFER_PG_TABLE:" + key);
+            model.removePriorityGroup(key);
+        }
+
+        void setQueue(const string &key, const string &profile)
+        {
+            lua.dbs[APPL_DB]["BUFFER_QUEUE_TABLE:" + key] = { { "profile", "[BUFFER_PROFILE_TABLE:" + profile + "]" } };
+            model.setQueue(key, profile);
+        }
+
+        // Creates the lossless profile of a port the way buffermgrd names it
+        string losslessProfile(const string &speed, const string &cable)
+        {
+            string name = "pg_lossless_" + speed + "_" + cable + "_profile";
+            buffer_headroom_t headroom;
+            EXPECT_TRUE(formula->calculateHeadroom(params, speed, cable, "9100", "", headroom));
+            setProfile(name, headroom.size, headroom.xon, headroom.xoff);
+            return name;
+        }
+
+        vector<string> calculatePools()
+        {
+            vector<string> result;
+            formula->calculatePools(params, model, result);
+            return poolSizes(result);
+        }
+    };
+
+    TEST_F(BufferModelTest, NoFormula)
+    {
+        ASSERT_NE(BufferVendorFormula::create("vs"), nullptr);
+        ASSERT_EQ(BufferVendorFormula::create("broadcom"), nullptr);
+    }
+
+    TEST_F(BufferModelTest, HeadroomMatchesLuaPlugin)
+    {
+        int checked = 0;
+
+        for (auto cellSize : { "96", "144" })
+        {
+            setAsic(cellSize);
+            for (int shp = 0; shp < 3; shp++)
+            {
+                setOverSubscribeRatio(shp == 1 ? "2" : "0");
+                setPool("ingress_lossless_pool", "", shp == 2 ? "1024000" : "");
+
+                for (auto speed : { "1000", "10000", "25000", "40000", "50000", "100000", "200000", "400000" })
+                {
+                    for (auto cable : { "1m", "5m", "40m", "300m", "1500m" })
+                    {
+                        for (auto mtu : { "1500", "4096", "9100" })
+                        {
+                            for (auto gearbox : { "", "700" })
+                            {
+                                buffer_headroom_t headroom;
+                                ASSERT_TRUE(formula->calculateHeadroom(params, speed, cable, mtu, gearbox, headroom));
+                                ASSERT_EQ(headroomLines(headroom), lua.headroom(speed, cable, mtu, gearbox))
+                                    << "speed " << speed << " cable " << cable << " mtu " << mtu << " gearbox " << gearbox
+                                    << " cell " << cellSize << " shp " << shp;
+                                checked++;
+                            }
+                        }
+                    }
+                }
+            }
+        }
+
+        ASSERT_EQ(checked, 2 * 3 * 8 * 5 * 3 * 2);
+    }
+
+    TEST_F(BufferModelTest, HeadroomInvalidArguments)
+    {
+        buffer_headroom_t headroom;
+        ASSERT_FALSE(formula->calculateHeadroom(params, "100000", "", "9100", "", headroom));
+        ASSERT_FALSE(formula->calculateHeadroom(params, "", "5m", "9100", "", headroom));
+
+        params.cell_size.clear();
+        ASSERT_FALSE(formula->calculateHeadroom(params, "100000", "5m", "9100", "", headroom));
+    }
+
+    TEST_F(BufferModelTest, MissingProfile)
+    {
+        setMmuSize("13945824");
+        setPool("ingress_lossless_pool", "");
+        setPool("egress_lossless_pool", "13945824");
+        setPort("Ethernet0", "100000");
+
+        setPg("Ethernet0:3-4", "pg_lossless_100000_5m_profile");
+        ASSERT_TRUE(lua.pool().empty());
+        ASSERT_TRUE(calculatePools().empty());
+
+        // The profile referenced by the PG is created afterwards
+        losslessProfile("100000", "5m");
+        ASSERT_FALSE(calculatePools().empty());
+        ASSERT_EQ(calculatePools(), poolSizes(lua.pool()));
+
+        removeProfile("pg_lossless_100000_5m_profile");
+        ASSERT_TRUE(calculatePools().empty());
+
+        removePg("Ethernet0:3-4");
+        ASSERT_EQ(calculatePools(), poolSizes(lua.pool()));
+    }
+
+    TEST_F(BufferModelTest, PoolMatchesLuaPluginOnTrace)
+    {
+        const int ports = 32;
+        const vector<string> speeds = { "25000", "50000", "100000", "400000" };
+        const vector<string> cables = { "5m", "40m", "300m" };
+
+        setMmuSize("13945824");
+        setPool("ingress_lossless_pool", "");
+        setPool("ingress_lossy_pool", "");
+        setPool("egress_lossless_pool", "13945824");
+        setPool("egress_lossy_pool", "");
+        setProfile("ingress_lossy_profile", "0");
+        setProfile("egress_lossless_profile", "0");
+        setProfile("egress_lossy_profile", "9216");
+        setProfile("q_lossy_profile", "0");
+
+        map<string, string> portSpeed, portCable;
+        map<string, bool> lossless;
+        for (int i = 0; i < ports; i++)
+        {
+            string port = "Ethernet" + to_string(i * 4);
+            portSpeed[port] = speeds[i % speeds.size()];
+            portCable[port] = cables[i % cables.size()];
+            lossless[port] = true;
+
+            setPort(port, portSpeed[port]);
+            setPg(port + ":0", "ingress_lossy_profile");
+            setPg(port + ":3-4", losslessProfile(portSpeed[port], portCable[port]));
+            setQueue(port + ":0-2", "q_lossy_profile");
+            setQueue(port + ":3-4", "egress_lossless_profile");
+            setQueue(port + ":5-6", "q_lossy_profile");
+        }
+
+        ASSERT_EQ(calculatePools(), poolSizes(lua.pool()));
+
+        mt19937 gen(1);
+        for (int step = 0; step < 2000; step++)
+        {
+            string port = "Ethernet" + to_string(gen() % ports * 4);
+            switch (gen() % 8)
+            {
+            case 0:
+            case 1:
+                portCable[port] = cables[gen() % cables.size()];
+                break;
+            case 2:
+                portSpeed[port] = speeds[gen() % speeds.size()];
+                setPort(port, portSpeed[port]);
+                break;
+            case 3:
+                lossless[port] = !lossless[port];
+                break;
+            case 4:
+                setOverSubscribeRatio(to_string(gen() % 3));
+                break;
+            case 5:
+                setPool("ingress_lossless_pool", "", gen() % 4 == 0 ? "2097152" : "");
+                break;
+            case 6:
+                setPool("ingress_lossy_pool", gen() % 4 == 0 ? "4194304" : "");
+                break;
+            case 7:
+                setMmuSize(gen() % 4 == 0 ? "14024704" : "13945824");
+                break;
+            }
+
+            if (lossless[port])
+                setPg(port + ":3-4", losslessProfile(portSpeed[port], portCable[port]));
+            else
+                removePg(port + ":3-4");
+
+            auto expected = poolSizes(lua.pool());
+            ASSERT_FALSE(expected.empty());
+            ASSERT_EQ(calculatePools(), expected) << "step " << step;
+        }
+    }
+}
@@ -103,4 +103,65 @@ namespace bulker_test
         ASSERT_EQ(ia->first.id, SAI_ROUTE_ENTRY_ATTR_PACKET_ACTION);
         ASSERT_EQ(ia->first.value.s32, SAI_PACKET_ACTION_FORWARD);
     }
+
+    sai_status_t createFdbEntry(const sai_fdb_entry_t *fdb_entry, uint32_t, const sai_attribute_t *)
+    {
+        // Entries of odd MACs do not fit
+        return (fdb_entry->mac_address[5] & 1) ? SAI_STATUS_TABLE_FULL : SAI_STATUS_SUCCESS;
+    }
+
+    sai_status_t removeFdbEntry(const sai_fdb_entry_t *)
+    {
+        return SAI_STATUS_SUCCESS;
+    }
+
+    TEST(FdbBulkerTest, EntryStatuses)
+    {
+        sai_fdb_api_t fdb_api = {};
+        fdb_api.create_fdb_entry = createFdbEntry;
+        fdb_api.remove_fdb_entry = removeFdbEntry;
+
+        EntityBulker<sai_fdb_api_t> fdbBulker(&fdb_api);
+        deque<sai_status_t> object_statuses;
+
+        sai_fdb_entry_t fdb_entry = {};
+        sai_attribute_t fdb_attr;
+        fdb_attr.id = SAI_FDB_ENTRY_ATTR_TYPE;
+        fdb_attr.value.s32 = SAI_FDB_ENTRY_TYPE_STATIC;
+
+        for (uint8_t i = 0; i < 4; i++)
+        {
+            fdb_entry.mac_address[5] = i;
+            object_statuses.emplace_back();
+            ASSERT_EQ(fdbBulker.create_entry(&object_statuses.back(), &fdb_entry, 1, &fdb_attr), SAI_STATUS_NOT_EXECUTED);
+        }
+
+        // The same entry is not created twice in a bulk
+        sai_status_t duplicate_status;
+        fdb_entry.mac_address[5] = 0;
+        ASSERT_EQ(fdbBulker.create_entry(&duplicate_status, &fdb_entry, 1, &fdb_attr), SAI_STATUS_ITEM_ALREADY_EXISTS);
+        ASSERT_EQ(fdbBulker.creating_entries_count(), 4);
+
+        // Every entry gets its own status
+        fdbBulker.flush();
+        ASSERT_EQ(fdbBulker.creating_entries_count(), 0);
+        ASSERT_EQ(object_statuses[0], SAI_STATUS_SUCCESS);
+        ASSERT_EQ(object_statuses[1], SAI_STATUS_TABLE_FULL);
+        ASSERT_EQ(object_statuses[2], SAI_STATUS_SUCCESS);
+        ASSERT_EQ(object_statuses[3], SAI_STATUS_TABLE_FULL);
+
+        object_statuses.clear();
+        for (uint8_t i = 0; i < 4; i += 2)
+        {
+            fdb_entry.mac_address[5] = i;
+            object_statuses.emplace_back();
+            fdbBulker.remove_entry(&object_statuses.back(), &fdb_entry);
+        }
+        ASSERT_EQ(fdbBulker.removing_entries_count(), 2);
+
+        fdbBulker.flush();
+        ASSERT_EQ(fdbBulker.removing_entries_count(), 0);
+        ASSERT_EQ(object_statuses[0], SAI_STATUS_SUCCESS);
+        ASSERT_EQ(object_statuses[1], SAI_STATUS_SUCCESS);
+    }
 }
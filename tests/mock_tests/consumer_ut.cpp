@@ -2,6 +2,9 @@
 #include "mock_orchagent_main.h"
 #include "mock_table.h"
 
+#include <chrono>
+#include <iostream>
+#include <map>
 #include <sstream>
 
 extern PortsOrch *gPortsOrch;
@@ -10,6 +13,44 @@ namespace consumer_test
 {
     using namespace std;
 
+    class ParkingOrch : public Orch
+    {
+    public:
+        ParkingOrch() : Orch(vector<TableConnector>())
+        {
+        }
+
+        // Keep every task pending until its VRF is added
+        void doTask(Consumer &consumer) override
+        {
+            m_calls++;
+            for (auto &it : consumer.m_toSync)
+            {
+                consumer.parkUntil(it.first, make_pair(RETRY_EVENT_VRF_ADDED, it.first));
+            }
+        }
+
+        int m_calls = 0;
+    };
+
+    class DrainingOrch : public Orch
+    {
+    public:
+        DrainingOrch() : Orch(vector<TableConnector>())
+        {
+        }
+
+        // Complete the first pending task only
+        void doTask(Consumer &consumer) override
+        {
+            auto it = consumer.m_toSync.begin();
+            if (it != consumer.m_toSync.end())
+            {
+                consumer.m_toSync.erase(it);
+            }
+        }
+    };
+
     struct ConsumerTest : public ::testing::Test
     {
         shared_ptr<swss::DBConnector> m_app_db;
@@ -322,4 +363,235 @@ namespace consumer_test
         validate_syncmap(consumer->m_toSync, 1, key, exp_kofv);
 
     }
+
+    TEST_F(ConsumerTest, ConsumerAddToSync_Insertion_Order)
+    {
+        // Test case, pending tasks are kept in the order their key was first seen
+        auto entrya = KeyOpFieldsValuesTuple(
+            { "key_b",
+                SET_COMMAND,
+                { { f1, v1a } } });
+
+        auto entryb = KeyOpFieldsValuesTuple(
+            { "key_a",
+                SET_COMMAND,
+                { { f1, v1a } } });
+
+        auto entryc = KeyOpFieldsValuesTuple(
+            { "key_b",
+                DEL_COMMAND,
+                { { } } });
+
+        auto entryd = KeyOpFieldsValuesTuple(
+            { "key_b",
+                SET_COMMAND,
+                { { f2, v2a } } });
+
+        kofv_q.push_back(entrya);
+        kofv_q.push_back(entryb);
+        kofv_q.push_back(entryc);
+        kofv_q.push_back(entryd);
+        consumer->addToSync(std::move(kofv_q));
+
+        // expect DEL then SET of key_b, followed by key_a
+        ASSERT_EQ(consumer->m_toSync.size(), 3u);
+        ASSERT_EQ(consumer->m_toSync.count("key_b"), 2u);
+        auto it = consumer->m_toSync.begin();
+        ASSERT_EQ(it->second, entryc);
+        ASSERT_EQ(consumer->m_toSync.find("key_b"), it);
+        it = consumer->m_toSync.erase(it);
+        ASSERT_EQ(it->second, entryd);
+        ASSERT_EQ(consumer->m_toSync.find("key_b"), it);
+        it = consumer->m_toSync.erase(it);
+        ASSERT_EQ(it->second, entryb);
+        ASSERT_EQ(consumer->m_toSync.find("key_b"), consumer->m_toSync.end());
+        consumer->m_toSync.erase(it);
+        ASSERT_TRUE(consumer->m_toSync.empty());
+    }
+
+    TEST_F(ConsumerTest, ConsumerAddToSync_MoveToBack)
+    {
+        // Test case, the pending tasks of a key are moved behind the other keys
+        auto entrya = KeyOpFieldsValuesTuple(
+            { "key_a",
+                DEL_COMMAND,
+                { { } } });
+
+        auto entryb = KeyOpFieldsValuesTuple(
+            { "key_a",
+                SET_COMMAND,
+                { { f1, v1a } } });
+
+        auto entryc = KeyOpFieldsValuesTuple(
+            { "key_b",
+                SET_COMMAND,
+                { { f2, v2a } } });
+
+        kofv_q.push_back(entrya);
+        kofv_q.push_back(entryb);
+        kofv_q.push_back(entryc);
+        consumer->addToSync(std::move(kofv_q));
+
+        consumer->m_toSync.moveToBack("key_a");
+        consumer->m_toSync.moveToBack("key_c");
+
+        // expect key_b, followed by DEL then SET of key_a
+        ASSERT_EQ(consumer->m_toSync.size(), 3u);
+        auto it = consumer->m_toSync.begin();
+        ASSERT_EQ(it->second, entryc);
+        it = consumer->m_toSync.erase(it);
+        ASSERT_EQ(it->second, entrya);
+        ASSERT_EQ(consumer->m_toSync.find("key_a"), it);
+        it = consumer->m_toSync.erase(it);
+        ASSERT_EQ(it->second, entryb);
+        ASSERT_EQ(consumer->m_toSync.find("key_a"), it);
+        consumer->m_toSync.erase(it);
+        ASSERT_TRUE(consumer->m_toSync.empty());
+    }
+
+    TEST_F(ConsumerTest, DISABLED_ConsumerAddToSync_Scale)
+    {
+        // Measure the per entry cost to add and drain unique route like keys
+        for (size_t count : vector<size_t>{ 10000, 100000, 1000000 })
+        {
+            deque<KeyOpFieldsValuesTuple> entries;
+            for (size_t i = 0; i < count; i++)
+            {
+                entries.push_back(KeyOpFieldsValuesTuple(
+                    { "10." + to_string(i >> 16) + "." + to_string((i >> 8) & 0xff) + "." + to_string(i & 0xff) + "/32",
+                        SET_COMMAND,
+                        { { "nexthop", "10.0.0.1" },
+                            { "ifname", "Ethernet0" } } }));
+            }
+
+            auto start = chrono::steady_clock::now();
+            consumer->addToSync(std::move(entries));
+            auto added = chrono::steady_clock::now();
+            ASSERT_EQ(consumer->m_toSync.size(), count);
+
+            auto it = consumer->m_toSync.begin();
+            while (it != consumer->m_toSync.end())
+            {
+                it = consumer->m_toSync.erase(it);
+            }
+            auto drained = chrono::steady_clock::now();
+            ASSERT_TRUE(consumer->m_toSync.empty());
+
+            cout << "addToSync " << count << " keys: "
+                 << chrono::duration_cast<chrono::nanoseconds>(added - start).count() / count << " ns/entry, drain: "
+                 << chrono::duration_cast<chrono::nanoseconds>(drained - added).count() / count << " ns/entry" << endl;
+        }
+    }
+
+    TEST_F(ConsumerTest, ConsumerRetry_Park_WakeUp)
+    {
+        ParkingOrch orch;
+        Consumer parking(new swss::ConsumerStateTable(m_config_db.get(), "CFG_TEST_TABLE", 1, 1), &orch, "CFG_TEST_TABLE");
+
+        parking.addToSync(KeyOpFieldsValuesTuple({ "Vrf1", SET_COMMAND, { { f1, v1a } } }));
+        parking.drain();
+        ASSERT_EQ(orch.m_calls, 1);
+        ASSERT_TRUE(parking.isParked());
+
+        // Parked consumer is not re-driven by the retry loop
+        parking.drain();
+        parking.drain();
+        ASSERT_EQ(orch.m_calls, 1);
+        ASSERT_EQ(parking.m_retrySkipped, 2u);
+
+        // Unrelated event keeps the consumer parked
+        Orch::notifyRetryEvent(RETRY_EVENT_VRF_ADDED, "Vrf2");
+        ASSERT_TRUE(parking.isParked());
+
+        Orch::notifyRetryEvent(RETRY_EVENT_VRF_ADDED, "Vrf1");
+        ASSERT_FALSE(parking.isParked());
+        ASSERT_EQ(parking.m_retryWakeups, 1u);
+        parking.drain();
+        ASSERT_EQ(orch.m_calls, 2);
+        ASSERT_TRUE(parking.isParked());
+
+        // New data unparks the consumer
+        parking.addToSync(KeyOpFieldsValuesTuple({ "Vrf3", SET_COMMAND, { { f1, v1a } } }));
+        ASSERT_FALSE(parking.isParked());
+        parking.drain();
+        ASSERT_EQ(orch.m_calls, 3);
+        ASSERT_EQ(parking.m_retryAttempts, 3u);
+
+        vector<FieldValueTuple> fvs;
+        parking.dumpStats(fvs);
+        ASSERT_FALSE(fvs.empty());
+    }
+
+    /* A consumer stops waiting for the constraints of its tasks once they are gone */
+    TEST_F(ConsumerTest, ConsumerRetry_Waiters_Cleanup)
+    {
+        ParkingOrch orch;
+        auto vrf1 = make_pair(RETRY_EVENT_VRF_ADDED, string("Vrf1"));
+        auto vrf2 = make_pair(RETRY_EVENT_VRF_ADDED, string("Vrf2"));
+
+        {
+            Consumer parking(new swss::ConsumerStateTable(m_config_db.get(), "CFG_TEST_TABLE", 1, 1), &orch, "CFG_TEST_TABLE");
+
+            parking.addToSync(KeyOpFieldsValuesTuple({ "Vrf1", SET_COMMAND, { { f1, v1a } } }));
+            parking.addToSync(KeyOpFieldsValuesTuple({ "Vrf2", SET_COMMAND, { { f1, v1a } } }));
+            parking.drain();
+            ASSERT_EQ(Orch::getRetryWaiterCount(vrf1), 1u);
+            ASSERT_EQ(Orch::getRetryWaiterCount(vrf2), 1u);
+
+            // The task of Vrf1 is erased without its VRF being ever added
+            parking.m_toSync.erase(parking.m_toSync.find("Vrf1"));
+            parking.addToSync(KeyOpFieldsValuesTuple({ "Vrf2", SET_COMMAND, { { f2, v2a } } }));
+            parking.drain();
+            ASSERT_EQ(Orch::getRetryWaiterCount(vrf1), 0u);
+            ASSERT_EQ(Orch::getRetryWaiterCount(vrf2), 1u);
+        }
+
+        ASSERT_EQ(Orch::getRetryWaiterCount(vrf2), 0u);
+    }
+
+    TEST_F(ConsumerTest, ConsumerStats)
+    {
+        DrainingOrch orch;
+        Consumer draining(new swss::ConsumerStateTable(m_config_db.get(), "CFG_TEST_TABLE", 1, 1), &orch, "CFG_TEST_TABLE");
+
+        for (int i = 0; i < 3; i++)
+        {
+            draining.addToSync(KeyOpFieldsValuesTuple({ "key" + to_string(i), SET_COMMAND, { { f1, v1a } } }));
+        }
+        draining.drain();
+        draining.drain();
+        draining.drain();
+        draining.drain();
+
+        ASSERT_EQ(draining.m_processed, 3u);
+        ASSERT_EQ(draining.m_retried, 6u);
+        ASSERT_EQ(draining.m_doTaskCalls, 3u);
+        ASSERT_EQ(draining.m_maxPending, 3u);
+        ASSERT_EQ(draining.m_doTaskLatency.count(), 3u);
+
+        vector<FieldValueTuple> fvs;
+        draining.dumpStats(fvs);
+        map<string, string> stats(fvs.begin(), fvs.end());
+        ASSERT_EQ(stats["processed"], "3");
+        ASSERT_EQ(stats["pending"], "0");
+        ASSERT_NE(stats.find("dotask_p99_us"), stats.end());
+    }
+
+    TEST(LatencyHistogram, Percentiles)
+    {
+        LatencyHistogram histogram;
+        ASSERT_EQ(histogram.percentile(50), 0u);
+
+        for (int i = 0; i < 98; i++)
+        {
+            histogram.add(chrono::microseconds(3));
+        }
+        histogram.add(chrono::microseconds(900));
+        histogram.add(chrono::seconds(3600));
+
+        ASSERT_EQ(histogram.count(), 100u);
+        ASSERT_EQ(histogram.percentile(50), 4u);
+        ASSERT_EQ(histogram.percentile(99), 1024u);
+        ASSERT_EQ(histogram.percentile(100), 1ULL << 31);
+    }
 }
@@ -0,0 +1,322 @@
+#include "ut_helper.h"
+#include "mock_orchagent_main.h"
+#include "mock_table.h"
+#include "portal.h"
+
+#include <atomic>
+#include <chrono>
+#include <thread>
+
+extern sai_switch_api_t *sai_switch_api;
+extern sai_acl_api_t *sai_acl_api;
+
+namespace crmorch_test
+{
+    using namespace std;
+
+    const sai_object_id_t acl_table_1 = 0x7000000000001;
+    const sai_object_id_t acl_table_2 = 0x7000000000002;
+
+    /*
+     * SAI getters of the availability attributes: every counter reads as
+     * availCounter, the generic error of a multi attribute get is optional.
+     */
+    atomic<uint32_t> availCounter;
+    bool failBulkGet;
+    set<sai_attr_id_t> unsupportedSwitchAttrs;
+    set<sai_attr_id_t> unsupportedAclTableAttrs;
+    atomic<uint32_t> switchGets;
+    atomic<uint32_t> aclTableGets;
+
+    sai_status_t getSwitchAttribute(sai_object_id_t, uint32_t count, sai_attribute_t *attrs)
+    {
+        switchGets++;
+
+        for (uint32_t i = 0; i < count; i++)
+        {
+            if (unsupportedSwitchAttrs.count(attrs[i].id))
+            {
+                return count > 1 && failBulkGet ? SAI_STATUS_FAILURE : SAI_STATUS_ATTR_NOT_SUPPORTED_0;
+            }
+        }
+
+        for (uint32_t i = 0; i < count; i++)
+        {
+            if (attrs[i].id == SAI_SWITCH_ATTR_AVAILABLE_ACL_TABLE ||
+                attrs[i].id == SAI_SWITCH_ATTR_AVAILABLE_ACL_TABLE_GROUP)
+            {
+                auto &list = attrs[i].value.aclresource;
+                list.count = 2;
+                list.list[0] = { SAI_ACL_STAGE_INGRESS, SAI_ACL_BIND_POINT_TYPE_PORT, availCounter };
+                list.list[1] = { SAI_ACL_STAGE_EGRESS, SAI_ACL_BIND_POINT_TYPE_LAG, availCounter + 1 };
+            }
+            else
+            {
+                attrs[i].value.u32 = availCounter + attrs[i].id;
+            }
+        }
+
+        return SAI_STATUS_SUCCESS;
+    }
+
+    sai_status_t getAclTableAttribute(sai_object_id_t table, uint32_t count, sai_attribute_t *attrs)
+    {
+        aclTableGets++;
+
+        for (uint32_t i = 0; i < count; i++)
+        {
+            if (unsupportedAclTableAttrs.count(attrs[i].id))
+            {
+                return count > 1 && failBulkGet ? SAI_STATUS_FAILURE : SAI_STATUS_NOT_SUPPORTED;
+            }
+        }
+
+        for (uint32_t i = 0; i < count; i++)
+        {
+            attrs[i].value.u32 = availCounter + static_cast<uint32_t>(table & 0xff) * 100 + attrs[i].id;
+        }
+
+        return SAI_STATUS_SUCCESS;
+    }
+
+    struct CrmOrchTest : public ::testing::Test
+    {
+        shared_ptr<swss::DBConnector> m_config_db;
+        sai_switch_api_t *m_orig_switch_api;
+        sai_switch_api_t m_switch_api;
+        sai_acl_api_t *m_orig_acl_api;
+        sai_acl_api_t m_acl_api;
+
+        CrmOrchTest()
+        {
+            m_config_db = make_shared<swss::DBConnector>("CONFIG_DB", 0);
+        }
+
+        void SetUp() override
+        {
+            ::testing_db::reset();
+
+            map<string, string> profile = {
+                { "SAI_VS_SWITCH_TYPE", "SAI_VS_SWITCH_TYPE_BCM56850" },
+                { "KV_DEVICE_MAC_ADDRESS", "20:03:04:05:06:00" }
+            };
+
+            auto status = ut_helper::initSaiApi(profile);
+            ASSERT_EQ(status, SAI_STATUS_SUCCESS);
+
+            m_orig_switch_api = sai_switch_api;
+            m_switch_api = *sai_switch_api;
+            m_switch_api.get_switch_attribute = getSwitchAttribute;
+            sai_switch_api = &m_switch_api;
+
+            m_orig_acl_api = sai_acl_api;
+            m_acl_api = *sai_acl_api;
+            m_acl_api.get_acl_table_attribute = getAclTableAttribute;
+            sai_acl_api = &m_acl_api;
+
+            availCounter = 1000;
+            failBulkGet = false;
+            unsupportedSwitchAttrs.clear();
+            unsupportedAclTableAttrs.clear();
+            switchGets = 0;
+            aclTableGets = 0;
+        }
+
+        void TearDown() override
+        {
+            sai_switch_api = m_orig_switch_api;
+            sai_acl_api = m_orig_acl_api;
+            ut_helper::uninitSaiApi();
+
+            ::testing_db::reset();
+        }
+
+        CrmAvailQuery makeQuery()
+        {
+            CrmAvailQuery query;
+
+            query.switchAttrs = {
+                SAI_SWITCH_ATTR_AVAILABLE_IPV4_ROUTE_ENTRY,
+                SAI_SWITCH_ATTR_AVAILABLE_IPV6_NEXTHOP_ENTRY,
+                SAI_SWITCH_ATTR_AVAILABLE_ACL_TABLE
+            };
+            query.aclResourceAttrs = { SAI_SWITCH_ATTR_AVAILABLE_ACL_TABLE };
+            query.aclTableAttrs = {
+                SAI_ACL_TABLE_ATTR_AVAILABLE_ACL_ENTRY,
+                SAI_ACL_TABLE_ATTR_AVAILABLE_ACL_COUNTER
+            };
+            query.aclTables = { acl_table_1, acl_table_2 };
+
+            return query;
+        }
+
+        static uint32_t ipv4RouteAvail(const CrmOrch &crmOrch)
+        {
+            const auto &res = Portal::CrmOrchInternal::getResourceMap(&crmOrch).at(CrmResourceType::CRM_IPV4_ROUTE);
+            return res.countersMap.at("STATS").availableCounter;
+        }
+    };
+
+    /* Every attribute lands in the result map of its kind, with one get for the switch and one per ACL table */
+    TEST_F(CrmOrchTest, QueryResultMapping)
+    {
+        CrmAvailResult result;
+        CrmOrch::queryAvailableCounters(makeQuery(), result);
+
+        ASSERT_EQ(switchGets.load(), 1u);
+        ASSERT_EQ(aclTableGets.load(), 2u);
+        ASSERT_TRUE(result.unsupported.empty());
+
+        ASSERT_EQ(result.switchCounters.size(), 2u);
+        ASSERT_EQ(result.switchCounters.at(SAI_SWITCH_ATTR_AVAILABLE_IPV4_ROUTE_ENTRY),
+                  1000u + SAI_SWITCH_ATTR_AVAILABLE_IPV4_ROUTE_ENTRY);
+        ASSERT_EQ(result.switchCounters.at(SAI_SWITCH_ATTR_AVAILABLE_IPV6_NEXTHOP_ENTRY),
+                  1000u + SAI_SWITCH_ATTR_AVAILABLE_IPV6_NEXTHOP_ENTRY);
+
+        ASSERT_EQ(result.aclResources.size(), 1u);
+        const auto &resources = result.aclResources.at(SAI_SWITCH_ATTR_AVAILABLE_ACL_TABLE);
+        ASSERT_EQ(resources.size(), 2u);
+        ASSERT_EQ(resources[0].stage, SAI_ACL_STAGE_INGRESS);
+        ASSERT_EQ(resources[0].bind_point, SAI_ACL_BIND_POINT_TYPE_PORT);
+        ASSERT_EQ(resources[0].avail_num, 1000u);
+        ASSERT_EQ(resources[1].stage, SAI_ACL_STAGE_EGRESS);
+        ASSERT_EQ(resources[1].bind_point, SAI_ACL_BIND_POINT_TYPE_LAG);
+        ASSERT_EQ(resources[1].avail_num, 1001u);
+
+        ASSERT_EQ(result.aclTableCounters.size(), 2u);
+        ASSERT_EQ(result.aclTableCounters.at(acl_table_1).at(SAI_ACL_TABLE_ATTR_AVAILABLE_ACL_ENTRY),
+                  1100u + SAI_ACL_TABLE_ATTR_AVAILABLE_ACL_ENTRY);
+        ASSERT_EQ(result.aclTableCounters.at(acl_table_2).at(SAI_ACL_TABLE_ATTR_AVAILABLE_ACL_COUNTER),
+                  1200u + SAI_ACL_TABLE_ATTR_AVAILABLE_ACL_COUNTER);
+    }
+
+    /*
+     * A multi attribute switch get failing with a generic error is retried
+     * one attribute at a time: the others are still read and the unsupported
+     * one is reported. ACL table gets are only retried when the error says an
+     * attribute is not supported.
+     */
+    TEST_F(CrmOrchTest, QueryFallbackOnGenericError)
+    {
+        failBulkGet = true;
+        unsupportedSwitchAttrs = { SAI_SWITCH_ATTR_AVAILABLE_IPV6_NEXTHOP_ENTRY };
+        unsupportedAclTableAttrs = { SAI_ACL_TABLE_ATTR_AVAILABLE_ACL_COUNTER };
+
+        CrmAvailResult result;
+        CrmOrch::queryAvailableCounters(makeQuery(), result);
+
+        ASSERT_EQ(switchGets.load(), 4u);
+        ASSERT_EQ(aclTableGets.load(), 2u);
+
+        ASSERT_EQ(result.unsupported, set<sai_attr_id_t>({ SAI_SWITCH_ATTR_AVAILABLE_IPV6_NEXTHOP_ENTRY }));
+        ASSERT_EQ(result.switchCounters.size(), 1u);
+        ASSERT_EQ(result.switchCounters.count(SAI_SWITCH_ATTR_AVAILABLE_IPV4_ROUTE_ENTRY), 1u);
+        ASSERT_EQ(result.aclResources.at(SAI_SWITCH_ATTR_AVAILABLE_ACL_TABLE).size(), 2u);
+
+        ASSERT_TRUE(result.aclTableCounters.empty());
+        ASSERT_TRUE(result.unsupportedAclTableAttrs.empty());
+    }
+
+    /*
+     * An ACL table attribute that is not supported is found with single
+     * attribute gets on the first table and left out of the gets of the
+     * other tables.
+     */
+    TEST_F(CrmOrchTest, QueryAclTableUnsupported)
+    {
+        unsupportedAclTableAttrs = { SAI_ACL_TABLE_ATTR_AVAILABLE_ACL_COUNTER };
+
+        CrmAvailResult result;
+        CrmOrch::queryAvailableCounters(makeQuery(), result);
+
+        ASSERT_EQ(aclTableGets.load(), 4u);
+        ASSERT_EQ(result.unsupportedAclTableAttrs, set<sai_attr_id_t>({ SAI_ACL_TABLE_ATTR_AVAILABLE_ACL_COUNTER }));
+
+        for (auto table : { acl_table_1, acl_table_2 })
+        {
+            const auto &counters = result.aclTableCounters.at(table);
+            ASSERT_EQ(counters.size(), 1u);
+            ASSERT_EQ(counters.count(SAI_ACL_TABLE_ATTR_AVAILABLE_ACL_ENTRY), 1u);
+        }
+    }
+
+    /* The next polls do not query an ACL table attribute found not supported */
+    TEST_F(CrmOrchTest, PollSkipsUnsupportedAclTableAttr)
+    {
+        unsupportedAclTableAttrs = { SAI_ACL_TABLE_ATTR_AVAILABLE_ACL_COUNTER };
+
+        CrmOrch crmOrch(m_config_db.get(), CFG_CRM_TABLE_NAME);
+        crmOrch.incCrmAclTableUsedCounter(CrmResourceType::CRM_ACL_ENTRY, acl_table_1);
+
+        Portal::CrmOrchInternal::getResAvailableCounters(&crmOrch);
+        ASSERT_EQ(aclTableGets.load(), 3u);
+
+        const auto &resources = Portal::CrmOrchInternal::getResourceMap(&crmOrch);
+        ASSERT_EQ(resources.at(CrmResourceType::CRM_ACL_COUNTER).resStatus, CrmResourceStatus::CRM_RES_NOT_SUPPORTED);
+        ASSERT_EQ(resources.at(CrmResourceType::CRM_ACL_ENTRY).resStatus, CrmResourceStatus::CRM_RES_SUPPORTED);
+
+        aclTableGets = 0;
+        Portal::CrmOrchInternal::getResAvailableCounters(&crmOrch);
+        ASSERT_EQ(aclTableGets.load(), 1u);
+
+        const auto &entries = resources.at(CrmResourceType::CRM_ACL_ENTRY).countersMap;
+        ASSERT_EQ(entries.at(Portal::CrmOrchInternal::getCrmAclTableKey(&crmOrch, acl_table_1)).availableCounter,
+                  1100u + SAI_ACL_TABLE_ATTR_AVAILABLE_ACL_ENTRY);
+    }
+
+    /* A single attribute that is not supported is reported without a retry */
+    TEST_F(CrmOrchTest, QuerySingleUnsupported)
+    {
+        failBulkGet = true;
+        unsupportedSwitchAttrs = { SAI_SWITCH_ATTR_AVAILABLE_IPV4_ROUTE_ENTRY };
+
+        CrmAvailQuery query;
+        query.switchAttrs = { SAI_SWITCH_ATTR_AVAILABLE_IPV4_ROUTE_ENTRY };
+
+        CrmAvailResult result;
+        CrmOrch::queryAvailableCounters(query, result);
+
+        ASSERT_EQ(switchGets.load(), 1u);
+        ASSERT_TRUE(result.switchCounters.empty());
+        ASSERT_EQ(result.unsupported, set<sai_attr_id_t>({ SAI_SWITCH_ATTR_AVAILABLE_IPV4_ROUTE_ENTRY }));
+    }
+
+    /*
+     * The first poll is synchronous, the next ones are answered by the poll
+     * thread and picked up by a later poll. Once the thread is stopped the
+     * polls are synchronous again, and it can be restarted.
+     */
+    TEST_F(CrmOrchTest, PollThreadStartStop)
+    {
+        const uint32_t ipv4Route = SAI_SWITCH_ATTR_AVAILABLE_IPV4_ROUTE_ENTRY;
+        CrmOrch crmOrch(m_config_db.get(), CFG_CRM_TABLE_NAME);
+
+        Portal::CrmOrchInternal::getResAvailableCounters(&crmOrch);
+        ASSERT_EQ(ipv4RouteAvail(crmOrch), 1000u + ipv4Route);
+
+        for (int round = 0; round < 2; round++)
+        {
+            availCounter = 2000 + round;
+            crmOrch.startPollThread();
+            crmOrch.startPollThread();
+
+            for (int i = 0; i < 500 && ipv4RouteAvail(crmOrch) != availCounter + ipv4Route; i++)
+            {
+                Portal::CrmOrchInternal::getResAvailableCounters(&crmOrch);
+                this_thread::sleep_for(chrono::milliseconds(10));
+            }
+            ASSERT_EQ(ipv4RouteAvail(crmOrch), availCounter + ipv4Route);
+
+            crmOrch.stopPollThread();
+            crmOrch.stopPollThread();
+
+            availCounter = 3000 + round;
+            Portal::CrmOrchInternal::getResAvailableCounters(&crmOrch);
+            ASSERT_EQ(ipv4RouteAvail(crmOrch), availCounter + ipv4Route);
+        }
+
+        // The destructor stops a running thread
+        crmOrch.startPollThread();
+        Portal::CrmOrchInternal::getResAvailableCounters(&crmOrch);
+    }
+}
@@ -0,0 +1,413 @@
+#include "ut_helper.h"
+#include "mock_orchagent_main.h"
+#include "mock_table.h"
+
+#include <chrono>
+#include <iostream>
+
+extern sai_fdb_api_t *sai_fdb_api;
+extern Directory<Orch*> gDirectory;
+
+namespace fdborch_test
+{
+    using namespace std;
+
+    const sai_object_id_t trunk_bridge_port_id = 0x3a000000000100;
+    const sai_object_id_t other_bridge_port_id = 0x3a000000000200;
+    const sai_object_id_t tunnel_bridge_port_id = 0x3a000000000300;
+    const sai_vlan_id_t vlan_count = 4094;
+    const int macs_per_vlan = 4;
+    const char *remote_vtep = "10.0.0.2";
+
+    size_t created_fdb_entries;
+    size_t removed_fdb_entries;
+
+    sai_status_t createFdbEntry(const sai_fdb_entry_t *, uint32_t, const sai_attribute_t *)
+    {
+        created_fdb_entries++;
+        return SAI_STATUS_SUCCESS;
+    }
+
+    sai_status_t removeFdbEntry(const sai_fdb_entry_t *)
+    {
+        removed_fdb_entries++;
+        return SAI_STATUS_SUCCESS;
+    }
+
+    class FlushObserver : public Observer
+    {
+    public:
+        void update(SubjectType type, void *cntx) override
+        {
+            if (type == SUBJECT_TYPE_FDB_FLUSH_CHANGE)
+            {
+                auto update = static_cast<FdbFlushUpdate *>(cntx);
+                m_flushed += update->entries.size();
+            }
+        }
+
+        size_t m_flushed = 0;
+    };
+
+    struct FdbOrchTest : public ::testing::Test
+    {
+        shared_ptr<swss::DBConnector> m_app_db;
+        shared_ptr<swss::DBConnector> m_config_db;
+        shared_ptr<swss::DBConnector> m_state_db;
+        shared_ptr<swss::DBConnector> m_chassis_app_db;
+        sai_fdb_api_t *m_orig_fdb_api;
+        sai_fdb_api_t m_fdb_api;
+
+        FdbOrchTest()
+        {
+            // FIXME: move out from constructor
+            m_app_db = make_shared<swss::DBConnector>("APPL_DB", 0);
+            m_config_db = make_shared<swss::DBConnector>("CONFIG_DB", 0);
+            m_state_db = make_shared<swss::DBConnector>("STATE_DB", 0);
+            m_chassis_app_db = make_shared<swss::DBConnector>("CHASSIS_APP_DB", 0);
+        }
+
+        void SetUp() override
+        {
+            ::testing_db::reset();
+
+            map<string, string> profile = {
+                { "SAI_VS_SWITCH_TYPE", "SAI_VS_SWITCH_TYPE_BCM56850" },
+                { "KV_DEVICE_MAC_ADDRESS", "20:03:04:05:06:00" }
+            };
+
+            auto status = ut_helper::initSaiApi(profile);
+            ASSERT_EQ(status, SAI_STATUS_SUCCESS);
+
+            sai_attribute_t attr;
+            attr.id = SAI_SWITCH_ATTR_INIT_SWITCH;
+            attr.value.booldata = true;
+
+            status = sai_switch_api->create_switch(&gSwitchId, 1, &attr);
+            ASSERT_EQ(status, SAI_STATUS_SUCCESS);
+
+            // save original api since tests may fake FDB entries
+            m_orig_fdb_api = sai_fdb_api;
+            m_fdb_api = *sai_fdb_api;
+            sai_fdb_api = &m_fdb_api;
+
+            const int portsorch_base_pri = 40;
+
+            vector<table_name_with_pri_t> ports_tables = {
+                { APP_PORT_TABLE_NAME, portsorch_base_pri + 5 },
+                { APP_VLAN_TABLE_NAME, portsorch_base_pri + 2 },
+                { APP_VLAN_MEMBER_TABLE_NAME, portsorch_base_pri },
+                { APP_LAG_TABLE_NAME, portsorch_base_pri + 4 },
+                { APP_LAG_MEMBER_TABLE_NAME, portsorch_base_pri }
+            };
+
+            ASSERT_EQ(gPortsOrch, nullptr);
+            gPortsOrch = new PortsOrch(m_app_db.get(), ports_tables, m_chassis_app_db.get());
+
+            ASSERT_EQ(gCrmOrch, nullptr);
+            gCrmOrch = new CrmOrch(m_config_db.get(), CFG_CRM_TABLE_NAME);
+
+            TableConnector stateDbFdb(m_state_db.get(), STATE_FDB_TABLE_NAME);
+
+            vector<table_name_with_pri_t> app_fdb_tables = {
+                { APP_FDB_TABLE_NAME,        FdbOrch::fdborch_pri},
+                { APP_VXLAN_FDB_TABLE_NAME,  FdbOrch::fdborch_pri}
+            };
+
+            ASSERT_EQ(gFdbOrch, nullptr);
+            gFdbOrch = new FdbOrch(m_app_db.get(), app_fdb_tables, stateDbFdb, gPortsOrch);
+
+            ASSERT_EQ(gNeighOrch, nullptr);
+            gNeighOrch = new NeighOrch(m_app_db.get(), APP_NEIGH_TABLE_NAME, nullptr, gFdbOrch, gPortsOrch, m_chassis_app_db.get());
+
+            addTrunkTopology();
+        }
+
+        void TearDown() override
+        {
+            delete gDirectory.get<VxlanTunnelOrch *>();
+            gDirectory.erase<VxlanTunnelOrch *>();
+
+            delete gNeighOrch;
+            gNeighOrch = nullptr;
+            delete gFdbOrch;
+            gFdbOrch = nullptr;
+            delete gCrmOrch;
+            gCrmOrch = nullptr;
+            delete gPortsOrch;
+            gPortsOrch = nullptr;
+
+            auto status = sai_switch_api->remove_switch(gSwitchId);
+            ASSERT_EQ(status, SAI_STATUS_SUCCESS);
+            gSwitchId = 0;
+
+            sai_fdb_api = m_orig_fdb_api;
+            ut_helper::uninitSaiApi();
+
+            ::testing_db::reset();
+        }
+
+        // Two trunks carrying all the VLANs, the ports and VLANs only exist in PortsOrch
+        void addTrunkTopology()
+        {
+            Port trunk("Ethernet0", Port::PHY);
+            trunk.m_port_id = 0x1000000000100;
+            trunk.m_bridge_port_id = trunk_bridge_port_id;
+
+            Port other("Ethernet4", Port::PHY);
+            other.m_port_id = 0x1000000000200;
+            other.m_bridge_port_id = other_bridge_port_id;
+
+            for (sai_vlan_id_t vlan_id = 1; vlan_id <= vlan_count; vlan_id++)
+            {
+                Port vlan(VLAN_PREFIX + to_string(vlan_id), Port::VLAN);
+                vlan.m_vlan_info.vlan_id = vlan_id;
+                vlan.m_vlan_info.vlan_oid = getVlanOid(vlan_id);
+                vlan.m_members.insert(trunk.m_alias);
+                vlan.m_members.insert(other.m_alias);
+                gPortsOrch->setPort(vlan.m_alias, vlan);
+
+                trunk.m_vlan_members[vlan_id] = { 0, SAI_VLAN_TAGGING_MODE_TAGGED };
+                other.m_vlan_members[vlan_id] = { 0, SAI_VLAN_TAGGING_MODE_TAGGED };
+            }
+
+            gPortsOrch->setPort(trunk.m_alias, trunk);
+            gPortsOrch->setPort(other.m_alias, other);
+        }
+
+        // A VXLAN tunnel port to the remote VTEP carrying the first VLANs
+        void addTunnelTopology(sai_vlan_id_t vlans)
+        {
+            gDirectory.set(new VxlanTunnelOrch(new swss::DBConnector("STATE_DB", 0),
+                        new swss::DBConnector("APPL_DB", 0), APP_VXLAN_TUNNEL_TABLE_NAME));
+
+            Port tunnel(getTunnelAlias(), Port::TUNNEL);
+            tunnel.m_bridge_port_id = tunnel_bridge_port_id;
+            gPortsOrch->setPort(tunnel.m_alias, tunnel);
+
+            for (sai_vlan_id_t vlan_id = 1; vlan_id <= vlans; vlan_id++)
+            {
+                gPortsOrch->findPort(VLAN_PREFIX + to_string(vlan_id))->m_members.insert(tunnel.m_alias);
+            }
+
+            Portal::PortsOrchInternal::setInitDone(gPortsOrch);
+        }
+
+        static string getTunnelAlias()
+        {
+            return gDirectory.get<VxlanTunnelOrch *>()->getTunnelPortName(remote_vtep);
+        }
+
+        static sai_object_id_t getVlanOid(sai_vlan_id_t vlan_id)
+        {
+            return 0x26000000000000 + vlan_id;
+        }
+
+        static MacAddress getMac(sai_vlan_id_t vlan_id, int i, sai_object_id_t bridge_port_id)
+        {
+            uint8_t mac[6] = { 0x00, (uint8_t)(bridge_port_id >> 8), (uint8_t)(vlan_id >> 8), (uint8_t)vlan_id, 0x00, (uint8_t)i };
+            return MacAddress(mac);
+        }
+
+        void sendFdbEvent(sai_fdb_event_t type, sai_vlan_id_t vlan_id, const MacAddress &mac, sai_object_id_t bridge_port_id)
+        {
+            sai_fdb_entry_t entry;
+            entry.switch_id = gSwitchId;
+            memcpy(entry.mac_address, mac.getMac(), sizeof(sai_mac_t));
+            entry.bv_id = getVlanOid(vlan_id);
+            gFdbOrch->update(type, &entry, bridge_port_id);
+        }
+
+        void learnAll()
+        {
+            for (sai_vlan_id_t vlan_id = 1; vlan_id <= vlan_count; vlan_id++)
+            {
+                for (int i = 0; i < macs_per_vlan; i++)
+                {
+                    sendFdbEvent(SAI_FDB_EVENT_LEARNED, vlan_id, getMac(vlan_id, i, trunk_bridge_port_id), trunk_bridge_port_id);
+                    sendFdbEvent(SAI_FDB_EVENT_LEARNED, vlan_id, getMac(vlan_id, i, other_bridge_port_id), other_bridge_port_id);
+                }
+            }
+        }
+
+        size_t portDown(const string &alias)
+        {
+            FlushObserver observer;
+            gFdbOrch->attach(&observer);
+
+            PortOperStateUpdate update;
+            gPortsOrch->getPort(alias, update.port);
+            update.operStatus = SAI_PORT_OPER_STATUS_DOWN;
+            gFdbOrch->update(SUBJECT_TYPE_PORT_OPER_STATE_CHANGE, &update);
+
+            gFdbOrch->detach(&observer);
+            return observer.m_flushed;
+        }
+
+        // Tunnel to the remote VTEP on the first VLANs, with the FDB entries created and removed by the fakes
+        Consumer *setupRemoteMacs(sai_vlan_id_t vlans)
+        {
+            addTunnelTopology(vlans);
+
+            m_fdb_api.create_fdb_entry = createFdbEntry;
+            m_fdb_api.remove_fdb_entry = removeFdbEntry;
+            created_fdb_entries = 0;
+            removed_fdb_entries = 0;
+
+            return static_cast<Consumer *>(gFdbOrch->getExecutor(APP_VXLAN_FDB_TABLE_NAME));
+        }
+
+        static string getRemoteMacKey(sai_vlan_id_t vlan_id, int i)
+        {
+            return VLAN_PREFIX + to_string(vlan_id) + ":" + getMac(vlan_id, i, tunnel_bridge_port_id).to_string();
+        }
+
+        static deque<KeyOpFieldsValuesTuple> getRemoteMacs(sai_vlan_id_t vlans, int macs, const string &op)
+        {
+            deque<KeyOpFieldsValuesTuple> entries;
+            for (sai_vlan_id_t vlan_id = 1; vlan_id <= vlans; vlan_id++)
+            {
+                for (int i = 0; i < macs; i++)
+                {
+                    if (op == DEL_COMMAND)
+                    {
+                        entries.push_back({ getRemoteMacKey(vlan_id, i), DEL_COMMAND, { } });
+                    }
+                    else
+                    {
+                        entries.push_back({ getRemoteMacKey(vlan_id, i), SET_COMMAND, {
+                            { "remote_vtep", remote_vtep }, { "type", "dynamic" }, { "vni", to_string(1000 + vlan_id) } } });
+                    }
+                }
+            }
+            return entries;
+        }
+    };
+
+    /*
+     * Port down flush of the MACs learnt on 4094 VLANs, 4 MACs per VLAN on each
+     * of the two trunks.
+     * Run with --gtest_also_run_disabled_tests.
+     */
+    TEST_F(FdbOrchTest, DISABLED_PortDownOnTrunk)
+    {
+        auto start = chrono::steady_clock::now();
+        learnAll();
+        auto learnt = chrono::steady_clock::now();
+
+        const size_t macs = (size_t)vlan_count * macs_per_vlan;
+        ASSERT_EQ(Portal::FdbOrchInternal::getEntries(gFdbOrch).size(), macs * 2);
+        ASSERT_EQ(gPortsOrch->findPort("Ethernet0")->m_fdb_count, macs);
+        ASSERT_EQ(gPortsOrch->findPort("Vlan1")->m_fdb_count, (uint32_t)macs_per_vlan * 2);
+
+        // Only the MACs learnt on the port are flushed
+        ASSERT_EQ(portDown("Ethernet0"), macs);
+        auto flushed = chrono::steady_clock::now();
+
+        cout << "Learnt " << macs * 2 << " MACs in "
+             << chrono::duration_cast<chrono::milliseconds>(learnt - start).count() << " ms, port down flush of "
+             << macs << " MACs on " << vlan_count << " VLANs in "
+             << chrono::duration_cast<chrono::microseconds>(flushed - learnt).count() << " us" << endl;
+
+        // Aged MACs are no longer flushed
+        sendFdbEvent(SAI_FDB_EVENT_AGED, 1, getMac(1, 0, trunk_bridge_port_id), trunk_bridge_port_id);
+        sendFdbEvent(SAI_FDB_EVENT_AGED, 2, getMac(2, 0, trunk_bridge_port_id), trunk_bridge_port_id);
+        ASSERT_EQ(portDown("Ethernet0"), macs - 2);
+        ASSERT_EQ(portDown("Ethernet4"), macs);
+        ASSERT_EQ(gPortsOrch->findPort("Ethernet0")->m_fdb_count, macs - 2);
+    }
+
+    TEST_F(FdbOrchTest, NeighborsByMac)
+    {
+        MacAddress mac1 = getMac(1, 0, trunk_bridge_port_id);
+        MacAddress mac2 = getMac(1, 1, trunk_bridge_port_id);
+        NeighborEntry neigh1(IpAddress("10.0.0.1"), "Vlan1");
+        NeighborEntry neigh2(IpAddress("fc00::1"), "Vlan1");
+
+        Portal::NeighOrchInternal::setSyncdNeighbor(gNeighOrch, neigh1, mac1);
+        Portal::NeighOrchInternal::setSyncdNeighbor(gNeighOrch, neigh2, mac1);
+        ASSERT_EQ(Portal::NeighOrchInternal::getNeighborCount(gNeighOrch, "Vlan1", mac1), 2u);
+        ASSERT_EQ(Portal::NeighOrchInternal::getNeighborCount(gNeighOrch, "Vlan2", mac1), 0u);
+
+        // A neighbor moved to another MAC is only found with the new MAC
+        Portal::NeighOrchInternal::setSyncdNeighbor(gNeighOrch, neigh2, mac2);
+        ASSERT_EQ(Portal::NeighOrchInternal::getNeighborCount(gNeighOrch, "Vlan1", mac1), 1u);
+        ASSERT_EQ(Portal::NeighOrchInternal::getNeighborCount(gNeighOrch, "Vlan1", mac2), 1u);
+
+        Portal::NeighOrchInternal::eraseSyncdNeighbor(gNeighOrch, neigh1);
+        ASSERT_EQ(Portal::NeighOrchInternal::getNeighborCount(gNeighOrch, "Vlan1", mac1), 0u);
+
+        // The flush of the port resolves the neighbors of its MACs again
+        learnAll();
+        ASSERT_EQ(portDown("Ethernet0"), (size_t)vlan_count * macs_per_vlan);
+    }
+
+    /* Remote MACs from APP_DB are installed and removed in bulk, in order */
+    TEST_F(FdbOrchTest, RemoteMacBulk)
+    {
+        const sai_vlan_id_t vlans = 4;
+        const int macs = 8;
+        const size_t total = (size_t)vlans * macs;
+
+        auto consumer = setupRemoteMacs(vlans);
+        consumer->addToSync(getRemoteMacs(vlans, macs, SET_COMMAND));
+        static_cast<Orch *>(gFdbOrch)->doTask(*consumer);
+
+        ASSERT_TRUE(consumer->m_toSync.empty());
+        ASSERT_EQ(created_fdb_entries, total);
+        ASSERT_EQ(Portal::FdbOrchInternal::getEntries(gFdbOrch).size(), total);
+        ASSERT_EQ(gPortsOrch->findPort(getTunnelAlias())->m_fdb_count, total);
+        ASSERT_EQ(gPortsOrch->findPort("Vlan1")->m_fdb_count, (uint32_t)macs);
+
+        // A MAC removed and added again in the same batch is applied in order
+        consumer->addToSync({ { getRemoteMacKey(1, 0), DEL_COMMAND, { } } });
+        consumer->addToSync({ { getRemoteMacKey(1, 0), SET_COMMAND, {
+            { "remote_vtep", remote_vtep }, { "type", "dynamic" }, { "vni", "1001" } } } });
+        static_cast<Orch *>(gFdbOrch)->doTask(*consumer);
+
+        ASSERT_TRUE(consumer->m_toSync.empty());
+        ASSERT_EQ(removed_fdb_entries, 1u);
+        ASSERT_EQ(created_fdb_entries, total + 1);
+        ASSERT_EQ(Portal::FdbOrchInternal::getEntries(gFdbOrch).size(), total);
+
+        // Remove the MACs of half the VLANs
+        consumer->addToSync(getRemoteMacs(vlans / 2, macs, DEL_COMMAND));
+        static_cast<Orch *>(gFdbOrch)->doTask(*consumer);
+
+        ASSERT_TRUE(consumer->m_toSync.empty());
+        ASSERT_EQ(removed_fdb_entries, total / 2 + 1);
+        ASSERT_EQ(Portal::FdbOrchInternal::getEntries(gFdbOrch).size(), total / 2);
+        ASSERT_EQ(gPortsOrch->findPort(getTunnelAlias())->m_fdb_count, total / 2);
+        ASSERT_EQ(gPortsOrch->findPort("Vlan1")->m_fdb_count, 0u);
+        ASSERT_EQ(gPortsOrch->findPort("Vlan" + to_string(vlans))->m_fdb_count, (uint32_t)macs);
+    }
+
+    /*
+     * Remote MACs per second from APP_DB, 16 VLANs with 4096 MACs each.
+     * Run with --gtest_also_run_disabled_tests.
+     */
+    TEST_F(FdbOrchTest, DISABLED_RemoteMacThroughput)
+    {
+        const sai_vlan_id_t vlans = 16;
+        const int macs = 4096;
+        const size_t total = (size_t)vlans * macs;
+
+        auto consumer = setupRemoteMacs(vlans);
+        consumer->addToSync(getRemoteMacs(vlans, macs, SET_COMMAND));
+
+        auto start = chrono::steady_clock::now();
+        static_cast<Orch *>(gFdbOrch)->doTask(*consumer);
+        auto installed = chrono::steady_clock::now();
+
+        consumer->addToSync(getRemoteMacs(vlans, macs, DEL_COMMAND));
+        static_cast<Orch *>(gFdbOrch)->doTask(*consumer);
+        auto removed = chrono::steady_clock::now();
+
+        cout << "Installed " << total << " remote MACs in "
+             << chrono::duration_cast<chrono::milliseconds>(installed - start).count() << " ms, removed them in "
+             << chrono::duration_cast<chrono::milliseconds>(removed - installed).count() << " ms" << endl;
+
+        ASSERT_EQ(created_fdb_entries, total);
+        ASSERT_EQ(removed_fdb_entries, total);
+    }
+}
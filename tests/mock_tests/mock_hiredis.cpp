@@ -1,8 +1,74 @@
 #include <stdlib.h>
+#include <string.h>
+#include <algorithm>
 #include <hiredis/hiredis.h>
 
+#include "mock_hiredis.h"
+
+namespace testing_redis
+{
+    bool gCapture = false;
+    std::vector<std::string> gCommands;
+    std::deque<redisReply *> gReplies;
+
+    void reset()
+    {
+        gCapture = false;
+        gCommands.clear();
+
+        for (auto reply : gReplies)
+        {
+            freeReplyObject(reply);
+        }
+        gReplies.clear();
+    }
+
+    std::vector<std::string> commandArgs(const std::string &command)
+    {
+        std::vector<std::string> args;
+        size_t pos = command.find("\r\n") + 2;
+
+        while (pos < command.size())
+        {
+            size_t end = command.find("\r\n", pos);
+            size_t len = std::stoul(command.substr(pos + 1, end - pos - 1));
+            args.push_back(command.substr(end + 2, len));
+            pos = end + 2 + len + 2;
+        }
+
+        return args;
+    }
+
+    redisReply *stringReply(const std::string &s)
+    {
+        auto reply = static_cast<redisReply *>(calloc(1, sizeof(redisReply)));
+        reply->type = REDIS_REPLY_STRING;
+        reply->str = static_cast<char *>(malloc(s.size() + 1));
+        memcpy(reply->str, s.c_str(), s.size() + 1);
+        reply->len = s.size();
+        return reply;
+    }
+
+    redisReply *arrayReply(const std::vector<redisReply *> &elements)
+    {
+        auto reply = static_cast<redisReply *>(calloc(1, sizeof(redisReply)));
+        reply->type = REDIS_REPLY_ARRAY;
+        reply->elements = elements.size();
+        reply->element = static_cast<redisReply **>(calloc(elements.size() + 1, sizeof(redisReply *)));
+        std::copy(elements.begin(), elements.end(), reply->element);
+        return reply;
+    }
+}
+
 int redisGetReply(redisContext *c, void **reply)
 {
+    if (!testing_redis::gReplies.empty())
+    {
+        *reply = testing_redis::gReplies.front();
+        testing_redis::gReplies.pop_front();
+        return 0;
+    }
+
     *reply = calloc(sizeof(redisReply), 1);
     ((redisReply *)*reply)->type = 3;
     return 0;
@@ -10,6 +76,10 @@ int redisGetReply(redisContext *c, void **reply)
 
 int redisAppendFormattedCommand(redisContext *c, const char *cmd, size_t len)
 {
+    if (testing_redis::gCapture)
+    {
+        testing_redis::gCommands.emplace_back(cmd, len);
+    }
     return 0;
 }
 
@@ -21,4 +91,4 @@ int redisvAppendCommand(redisContext *c, const char *format, va_list ap)
 int redisAppendCommand(redisContext *c, const char *format, ...)
 {
     return 0;
-}
\ No newline at end of file
+}
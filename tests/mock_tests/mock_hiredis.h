@@ -0,0 +1,25 @@
+#pragma once
+
+#include <deque>
+#include <string>
+#include <vector>
+#include <hiredis/hiredis.h>
+
+namespace testing_redis
+{
+    /* Record the commands sent while set, in the Redis protocol format */
+    extern bool gCapture;
+    extern std::vector<std::string> gCommands;
+
+    /* Replies handed out in order by redisGetReply(), an integer reply once empty */
+    extern std::deque<redisReply *> gReplies;
+
+    void reset();
+
+    /* Arguments of a command in the Redis protocol format */
+    std::vector<std::string> commandArgs(const std::string &command);
+
+    /* Replies to queue in gReplies */
+    redisReply *stringReply(const std::string &s);
+    redisReply *arrayReply(const std::vector<redisReply *> &elements);
+}
@@ -14,11 +14,13 @@ MacAddress gVxlanMacAddress;
 
 #define DEFAULT_BATCH_SIZE 128
 int gBatchSize = DEFAULT_BATCH_SIZE;
+int gRouteBatchSize = 0;
 
 bool gSairedisRecord = true;
 bool gSwssRecord = true;
 bool gLogRotate = false;
 bool gSaiRedisLogRotate = false;
+bool gConsumerStatsDump = false;
 ofstream gRecordOfs;
 string gRecordFile;
 string gMySwitchType = "switch";
@@ -17,10 +17,12 @@
 #include "fgnhgorch.h"
 
 extern int gBatchSize;
+extern int gRouteBatchSize;
 extern bool gSwssRecord;
 extern bool gSairedisRecord;
 extern bool gLogRotate;
 extern bool gSaiRedisLogRotate;
+extern bool gConsumerStatsDump;
 extern ofstream gRecordOfs;
 extern string gRecordFile;
 
@@ -58,3 +60,4 @@ extern sai_next_hop_api_t *sai_next_hop_api;
 extern sai_hostif_api_t *sai_hostif_api;
 extern sai_buffer_api_t *sai_buffer_api;
 extern sai_queue_api_t *sai_queue_api;
+extern sai_nat_api_t *sai_nat_api;
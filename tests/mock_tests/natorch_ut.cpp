@@ -0,0 +1,358 @@
+#include "ut_helper.h"
+#include "mock_orchagent_main.h"
+#include "mock_table.h"
+#include "mock_hiredis.h"
+#include "portal.h"
+
+#include <set>
+#include <time.h>
+
+#include "json.h"
+
+extern uint32_t natTimerTickCntr;
+
+namespace natorch_test
+{
+    using namespace std;
+
+    /* Hit bits of the NAT entries in the hardware, cleared when read with SAI_NAT_ENTRY_ATTR_HIT_BIT_COR */
+    map<string, bool> hitBits;
+    vector<string> hitBitQueries;
+
+    string natEntryKey(const sai_nat_entry_t *nat_entry)
+    {
+        const auto &key = nat_entry->data.key;
+
+        if (nat_entry->nat_type == SAI_NAT_TYPE_DESTINATION_NAT)
+        {
+            return "dnat:" + IpAddress(key.dst_ip).to_string() + (key.proto ? ":" + to_string(key.l4_dst_port) : "");
+        }
+        return "snat:" + IpAddress(key.src_ip).to_string() + (key.proto ? ":" + to_string(key.l4_src_port) : "");
+    }
+
+    sai_status_t getNatEntryAttribute(const sai_nat_entry_t *nat_entry, uint32_t attr_count, sai_attribute_t *attr_list)
+    {
+        string key = natEntryKey(nat_entry);
+        bool clear = false;
+
+        for (uint32_t i = 0; i < attr_count; i++)
+        {
+            switch (attr_list[i].id)
+            {
+                case SAI_NAT_ENTRY_ATTR_HIT_BIT:
+                    hitBitQueries.push_back(key);
+                    attr_list[i].value.booldata = hitBits[key];
+                    break;
+                case SAI_NAT_ENTRY_ATTR_HIT_BIT_COR:
+                    clear = attr_list[i].value.booldata;
+                    break;
+                default:
+                    attr_list[i].value.u64 = 0;
+                    break;
+            }
+        }
+
+        if (clear)
+        {
+            hitBits[key] = false;
+        }
+
+        return SAI_STATUS_SUCCESS;
+    }
+
+    time_t monotonicNow()
+    {
+        struct timespec now;
+        clock_gettime(CLOCK_MONOTONIC, &now);
+        return now.tv_sec;
+    }
+
+    struct NatOrchTest : public ::testing::Test
+    {
+        shared_ptr<swss::DBConnector> m_app_db;
+        shared_ptr<swss::DBConnector> m_state_db;
+        sai_nat_api_t *m_orig_nat_api;
+        sai_nat_api_t m_nat_api;
+        NatOrch *m_natOrch;
+        time_t m_now;
+
+        void SetUp() override
+        {
+            ::testing_db::reset();
+            ::testing_redis::reset();
+
+            hitBits.clear();
+            hitBitQueries.clear();
+            natTimerTickCntr = 0;
+
+            map<string, string> profile = {
+                { "SAI_VS_SWITCH_TYPE", "SAI_VS_SWITCH_TYPE_BCM56850" },
+                { "KV_DEVICE_MAC_ADDRESS", "20:03:04:05:06:00" }
+            };
+
+            auto status = ut_helper::initSaiApi(profile);
+            ASSERT_EQ(status, SAI_STATUS_SUCCESS);
+
+            sai_attribute_t attr;
+            attr.id = SAI_SWITCH_ATTR_INIT_SWITCH;
+            attr.value.booldata = true;
+
+            status = sai_switch_api->create_switch(&gSwitchId, 1, &attr);
+            ASSERT_EQ(status, SAI_STATUS_SUCCESS);
+
+            // NatOrch takes the NAT API when created
+            m_orig_nat_api = sai_nat_api;
+            m_nat_api = *sai_nat_api;
+            m_nat_api.get_nat_entry_attribute = getNatEntryAttribute;
+            sai_nat_api = &m_nat_api;
+
+            m_app_db = make_shared<swss::DBConnector>("APPL_DB", 0);
+            m_state_db = make_shared<swss::DBConnector>("STATE_DB", 0);
+
+            const int natorch_base_pri = 50;
+
+            vector<table_name_with_pri_t> nat_tables = {
+                { APP_NAT_DNAT_POOL_TABLE_NAME,  natorch_base_pri + 5 },
+                { APP_NAT_TABLE_NAME,            natorch_base_pri + 4 },
+                { APP_NAPT_TABLE_NAME,           natorch_base_pri + 3 },
+                { APP_NAT_TWICE_TABLE_NAME,      natorch_base_pri + 2 },
+                { APP_NAPT_TWICE_TABLE_NAME,     natorch_base_pri + 1 },
+                { APP_NAT_GLOBAL_TABLE_NAME,     natorch_base_pri     }
+            };
+
+            m_natOrch = new NatOrch(m_app_db.get(), m_state_db.get(), nat_tables, nullptr, nullptr);
+            m_now = monotonicNow();
+
+            testing_redis::gCapture = true;
+        }
+
+        void TearDown() override
+        {
+            delete m_natOrch;
+            m_natOrch = nullptr;
+
+            sai_nat_api = m_orig_nat_api;
+
+            auto status = sai_switch_api->remove_switch(gSwitchId);
+            ASSERT_EQ(status, SAI_STATUS_SUCCESS);
+            gSwitchId = 0;
+
+            ut_helper::uninitSaiApi();
+
+            ::testing_redis::reset();
+            ::testing_db::reset();
+        }
+
+        void addNatEntry(const string &ip, const string &translatedIp, const string &natType, time_t activeTime)
+        {
+            NatEntryValue value;
+            value.translated_ip = IpAddress(translatedIp);
+            value.nat_type = natType;
+            value.entry_type = "dynamic";
+            value.activeTime = activeTime;
+            value.ageOutTime = activeTime + 600;
+            value.addedToHw = true;
+
+            Portal::NatOrchInternal::getNatEntries(m_natOrch)[IpAddress(ip)] = value;
+        }
+
+        void addSnaptEntry(const string &proto, const string &ip, int port,
+                           const string &translatedIp, int translatedPort, time_t activeTime)
+        {
+            NaptEntryKey key;
+            key.ip_address = IpAddress(ip);
+            key.l4_port = port;
+            key.prototype = proto;
+
+            NaptEntryValue value;
+            value.translated_ip = IpAddress(translatedIp);
+            value.translated_l4_port = translatedPort;
+            value.nat_type = "snat";
+            value.entry_type = "dynamic";
+            value.activeTime = activeTime;
+            value.ageOutTime = activeTime + 300;
+            value.addedToHw = true;
+
+            Portal::NatOrchInternal::getNaptEntries(m_natOrch)[key] = value;
+        }
+
+        /* Aged out entries notified to natmgrd, as "<op> <key>" */
+        set<string> getAgeOutNotifications()
+        {
+            set<string> notifications;
+
+            for (const auto &command : testing_redis::gCommands)
+            {
+                auto args = testing_redis::commandArgs(command);
+                if (args.size() != 3 || args[0] != "PUBLISH" || args[1] != "SETTIMEOUTNAT")
+                {
+                    continue;
+                }
+
+                vector<FieldValueTuple> values;
+                JSon::readJson(args[2], values);
+                notifications.insert(fvField(values[0]) + " " + fvValue(values[0]));
+            }
+
+            return notifications;
+        }
+
+        size_t countQueries(const string &key)
+        {
+            return count(hitBitQueries.begin(), hitBitQueries.end(), key);
+        }
+
+        void runSweep()
+        {
+            for (int i = 0; i < NAT_HITBIT_QUERY_SLICES; i++)
+            {
+                Portal::NatOrchInternal::queryTick(m_natOrch);
+            }
+            ASSERT_FALSE(Portal::NatOrchInternal::getHitBitSweep(m_natOrch).inProgress);
+        }
+    };
+
+    /*
+     * Entries not hit for their timeout are notified, the hit ones are kept
+     * alive and their hit bit is cleared.
+     */
+    TEST_F(NatOrchTest, AgedOutEntryNotified)
+    {
+        addNatEntry("192.168.0.1", "65.55.42.1", "snat", m_now - 600);
+        addNatEntry("192.168.0.2", "65.55.42.2", "snat", m_now - 600);
+        addNatEntry("192.168.0.3", "65.55.42.3", "snat", m_now - 10);
+        addSnaptEntry("UDP", "192.168.0.4", 5000, "65.55.42.4", 6000, m_now - 300);
+
+        hitBits["snat:192.168.0.2"] = true;
+
+        runSweep();
+
+        ASSERT_EQ(getAgeOutNotifications(), set<string>({
+            "AGEOUT-SINGLE-NAT 192.168.0.1",
+            "AGEOUT-SINGLE-NAPT UDP:192.168.0.4:5000"
+        }));
+
+        auto &natEntries = Portal::NatOrchInternal::getNatEntries(m_natOrch);
+        const auto &hit = natEntries.at(IpAddress("192.168.0.2"));
+        ASSERT_GE(hit.activeTime, m_now);
+        ASSERT_EQ(hit.ageOutTime, hit.activeTime + 600);
+        ASSERT_FALSE(hitBits["snat:192.168.0.2"]);
+
+        ASSERT_EQ(natEntries.at(IpAddress("192.168.0.1")).activeTime, m_now - 600);
+        ASSERT_EQ(countQueries("snat:192.168.0.4:5000"), 1u);
+    }
+
+    /*
+     * The reverse DNAT entry of a SNAT entry not hit is queried, its hit
+     * keeps the SNAT entry alive. A SNAT entry hit doesn't need it.
+     */
+    TEST_F(NatOrchTest, ReverseDnatHitKeepsSnatAlive)
+    {
+        for (const string host : { "1", "2", "3" })
+        {
+            addNatEntry("192.168.0." + host, "65.55.42." + host, "snat", m_now - 600);
+            addNatEntry("65.55.42." + host, "192.168.0." + host, "dnat", 0);
+        }
+
+        hitBits["dnat:65.55.42.1"] = true;
+        hitBits["snat:192.168.0.3"] = true;
+
+        runSweep();
+
+        ASSERT_EQ(getAgeOutNotifications(), set<string>({ "AGEOUT-SINGLE-NAT 192.168.0.2" }));
+
+        const auto &alive = Portal::NatOrchInternal::getNatEntries(m_natOrch).at(IpAddress("192.168.0.1"));
+        ASSERT_GE(alive.activeTime, m_now);
+        ASSERT_EQ(alive.ageOutTime, alive.activeTime + 600);
+
+        ASSERT_EQ(countQueries("dnat:65.55.42.1"), 1u);
+        ASSERT_EQ(countQueries("dnat:65.55.42.2"), 1u);
+        ASSERT_EQ(countQueries("dnat:65.55.42.3"), 0u);
+        ASSERT_FALSE(hitBits["dnat:65.55.42.1"]);
+    }
+
+    /* Entries removed after the sweep started are neither queried nor notified */
+    TEST_F(NatOrchTest, RemovedMidSweepSkipped)
+    {
+        const int entries = 2 * NAT_HITBIT_QUERY_SLICES;
+
+        for (int i = 1; i <= entries; i++)
+        {
+            addNatEntry("192.168.0." + to_string(i), "65.55.42." + to_string(i), "snat", m_now - 600);
+        }
+
+        Portal::NatOrchInternal::queryTick(m_natOrch);
+        ASSERT_EQ(hitBitQueries.size(), 2u);
+
+        // Remove the entries of the next slice
+        const auto &sweep = Portal::NatOrchInternal::getHitBitSweep(m_natOrch);
+        ASSERT_TRUE(sweep.inProgress);
+
+        auto &natEntries = Portal::NatOrchInternal::getNatEntries(m_natOrch);
+        vector<IpAddress> removed = { sweep.natKeys[sweep.natPos], sweep.natKeys[sweep.natPos + 1] };
+        for (const auto &ip : removed)
+        {
+            natEntries.erase(ip);
+        }
+
+        for (int i = 1; i < NAT_HITBIT_QUERY_SLICES; i++)
+        {
+            Portal::NatOrchInternal::queryTick(m_natOrch);
+        }
+        ASSERT_FALSE(sweep.inProgress);
+        ASSERT_EQ(sweep.lastQueried, static_cast<uint64_t>(entries - 2));
+        ASSERT_EQ(hitBitQueries.size(), static_cast<size_t>(entries - 2));
+
+        auto notifications = getAgeOutNotifications();
+        ASSERT_EQ(notifications.size(), static_cast<size_t>(entries - 2));
+
+        for (const auto &ip : removed)
+        {
+            ASSERT_EQ(countQueries("snat:" + ip.to_string()), 0u);
+            ASSERT_EQ(notifications.count("AGEOUT-SINGLE-NAT " + ip.to_string()), 0u);
+        }
+    }
+
+    /*
+     * A sweep queries a slice of the entries per tick and takes
+     * NAT_HITBIT_QUERY_SLICES ticks. Entries added meanwhile wait for the
+     * next sweep.
+     */
+    TEST_F(NatOrchTest, SweepSpansSlices)
+    {
+        const int entries = 2 * NAT_HITBIT_QUERY_SLICES;
+
+        for (int i = 1; i <= entries; i++)
+        {
+            addNatEntry("192.168.0." + to_string(i), "65.55.42." + to_string(i), "snat", m_now);
+            hitBits["snat:192.168.0." + to_string(i)] = true;
+        }
+
+        const auto &sweep = Portal::NatOrchInternal::getHitBitSweep(m_natOrch);
+
+        for (int tick = 1; tick <= NAT_HITBIT_QUERY_SLICES; tick++)
+        {
+            Portal::NatOrchInternal::queryTick(m_natOrch);
+
+            ASSERT_EQ(hitBitQueries.size(), static_cast<size_t>(2 * tick));
+            ASSERT_EQ(sweep.inProgress, tick < NAT_HITBIT_QUERY_SLICES);
+
+            if (tick == 1)
+            {
+                addNatEntry("192.168.1.1", "65.55.43.1", "snat", m_now);
+            }
+        }
+
+        ASSERT_EQ(sweep.sweeps, 1u);
+        ASSERT_EQ(sweep.ticks, static_cast<uint32_t>(NAT_HITBIT_QUERY_SLICES));
+        ASSERT_EQ(sweep.lastQueried, static_cast<uint64_t>(entries));
+        ASSERT_EQ(set<string>(hitBitQueries.begin(), hitBitQueries.end()).size(), static_cast<size_t>(entries));
+        ASSERT_EQ(countQueries("snat:192.168.1.1"), 0u);
+        ASSERT_TRUE(getAgeOutNotifications().empty());
+
+        // The next sweep starts on the next tick
+        Portal::NatOrchInternal::queryTick(m_natOrch);
+        ASSERT_TRUE(sweep.inProgress);
+        ASSERT_EQ(sweep.natKeys.size(), static_cast<size_t>(entries + 1));
+    }
+}
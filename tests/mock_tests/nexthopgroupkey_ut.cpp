@@ -0,0 +1,138 @@
+#include "ut_helper.h"
+#include "nexthopgroupkey.h"
+
+#include <malloc.h>
+#include <unordered_set>
+
+namespace nexthopgroupkey_test
+{
+    using namespace std;
+
+    TEST(NextHopGroupKey, Interned)
+    {
+        NextHopGroupKey nhg1("10.0.0.3@Ethernet8,10.0.0.1@Ethernet0,10.0.0.2@Ethernet4");
+        NextHopGroupKey nhg2("10.0.0.2@Ethernet4,10.0.0.1@Ethernet0");
+
+        // Next hops are printed in NextHopKey order whatever the insertion order
+        ASSERT_EQ(nhg1.to_string(), "10.0.0.1@Ethernet0,10.0.0.2@Ethernet4,10.0.0.3@Ethernet8");
+        ASSERT_EQ(nhg1.getFirstNextHop(), NextHopKey("10.0.0.1", "Ethernet0"));
+        ASSERT_EQ(nhg1.getSize(), 3u);
+
+        ASSERT_NE(nhg1, nhg2);
+        ASSERT_TRUE(nhg1.contains(nhg2));
+        ASSERT_FALSE(nhg2.contains(nhg1));
+        ASSERT_TRUE(nhg1.contains("10.0.0.3", "Ethernet8"));
+        ASSERT_FALSE(nhg1.contains("10.0.0.3", "Ethernet12"));
+
+        nhg2.add("10.0.0.3@Ethernet8");
+        ASSERT_EQ(nhg1, nhg2);
+        ASSERT_EQ(hash<NextHopGroupKey>()(nhg1), hash<NextHopGroupKey>()(nhg2));
+
+        nhg2.remove("10.0.0.1", "Ethernet0");
+        ASSERT_EQ(nhg2.to_string(), "10.0.0.2@Ethernet4,10.0.0.3@Ethernet8");
+        ASSERT_FALSE(nhg2.contains("10.0.0.1@Ethernet0"));
+
+        nhg2.add("10.0.0.1", "Ethernet0");
+        ASSERT_EQ(nhg1, nhg2);
+        ASSERT_FALSE(nhg1 < nhg2 || nhg2 < nhg1);
+
+        unordered_set<NextHopGroupKey> groups = { nhg1, nhg2, NextHopGroupKey("10.0.0.1@Ethernet0") };
+        ASSERT_EQ(groups.size(), 2u);
+
+        nhg2.clear();
+        ASSERT_EQ(nhg2, NextHopGroupKey());
+    }
+
+    TEST(NextHopGroupKey, Iterate)
+    {
+        NextHopGroupKey nhg("10.0.0.9@Ethernet8,10.0.0.7@Ethernet0,10.0.0.8@Ethernet4");
+
+        // Iterated in NextHopKey order, like the copy returned by getNextHops()
+        vector<NextHopKey> nexthops(nhg.begin(), nhg.end());
+        ASSERT_EQ(nexthops, vector<NextHopKey>({ NextHopKey("10.0.0.7", "Ethernet0"),
+                                                 NextHopKey("10.0.0.8", "Ethernet4"),
+                                                 NextHopKey("10.0.0.9", "Ethernet8") }));
+        ASSERT_EQ(set<NextHopKey>(nexthops.begin(), nexthops.end()), nhg.getNextHops());
+
+        // The string is built once, and rebuilt after the group changes
+        const string &str = nhg.to_string();
+        ASSERT_EQ(&str, &nhg.to_string());
+
+        NextHopGroupKey copy = nhg;
+        ASSERT_EQ(&copy.to_string(), &str);
+
+        nhg.remove("10.0.0.7@Ethernet0");
+        ASSERT_EQ(nhg.to_string(), "10.0.0.8@Ethernet4,10.0.0.9@Ethernet8");
+        ASSERT_EQ(nhg.getFirstNextHop(), NextHopKey("10.0.0.8", "Ethernet4"));
+        ASSERT_EQ(copy.to_string(), "10.0.0.7@Ethernet0,10.0.0.8@Ethernet4,10.0.0.9@Ethernet8");
+
+        nhg.add("10.0.0.6@Ethernet12");
+        ASSERT_EQ(nhg.to_string(), "10.0.0.6@Ethernet12,10.0.0.8@Ethernet4,10.0.0.9@Ethernet8");
+
+        nhg.clear();
+        ASSERT_EQ(nhg.begin(), nhg.end());
+        ASSERT_EQ(nhg.to_string(), "");
+    }
+
+    static size_t getHeapUsage()
+    {
+#if defined(__GLIBC__) && __GLIBC_PREREQ(2, 33)
+        return mallinfo2().uordblks;
+#else
+        return static_cast<size_t>(mallinfo().uordblks);
+#endif
+    }
+
+    template <typename T>
+    static void reportRouteMemory(const string &name, size_t count, const vector<T> &nexthops)
+    {
+        size_t before = getHeapUsage();
+        {
+            map<IpPrefix, T> routes;
+            for (size_t i = 0; i < count; i++)
+            {
+                uint32_t ip = htonl(0x14000000 + static_cast<uint32_t>(i));
+                routes.emplace(IpPrefix(ip, 32), nexthops[i % nexthops.size()]);
+            }
+
+            size_t after = getHeapUsage();
+            cout << name << ": " << (after - before) / count << " bytes per route" << endl;
+        }
+    }
+
+    TEST(NextHopGroupKey, DISABLED_MemoryReport)
+    {
+        const size_t count = 1000000;
+
+        // One route in ten uses an 8-way ECMP group out of 32 next hops
+        vector<set<NextHopKey>> sets;
+        vector<NextHopGroupKey> keys;
+        for (uint32_t i = 0; i < 40; i++)
+        {
+            string nhs;
+            size_t width = i < 32 ? 1 : 8;
+            for (size_t j = 0; j < width; j++)
+            {
+                if (j)
+                {
+                    nhs += NHG_DELIMITER;
+                }
+                nhs += "10.0.0." + to_string((i + j * 4) % 32 + 1) + "@Ethernet" + to_string(((i + j * 4) % 32) * 4);
+            }
+
+            keys.emplace_back(nhs);
+            sets.push_back(keys.back().getNextHops());
+        }
+
+        vector<set<NextHopKey>> setRoutes;
+        vector<NextHopGroupKey> keyRoutes;
+        for (size_t i = 0; i < 10; i++)
+        {
+            setRoutes.push_back(sets[i < 9 ? i : 32 + i % 8]);
+            keyRoutes.push_back(keys[i < 9 ? i : 32 + i % 8]);
+        }
+
+        reportRouteMemory("std::set<NextHopKey>", count, setRoutes);
+        reportRouteMemory("NextHopGroupKey", count, keyRoutes);
+    }
+}
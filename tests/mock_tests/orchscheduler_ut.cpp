@@ -0,0 +1,131 @@
+#include "ut_helper.h"
+#include "orchscheduler.h"
+
+#include <atomic>
+#include <thread>
+
+namespace orchscheduler_test
+{
+    using namespace std;
+
+    class TestOrch : public Orch
+    {
+    public:
+        TestOrch() : Orch(vector<TableConnector>())
+        {
+        }
+
+        void doTask(Consumer &consumer) override
+        {
+        }
+
+        /* State guarded by the scheduler locks */
+        uint64_t m_value = 0;
+    };
+
+    struct OrchSchedulerTest : public ::testing::Test
+    {
+        // Ports-like orch shared by everyone, route-like and watermark-like
+        // orchs only reading it, and an fdb-like orch modifying it
+        TestOrch ports;
+        TestOrch route;
+        TestOrch watermark;
+        TestOrch fdb;
+        TestOrch core;
+
+        unique_ptr<OrchScheduler> scheduler;
+
+        void SetUp() override
+        {
+            scheduler = unique_ptr<OrchScheduler>(new OrchScheduler({ &ports, &route, &watermark, &fdb, &core }));
+            scheduler->addDependency(&route, &ports, true);
+            scheduler->addDependency(&watermark, &ports, true);
+            scheduler->addDependency(&fdb, &ports);
+        }
+    };
+
+    TEST_F(OrchSchedulerTest, Conflicts)
+    {
+        ASSERT_FALSE(scheduler->isConflicting(&route, &watermark));
+        ASSERT_TRUE(scheduler->isConflicting(&route, &fdb));
+        ASSERT_TRUE(scheduler->isConflicting(&watermark, &fdb));
+
+        // Orchs without declared dependencies conflict with everything
+        ASSERT_TRUE(scheduler->isConflicting(&core, &route));
+        ASSERT_TRUE(scheduler->isConflicting(&core, &watermark));
+        ASSERT_TRUE(scheduler->isConflicting(&core, &fdb));
+    }
+
+    TEST_F(OrchSchedulerTest, Offload)
+    {
+        ASSERT_TRUE(scheduler->offload(&route, "route"));
+        ASSERT_TRUE(scheduler->isOffloaded(&route));
+
+        // Undeclared orchs stay on the main thread
+        ASSERT_FALSE(scheduler->offload(&core, "core"));
+        ASSERT_FALSE(scheduler->isOffloaded(&core));
+    }
+
+    TEST_F(OrchSchedulerTest, SameResultAsSerial)
+    {
+        const uint64_t iterations = 20000;
+
+        // Each thread reads the shared state and updates its own state the
+        // same way a serial loop would, an unprotected concurrent writer on
+        // the shared state would make the readers observe a torn update.
+        atomic<bool> torn(false);
+
+        auto reader = [&](TestOrch *orch) {
+            for (uint64_t i = 0; i < iterations; i++)
+            {
+                auto guard = scheduler->lock(orch);
+                uint64_t before = ports.m_value;
+                orch->m_value += 1;
+                if (ports.m_value != before || before % 2 != 0)
+                {
+                    torn = true;
+                }
+            }
+        };
+
+        auto writer = [&](TestOrch *orch) {
+            for (uint64_t i = 0; i < iterations; i++)
+            {
+                auto guard = scheduler->lock(orch);
+                ports.m_value += 1;
+                this_thread::yield();
+                ports.m_value += 1;
+                orch->m_value += 1;
+            }
+        };
+
+        auto mainLoop = [&]() {
+            for (uint64_t i = 0; i < iterations; i++)
+            {
+                auto guard = scheduler->lockAll();
+                if (ports.m_value % 2 != 0)
+                {
+                    torn = true;
+                }
+                core.m_value += 1;
+            }
+        };
+
+        thread t1(reader, &route);
+        thread t2(reader, &watermark);
+        thread t3(writer, &fdb);
+        thread t4(mainLoop);
+
+        t1.join();
+        t2.join();
+        t3.join();
+        t4.join();
+
+        ASSERT_FALSE(torn);
+        ASSERT_EQ(route.m_value, iterations);
+        ASSERT_EQ(watermark.m_value, iterations);
+        ASSERT_EQ(fdb.m_value, iterations);
+        ASSERT_EQ(core.m_value, iterations);
+        ASSERT_EQ(ports.m_value, 2 * iterations);
+    }
+}
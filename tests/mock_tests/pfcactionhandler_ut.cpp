@@ -0,0 +1,163 @@
+#include "ut_helper.h"
+#include "mock_table.h"
+#include "pfcactionhandler.h"
+#include "batcheddbwriter.h"
+
+namespace pfcactionhandler_test
+{
+    using namespace std;
+
+    const sai_object_id_t port_id = 0x1000000000001;
+    const sai_object_id_t queue_id = 0x15000000000015;
+    const string queue_key = "oid:0x15000000000015";
+
+    /* COUNTERS table counting the reads of the handlers */
+    struct CountingTable : public Table
+    {
+        size_t gets = 0;
+
+        CountingTable(DBConnector *db) :
+            Table(db, "COUNTERS")
+        {
+        }
+
+        bool get(const string &key, vector<FieldValueTuple> &values) override
+        {
+            gets++;
+            return Table::get(key, values);
+        }
+    };
+
+    /* Alert handler with hardware counters set by the test */
+    struct TestHandler : public PfcWdActionHandler
+    {
+        PfcWdHwStats hw = {};
+
+        TestHandler(shared_ptr<Table> countersTable) :
+            PfcWdActionHandler(port_id, queue_id, 3, countersTable)
+        {
+        }
+
+        bool getHwCounters(PfcWdHwStats &counters) override
+        {
+            counters = hw;
+            return true;
+        }
+
+        void addTraffic()
+        {
+            hw.txPkt += 10;
+            hw.txDropPkt += 1;
+            hw.rxPkt += 20;
+            hw.rxDropPkt += 2;
+        }
+    };
+
+    struct PfcWdActionHandlerTest : public ::testing::Test
+    {
+        shared_ptr<DBConnector> m_counters_db;
+        shared_ptr<CountingTable> m_counters_table;
+
+        void SetUp() override
+        {
+            ::testing_db::reset();
+
+            m_counters_db = make_shared<DBConnector>("COUNTERS_DB", 0);
+            m_counters_table = make_shared<CountingTable>(m_counters_db.get());
+
+            // Queue with one storm behind it, as left by the previous handler
+            Table(m_counters_db.get(), "COUNTERS").set(queue_key, {
+                { "PFC_WD_QUEUE_STATS_DEADLOCK_DETECTED", "1" },
+                { "PFC_WD_QUEUE_STATS_DEADLOCK_RESTORED", "1" },
+                { "PFC_WD_QUEUE_STATS_TX_PACKETS", "100" },
+                { "PFC_WD_QUEUE_STATS_TX_DROPPED_PACKETS", "10" },
+                { "PFC_WD_QUEUE_STATS_RX_PACKETS", "200" },
+                { "PFC_WD_QUEUE_STATS_RX_DROPPED_PACKETS", "20" },
+                { "PFC_WD_QUEUE_STATS_TX_PACKETS_LAST", "5" },
+                { "PFC_WD_QUEUE_STATS_TX_DROPPED_PACKETS_LAST", "5" },
+                { "PFC_WD_QUEUE_STATS_RX_PACKETS_LAST", "5" },
+                { "PFC_WD_QUEUE_STATS_RX_DROPPED_PACKETS_LAST", "5" },
+                { "PFC_WD_STATUS", "operational" }
+            });
+        }
+
+        void TearDown() override
+        {
+            ::testing_db::reset();
+        }
+
+        map<string, string> getQueueHash()
+        {
+            vector<FieldValueTuple> fvs;
+            Table(m_counters_db.get(), "COUNTERS").get(queue_key, fvs);
+            return map<string, string>(fvs.begin(), fvs.end());
+        }
+
+        static map<string, string> queueHash(uint64_t detected, uint64_t restored,
+                const PfcWdHwStats &total, const PfcWdHwStats &last, const string &status)
+        {
+            return {
+                { "PFC_WD_QUEUE_STATS_DEADLOCK_DETECTED", to_string(detected) },
+                { "PFC_WD_QUEUE_STATS_DEADLOCK_RESTORED", to_string(restored) },
+                { "PFC_WD_QUEUE_STATS_TX_PACKETS", to_string(total.txPkt) },
+                { "PFC_WD_QUEUE_STATS_TX_DROPPED_PACKETS", to_string(total.txDropPkt) },
+                { "PFC_WD_QUEUE_STATS_RX_PACKETS", to_string(total.rxPkt) },
+                { "PFC_WD_QUEUE_STATS_RX_DROPPED_PACKETS", to_string(total.rxDropPkt) },
+                { "PFC_WD_QUEUE_STATS_TX_PACKETS_LAST", to_string(last.txPkt) },
+                { "PFC_WD_QUEUE_STATS_TX_DROPPED_PACKETS_LAST", to_string(last.txDropPkt) },
+                { "PFC_WD_QUEUE_STATS_RX_PACKETS_LAST", to_string(last.rxPkt) },
+                { "PFC_WD_QUEUE_STATS_RX_DROPPED_PACKETS_LAST", to_string(last.rxDropPkt) },
+                { "PFC_WD_STATUS", status }
+            };
+        }
+    };
+
+    /*
+     * The stats are read once when the storm starts. The periodic commits and
+     * the restore only write, and leave the hash a handler reading the stats
+     * back before every commit would leave.
+     */
+    TEST_F(PfcWdActionHandlerTest, CommitsReadStatsOnce)
+    {
+        TestHandler handler(m_counters_table);
+        handler.hw = { 1000, 50, 2000, 70 };
+
+        handler.initCounters();
+        ASSERT_EQ(m_counters_table->gets, 1u);
+        ASSERT_EQ(getQueueHash(), queueHash(2, 1, { 100, 10, 200, 20 }, { 0, 0, 0, 0 }, "stormed"));
+
+        for (uint64_t i = 1; i <= 3; i++)
+        {
+            handler.addTraffic();
+            handler.commitCounters(true);
+            BatchedDbWriter::flushAll();
+
+            ASSERT_EQ(getQueueHash(), queueHash(2, 1,
+                        { 100 + 10 * i, 10 + i, 200 + 20 * i, 20 + 2 * i },
+                        { 10 * i, i, 20 * i, 2 * i },
+                        "stormed"));
+        }
+
+        handler.addTraffic();
+        handler.commitCounters();
+        ASSERT_EQ(getQueueHash(), queueHash(2, 2, { 140, 14, 280, 28 }, { 40, 4, 80, 8 }, "operational"));
+
+        ASSERT_EQ(m_counters_table->gets, 1u);
+    }
+
+    /* A storm seen again after a warm reboot keeps its detection count and last counters */
+    TEST_F(PfcWdActionHandlerTest, OngoingStorm)
+    {
+        auto stormed = queueHash(2, 1, { 100, 10, 200, 20 }, { 5, 5, 5, 5 }, "stormed");
+        Table(m_counters_db.get(), "COUNTERS").set(queue_key, vector<FieldValueTuple>(stormed.begin(), stormed.end()));
+
+        TestHandler handler(m_counters_table);
+        handler.initCounters();
+        ASSERT_EQ(getQueueHash(), stormed);
+
+        handler.addTraffic();
+        handler.commitCounters();
+        ASSERT_EQ(getQueueHash(), queueHash(2, 2, { 110, 11, 220, 22 }, { 15, 6, 25, 7 }, "operational"));
+        ASSERT_EQ(m_counters_table->gets, 1u);
+    }
+}
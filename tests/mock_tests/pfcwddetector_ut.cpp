@@ -0,0 +1,459 @@
+#include "ut_helper.h"
+#include "pfcwddetector.h"
+
+#include <algorithm>
+#include <random>
+
+namespace pfcwddetector_test
+{
+    using namespace std;
+
+    /*
+     * pfc_detect_broadcom.lua and pfc_restore.lua statement by statement,
+     * on a map standing for COUNTERS_DB.
+     *
+     * This is a hand transcription, the detector is checked against it and
+     * not against the scripts themselves, which need a Redis server to run.
+     * A change to the plugins has to be carried over here.
+     */
+    struct LuaPlugins
+    {
+        map<string, map<string, string>> db;
+
+        const string *hget(const string &key, const string &field)
+        {
+            auto hash = db.find(key);
+            if (hash == db.end())
+            {
+                return nullptr;
+            }
+
+            auto value = hash->second.find(field);
+            return value == hash->second.end() ? nullptr : &value->second;
+        }
+
+        void hset(const string &key, const string &field, const string &value)
+        {
+            db[key][field] = value;
+        }
+
+        bool is(const string *value, const string &expected)
+        {
+            return value != nullptr && *value == expected;
+        }
+
+        void detect(const vector<string> &queues, int64_t pollTime, vector<pair<string, string>> &published)
+        {
+            for (auto it = queues.rbegin(); it != queues.rend(); it++)
+            {
+                string queue = "COUNTERS:" + *it;
+                auto status = hget(queue, "PFC_WD_STATUS");
+                auto action = hget(queue, "PFC_WD_ACTION");
+                auto brs = hget(queue, "BIG_RED_SWITCH_MODE");
+                if (brs || !(is(status, "operational") || is(action, "alert")))
+                {
+                    continue;
+                }
+
+                auto detection = hget(queue, "PFC_WD_DETECTION_TIME");
+                if (!detection)
+                {
+                    continue;
+                }
+
+                int64_t detectionTime = stoll(*detection);
+                auto left = hget(queue, "PFC_WD_DETECTION_TIME_LEFT");
+                int64_t timeLeft = left ? stoll(*left) : detectionTime;
+
+                string index = *hget("COUNTERS_QUEUE_INDEX_MAP", *it);
+                string port = "COUNTERS:" + *hget("COUNTERS_QUEUE_PORT_MAP", *it);
+                string rxKey = "SAI_PORT_STAT_PFC_" + index + "_RX_PKTS";
+                string on2offKey = "SAI_PORT_STAT_PFC_" + index + "_ON2OFF_RX_PKTS";
+
+                auto occupancy = hget(queue, "SAI_QUEUE_STAT_CURR_OCCUPANCY_BYTES");
+                auto packets = hget(queue, "SAI_QUEUE_STAT_PACKETS");
+                auto rx = hget(port, rxKey);
+                auto on2off = hget(port, on2offKey);
+                auto pause = hget(queue, "SAI_QUEUE_ATTR_PAUSE_STATUS");
+                if (!occupancy || !packets || !rx || !on2off || !pause)
+                {
+                    continue;
+                }
+
+                int64_t occupancyBytes = stoll(*occupancy);
+                int64_t packetsNow = stoll(*packets);
+                int64_t rxNow = stoll(*rx);
+                int64_t on2offNow = stoll(*on2off);
+                string pauseNow = *pause;
+
+                auto packetsLast = hget(queue, "SAI_QUEUE_STAT_PACKETS_last");
+                auto rxLast = hget(port, rxKey + "_last");
+                auto on2offLast = hget(port, on2offKey + "_last");
+                auto pauseLast = hget(queue, "SAI_QUEUE_ATTR_PAUSE_STATUS_last");
+                auto debugStorm = hget(queue, "DEBUG_STORM");
+
+                if (packetsLast && rxLast && on2offLast && pauseLast)
+                {
+                    int64_t packetsDelta = packetsNow - stoll(*packetsLast);
+                    int64_t rxDelta = rxNow - stoll(*rxLast);
+                    int64_t on2offDelta = on2offNow - stoll(*on2offLast);
+
+                    if ((occupancyBytes > 0 && packetsDelta == 0 && rxDelta > 0) ||
+                        is(debugStorm, "enabled") ||
+                        (occupancyBytes == 0 && rxDelta > 0 && on2offDelta == 0 && *pauseLast == "true" && pauseNow == "true"))
+                    {
+                        if (timeLeft <= pollTime)
+                        {
+                            published.emplace_back(*it, "storm");
+                            timeLeft = detectionTime;
+                        }
+                        else
+                        {
+                            timeLeft = timeLeft - pollTime;
+                        }
+                    }
+                    else
+                    {
+                        if (is(action, "alert") && !is(status, "operational"))
+                        {
+                            published.emplace_back(*it, "restore");
+                        }
+                        timeLeft = detectionTime;
+                    }
+                }
+
+                hset(queue, "SAI_QUEUE_ATTR_PAUSE_STATUS_last", pauseNow);
+                hset(queue, "SAI_QUEUE_STAT_PACKETS_last", to_string(packetsNow));
+                hset(queue, "PFC_WD_DETECTION_TIME_LEFT", to_string(timeLeft));
+                hset(port, rxKey + "_last", to_string(rxNow));
+                hset(port, on2offKey + "_last", to_string(on2offNow));
+            }
+        }
+
+        void restore(const vector<string> &queues, int64_t pollTime, vector<pair<string, string>> &published)
+        {
+            for (auto it = queues.rbegin(); it != queues.rend(); it++)
+            {
+                string queue = "COUNTERS:" + *it;
+                auto status = hget(queue, "PFC_WD_STATUS");
+                auto restoration = hget(queue, "PFC_WD_RESTORATION_TIME");
+                auto action = hget(queue, "PFC_WD_ACTION");
+                auto brs = hget(queue, "BIG_RED_SWITCH_MODE");
+                if (brs || is(status, "operational") || is(action, "alert") || !restoration || restoration->empty())
+                {
+                    continue;
+                }
+
+                int64_t restorationTime = stoll(*restoration);
+                auto left = hget(queue, "PFC_WD_RESTORATION_TIME_LEFT");
+                int64_t timeLeft = left ? stoll(*left) : restorationTime;
+
+                string index = *hget("COUNTERS_QUEUE_INDEX_MAP", *it);
+                string port = "COUNTERS:" + *hget("COUNTERS_QUEUE_PORT_MAP", *it);
+                string rxKey = "SAI_PORT_STAT_PFC_" + index + "_RX_PKTS";
+
+                int64_t rx = stoll(*hget(port, rxKey));
+                auto rxLast = hget(port, rxKey + "_last");
+                auto debugStorm = hget(queue, "DEBUG_STORM");
+
+                if (rxLast)
+                {
+                    if (rx - stoll(*rxLast) == 0 && !is(debugStorm, "enabled"))
+                    {
+                        if (timeLeft <= pollTime)
+                        {
+                            published.emplace_back(*it, "restore");
+                            timeLeft = restorationTime;
+                        }
+                        else
+                        {
+                            timeLeft = timeLeft - pollTime;
+                        }
+                    }
+                    else
+                    {
+                        timeLeft = restorationTime;
+                    }
+                }
+
+                hset(queue, "PFC_WD_RESTORATION_TIME_LEFT", to_string(timeLeft));
+                hset(port, rxKey + "_last", to_string(rx));
+            }
+        }
+    };
+
+    struct WatchedQueue
+    {
+        sai_object_id_t queueId;
+        sai_object_id_t portId;
+        uint8_t index;
+        uint32_t detectionTime;
+        uint32_t restorationTime;
+        bool alert;
+    };
+
+    /*
+     * Runs the plugins and the detector side by side. Counters are written
+     * to the plugins database as syncd does, and storm actions start and
+     * stop on the published events as they do in PfcWdSwOrch.
+     */
+    struct SideBySide
+    {
+        vector<WatchedQueue> queues;
+        vector<string> queueKeys;
+        LuaPlugins lua;
+        PfcWdDetector detector;
+
+        SideBySide(const vector<WatchedQueue> &watched) :
+            queues(watched)
+        {
+            for (const auto &q : queues)
+            {
+                string key = "oid:" + to_string(q.queueId);
+                string queue = "COUNTERS:" + key;
+
+                queueKeys.push_back(key);
+                lua.hset("COUNTERS_QUEUE_INDEX_MAP", key, to_string(q.index));
+                lua.hset("COUNTERS_QUEUE_PORT_MAP", key, "oid:" + to_string(q.portId));
+                lua.hset(queue, "PFC_WD_DETECTION_TIME", to_string(q.detectionTime));
+                lua.hset(queue, "PFC_WD_RESTORATION_TIME", q.restorationTime == 0 ? "" : to_string(q.restorationTime));
+                lua.hset(queue, "PFC_WD_ACTION", q.alert ? "alert" : "drop");
+                lua.hset(queue, "PFC_WD_STATUS", "operational");
+
+                detector.addQueue(q.queueId, q.portId, q.index, q.detectionTime, q.restorationTime, q.alert);
+            }
+        }
+
+        /* counters[i] is the poll of queues[i], returns the events of the detector */
+        vector<pair<string, string>> poll(vector<PfcWdQueueCounters> counters, uint32_t pollTime)
+        {
+            for (size_t i = 0; i < queues.size(); i++)
+            {
+                const auto &c = counters[i];
+                string queue = "COUNTERS:" + queueKeys[i];
+                string port = "COUNTERS:oid:" + to_string(queues[i].portId);
+                string pfc = "SAI_PORT_STAT_PFC_" + to_string(queues[i].index);
+
+                lua.hset(queue, "SAI_QUEUE_STAT_CURR_OCCUPANCY_BYTES", to_string(c.occupancyBytes));
+                lua.hset(queue, "SAI_QUEUE_STAT_PACKETS", to_string(c.packets));
+                lua.hset(queue, "SAI_QUEUE_ATTR_PAUSE_STATUS", c.paused ? "true" : "false");
+                lua.hset(queue, "DEBUG_STORM", c.debugStorm ? "enabled" : "disabled");
+                lua.hset(port, pfc + "_RX_PKTS", to_string(c.pfcRxPackets));
+                lua.hset(port, pfc + "_ON2OFF_RX_PKTS", to_string(c.pfcOn2OffRxPackets));
+
+                counters[i].valid = true;
+                counters[i].pfcRxValid = true;
+                counters[i].operational = lua.is(lua.hget(queue, "PFC_WD_STATUS"), "operational");
+            }
+
+            vector<pair<string, string>> published;
+            lua.detect(queueKeys, pollTime, published);
+            lua.restore(queueKeys, pollTime, published);
+
+            vector<pair<sai_object_id_t, PfcWdDetectorEvent>> events;
+            detector.process(counters, pollTime, events);
+
+            vector<pair<string, string>> detected;
+            for (const auto &event : events)
+            {
+                detected.emplace_back("oid:" + to_string(event.first),
+                        event.second == PfcWdDetectorEvent::STORM ? "storm" : "restore");
+            }
+
+            sort(published.begin(), published.end());
+            sort(detected.begin(), detected.end());
+            EXPECT_EQ(published, detected);
+
+            for (const auto &event : published)
+            {
+                lua.hset("COUNTERS:" + event.first, "PFC_WD_STATUS", event.second == "storm" ? "stormed" : "operational");
+            }
+
+            return detected;
+        }
+    };
+
+    PfcWdQueueCounters counters(uint64_t occupancyBytes, uint64_t packets, bool paused,
+            uint64_t pfcRxPackets, uint64_t pfcOn2OffRxPackets)
+    {
+        PfcWdQueueCounters c;
+        c.occupancyBytes = occupancyBytes;
+        c.packets = packets;
+        c.paused = paused;
+        c.pfcRxPackets = pfcRxPackets;
+        c.pfcOn2OffRxPackets = pfcOn2OffRxPackets;
+        return c;
+    }
+
+    TEST(PfcWdDetectorTest, StormAndRestore)
+    {
+        SideBySide wd({ { 0x15, 0x1, 3, 300, 200, false } });
+        vector<pair<string, string>> none;
+        vector<pair<string, string>> storm = { { "oid:21", "storm" } };
+        vector<pair<string, string>> restore = { { "oid:21", "restore" } };
+
+        // First poll only records the counters
+        ASSERT_EQ(wd.poll({ counters(1000, 10, false, 0, 0) }, 100), none);
+
+        // Queue is stuck with PFC frames coming in, storm once detection time elapsed
+        ASSERT_EQ(wd.poll({ counters(1000, 10, false, 5, 0) }, 100), none);
+        ASSERT_EQ(wd.poll({ counters(1000, 10, false, 10, 0) }, 100), none);
+        ASSERT_EQ(wd.poll({ counters(1000, 10, false, 15, 0) }, 100),
+                storm);
+
+        // No more PFC frames, restore once restoration time elapsed
+        ASSERT_EQ(wd.poll({ counters(1000, 10, false, 15, 0) }, 100), none);
+        ASSERT_EQ(wd.poll({ counters(1000, 10, false, 15, 0) }, 100),
+                restore);
+    }
+
+    TEST(PfcWdDetectorTest, PausedEmptyQueue)
+    {
+        SideBySide wd({ { 0x15, 0x1, 3, 200, 200, true } });
+        vector<pair<string, string>> none;
+        vector<pair<string, string>> storm = { { "oid:21", "storm" } };
+        vector<pair<string, string>> restore = { { "oid:21", "restore" } };
+
+        ASSERT_EQ(wd.poll({ counters(0, 10, true, 0, 0) }, 100), none);
+        ASSERT_EQ(wd.poll({ counters(0, 10, true, 5, 0) }, 100), none);
+        ASSERT_EQ(wd.poll({ counters(0, 10, true, 10, 0) }, 100),
+                storm);
+
+        // ON2OFF frames, the queue is released and the alert is cleared
+        ASSERT_EQ(wd.poll({ counters(0, 10, true, 15, 1) }, 100),
+                restore);
+    }
+
+    TEST(PfcWdDetectorTest, RestoreWithPfcRxOnly)
+    {
+        PfcWdDetector detector;
+        detector.addQueue(0x15, 0x1, 3, 200, 200, false);
+
+        // A stormed queue missing its queue counters, only the PFC RX counter is read
+        PfcWdQueueCounters c = counters(0, 0, false, 15, 0);
+        c.operational = false;
+
+        vector<pair<sai_object_id_t, PfcWdDetectorEvent>> events;
+        for (int i = 0; i < 3; i++)
+        {
+            detector.process({ c }, 100, events);
+        }
+        ASSERT_TRUE(events.empty());
+
+        c.pfcRxValid = true;
+        for (int i = 0; i < 3; i++)
+        {
+            detector.process({ c }, 100, events);
+        }
+        ASSERT_EQ(events.size(), 1u);
+        ASSERT_EQ(events[0].first, 0x15u);
+        ASSERT_EQ(events[0].second, PfcWdDetectorEvent::RESTORE);
+    }
+
+    TEST(PfcWdDetectorTest, RemoveQueue)
+    {
+        PfcWdDetector detector;
+        detector.addQueue(0x11, 0x1, 3, 200, 200, false);
+        detector.addQueue(0x12, 0x1, 4, 200, 200, false);
+        detector.addQueue(0x21, 0x2, 3, 200, 200, false);
+
+        detector.removeQueue(0x11);
+        detector.removeQueue(0x11);
+        ASSERT_EQ(detector.size(), 2u);
+        ASSERT_EQ(detector.getQueueId(0), 0x21u);
+        ASSERT_EQ(detector.getPortId(0), 0x2u);
+        ASSERT_EQ(detector.getQueueId(1), 0x12u);
+        ASSERT_EQ(detector.getIndex(1), 4u);
+
+        // Counters are matched to the queues by slot
+        vector<pair<sai_object_id_t, PfcWdDetectorEvent>> events;
+        vector<PfcWdQueueCounters> polls(2, counters(1000, 10, false, 0, 0));
+        polls[0].valid = polls[1].valid = true;
+        for (uint64_t rx = 0; rx < 3; rx++)
+        {
+            polls[0].pfcRxPackets = rx;
+            detector.process(polls, 100, events);
+        }
+        ASSERT_EQ(events.size(), 1u);
+        ASSERT_EQ(events[0].first, 0x21u);
+        ASSERT_EQ(events[0].second, PfcWdDetectorEvent::STORM);
+    }
+
+    TEST(PfcWdDetectorTest, MatchesLuaPluginsOnTrace)
+    {
+        vector<WatchedQueue> watched;
+        for (uint8_t i = 0; i < 16; i++)
+        {
+            uint32_t restoration = i % 5 == 0 ? 0 : 100u * (i % 4 + 1);
+            watched.push_back({ 0x100u + i, 0x10u + i / 4u, static_cast<uint8_t>(i % 8), 100u * (i % 3 + 1), restoration, i % 4 == 0 });
+        }
+
+        SideBySide wd(watched);
+
+        // Traffic patterns of each queue change every few polls
+        enum Pattern { IDLE, FORWARDING, STUCK, PAUSED, RELEASED, DEBUG, PATTERNS };
+        mt19937 rng(20210101);
+        vector<Pattern> patterns(watched.size(), IDLE);
+        vector<PfcWdQueueCounters> last(watched.size(), counters(0, 0, false, 0, 0));
+        size_t storms = 0, restores = 0;
+
+        for (int poll = 0; poll < 5000; poll++)
+        {
+            vector<PfcWdQueueCounters> polls;
+            for (size_t i = 0; i < watched.size(); i++)
+            {
+                if (rng() % 6 == 0)
+                {
+                    patterns[i] = static_cast<Pattern>(rng() % PATTERNS);
+                }
+
+                auto c = last[i];
+                c.debugStorm = false;
+                switch (patterns[i])
+                {
+                    case IDLE:
+                        c.occupancyBytes = 0;
+                        c.paused = false;
+                        break;
+                    case FORWARDING:
+                        c.occupancyBytes = rng() % 2 ? 0 : rng() % 10000;
+                        c.packets += rng() % 100 + 1;
+                        c.pfcRxPackets += rng() % 2;
+                        break;
+                    case STUCK:
+                        c.occupancyBytes = rng() % 10000 + 1;
+                        c.pfcRxPackets += rng() % 100;
+                        break;
+                    case PAUSED:
+                        c.occupancyBytes = 0;
+                        c.paused = rng() % 8 != 0;
+                        c.pfcRxPackets += rng() % 100;
+                        break;
+                    case RELEASED:
+                        c.occupancyBytes = 0;
+                        c.paused = rng() % 2 == 0;
+                        c.pfcRxPackets += rng() % 100;
+                        c.pfcOn2OffRxPackets += rng() % 3;
+                        break;
+                    case DEBUG:
+                        c.debugStorm = true;
+                        break;
+                    default:
+                        break;
+                }
+
+                last[i] = c;
+                polls.push_back(c);
+            }
+
+            for (const auto &event : wd.poll(polls, 100))
+            {
+                (event.second == "storm" ? storms : restores)++;
+            }
+        }
+
+        // The trace goes through both plugins
+        ASSERT_GT(storms, 100u);
+        ASSERT_GT(restores, 100u);
+    }
+}
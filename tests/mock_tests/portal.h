@@ -5,6 +5,9 @@
 
 #include "aclorch.h"
 #include "crmorch.h"
+#include "fdborch.h"
+#include "neighorch.h"
+#include "natorch.h"
 
 #undef protected
 #undef private
@@ -35,6 +38,11 @@ struct Portal
         {
             return aclOrch->m_AclTables;
         }
+
+        static const unordered_map<string, sai_object_id_t> &getAclTableOids(const AclOrch *aclOrch)
+        {
+            return aclOrch->m_AclTableOids;
+        }
     };
 
     struct CrmOrchInternal
@@ -59,4 +67,62 @@ struct Portal
             crmOrch->getResAvailableCounters();
         }
     };
+
+    struct FdbOrchInternal
+    {
+        static const map<FdbEntry, FdbData> &getEntries(const FdbOrch *fdbOrch)
+        {
+            return fdbOrch->m_entries;
+        }
+    };
+
+    struct PortsOrchInternal
+    {
+        static void setInitDone(PortsOrch *portsOrch)
+        {
+            portsOrch->m_initDone = true;
+        }
+    };
+
+    struct NeighOrchInternal
+    {
+        static void setSyncdNeighbor(NeighOrch *neighOrch, const NeighborEntry &entry, const MacAddress &mac)
+        {
+            neighOrch->setSyncdNeighbor(entry, mac, true);
+        }
+
+        static void eraseSyncdNeighbor(NeighOrch *neighOrch, const NeighborEntry &entry)
+        {
+            neighOrch->eraseSyncdNeighbor(entry);
+        }
+
+        static size_t getNeighborCount(const NeighOrch *neighOrch, const string &alias, const MacAddress &mac)
+        {
+            auto it = neighOrch->m_neighborsByMac.find(make_pair(alias, mac));
+            return it == neighOrch->m_neighborsByMac.end() ? 0 : it->second.size();
+        }
+    };
+
+    struct NatOrchInternal
+    {
+        static NatEntry &getNatEntries(NatOrch *natOrch)
+        {
+            return natOrch->m_natEntries;
+        }
+
+        static NaptEntry &getNaptEntries(NatOrch *natOrch)
+        {
+            return natOrch->m_naptEntries;
+        }
+
+        static const NatQuerySweep &getHitBitSweep(const NatOrch *natOrch)
+        {
+            return natOrch->m_hitBitSweep;
+        }
+
+        static void queryTick(NatOrch *natOrch)
+        {
+            natOrch->getExecutor("NAT_HITBIT_N_CNTRS_QUERY_TIMER")->execute();
+        }
+    };
 };
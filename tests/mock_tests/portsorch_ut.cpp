@@ -3,6 +3,8 @@
 #include "mock_table.h"
 #include "pfcactionhandler.h"
 
+#include <chrono>
+#include <iostream>
 #include <sstream>
 
 namespace portsorch_test
@@ -321,6 +323,99 @@ namespace portsorch_test
         ASSERT_TRUE(ts.empty());
     }
 
+    /*
+     * The warm restart replay of APP_DB PORT_TABLE is not sorted, PortConfigDone
+     * and PortInitDone may come before the ports. The ports created by SAI must
+     * be kept and initialized before init done is marked.
+     */
+    TEST_F(PortsOrchTest, PortReadinessWarmBootMarkersFirst)
+    {
+        // Get SAI default ports to populate DB
+
+        auto ports = ut_helper::getInitialSaiPorts();
+
+        // Get the SAI ports, which must survive the replay
+
+        sai_attribute_t attr;
+        vector<sai_object_id_t> portList(ports.size());
+
+        attr.id = SAI_SWITCH_ATTR_PORT_LIST;
+        attr.value.objlist.count = static_cast<uint32_t>(portList.size());
+        attr.value.objlist.list = portList.data();
+
+        auto status = sai_switch_api->get_switch_attribute(gSwitchId, 1, &attr);
+        ASSERT_EQ(status, SAI_STATUS_SUCCESS);
+
+        set<sai_object_id_t> saiPorts(portList.begin(), portList.begin() + attr.value.objlist.count);
+
+        // Create dependencies ...
+
+        const int portsorch_base_pri = 40;
+
+        vector<table_name_with_pri_t> ports_tables = {
+            { APP_PORT_TABLE_NAME, portsorch_base_pri + 5 },
+            { APP_VLAN_TABLE_NAME, portsorch_base_pri + 2 },
+            { APP_VLAN_MEMBER_TABLE_NAME, portsorch_base_pri },
+            { APP_LAG_TABLE_NAME, portsorch_base_pri + 4 },
+            { APP_LAG_MEMBER_TABLE_NAME, portsorch_base_pri }
+        };
+
+        ASSERT_EQ(gPortsOrch, nullptr);
+        gPortsOrch = new PortsOrch(m_app_db.get(), ports_tables, m_chassis_app_db.get());
+        vector<string> buffer_tables = { APP_BUFFER_POOL_TABLE_NAME,
+                                         APP_BUFFER_PROFILE_TABLE_NAME,
+                                         APP_BUFFER_QUEUE_TABLE_NAME,
+                                         APP_BUFFER_PG_TABLE_NAME,
+                                         APP_BUFFER_PORT_INGRESS_PROFILE_LIST_NAME,
+                                         APP_BUFFER_PORT_EGRESS_PROFILE_LIST_NAME };
+
+        ASSERT_EQ(gBufferOrch, nullptr);
+        gBufferOrch = new BufferOrch(m_app_db.get(), m_config_db.get(), m_state_db.get(), buffer_tables);
+
+        // Replay PortConfigDone, PortInitDone, then the ports
+
+        std::deque<KeyOpFieldsValuesTuple> entries;
+        entries.push_back({ "PortConfigDone", SET_COMMAND, { { "count", to_string(ports.size()) } } });
+        entries.push_back({ "PortInitDone", SET_COMMAND, { { "lanes", "0" } } });
+        for (const auto &it : ports)
+        {
+            entries.push_back({ it.first, SET_COMMAND, it.second });
+        }
+
+        auto consumer = dynamic_cast<Consumer *>(gPortsOrch->getExecutor(APP_PORT_TABLE_NAME));
+        consumer->addToSync(entries);
+
+        static_cast<Orch *>(gPortsOrch)->doTask();
+
+        // All ports are known, with their SAI port, once init done is marked
+
+        ASSERT_TRUE(gPortsOrch->isInitDone());
+
+        for (const auto &it : ports)
+        {
+            Port port;
+            ASSERT_TRUE(gPortsOrch->getPort(it.first, port));
+            ASSERT_TRUE(saiPorts.count(port.m_port_id));
+        }
+
+        attr.id = SAI_SWITCH_ATTR_PORT_NUMBER;
+        status = sai_switch_api->get_switch_attribute(gSwitchId, 1, &attr);
+        ASSERT_EQ(status, SAI_STATUS_SUCCESS);
+        ASSERT_EQ(attr.value.u32, saiPorts.size());
+
+        // Drain remaining
+
+        static_cast<Orch *>(gBufferOrch)->doTask();
+        static_cast<Orch *>(gPortsOrch)->doTask();
+
+        ASSERT_TRUE(gPortsOrch->allPortsReady());
+
+        vector<string> ts;
+
+        gPortsOrch->dumpPendingTasks(ts);
+        ASSERT_TRUE(ts.empty());
+    }
+
     TEST_F(PortsOrchTest, PfcZeroBufferHandlerLocksPortPgAndQueue)
     {
         Table portTable = Table(m_app_db.get(), APP_PORT_TABLE_NAME);
@@ -592,4 +687,109 @@ namespace portsorch_test
         ASSERT_FALSE(bridgePortCalledBeforeLagMember); // bridge port created on lag before lag member was created
     }
 
+
+    static void createPortsOrch(shared_ptr<swss::DBConnector> app_db, shared_ptr<swss::DBConnector> chassis_app_db)
+    {
+        const int portsorch_base_pri = 40;
+
+        vector<table_name_with_pri_t> ports_tables = {
+            { APP_PORT_TABLE_NAME, portsorch_base_pri + 5 },
+            { APP_VLAN_TABLE_NAME, portsorch_base_pri + 2 },
+            { APP_VLAN_MEMBER_TABLE_NAME, portsorch_base_pri },
+            { APP_LAG_TABLE_NAME, portsorch_base_pri + 4 },
+            { APP_LAG_MEMBER_TABLE_NAME, portsorch_base_pri }
+        };
+
+        gPortsOrch = new PortsOrch(app_db.get(), ports_tables, chassis_app_db.get());
+    }
+
+    // Add 256 ports with bridge ports and router interfaces, and 4094 VLANs with 8 members each
+    static void addFdbTopology()
+    {
+        for (sai_object_id_t i = 0; i < 256; i++)
+        {
+            Port port("Ethernet" + to_string(i * 4), Port::PHY);
+            port.m_port_id = 0x1000000 + i;
+            port.m_bridge_port_id = 0x2000000 + i;
+            port.m_rif_id = 0x3000000 + i;
+            gPortsOrch->setPort(port.m_alias, port);
+        }
+
+        for (sai_vlan_id_t vlan_id = 1; vlan_id < 4095; vlan_id++)
+        {
+            Port vlan("Vlan" + to_string(vlan_id), Port::VLAN);
+            vlan.m_vlan_info.vlan_id = vlan_id;
+            vlan.m_vlan_info.vlan_oid = 0x4000000 + vlan_id;
+            for (int i = 0; i < 8; i++)
+            {
+                vlan.m_members.insert("Ethernet" + to_string(((vlan_id + i) % 256) * 4));
+            }
+            gPortsOrch->setPort(vlan.m_alias, vlan);
+        }
+    }
+
+    TEST_F(PortsOrchTest, PortIndexes)
+    {
+        createPortsOrch(m_app_db, m_chassis_app_db);
+        addFdbTopology();
+
+        Port *port = gPortsOrch->findPortByBridgePortId(0x2000000 + 7);
+        ASSERT_NE(port, nullptr);
+        ASSERT_EQ(port->m_alias, "Ethernet28");
+        ASSERT_EQ(gPortsOrch->findPort(port->m_port_id), port);
+        ASSERT_EQ(gPortsOrch->findPortByRifId(port->m_rif_id), port);
+        ASSERT_EQ(gPortsOrch->findPort("Ethernet28"), port);
+        ASSERT_EQ(gPortsOrch->findPortByBridgePortId(0x2000000 + 256), nullptr);
+
+        Port *vlan = gPortsOrch->findVlanByVlanId(100);
+        ASSERT_NE(vlan, nullptr);
+        ASSERT_EQ(vlan->m_alias, "Vlan100");
+        ASSERT_EQ(gPortsOrch->findPort(vlan->m_vlan_info.vlan_oid), vlan);
+
+        // Updates in place are seen by the copying lookups
+        vlan->m_fdb_count++;
+        Port copy;
+        ASSERT_TRUE(gPortsOrch->getPort(0x4000000 + 100, copy));
+        ASSERT_EQ(copy.m_fdb_count, 1u);
+
+        // A bridge port moved to another port is found on the new port
+        Port moved = *port;
+        moved.m_bridge_port_id = 0x2000000 + 1000;
+        gPortsOrch->setPort(moved.m_alias, moved);
+        Port *other = gPortsOrch->findPort("Ethernet32");
+        other->m_bridge_port_id = 0x2000000 + 7;
+        ASSERT_EQ(gPortsOrch->findPortByBridgePortId(0x2000000 + 7), other);
+        ASSERT_TRUE(gPortsOrch->getPortByBridgePortId(0x2000000 + 1000, copy));
+        ASSERT_EQ(copy.m_alias, "Ethernet28");
+    }
+
+    // Port and VLAN lookups of an FDB learn storm, run with --gtest_also_run_disabled_tests
+    TEST_F(PortsOrchTest, DISABLED_FdbLearnStormLookups)
+    {
+        createPortsOrch(m_app_db, m_chassis_app_db);
+        addFdbTopology();
+
+        const int events = 200000;
+        size_t found = 0;
+
+        auto start = chrono::steady_clock::now();
+        for (int i = 0; i < events; i++)
+        {
+            Port port, vlan;
+            found += gPortsOrch->getPortByBridgePortId(0x2000000 + (sai_object_id_t)(i % 256), port);
+            found += gPortsOrch->getPort(0x4000000 + (sai_object_id_t)(i % 4094 + 1), vlan);
+        }
+        auto copied = chrono::steady_clock::now();
+        for (int i = 0; i < events; i++)
+        {
+            found += gPortsOrch->findPortByBridgePortId(0x2000000 + (sai_object_id_t)(i % 256)) != nullptr;
+            found += gPortsOrch->findPort(0x4000000 + (sai_object_id_t)(i % 4094 + 1)) != nullptr;
+        }
+        auto indexed = chrono::steady_clock::now();
+
+        ASSERT_EQ(found, (size_t)events * 4);
+        cout << "FDB learn lookups, copying: "
+             << chrono::duration_cast<chrono::nanoseconds>(copied - start).count() / events << " ns/event, indexed: "
+             << chrono::duration_cast<chrono::nanoseconds>(indexed - copied).count() / events << " ns/event" << endl;
+    }
 }
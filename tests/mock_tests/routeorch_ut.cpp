@@ -0,0 +1,623 @@
+#include "ut_helper.h"
+#include "mock_orchagent_main.h"
+#include "mock_table.h"
+#include "muxorch.h"
+#include "orchscheduler.h"
+
+#include <chrono>
+#include <iostream>
+#include <sstream>
+#include <thread>
+
+extern sai_next_hop_group_api_t* sai_next_hop_group_api;
+extern Directory<Orch*> gDirectory;
+
+namespace routeorch_test
+{
+    using namespace std;
+
+    struct RouteOrchTest : public ::testing::Test
+    {
+        shared_ptr<swss::DBConnector> m_app_db;
+        shared_ptr<swss::DBConnector> m_config_db;
+        shared_ptr<swss::DBConnector> m_state_db;
+        shared_ptr<swss::DBConnector> m_chassis_app_db;
+
+        unique_ptr<Consumer> m_routeConsumer;
+        unique_ptr<Consumer> m_neighConsumer;
+
+        RouteOrchTest()
+        {
+            // FIXME: move out from constructor
+            m_app_db = make_shared<swss::DBConnector>("APPL_DB", 0);
+            m_config_db = make_shared<swss::DBConnector>("CONFIG_DB", 0);
+            m_state_db = make_shared<swss::DBConnector>("STATE_DB", 0);
+            m_chassis_app_db = make_shared<swss::DBConnector>("CHASSIS_APP_DB", 0);
+        }
+
+        void SetUp() override
+        {
+            ::testing_db::reset();
+
+            // Init switch and create dependencies, routes are not removed
+            // by RouteOrch so each test runs on its own switch
+
+            map<string, string> profile = {
+                { "SAI_VS_SWITCH_TYPE", "SAI_VS_SWITCH_TYPE_BCM56850" },
+                { "KV_DEVICE_MAC_ADDRESS", "20:03:04:05:06:00" }
+            };
+
+            auto status = ut_helper::initSaiApi(profile);
+            ASSERT_EQ(status, SAI_STATUS_SUCCESS);
+
+            sai_api_query(SAI_API_NEXT_HOP_GROUP, (void **)&sai_next_hop_group_api);
+
+            sai_attribute_t attr;
+
+            attr.id = SAI_SWITCH_ATTR_INIT_SWITCH;
+            attr.value.booldata = true;
+
+            status = sai_switch_api->create_switch(&gSwitchId, 1, &attr);
+            ASSERT_EQ(status, SAI_STATUS_SUCCESS);
+
+            // Get switch source MAC address
+            attr.id = SAI_SWITCH_ATTR_SRC_MAC_ADDRESS;
+            status = sai_switch_api->get_switch_attribute(gSwitchId, 1, &attr);
+
+            ASSERT_EQ(status, SAI_STATUS_SUCCESS);
+
+            gMacAddress = attr.value.mac;
+
+            // Get the default virtual router ID
+            attr.id = SAI_SWITCH_ATTR_DEFAULT_VIRTUAL_ROUTER_ID;
+            status = sai_switch_api->get_switch_attribute(gSwitchId, 1, &attr);
+
+            ASSERT_EQ(status, SAI_STATUS_SUCCESS);
+
+            gVirtualRouterId = attr.value.oid;
+
+            TableConnector stateDbSwitchTable(m_state_db.get(), "SWITCH_CAPABILITY");
+            TableConnector conf_asic_sensors(m_config_db.get(), CFG_ASIC_SENSORS_TABLE_NAME);
+            TableConnector app_switch_table(m_app_db.get(),  APP_SWITCH_TABLE_NAME);
+
+            vector<TableConnector> switch_tables = {
+                conf_asic_sensors,
+                app_switch_table
+            };
+
+            ASSERT_EQ(gSwitchOrch, nullptr);
+            gSwitchOrch = new SwitchOrch(m_app_db.get(), switch_tables, stateDbSwitchTable);
+
+            const int portsorch_base_pri = 40;
+
+            vector<table_name_with_pri_t> ports_tables = {
+                { APP_PORT_TABLE_NAME, portsorch_base_pri + 5 },
+                { APP_VLAN_TABLE_NAME, portsorch_base_pri + 2 },
+                { APP_VLAN_MEMBER_TABLE_NAME, portsorch_base_pri },
+                { APP_LAG_TABLE_NAME, portsorch_base_pri + 4 },
+                { APP_LAG_MEMBER_TABLE_NAME, portsorch_base_pri }
+            };
+
+            ASSERT_EQ(gPortsOrch, nullptr);
+            gPortsOrch = new PortsOrch(m_app_db.get(), ports_tables, m_chassis_app_db.get());
+
+            vector<string> buffer_tables = { APP_BUFFER_POOL_TABLE_NAME,
+                                             APP_BUFFER_PROFILE_TABLE_NAME,
+                                             APP_BUFFER_QUEUE_TABLE_NAME,
+                                             APP_BUFFER_PG_TABLE_NAME,
+                                             APP_BUFFER_PORT_INGRESS_PROFILE_LIST_NAME,
+                                             APP_BUFFER_PORT_EGRESS_PROFILE_LIST_NAME };
+
+            ASSERT_EQ(gBufferOrch, nullptr);
+            gBufferOrch = new BufferOrch(m_app_db.get(), m_config_db.get(), m_state_db.get(), buffer_tables);
+
+            ASSERT_EQ(gCrmOrch, nullptr);
+            gCrmOrch = new CrmOrch(m_config_db.get(), CFG_CRM_TABLE_NAME);
+
+            ASSERT_EQ(gVrfOrch, nullptr);
+            gVrfOrch = new VRFOrch(m_app_db.get(), APP_VRF_TABLE_NAME, m_state_db.get(), STATE_VRF_OBJECT_TABLE_NAME);
+
+            ASSERT_EQ(gIntfsOrch, nullptr);
+            gIntfsOrch = new IntfsOrch(m_app_db.get(), APP_INTF_TABLE_NAME, gVrfOrch, m_chassis_app_db.get());
+
+            TableConnector stateDbFdb(m_state_db.get(), STATE_FDB_TABLE_NAME);
+
+            vector<table_name_with_pri_t> app_fdb_tables = {
+                { APP_FDB_TABLE_NAME,        FdbOrch::fdborch_pri},
+                { APP_VXLAN_FDB_TABLE_NAME,  FdbOrch::fdborch_pri}
+            };
+
+            ASSERT_EQ(gFdbOrch, nullptr);
+            gFdbOrch = new FdbOrch(m_app_db.get(), app_fdb_tables, stateDbFdb, gPortsOrch);
+
+            ASSERT_EQ(gNeighOrch, nullptr);
+            gNeighOrch = new NeighOrch(m_app_db.get(), APP_NEIGH_TABLE_NAME, gIntfsOrch, gFdbOrch, gPortsOrch, m_chassis_app_db.get());
+
+            ASSERT_EQ(gFgNhgOrch, nullptr);
+            const int fgnhgorch_pri = 15;
+
+            vector<table_name_with_pri_t> fgnhg_tables = {
+                { CFG_FG_NHG,                 fgnhgorch_pri },
+                { CFG_FG_NHG_PREFIX,          fgnhgorch_pri },
+                { CFG_FG_NHG_MEMBER,          fgnhgorch_pri }
+            };
+            gFgNhgOrch = new FgNhgOrch(m_config_db.get(), m_app_db.get(), m_state_db.get(), fgnhg_tables, gNeighOrch, gIntfsOrch, gVrfOrch);
+
+            ASSERT_EQ(gRouteOrch, nullptr);
+            gRouteOrch = new RouteOrch(m_app_db.get(), APP_ROUTE_TABLE_NAME, gSwitchOrch, gNeighOrch, gIntfsOrch, gVrfOrch, gFgNhgOrch);
+
+            // NeighOrch checks the mux state of the neighbors, no mux cable is configured
+            ASSERT_EQ(gDirectory.get<MuxOrch *>(), nullptr);
+            vector<string> mux_tables = { CFG_MUX_CABLE_TABLE_NAME, CFG_PEER_SWITCH_TABLE_NAME };
+            gDirectory.set(new MuxOrch(m_config_db.get(), mux_tables, nullptr, gNeighOrch, gFdbOrch));
+
+            // Create ports
+
+            Table portTable = Table(m_app_db.get(), APP_PORT_TABLE_NAME);
+
+            auto ports = ut_helper::getInitialSaiPorts();
+            for (const auto &it : ports)
+            {
+                portTable.set(it.first, it.second);
+            }
+
+            portTable.set("PortConfigDone", { { "count", to_string(ports.size()) } });
+            gPortsOrch->addExistingData(&portTable);
+            static_cast<Orch *>(gPortsOrch)->doTask();
+
+            portTable.set("PortInitDone", { { "lanes", "0" } });
+            gPortsOrch->addExistingData(&portTable);
+            static_cast<Orch *>(gPortsOrch)->doTask();
+            static_cast<Orch *>(gBufferOrch)->doTask();
+            static_cast<Orch *>(gPortsOrch)->doTask();
+            ASSERT_TRUE(gPortsOrch->allPortsReady());
+
+            // Create the router interface and the next hops of the routes
+
+            auto intfConsumer = unique_ptr<Consumer>(new Consumer(
+                new swss::ConsumerStateTable(m_app_db.get(), APP_INTF_TABLE_NAME, 1, 1), gIntfsOrch, APP_INTF_TABLE_NAME));
+            intfConsumer->addToSync({ { "Ethernet0", SET_COMMAND, { } } });
+            static_cast<Orch *>(gIntfsOrch)->doTask(*intfConsumer.get());
+            ASSERT_TRUE(intfConsumer->m_toSync.empty());
+
+            m_neighConsumer = unique_ptr<Consumer>(new Consumer(
+                new swss::ConsumerStateTable(m_app_db.get(), APP_NEIGH_TABLE_NAME, 1, 1), gNeighOrch, APP_NEIGH_TABLE_NAME));
+            m_neighConsumer->addToSync({ { "Ethernet0:10.0.0.1", SET_COMMAND, { { "neigh", "00:00:0a:00:00:01" }, { "family", "IPv4" } } } });
+            m_neighConsumer->addToSync({ { "Ethernet0:fc00::1", SET_COMMAND, { { "neigh", "00:00:0a:00:00:01" }, { "family", "IPv6" } } } });
+            static_cast<Orch *>(gNeighOrch)->doTask(*m_neighConsumer.get());
+            ASSERT_TRUE(m_neighConsumer->m_toSync.empty());
+
+            m_routeConsumer = unique_ptr<Consumer>(new Consumer(
+                new swss::ConsumerStateTable(m_app_db.get(), APP_ROUTE_TABLE_NAME, 1, 1), gRouteOrch, APP_ROUTE_TABLE_NAME));
+        }
+
+        void TearDown() override
+        {
+            gRouteBatchSize = 0;
+            m_routeConsumer.reset();
+            m_neighConsumer.reset();
+
+            delete gDirectory.get<MuxOrch *>();
+            gDirectory.erase<MuxOrch *>();
+
+            delete gRouteOrch;
+            gRouteOrch = nullptr;
+            delete gFgNhgOrch;
+            gFgNhgOrch = nullptr;
+            delete gNeighOrch;
+            gNeighOrch = nullptr;
+            delete gFdbOrch;
+            gFdbOrch = nullptr;
+            delete gIntfsOrch;
+            gIntfsOrch = nullptr;
+            delete gVrfOrch;
+            gVrfOrch = nullptr;
+            delete gCrmOrch;
+            gCrmOrch = nullptr;
+            delete gBufferOrch;
+            gBufferOrch = nullptr;
+            delete gPortsOrch;
+            gPortsOrch = nullptr;
+            delete gSwitchOrch;
+            gSwitchOrch = nullptr;
+
+            auto status = sai_switch_api->remove_switch(gSwitchId);
+            ASSERT_EQ(status, SAI_STATUS_SUCCESS);
+            gSwitchId = 0;
+
+            sai_next_hop_group_api = nullptr;
+            ut_helper::uninitSaiApi();
+
+            ::testing_db::reset();
+        }
+
+        // Half IPv4 /32 and half IPv6 /64 prefixes
+        string getPrefix(size_t i)
+        {
+            if (i % 2 == 0)
+            {
+                i /= 2;
+                return "20." + to_string(i >> 16) + "." + to_string((i >> 8) & 0xff) + "." + to_string(i & 0xff) + "/32";
+            }
+
+            i /= 2;
+            ostringstream oss;
+            oss << "2001:db8:" << hex << (i >> 16) << ":" << (i & 0xffff) << "::/64";
+            return oss.str();
+        }
+
+        deque<KeyOpFieldsValuesTuple> getRoutes(size_t count, const string &op)
+        {
+            deque<KeyOpFieldsValuesTuple> entries;
+            for (size_t i = 0; i < count; i++)
+            {
+                if (op == DEL_COMMAND)
+                {
+                    entries.push_back({ getPrefix(i), DEL_COMMAND, { } });
+                }
+                else
+                {
+                    entries.push_back({ getPrefix(i), SET_COMMAND,
+                        { { "nexthop", i % 2 == 0 ? "10.0.0.1" : "fc00::1" }, { "ifname", "Ethernet0" } } });
+                }
+            }
+            return entries;
+        }
+
+        void doRouteTask(deque<KeyOpFieldsValuesTuple> &&entries)
+        {
+            m_routeConsumer->addToSync(std::move(entries));
+            static_cast<Orch *>(gRouteOrch)->doTask(*m_routeConsumer.get());
+        }
+
+        // Half IPv4 and half IPv6 neighbors on Ethernet0, each with its own MAC
+        string getNeighborIp(size_t i)
+        {
+            if (i % 2 == 0)
+            {
+                i /= 2;
+                return "10.1." + to_string((i >> 8) & 0xff) + "." + to_string(i & 0xff);
+            }
+
+            i /= 2;
+            ostringstream oss;
+            oss << "fc00::1:" << hex << i;
+            return oss.str();
+        }
+
+        deque<KeyOpFieldsValuesTuple> getNeighbors(size_t count, const string &op)
+        {
+            deque<KeyOpFieldsValuesTuple> entries;
+            for (size_t i = 0; i < count; i++)
+            {
+                string key = "Ethernet0:" + getNeighborIp(i);
+                if (op == DEL_COMMAND)
+                {
+                    entries.push_back({ key, DEL_COMMAND, { } });
+                }
+                else
+                {
+                    uint8_t mac[6] = { 0x00, 0x00, 0x0b, (uint8_t)(i >> 16), (uint8_t)(i >> 8), (uint8_t)i };
+                    entries.push_back({ key, SET_COMMAND,
+                        { { "neigh", MacAddress(mac).to_string() }, { "family", i % 2 == 0 ? "IPv4" : "IPv6" } } });
+                }
+            }
+            return entries;
+        }
+
+        void doNeighTask(deque<KeyOpFieldsValuesTuple> &&entries)
+        {
+            m_neighConsumer->addToSync(std::move(entries));
+            static_cast<Orch *>(gNeighOrch)->doTask(*m_neighConsumer.get());
+        }
+
+        static uint32_t getCrmUsed(CrmResourceType type)
+        {
+            return Portal::CrmOrchInternal::getResourceMap(gCrmOrch).at(type).countersMap.at("STATS").usedCounter;
+        }
+    };
+
+    TEST_F(RouteOrchTest, PipelinedMatchesSerial)
+    {
+        const size_t count = 2000;
+
+        for (int batch_size : { 0, 1, 64 })
+        {
+            gRouteBatchSize = batch_size;
+
+            doRouteTask(getRoutes(count, SET_COMMAND));
+            ASSERT_TRUE(m_routeConsumer->m_toSync.empty());
+
+            for (size_t i = 0; i < count; i++)
+            {
+                auto nhg = gRouteOrch->getSyncdRouteNhgKey(gVirtualRouterId, IpPrefix(getPrefix(i)));
+                ASSERT_EQ(nhg.to_string(), i % 2 == 0 ? "10.0.0.1@Ethernet0" : "fc00::1@Ethernet0");
+            }
+
+            doRouteTask(getRoutes(count, DEL_COMMAND));
+            ASSERT_TRUE(m_routeConsumer->m_toSync.empty());
+
+            for (size_t i = 0; i < count; i++)
+            {
+                auto nhg = gRouteOrch->getSyncdRouteNhgKey(gVirtualRouterId, IpPrefix(getPrefix(i)));
+                ASSERT_EQ(nhg.getSize(), 0u);
+            }
+        }
+    }
+
+    TEST_F(RouteOrchTest, PipelinedKeepsPrefixOrder)
+    {
+        gRouteBatchSize = 1;
+
+        doRouteTask(getRoutes(4, SET_COMMAND));
+        ASSERT_TRUE(m_routeConsumer->m_toSync.empty());
+
+        // DEL and SET of the same prefix are split across batches and must not be reordered
+        m_routeConsumer->addToSync({ { getPrefix(0), DEL_COMMAND, { } } });
+        m_routeConsumer->addToSync({ { getPrefix(0), SET_COMMAND, { { "nexthop", "10.0.0.1" }, { "ifname", "Ethernet0" } } } });
+        m_routeConsumer->addToSync({ { getPrefix(1), SET_COMMAND, { { "nexthop", "fc00::1" }, { "ifname", "Ethernet0" } } } });
+        m_routeConsumer->addToSync({ { getPrefix(1), DEL_COMMAND, { } } });
+        ASSERT_EQ(m_routeConsumer->m_toSync.size(), 3u);
+
+        static_cast<Orch *>(gRouteOrch)->doTask(*m_routeConsumer.get());
+        ASSERT_TRUE(m_routeConsumer->m_toSync.empty());
+
+        ASSERT_EQ(gRouteOrch->getSyncdRouteNhgKey(gVirtualRouterId, IpPrefix(getPrefix(0))).to_string(), "10.0.0.1@Ethernet0");
+        ASSERT_EQ(gRouteOrch->getSyncdRouteNhgKey(gVirtualRouterId, IpPrefix(getPrefix(1))).getSize(), 0u);
+    }
+
+    TEST_F(RouteOrchTest, UpdateNextHopRoutes)
+    {
+        const size_t count = 10;
+        uint32_t numRoutes;
+
+        doRouteTask(getRoutes(count, SET_COMMAND));
+        ASSERT_TRUE(m_routeConsumer->m_toSync.empty());
+
+        // Only the routes pointing to the next hop are updated
+        ASSERT_TRUE(gRouteOrch->updateNextHopRoutes(NextHopKey("10.0.0.1", "Ethernet0"), numRoutes));
+        ASSERT_EQ(numRoutes, count / 2);
+        ASSERT_TRUE(gRouteOrch->updateNextHopRoutes(NextHopKey("fc00::1", "Ethernet0"), numRoutes));
+        ASSERT_EQ(numRoutes, count / 2);
+        ASSERT_TRUE(gRouteOrch->updateNextHopRoutes(NextHopKey("10.0.0.2", "Ethernet0"), numRoutes));
+        ASSERT_EQ(numRoutes, 0u);
+
+        // Removed routes leave the index
+        m_routeConsumer->addToSync({ { getPrefix(0), DEL_COMMAND, { } } });
+        static_cast<Orch *>(gRouteOrch)->doTask(*m_routeConsumer.get());
+        ASSERT_TRUE(gRouteOrch->updateNextHopRoutes(NextHopKey("10.0.0.1", "Ethernet0"), numRoutes));
+        ASSERT_EQ(numRoutes, count / 2 - 1);
+
+        doRouteTask(getRoutes(count, DEL_COMMAND));
+        ASSERT_TRUE(gRouteOrch->updateNextHopRoutes(NextHopKey("10.0.0.1", "Ethernet0"), numRoutes));
+        ASSERT_EQ(numRoutes, 0u);
+        ASSERT_TRUE(gRouteOrch->updateNextHopRoutes(NextHopKey("fc00::1", "Ethernet0"), numRoutes));
+        ASSERT_EQ(numRoutes, 0u);
+    }
+
+    TEST_F(RouteOrchTest, NextHopGroupRoutes)
+    {
+        const size_t count = 10;
+        NextHopGroupKey ecmp("10.0.0.1@Ethernet0,10.0.0.2@Ethernet0");
+        uint32_t numRoutes;
+
+        m_neighConsumer->addToSync({ { "Ethernet0:10.0.0.2", SET_COMMAND, { { "neigh", "00:00:0a:00:00:02" }, { "family", "IPv4" } } } });
+        static_cast<Orch *>(gNeighOrch)->doTask(*m_neighConsumer.get());
+        ASSERT_TRUE(m_neighConsumer->m_toSync.empty());
+
+        deque<KeyOpFieldsValuesTuple> entries;
+        for (size_t i = 0; i < count; i += 2)
+        {
+            entries.push_back({ getPrefix(i), SET_COMMAND, { { "nexthop", "10.0.0.1,10.0.0.2" }, { "ifname", "Ethernet0,Ethernet0" } } });
+        }
+        doRouteTask(std::move(entries));
+        ASSERT_TRUE(m_routeConsumer->m_toSync.empty());
+
+        // ECMP routes are indexed by their group, not by its members
+        auto routes = gRouteOrch->getNextHopGroupRoutes(ecmp);
+        ASSERT_NE(routes, nullptr);
+        ASSERT_EQ(routes->size(), count / 2);
+        ASSERT_EQ(routes->count(make_pair(gVirtualRouterId, IpPrefix(getPrefix(0)))), 1u);
+        ASSERT_TRUE(gRouteOrch->updateNextHopRoutes(NextHopKey("10.0.0.1", "Ethernet0"), numRoutes));
+        ASSERT_EQ(numRoutes, 0u);
+
+        // A route moved to a single next hop changes index
+        m_routeConsumer->addToSync({ { getPrefix(0), SET_COMMAND, { { "nexthop", "10.0.0.1" }, { "ifname", "Ethernet0" } } } });
+        static_cast<Orch *>(gRouteOrch)->doTask(*m_routeConsumer.get());
+        ASSERT_EQ(gRouteOrch->getNextHopGroupRoutes(ecmp)->size(), count / 2 - 1);
+        ASSERT_TRUE(gRouteOrch->updateNextHopRoutes(NextHopKey("10.0.0.1", "Ethernet0"), numRoutes));
+        ASSERT_EQ(numRoutes, 1u);
+
+        doRouteTask(getRoutes(count, DEL_COMMAND));
+        ASSERT_EQ(gRouteOrch->getNextHopGroupRoutes(ecmp), nullptr);
+    }
+
+    TEST_F(RouteOrchTest, BulkNeighbors)
+    {
+        const size_t count = 2000;
+
+        uint32_t ipv4_neighbors = getCrmUsed(CrmResourceType::CRM_IPV4_NEIGHBOR);
+        uint32_t ipv6_neighbors = getCrmUsed(CrmResourceType::CRM_IPV6_NEIGHBOR);
+        uint32_t ipv4_nexthops = getCrmUsed(CrmResourceType::CRM_IPV4_NEXTHOP);
+        uint32_t ipv6_nexthops = getCrmUsed(CrmResourceType::CRM_IPV6_NEXTHOP);
+
+        // The route waits for its next hop, which is created with the neighbors
+        m_routeConsumer->addToSync({ { getPrefix(0), SET_COMMAND, { { "nexthop", getNeighborIp(2) }, { "ifname", "Ethernet0" } } } });
+        static_cast<Orch *>(gRouteOrch)->doTask(*m_routeConsumer.get());
+        ASSERT_EQ(m_routeConsumer->m_toSync.size(), 1u);
+
+        doNeighTask(getNeighbors(count, SET_COMMAND));
+        ASSERT_TRUE(m_neighConsumer->m_toSync.empty());
+
+        for (size_t i = 0; i < count; i++)
+        {
+            NextHopKey nexthop(getNeighborIp(i), "Ethernet0");
+            ASSERT_TRUE(gNeighOrch->hasNextHop(nexthop));
+            ASSERT_NE(gNeighOrch->getNextHopId(nexthop), SAI_NULL_OBJECT_ID);
+            ASSERT_TRUE(gNeighOrch->isHwConfigured(nexthop));
+        }
+
+        ASSERT_EQ(getCrmUsed(CrmResourceType::CRM_IPV4_NEIGHBOR), ipv4_neighbors + count / 2);
+        ASSERT_EQ(getCrmUsed(CrmResourceType::CRM_IPV6_NEIGHBOR), ipv6_neighbors + count / 2);
+        ASSERT_EQ(getCrmUsed(CrmResourceType::CRM_IPV4_NEXTHOP), ipv4_nexthops + count / 2);
+        ASSERT_EQ(getCrmUsed(CrmResourceType::CRM_IPV6_NEXTHOP), ipv6_nexthops + count / 2);
+
+        static_cast<Orch *>(gRouteOrch)->doTask(*m_routeConsumer.get());
+        ASSERT_TRUE(m_routeConsumer->m_toSync.empty());
+        ASSERT_EQ(gRouteOrch->getSyncdRouteNhgKey(gVirtualRouterId, IpPrefix(getPrefix(0))).to_string(),
+                  getNeighborIp(2) + "@Ethernet0");
+
+        // A MAC update is applied to the created neighbor
+        uint8_t mac[6] = { 0x00, 0x00, 0x0c, 0x00, 0x00, 0x01 };
+        m_neighConsumer->addToSync({ { "Ethernet0:" + getNeighborIp(1), SET_COMMAND,
+            { { "neigh", MacAddress(mac).to_string() }, { "family", "IPv6" } } } });
+        static_cast<Orch *>(gNeighOrch)->doTask(*m_neighConsumer.get());
+        ASSERT_TRUE(m_neighConsumer->m_toSync.empty());
+
+        NeighborEntry neighbor;
+        MacAddress neighbor_mac;
+        ASSERT_TRUE(gNeighOrch->getNeighborEntry(IpAddress(getNeighborIp(1)), neighbor, neighbor_mac));
+        ASSERT_EQ(neighbor_mac, MacAddress(mac));
+
+        doRouteTask(getRoutes(1, DEL_COMMAND));
+        doNeighTask(getNeighbors(count, DEL_COMMAND));
+        ASSERT_TRUE(m_neighConsumer->m_toSync.empty());
+        ASSERT_EQ(getCrmUsed(CrmResourceType::CRM_IPV4_NEIGHBOR), ipv4_neighbors);
+        ASSERT_EQ(getCrmUsed(CrmResourceType::CRM_IPV6_NEXTHOP), ipv6_nexthops);
+    }
+
+    /*
+     * Routes waiting for their neighbors are retried by the RouteOrch worker
+     * thread once the main loop created the neighbors, with the same result
+     * as the serial loop.
+     */
+    TEST_F(RouteOrchTest, SchedulerMatchesSerial)
+    {
+        const size_t count = 100;
+
+        auto routeConsumer = dynamic_cast<Consumer *>(gRouteOrch->getExecutor(APP_ROUTE_TABLE_NAME));
+        auto neighConsumer = dynamic_cast<Consumer *>(gNeighOrch->getExecutor(APP_NEIGH_TABLE_NAME));
+        auto neighbors = getNeighbors(6, SET_COMMAND);
+
+        // Even routes are IPv4 and odd ones IPv6, as the neighbors
+        auto getRoutesVia = [&](size_t first, size_t neighbor) {
+            deque<KeyOpFieldsValuesTuple> entries;
+            for (size_t i = first; i < first + count; i++)
+            {
+                entries.push_back({ getPrefix(i), SET_COMMAND,
+                    { { "nexthop", getNeighborIp(neighbor + i % 2) }, { "ifname", "Ethernet0" } } });
+            }
+            return entries;
+        };
+
+        // Serial loop, every orch retries its tasks after an event
+
+        routeConsumer->addToSync(getRoutesVia(0, 2));
+        static_cast<Orch *>(gRouteOrch)->doTask();
+        ASSERT_EQ(routeConsumer->m_toSync.size(), count);
+
+        neighConsumer->addToSync({ neighbors[2], neighbors[3] });
+        static_cast<Orch *>(gNeighOrch)->doTask();
+        static_cast<Orch *>(gRouteOrch)->doTask();
+        ASSERT_TRUE(routeConsumer->m_toSync.empty());
+
+        // RouteOrch on a worker thread, which has no event to wake it up
+        // once the neighbors are created by the main loop
+
+        OrchScheduler scheduler({ gPortsOrch, gIntfsOrch, gNeighOrch, gRouteOrch });
+        scheduler.addDependency(gRouteOrch, gNeighOrch);
+        scheduler.addDependency(gRouteOrch, gIntfsOrch);
+        scheduler.addDependency(gRouteOrch, gPortsOrch, true);
+        ASSERT_TRUE(scheduler.offload(gRouteOrch, "RouteOrch"));
+        scheduler.start();
+
+        {
+            auto guard = scheduler.lockAll();
+            routeConsumer->addToSync(getRoutesVia(count, 4));
+            static_cast<Orch *>(gRouteOrch)->doTask();
+            ASSERT_EQ(routeConsumer->m_toSync.size(), count);
+        }
+
+        {
+            auto guard = scheduler.lockAll();
+            neighConsumer->addToSync({ neighbors[4], neighbors[5] });
+            static_cast<Orch *>(gNeighOrch)->doTask();
+            ASSERT_TRUE(neighConsumer->m_toSync.empty());
+        }
+
+        bool done = false;
+        for (int i = 0; i < 50 && !done; i++)
+        {
+            this_thread::sleep_for(chrono::milliseconds(100));
+            auto guard = scheduler.lockAll();
+            done = routeConsumer->m_toSync.empty();
+        }
+
+        scheduler.stop();
+        ASSERT_TRUE(done);
+
+        for (size_t i = 0; i < count; i++)
+        {
+            ASSERT_EQ(gRouteOrch->getSyncdRouteNhgKey(gVirtualRouterId, IpPrefix(getPrefix(i))).to_string(),
+                      getNeighborIp(2 + i % 2) + "@Ethernet0");
+            ASSERT_EQ(gRouteOrch->getSyncdRouteNhgKey(gVirtualRouterId, IpPrefix(getPrefix(count + i))).to_string(),
+                      getNeighborIp(4 + i % 2) + "@Ethernet0");
+        }
+    }
+
+    /*
+     * Routes per second against the virtual switch SAI, serial and pipelined.
+     * Run with --gtest_also_run_disabled_tests.
+     */
+    TEST_F(RouteOrchTest, DISABLED_RouteProgrammingBenchmark)
+    {
+        for (size_t count : vector<size_t>{ 100000, 500000, 1000000 })
+        {
+            for (int batch_size : { 0, 1000 })
+            {
+                gRouteBatchSize = batch_size;
+
+                auto start = chrono::steady_clock::now();
+                doRouteTask(getRoutes(count, SET_COMMAND));
+                auto added = chrono::steady_clock::now();
+                ASSERT_TRUE(m_routeConsumer->m_toSync.empty());
+
+                doRouteTask(getRoutes(count, DEL_COMMAND));
+                auto removed = chrono::steady_clock::now();
+                ASSERT_TRUE(m_routeConsumer->m_toSync.empty());
+
+                auto add_us = chrono::duration_cast<chrono::microseconds>(added - start).count();
+                auto del_us = chrono::duration_cast<chrono::microseconds>(removed - added).count();
+
+                cout << count << " routes, batch " << batch_size << ": add "
+                     << (double)count * 1000000 / (double)max<int64_t>(add_us, 1) << " routes/s, remove "
+                     << (double)count * 1000000 / (double)max<int64_t>(del_us, 1) << " routes/s" << endl;
+            }
+        }
+    }
+
+    /*
+     * Neighbors per second against the virtual switch SAI.
+     * Run with --gtest_also_run_disabled_tests.
+     */
+    TEST_F(RouteOrchTest, DISABLED_NeighborProgrammingBenchmark)
+    {
+        const size_t count = 32768;
+
+        auto start = chrono::steady_clock::now();
+        doNeighTask(getNeighbors(count, SET_COMMAND));
+        auto added = chrono::steady_clock::now();
+        ASSERT_TRUE(m_neighConsumer->m_toSync.empty());
+
+        doNeighTask(getNeighbors(count, DEL_COMMAND));
+        auto removed = chrono::steady_clock::now();
+        ASSERT_TRUE(m_neighConsumer->m_toSync.empty());
+
+        auto add_us = chrono::duration_cast<chrono::microseconds>(added - start).count();
+        auto del_us = chrono::duration_cast<chrono::microseconds>(removed - added).count();
+
+        cout << count << " neighbors: add "
+             << (double)count * 1000000 / (double)max<int64_t>(add_us, 1) << " neighbors/s, remove "
+             << (double)count * 1000000 / (double)max<int64_t>(del_us, 1) << " neighbors/s" << endl;
+    }
+}
@@ -78,6 +78,7 @@ namespace ut_helper
         sai_api_query(SAI_API_HOSTIF, (void **)&sai_hostif_api);
         sai_api_query(SAI_API_BUFFER, (void **)&sai_buffer_api);
         sai_api_query(SAI_API_QUEUE, (void **)&sai_queue_api);
+        sai_api_query(SAI_API_NAT, (void **)&sai_nat_api);
 
         return SAI_STATUS_SUCCESS;
     }
@@ -101,6 +102,7 @@ namespace ut_helper
         sai_hostif_api = nullptr;
         sai_buffer_api = nullptr;
         sai_queue_api = nullptr;
+        sai_nat_api = nullptr;
     }
 
     map<string, vector<FieldValueTuple>> getInitialSaiPorts()
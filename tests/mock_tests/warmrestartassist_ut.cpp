@@ -0,0 +1,209 @@
+#include "ut_helper.h"
+#include "mock_table.h"
+#include "mock_hiredis.h"
+
+#include <set>
+#include <string.h>
+
+#include "redispipeline.h"
+#include "warmRestartScanner.h"
+
+#define private public
+#include "warmRestartAssist.h"
+#undef private
+
+namespace warmrestartassist_test
+{
+    using namespace std;
+
+    using testing_redis::stringReply;
+    using testing_redis::arrayReply;
+    using testing_redis::commandArgs;
+
+    /* HGETALL reply of a hash */
+    redisReply *hashReply(const vector<FieldValueTuple> &fvs)
+    {
+        vector<redisReply *> elements;
+        for (const auto &fv : fvs)
+        {
+            elements.push_back(stringReply(fvField(fv)));
+            elements.push_back(stringReply(fvValue(fv)));
+        }
+        return arrayReply(elements);
+    }
+
+    /* Reply of the scan script: the next cursor, then each key and its field-values */
+    redisReply *chunkReply(const string &cursor, const vector<pair<string, redisReply *>> &entries)
+    {
+        vector<redisReply *> elements = { stringReply(cursor) };
+        for (const auto &entry : entries)
+        {
+            elements.push_back(stringReply(entry.first));
+            elements.push_back(entry.second);
+        }
+        return arrayReply(elements);
+    }
+
+    const vector<FieldValueTuple> route_a = { { "nexthop", "10.1.1.1" }, { "ifname", "Ethernet0" } };
+    const vector<FieldValueTuple> route_b = { { "nexthop", "10.1.1.5" }, { "ifname", "Ethernet4" } };
+
+    struct WarmRestartAssistTest : public ::testing::Test
+    {
+        shared_ptr<DBConnector> m_app_db;
+        shared_ptr<RedisPipeline> m_pipeline;
+
+        void SetUp() override
+        {
+            ::testing_db::reset();
+            ::testing_redis::reset();
+
+            m_app_db = make_shared<DBConnector>("APPL_DB", 0);
+            m_pipeline = make_shared<RedisPipeline>(m_app_db.get());
+        }
+
+        void TearDown() override
+        {
+            ::testing_redis::reset();
+            ::testing_db::reset();
+        }
+    };
+
+    /*
+     * The scan script is loaded once and run once per chunk, on the keys of
+     * the table only. The table prefix is removed from the keys and the
+     * entries removed while scanning are skipped.
+     */
+    TEST_F(WarmRestartAssistTest, RedisTableScanner)
+    {
+        Table table(m_pipeline.get(), "ROUTE_TABLE", false);
+
+        testing_redis::gCapture = true;
+        testing_redis::gReplies = {
+            stringReply("scan-sha"),
+            chunkReply("17", {
+                { "ROUTE_TABLE:10.0.0.0/24", hashReply(route_a) },
+                { "ROUTE_TABLE:10.0.1.0/24", arrayReply({}) }
+            }),
+            chunkReply("0", {
+                { "ROUTE_TABLE:fc00::/64", hashReply(route_b) }
+            })
+        };
+
+        RedisTableScanner scanner(m_pipeline.get(), table, 100);
+
+        vector<pair<string, vector<FieldValueTuple>>> entries;
+        uint64_t count = scanner.scan([&entries](const string &key, const vector<FieldValueTuple> &fv) {
+            entries.emplace_back(key, fv);
+        });
+
+        ASSERT_EQ(count, 2u);
+        ASSERT_EQ(scanner.getChunks(), 2u);
+        ASSERT_EQ(entries.size(), 2u);
+        ASSERT_EQ(entries[0].first, "10.0.0.0/24");
+        ASSERT_EQ(entries[0].second, route_a);
+        ASSERT_EQ(entries[1].first, "fc00::/64");
+        ASSERT_EQ(entries[1].second, route_b);
+
+        ASSERT_EQ(testing_redis::gCommands.size(), 3u);
+
+        auto load = commandArgs(testing_redis::gCommands[0]);
+        ASSERT_EQ(load.size(), 3u);
+        ASSERT_EQ(load[0], "SCRIPT");
+        ASSERT_EQ(load[1], "LOAD");
+        ASSERT_NE(load[2].find("redis.call('SCAN', ARGV[1], 'MATCH', ARGV[2], 'COUNT', ARGV[3])"), string::npos);
+        ASSERT_NE(load[2].find("redis.call('HGETALL', key)"), string::npos);
+
+        ASSERT_EQ(commandArgs(testing_redis::gCommands[1]),
+                  vector<string>({ "EVALSHA", "scan-sha", "0", "0", "ROUTE_TABLE:*", "100" }));
+        ASSERT_EQ(commandArgs(testing_redis::gCommands[2]),
+                  vector<string>({ "EVALSHA", "scan-sha", "0", "17", "ROUTE_TABLE:*", "100" }));
+    }
+
+    TEST_F(WarmRestartAssistTest, RedisTableScannerBadReply)
+    {
+        Table table(m_pipeline.get(), "ROUTE_TABLE", false);
+
+        testing_redis::gReplies = { stringReply("scan-sha"), arrayReply({}) };
+
+        RedisTableScanner scanner(m_pipeline.get(), table);
+        ASSERT_THROW(scanner.scan([](const string &, const vector<FieldValueTuple> &) {}), runtime_error);
+    }
+
+    /*
+     * A restored entry received with the same value is cached from the
+     * received one, appDB is only read back when the value can differ.
+     */
+    TEST_F(WarmRestartAssistTest, LoadRestoredEntry)
+    {
+        const string table = "ROUTE_TABLE";
+
+        ProducerStateTable routeTable(m_pipeline.get(), table, true);
+        AppRestartAssist assist(m_pipeline.get(), "fpmsyncd", "bgp");
+        assist.registerAppTable(table, &routeTable);
+
+        // The same route has another value in appDB, to tell whether it was read back
+        Table appTable(m_app_db.get(), table);
+        appTable.set("10.0.0.0/24", route_b);
+        appTable.set("10.0.1.0/24", route_a);
+        appTable.set("10.0.2.0/24", route_a);
+        appTable.set("10.0.3.0/24", route_a);
+        appTable.set("10.0.5.0/24", route_a);
+
+        testing_redis::gReplies = {
+            stringReply("scan-sha"),
+            chunkReply("0", {
+                { table + ":10.0.0.0/24", hashReply(route_a) },
+                { table + ":10.0.1.0/24", hashReply(route_a) },
+                { table + ":10.0.2.0/24", hashReply(route_a) },
+                { table + ":10.0.3.0/24", hashReply(route_a) },
+                { table + ":10.0.5.0/24", hashReply(route_a) }
+            })
+        };
+        assist.readTablesToMap();
+        ASSERT_EQ(assist.appTableRestoredMap[table].size(), 5u);
+        ASSERT_TRUE(testing_redis::gReplies.empty());
+
+        // Removed from appDB before being received
+        appTable.del("10.0.5.0/24");
+
+        assist.insertToMap(table, "10.0.0.0/24", route_a, false);
+        assist.insertToMap(table, "10.0.1.0/24", route_b, false);
+        assist.insertToMap(table, "10.0.2.0/24", {}, true);
+        assist.insertToMap(table, "10.0.4.0/24", route_a, false);
+        assist.insertToMap(table, "10.0.5.0/24", route_b, false);
+
+        auto &cache = assist.appTableCacheMap[table];
+
+        ASSERT_EQ(cache.at("10.0.0.0/24").back().second, "SAME");
+        ASSERT_EQ(vector<FieldValueTuple>(cache.at("10.0.0.0/24").begin(), cache.at("10.0.0.0/24").end() - 1), route_a);
+        ASSERT_EQ(cache.at("10.0.1.0/24").back().second, "NEW");
+        ASSERT_EQ(cache.at("10.0.2.0/24").back().second, "DELETE");
+        ASSERT_EQ(cache.at("10.0.4.0/24").back().second, "NEW");
+        ASSERT_EQ(cache.at("10.0.5.0/24").back().second, "NEW");
+        ASSERT_EQ(cache.count("10.0.3.0/24"), 0u);
+
+        // Never received, stale
+        ASSERT_EQ(assist.appTableRestoredMap[table].size(), 1u);
+        ASSERT_EQ(assist.appTableRestoredMap[table].count("10.0.3.0/24"), 1u);
+
+        // Only the changes are written, the stale and deleted routes are removed
+        testing_redis::gCapture = true;
+        assist.reconcile();
+        routeTable.flush();
+
+        set<string> written;
+        for (const auto &command : testing_redis::gCommands)
+        {
+            for (const string key : { "10.0.0.0/24", "10.0.1.0/24", "10.0.2.0/24", "10.0.3.0/24", "10.0.4.0/24", "10.0.5.0/24" })
+            {
+                if (command.find(key) != string::npos)
+                {
+                    written.insert(key);
+                }
+            }
+        }
+        ASSERT_EQ(written, set<string>({ "10.0.1.0/24", "10.0.2.0/24", "10.0.3.0/24", "10.0.4.0/24", "10.0.5.0/24" }));
+        ASSERT_TRUE(assist.appTableRestoredMap.empty());
+        ASSERT_TRUE(assist.appTableCacheMap.empty());
+    }
+}
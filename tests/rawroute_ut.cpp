@@ -0,0 +1,395 @@
+#include <stdlib.h>
+#include <string.h>
+#include <arpa/inet.h>
+#include <netlink/msg.h>
+#include <netlink/route/route.h>
+#include <netlink/route/nexthop.h>
+
+#include <atomic>
+#include <chrono>
+#include <fstream>
+#include <iostream>
+#include <iterator>
+#include <string>
+#include <vector>
+
+#include "gtest/gtest.h"
+#include "fpm/fpm.h"
+#include "rawroute.h"
+
+using namespace std;
+using namespace swss;
+
+#ifdef RAWROUTE_COUNT_ALLOCATIONS
+/*
+ * Count heap allocations, operator new and libnl both end up in
+ * malloc/calloc. This replaces malloc for the whole process, so it is only
+ * built into the rawroute_bench binary.
+ */
+extern "C" void *__libc_malloc(size_t size);
+extern "C" void *__libc_calloc(size_t nmemb, size_t size);
+extern "C" void *__libc_realloc(void *ptr, size_t size);
+
+static atomic<size_t> gAllocations(0);
+
+extern "C" void *malloc(size_t size)
+{
+    gAllocations.fetch_add(1, memory_order_relaxed);
+    return __libc_malloc(size);
+}
+
+extern "C" void *calloc(size_t nmemb, size_t size)
+{
+    gAllocations.fetch_add(1, memory_order_relaxed);
+    return __libc_calloc(nmemb, size);
+}
+
+extern "C" void *realloc(void *ptr, size_t size)
+{
+    gAllocations.fetch_add(1, memory_order_relaxed);
+    return __libc_realloc(ptr, size);
+}
+
+static size_t getAllocations()
+{
+    return gAllocations.load(memory_order_relaxed);
+}
+#else
+static size_t getAllocations()
+{
+    return 0;
+}
+#endif
+
+namespace rawroute_test
+{
+    struct NextHop
+    {
+        string gateway;
+        int ifindex;
+    };
+
+    static void addAttr(vector<char> &msg, unsigned short type, const void *data, size_t len)
+    {
+        struct rtattr rta;
+        rta.rta_type = type;
+        rta.rta_len = static_cast<unsigned short>(RTA_LENGTH(len));
+
+        size_t offset = msg.size();
+        msg.resize(offset + RTA_SPACE(len), 0);
+        memcpy(msg.data() + offset, &rta, sizeof(rta));
+        memcpy(msg.data() + offset + RTA_LENGTH(0), data, len);
+    }
+
+    /* Append a FPM framed route message to the stream */
+    static void addRoute(vector<char> &stream, uint16_t type, const string &prefix,
+                         const vector<NextHop> &nexthops, uint32_t table = 0,
+                         unsigned char route_type = RTN_UNICAST)
+    {
+        auto slash = prefix.find('/');
+        string addr = prefix.substr(0, slash);
+        unsigned char family = addr.find(':') == string::npos ? AF_INET : AF_INET6;
+        size_t addr_len = family == AF_INET ? 4 : 16;
+
+        vector<char> msg(NLMSG_SPACE(sizeof(struct rtmsg)), 0);
+        struct nlmsghdr *h = (struct nlmsghdr *)msg.data();
+        h->nlmsg_type = type;
+
+        struct rtmsg *rtm = (struct rtmsg *)NLMSG_DATA(h);
+        rtm->rtm_family = family;
+        rtm->rtm_dst_len = static_cast<unsigned char>(stoi(prefix.substr(slash + 1)));
+        rtm->rtm_type = route_type;
+        rtm->rtm_table = static_cast<unsigned char>(table < 256 ? table : 0);
+
+        /* Zebra always sends the destination, default routes included */
+        unsigned char dst[16];
+        inet_pton(family, addr.c_str(), dst);
+        addAttr(msg, RTA_DST, dst, addr_len);
+
+        if (table >= 256)
+        {
+            addAttr(msg, RTA_TABLE, &table, sizeof(table));
+        }
+
+        if (nexthops.size() == 1)
+        {
+            unsigned char gw[16];
+            inet_pton(family, nexthops[0].gateway.c_str(), gw);
+            addAttr(msg, RTA_GATEWAY, gw, addr_len);
+            addAttr(msg, RTA_OIF, &nexthops[0].ifindex, sizeof(int));
+        }
+        else if (nexthops.size() > 1)
+        {
+            vector<char> mp;
+            for (const auto &nh : nexthops)
+            {
+                vector<char> attrs;
+                unsigned char gw[16];
+                inet_pton(family, nh.gateway.c_str(), gw);
+                addAttr(attrs, RTA_GATEWAY, gw, addr_len);
+
+                struct rtnexthop rtnh;
+                memset(&rtnh, 0, sizeof(rtnh));
+                rtnh.rtnh_len = static_cast<unsigned short>(RTNH_LENGTH(attrs.size()));
+                rtnh.rtnh_ifindex = nh.ifindex;
+
+                size_t offset = mp.size();
+                mp.resize(offset + RTNH_ALIGN(rtnh.rtnh_len), 0);
+                memcpy(mp.data() + offset, &rtnh, sizeof(rtnh));
+                memcpy(mp.data() + offset + RTNH_LENGTH(0), attrs.data(), attrs.size());
+            }
+            addAttr(msg, RTA_MULTIPATH, mp.data(), mp.size());
+        }
+
+        h = (struct nlmsghdr *)msg.data();
+        h->nlmsg_len = static_cast<uint32_t>(msg.size());
+
+        fpm_msg_hdr_t hdr;
+        hdr.version = FPM_PROTO_VERSION;
+        hdr.msg_type = FPM_MSG_TYPE_NETLINK;
+        hdr.msg_len = htons(static_cast<uint16_t>(fpm_data_len_to_msg_len(msg.size())));
+
+        size_t offset = stream.size();
+        stream.resize(offset + fpm_msg_len(&hdr), 0);
+        memcpy(stream.data() + offset, &hdr, sizeof(hdr));
+        memcpy(stream.data() + offset + FPM_MSG_HDR_LEN, msg.data(), msg.size());
+    }
+
+    /* Walk the FPM frames of the stream the way FpmLink::readData does */
+    template <typename F>
+    static size_t replay(vector<char> &stream, F onMsg)
+    {
+        size_t start = 0;
+        size_t count = 0;
+
+        while (stream.size() - start >= FPM_MSG_HDR_LEN)
+        {
+            fpm_msg_hdr_t *hdr = reinterpret_cast<fpm_msg_hdr_t *>(static_cast<void *>(stream.data() + start));
+            if (!fpm_msg_ok(hdr, stream.size() - start))
+            {
+                break;
+            }
+
+            if (hdr->msg_type == FPM_MSG_TYPE_NETLINK)
+            {
+                onMsg((struct nlmsghdr *)fpm_msg_data(hdr));
+                count++;
+            }
+            start += fpm_msg_len(hdr);
+        }
+
+        return count;
+    }
+
+    struct Decoded
+    {
+        string dst;
+        string gateways;
+        vector<int> ifindexes;
+    };
+
+    static Decoded decodeRaw(RawRouteMsg &route, struct nlmsghdr *h)
+    {
+        Decoded d;
+        char dst[64];
+
+        EXPECT_TRUE(route.parse(h));
+        route.formatDst(dst, sizeof(dst));
+        route.formatGateways(d.gateways);
+        d.dst = dst;
+        for (const auto &nh : route.nexthops)
+        {
+            d.ifindexes.push_back(nh.ifindex);
+        }
+        return d;
+    }
+
+    static void parseLibnl(struct nl_object *obj, void *arg)
+    {
+        Decoded *d = static_cast<Decoded *>(arg);
+        struct rtnl_route *route_obj = (struct rtnl_route *)obj;
+        char buf[64];
+
+        d->dst = nl_addr2str(rtnl_route_get_dst(route_obj), buf, sizeof(buf));
+
+        for (int i = 0; i < rtnl_route_get_nnexthops(route_obj); i++)
+        {
+            struct rtnl_nexthop *nexthop = rtnl_route_nexthop_n(route_obj, i);
+            struct nl_addr *addr = rtnl_route_nh_get_gateway(nexthop);
+
+            if (i)
+            {
+                d->gateways += ",";
+            }
+
+            if (addr)
+            {
+                d->gateways += nl_addr2str(addr, buf, sizeof(buf));
+            }
+            else
+            {
+                d->gateways += rtnl_route_get_family(route_obj) == AF_INET ? "0.0.0.0" : "::";
+            }
+
+            d->ifindexes.push_back(rtnl_route_nh_get_ifindex(nexthop));
+        }
+    }
+
+    static Decoded decodeLibnl(struct nlmsghdr *h)
+    {
+        Decoded d;
+
+        struct nl_msg *msg = nlmsg_convert(h);
+        EXPECT_NE(msg, nullptr);
+        nlmsg_set_proto(msg, NETLINK_ROUTE);
+        nl_msg_parse(msg, parseLibnl, &d);
+        nlmsg_free(msg);
+        return d;
+    }
+
+    TEST(RawRouteMsg, MatchesLibnl)
+    {
+        vector<char> stream;
+        addRoute(stream, RTM_NEWROUTE, "10.1.0.0/16", { { "10.0.0.1", 2 } });
+        addRoute(stream, RTM_NEWROUTE, "10.1.1.1/32", { { "10.0.0.1", 2 }, { "10.0.0.3", 3 } });
+        addRoute(stream, RTM_NEWROUTE, "0.0.0.0/0", { { "10.0.0.1", 2 } });
+        addRoute(stream, RTM_NEWROUTE, "2001:db8::/64", { { "fc00::1", 2 }, { "fc00::3", 3 }, { "fc00::5", 4 } });
+        addRoute(stream, RTM_NEWROUTE, "::/0", { { "fc00::1", 2 } });
+        addRoute(stream, RTM_DELROUTE, "2001:db8::1/128", { }, 1000);
+
+        RawRouteMsg route;
+        size_t count = replay(stream, [&](struct nlmsghdr *h) {
+            Decoded raw = decodeRaw(route, h);
+            Decoded nl = decodeLibnl(h);
+            EXPECT_EQ(raw.dst, nl.dst);
+            EXPECT_EQ(raw.gateways, nl.gateways);
+            EXPECT_EQ(raw.ifindexes, nl.ifindexes);
+        });
+        ASSERT_EQ(count, 6u);
+    }
+
+    TEST(RawRouteMsg, Fields)
+    {
+        vector<char> stream;
+        addRoute(stream, RTM_NEWROUTE, "10.1.1.0/24", { { "10.0.0.1", 2 }, { "10.0.0.3", 3 } }, 1000);
+        addRoute(stream, RTM_NEWROUTE, "10.2.0.0/16", { }, 0, RTN_BLACKHOLE);
+
+        vector<Decoded> decoded;
+        vector<RawRouteMsg> routes;
+        RawRouteMsg route;
+        replay(stream, [&](struct nlmsghdr *h) {
+            decoded.push_back(decodeRaw(route, h));
+            routes.push_back(route);
+        });
+
+        ASSERT_EQ(routes.size(), 2u);
+        ASSERT_EQ(routes[0].table, 1000u);
+        ASSERT_EQ(routes[0].route_type, RTN_UNICAST);
+        ASSERT_EQ(decoded[0].dst, "10.1.1.0/24");
+        ASSERT_EQ(decoded[0].gateways, "10.0.0.1,10.0.0.3");
+        ASSERT_EQ(decoded[0].ifindexes, vector<int>({ 2, 3 }));
+
+        ASSERT_EQ(routes[1].table, 0u);
+        ASSERT_EQ(routes[1].route_type, RTN_BLACKHOLE);
+        ASSERT_TRUE(routes[1].nexthops.empty());
+
+        // Truncated and non-route messages are declined
+        struct nlmsghdr h;
+        memset(&h, 0, sizeof(h));
+        h.nlmsg_type = RTM_NEWROUTE;
+        h.nlmsg_len = NLMSG_LENGTH(0);
+        ASSERT_FALSE(route.parse(&h));
+        h.nlmsg_type = RTM_NEWLINK;
+        ASSERT_FALSE(route.parse(&h));
+    }
+
+    TEST(RawRouteMsg, NoNextHop)
+    {
+        // A unicast route without next hop, RouteSync::writeRoute() skips it
+        vector<char> stream;
+        addRoute(stream, RTM_NEWROUTE, "10.3.0.0/16", { });
+
+        RawRouteMsg route;
+        size_t count = replay(stream, [&](struct nlmsghdr *h) {
+            Decoded raw = decodeRaw(route, h);
+            Decoded nl = decodeLibnl(h);
+            EXPECT_EQ(route.route_type, RTN_UNICAST);
+            EXPECT_TRUE(route.nexthops.empty());
+            EXPECT_EQ(raw.dst, "10.3.0.0/16");
+            EXPECT_EQ(raw.gateways, "");
+            EXPECT_EQ(raw.gateways, nl.gateways);
+            EXPECT_EQ(raw.ifindexes, nl.ifindexes);
+        });
+        ASSERT_EQ(count, 1u);
+    }
+
+    /*
+     * Replay a FPM stream through both decoders. The stream is read from the
+     * file in FPM_REPLAY_FILE if set, a capture of the fpmsyncd socket, or
+     * generated with 1M routes otherwise. Allocations are only counted when
+     * run from the rawroute_bench binary.
+     */
+    TEST(RawRouteMsg, DISABLED_ReplayBenchmark)
+    {
+        vector<char> stream;
+
+        const char *file = getenv("FPM_REPLAY_FILE");
+        if (file)
+        {
+            ifstream in(file, ios::binary);
+            stream.assign(istreambuf_iterator<char>(in), istreambuf_iterator<char>());
+        }
+        else
+        {
+            for (uint32_t i = 0; i < 1000000; i++)
+            {
+                char prefix[64];
+                if (i % 2)
+                {
+                    snprintf(prefix, sizeof(prefix), "2001:db8:%x:%x::/64", i >> 16, i & 0xffff);
+                    addRoute(stream, RTM_NEWROUTE, prefix, { { "fc00::1", 2 }, { "fc00::3", 3 } });
+                }
+                else
+                {
+                    snprintf(prefix, sizeof(prefix), "20.%u.%u.%u/32", (i >> 16) & 0xff, (i >> 8) & 0xff, i & 0xff);
+                    addRoute(stream, RTM_NEWROUTE, prefix, { { "10.0.0.1", 2 } });
+                }
+            }
+        }
+
+        RawRouteMsg route;
+        string gateways;
+        char dst[64];
+
+        auto raw = [&](struct nlmsghdr *h) {
+            if (route.parse(h))
+            {
+                route.formatDst(dst, sizeof(dst));
+                gateways.clear();
+                route.formatGateways(gateways);
+            }
+        };
+
+        auto libnl = [&](struct nlmsghdr *h) {
+            Decoded d = decodeLibnl(h);
+        };
+
+        for (int pass = 0; pass < 2; pass++)
+        {
+            size_t allocations = getAllocations();
+            auto start = chrono::steady_clock::now();
+
+            size_t count = pass ? replay(stream, raw) : replay(stream, libnl);
+
+            auto us = chrono::duration_cast<chrono::microseconds>(chrono::steady_clock::now() - start).count();
+            allocations = getAllocations() - allocations;
+
+            cout << (pass ? "raw" : "libnl") << ": " << count << " messages, "
+                 << (double)count * 1000000 / (double)max<int64_t>(us, 1) << " messages/s";
+#ifdef RAWROUTE_COUNT_ALLOCATIONS
+            cout << ", " << (double)allocations / (double)max<size_t>(count, 1) << " allocations/message";
+#endif
+            cout << endl;
+        }
+    }
+}
@@ -0,0 +1,117 @@
+#include <map>
+#include <thread>
+
+#include "gtest/gtest.h"
+#include "routecoalescer.h"
+
+using namespace std;
+using namespace std::chrono;
+using namespace swss;
+
+namespace routecoalescer_test
+{
+    struct RouteTable
+    {
+        map<string, vector<FieldValueTuple>> routes;
+        vector<string> ops;
+
+        RouteCoalescer coalescer()
+        {
+            return RouteCoalescer(
+                [this](const string &key, const vector<FieldValueTuple> &fvs) {
+                    routes[key] = fvs;
+                    ops.push_back("SET " + key);
+                },
+                [this](const string &key) {
+                    routes.erase(key);
+                    ops.push_back("DEL " + key);
+                });
+        }
+    };
+
+    static vector<FieldValueTuple> nexthop(const string &ip)
+    {
+        return { { "nexthop", ip }, { "ifname", "Ethernet0" } };
+    }
+
+    TEST(RouteCoalescer, PassThrough)
+    {
+        RouteTable table;
+        RouteCoalescer coalescer = table.coalescer();
+
+        coalescer.set("10.0.0.0/24", nexthop("1.1.1.1"));
+        coalescer.del("10.0.0.0/24");
+        ASSERT_EQ(table.ops, vector<string>({ "SET 10.0.0.0/24", "DEL 10.0.0.0/24" }));
+        ASSERT_EQ(coalescer.pending(), 0u);
+        ASSERT_EQ(coalescer.getWrites(), 2u);
+        ASSERT_EQ(coalescer.getSuppressed(), 0u);
+    }
+
+    TEST(RouteCoalescer, Flap)
+    {
+        RouteTable table;
+        RouteCoalescer coalescer = table.coalescer();
+        coalescer.setWindow(milliseconds(60000), 0);
+
+        // A stable route, a route flapping up and a route flapping down
+        coalescer.set("10.0.0.0/24", nexthop("1.1.1.1"));
+        for (int i = 0; i < 10; i++)
+        {
+            coalescer.set("10.1.0.0/24", nexthop("1.1.1.1"));
+            coalescer.set("10.1.0.0/24", nexthop("2.2.2.2"));
+            coalescer.del("10.2.0.0/24");
+            coalescer.set("10.2.0.0/24", nexthop("3.3.3.3"));
+            coalescer.del("10.2.0.0/24");
+        }
+        coalescer.set("10.1.0.0/24", nexthop("1.1.1.1"));
+
+        // Nothing is written until the window has elapsed
+        coalescer.flush();
+        ASSERT_TRUE(table.ops.empty());
+        ASSERT_EQ(coalescer.pending(), 3u);
+
+        coalescer.flush(true);
+        ASSERT_EQ(table.ops, vector<string>({ "SET 10.0.0.0/24", "SET 10.1.0.0/24", "DEL 10.2.0.0/24" }));
+        ASSERT_EQ(table.routes.size(), 2u);
+        ASSERT_EQ(table.routes["10.1.0.0/24"], nexthop("1.1.1.1"));
+        ASSERT_EQ(coalescer.getUpdates(), 52u);
+        ASSERT_EQ(coalescer.getWrites(), 3u);
+        ASSERT_EQ(coalescer.getSuppressed(), 49u);
+        ASSERT_EQ(coalescer.getFlushes(), 1u);
+
+        // A deleted route set again keeps the delete to clear the old fields
+        coalescer.del("10.1.0.0/24");
+        coalescer.set("10.1.0.0/24", { { "blackhole", "true" } });
+        coalescer.flush(true);
+        ASSERT_EQ(table.routes["10.1.0.0/24"], vector<FieldValueTuple>({ { "blackhole", "true" } }));
+        ASSERT_EQ(table.ops.size(), 5u);
+        ASSERT_EQ(table.ops[3], "DEL 10.1.0.0/24");
+    }
+
+    TEST(RouteCoalescer, Bounds)
+    {
+        RouteTable table;
+        RouteCoalescer coalescer = table.coalescer();
+        coalescer.setWindow(milliseconds(10), 2);
+
+        // The batch size writes the pending updates right away
+        coalescer.set("10.0.0.0/24", nexthop("1.1.1.1"));
+        coalescer.set("10.0.0.0/24", nexthop("2.2.2.2"));
+        ASSERT_TRUE(table.ops.empty());
+        coalescer.set("10.1.0.0/24", nexthop("1.1.1.1"));
+        ASSERT_EQ(table.ops.size(), 2u);
+        ASSERT_EQ(coalescer.pending(), 0u);
+
+        // So does the window
+        coalescer.set("10.2.0.0/24", nexthop("1.1.1.1"));
+        this_thread::sleep_for(milliseconds(20));
+        coalescer.flush();
+        ASSERT_EQ(table.ops.size(), 3u);
+
+        // Disabling coalescing writes what is pending
+        coalescer.set("10.3.0.0/24", nexthop("1.1.1.1"));
+        coalescer.setWindow(milliseconds(0), 0);
+        ASSERT_EQ(table.ops.size(), 4u);
+        ASSERT_EQ(coalescer.getFlushes(), 3u);
+    }
+}
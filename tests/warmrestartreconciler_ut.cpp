@@ -0,0 +1,311 @@
+#include <algorithm>
+#include <chrono>
+#include <iostream>
+#include <map>
+#include <unordered_map>
+
+#include "gtest/gtest.h"
+#include "tokenize.h"
+#include "warmRestartReconciler.h"
+
+using namespace std;
+using namespace std::chrono;
+using namespace swss;
+
+namespace warmrestartreconciler_test
+{
+    struct AppTable
+    {
+        map<string, vector<FieldValueTuple>> entries;
+        vector<string> ops;
+
+        WarmStartReconciler reconciler()
+        {
+            return WarmStartReconciler(
+                [this](const string &key, const vector<FieldValueTuple> &fvs) {
+                    entries[key] = fvs;
+                    ops.push_back("SET " + key);
+                },
+                [this](const string &key) {
+                    entries.erase(key);
+                    ops.push_back("DEL " + key);
+                });
+        }
+    };
+
+    static vector<FieldValueTuple> route(const string &nexthop, const string &ifname)
+    {
+        return { { "nexthop", nexthop }, { "ifname", ifname } };
+    }
+
+    static string prefix(uint32_t i)
+    {
+        return "10." + to_string((i >> 16) & 0xff) + "." + to_string((i >> 8) & 0xff) + "." + to_string(i & 0xff) + "/32";
+    }
+
+    /* Reconciliation as it was done entry by entry, comparing the values of every field */
+    static bool compareOneFV(const string &s1, const string &s2)
+    {
+        if (s1.size() != s2.size())
+        {
+            return true;
+        }
+
+        vector<string> splitValuesS1 = tokenize(s1, ',');
+        vector<string> splitValuesS2 = tokenize(s2, ',');
+
+        sort(splitValuesS1.begin(), splitValuesS1.end());
+        sort(splitValuesS2.begin(), splitValuesS2.end());
+
+        return splitValuesS1 != splitValuesS2;
+    }
+
+    static bool compareAllFV(const vector<FieldValueTuple> &v1, const vector<FieldValueTuple> &v2)
+    {
+        unordered_map<string, string> v1Map(v1.begin(), v1.end());
+
+        for (auto &v2fv : v2)
+        {
+            if (compareOneFV(v1Map[fvField(v2fv)], fvValue(v2fv)))
+            {
+                return true;
+            }
+        }
+
+        return false;
+    }
+
+    static size_t reconcileEntryByEntry(const vector<KeyOpFieldsValuesTuple> &restored,
+                                        unordered_map<string, KeyOpFieldsValuesTuple> refreshMap)
+    {
+        size_t changes = 0;
+
+        for (auto &restoredElem : restored)
+        {
+            auto iter = refreshMap.find(kfvKey(restoredElem));
+            if (iter == refreshMap.end() || kfvOp(iter->second) == DEL_COMMAND ||
+                compareAllFV(kfvFieldsValues(restoredElem), kfvFieldsValues(iter->second)))
+            {
+                changes++;
+            }
+            if (iter != refreshMap.end())
+            {
+                refreshMap.erase(iter);
+            }
+        }
+
+        for (auto &kfv : refreshMap)
+        {
+            if (kfvOp(kfv.second) != DEL_COMMAND)
+            {
+                changes++;
+            }
+        }
+
+        return changes;
+    }
+
+    TEST(WarmStartReconciler, Fingerprint)
+    {
+        auto fp = WarmStartReconciler::fingerprint(route("10.1.1.1,10.1.1.2", "Ethernet0,Ethernet4"));
+
+        // Order of the fields and of the elements of the values doesn't matter
+        ASSERT_EQ(fp, WarmStartReconciler::fingerprint(route("10.1.1.2,10.1.1.1", "Ethernet4,Ethernet0")));
+        ASSERT_EQ(fp, WarmStartReconciler::fingerprint({ { "ifname", "Ethernet0,Ethernet4" }, { "nexthop", "10.1.1.1,10.1.1.2" } }));
+
+        ASSERT_NE(fp, WarmStartReconciler::fingerprint(route("10.1.1.1,10.1.1.3", "Ethernet0,Ethernet4")));
+        ASSERT_NE(fp, WarmStartReconciler::fingerprint(route("10.1.1.1,10.1.1.2,", "Ethernet0,Ethernet4")));
+        ASSERT_NE(fp, WarmStartReconciler::fingerprint(route("10.1.1.1", "Ethernet0,Ethernet4")));
+        ASSERT_NE(fp, WarmStartReconciler::fingerprint({ { "nexthop", "10.1.1.1,10.1.1.2" } }));
+
+        // Values are not mixed up with the fields or with each other
+        ASSERT_NE(WarmStartReconciler::fingerprint({ { "a", "bc" } }), WarmStartReconciler::fingerprint({ { "ab", "c" } }));
+        ASSERT_NE(WarmStartReconciler::fingerprint({ { "a", "b" }, { "c", "d" } }),
+                  WarmStartReconciler::fingerprint({ { "a", "d" }, { "c", "b" } }));
+
+        // Exact fingerprint only ignores the order of the fields
+        auto exact = WarmStartReconciler::exactFingerprint(route("10.1.1.1,10.1.1.2", "Ethernet0"));
+        ASSERT_EQ(exact, WarmStartReconciler::exactFingerprint({ { "ifname", "Ethernet0" }, { "nexthop", "10.1.1.1,10.1.1.2" } }));
+        ASSERT_NE(exact, WarmStartReconciler::exactFingerprint(route("10.1.1.2,10.1.1.1", "Ethernet0")));
+        ASSERT_NE(exact, WarmStartReconciler::exactFingerprint(route("10.1.1.1,10.1.1.2", "")));
+    }
+
+    TEST(WarmStartReconciler, Reconcile)
+    {
+        AppTable table;
+        WarmStartReconciler reconciler = table.reconciler();
+
+        reconciler.insertRestored("10.0.0.0/24", route("1.1.1.1", "Ethernet0"));
+        reconciler.insertRestored("10.1.0.0/24", route("1.1.1.1,2.2.2.2", "Ethernet0,Ethernet4"));
+        reconciler.insertRestored("10.2.0.0/24", route("1.1.1.1", "Ethernet0"));
+        reconciler.insertRestored("10.3.0.0/24", route("1.1.1.1", "Ethernet0"));
+        reconciler.insertRestored("10.4.0.0/24", route("1.1.1.1", "Ethernet0"));
+        reconciler.insertRestored("10.4.0.0/24", route("1.1.1.1", "Ethernet0"));
+        ASSERT_EQ(reconciler.restoredCount(), 5u);
+
+        reconciler.insertRefresh({ "10.0.0.0/24", SET_COMMAND, route("2.2.2.2", "Ethernet4") });
+        reconciler.insertRefresh({ "10.0.0.0/24", SET_COMMAND, route("1.1.1.1", "Ethernet0") });
+        reconciler.insertRefresh({ "10.1.0.0/24", SET_COMMAND, route("2.2.2.2,1.1.1.1", "Ethernet4,Ethernet0") });
+        reconciler.insertRefresh({ "10.2.0.0/24", SET_COMMAND, route("3.3.3.3", "Ethernet8") });
+        reconciler.insertRefresh({ "10.3.0.0/24", DEL_COMMAND, {} });
+        reconciler.insertRefresh({ "10.5.0.0/24", SET_COMMAND, route("1.1.1.1", "Ethernet0") });
+        reconciler.insertRefresh({ "10.6.0.0/24", SET_COMMAND, route("1.1.1.1", "Ethernet0") });
+        reconciler.insertRefresh({ "10.6.0.0/24", DEL_COMMAND, {} });
+        ASSERT_EQ(reconciler.refreshedCount(), 6u);
+
+        auto &stats = reconciler.reconcile();
+
+        // Restored entries first, then the new one
+        ASSERT_EQ(table.ops.size(), 4u);
+        ASSERT_EQ(table.ops.back(), "SET 10.5.0.0/24");
+        sort(table.ops.begin(), table.ops.end());
+        ASSERT_EQ(table.ops, vector<string>({ "DEL 10.3.0.0/24", "DEL 10.4.0.0/24", "SET 10.2.0.0/24", "SET 10.5.0.0/24" }));
+        ASSERT_EQ(table.entries["10.2.0.0/24"], route("3.3.3.3", "Ethernet8"));
+        ASSERT_EQ(table.entries["10.5.0.0/24"], route("1.1.1.1", "Ethernet0"));
+
+        ASSERT_EQ(stats.restored, 5u);
+        ASSERT_EQ(stats.refreshed, 6u);
+        ASSERT_EQ(stats.unchanged, 2u);
+        ASSERT_EQ(stats.updated, 1u);
+        ASSERT_EQ(stats.deleted, 1u);
+        ASSERT_EQ(stats.stale, 1u);
+        ASSERT_EQ(stats.added, 1u);
+        ASSERT_EQ(stats.discarded, 1u);
+        ASSERT_EQ(stats.threads, 1u);
+
+        reconciler.clear();
+        ASSERT_EQ(reconciler.restoredCount(), 0u);
+        ASSERT_EQ(reconciler.refreshedCount(), 0u);
+    }
+
+    TEST(WarmStartReconciler, Shards)
+    {
+        const uint32_t routes = 20000;
+
+        AppTable serialTable, shardedTable;
+        WarmStartReconciler serial = serialTable.reconciler();
+        WarmStartReconciler sharded = shardedTable.reconciler();
+        serial.setThreads(1);
+        sharded.setThreads(4);
+        sharded.setMinShardSize(1000);
+
+        for (uint32_t i = 0; i < routes; i++)
+        {
+            serial.insertRestored(prefix(i), route("1.1.1.1", "Ethernet0"));
+            sharded.insertRestored(prefix(i), route("1.1.1.1", "Ethernet0"));
+        }
+
+        for (uint32_t i = routes / 2; i < routes + routes / 2; i++)
+        {
+            KeyOpFieldsValuesTuple kfv { prefix(i), SET_COMMAND, route(i % 3 ? "1.1.1.1" : "2.2.2.2", "Ethernet0") };
+            if (i % 7 == 0)
+            {
+                kfvOp(kfv) = DEL_COMMAND;
+            }
+            serial.insertRefresh(kfv);
+            sharded.insertRefresh(kfv);
+        }
+
+        auto &serialStats = serial.reconcile();
+        auto &shardedStats = sharded.reconcile();
+
+        ASSERT_EQ(serialStats.threads, 1u);
+        ASSERT_EQ(shardedStats.threads, 4u);
+        ASSERT_EQ(shardedTable.ops.size(), serialTable.ops.size());
+        ASSERT_EQ(shardedTable.entries, serialTable.entries);
+
+        // Same writes, whatever the order of the shards
+        sort(serialTable.ops.begin(), serialTable.ops.end());
+        sort(shardedTable.ops.begin(), shardedTable.ops.end());
+        ASSERT_EQ(shardedTable.ops, serialTable.ops);
+
+        ASSERT_EQ(shardedStats.unchanged, serialStats.unchanged);
+        ASSERT_EQ(shardedStats.updated, serialStats.updated);
+        ASSERT_EQ(shardedStats.deleted, serialStats.deleted);
+        ASSERT_EQ(shardedStats.stale, routes / 2);
+        ASSERT_EQ(shardedStats.added, serialStats.added);
+        ASSERT_EQ(shardedStats.discarded, serialStats.discarded);
+    }
+
+    /*
+     * 1M routes restored after a BGP warm restart, of which 1% is updated, 1%
+     * withdrawn and 1% new, compared with the former entry by entry
+     * reconciliation.
+     * Run with --gtest_also_run_disabled_tests.
+     */
+    TEST(WarmStartReconciler, DISABLED_Benchmark)
+    {
+        const uint32_t routes = 1000000;
+
+        vector<KeyOpFieldsValuesTuple> restored;
+        unordered_map<string, KeyOpFieldsValuesTuple> refreshMap;
+        restored.reserve(routes);
+        refreshMap.reserve(routes);
+
+        for (uint32_t i = 0; i < routes; i++)
+        {
+            auto fvs = i % 4 ? route("10.255.0.1", "Ethernet0") : route("10.255.0.1,10.255.0.5", "Ethernet0,Ethernet4");
+            restored.push_back({ prefix(i), SET_COMMAND, fvs });
+
+            if (i % 100 == 1)
+            {
+                continue;
+            }
+            if (i % 100 == 2)
+            {
+                fvs = route("10.255.0.9", "Ethernet8");
+            }
+            else if (i % 4 == 0)
+            {
+                fvs = route("10.255.0.5,10.255.0.1", "Ethernet4,Ethernet0");
+            }
+            refreshMap[prefix(i)] = KeyOpFieldsValuesTuple { prefix(i), SET_COMMAND, fvs };
+        }
+        for (uint32_t i = routes; i < routes + routes / 100; i++)
+        {
+            refreshMap[prefix(i)] = KeyOpFieldsValuesTuple { prefix(i), SET_COMMAND, route("10.255.0.1", "Ethernet0") };
+        }
+
+        auto start = steady_clock::now();
+        size_t changes = reconcileEntryByEntry(restored, refreshMap);
+        auto entryByEntry = duration_cast<milliseconds>(steady_clock::now() - start).count();
+
+        ASSERT_EQ(changes, 3 * routes / 100);
+
+        for (uint32_t threads : { 1u, static_cast<uint32_t>(DEFAULT_RECONCILE_MAX_THREADS) })
+        {
+            size_t written = 0;
+            WarmStartReconciler reconciler(
+                [&written](const string &, const vector<FieldValueTuple> &) { written++; },
+                [&written](const string &) { written++; });
+            reconciler.setThreads(threads);
+
+            start = steady_clock::now();
+            for (auto &kfv : restored)
+            {
+                reconciler.insertRestored(kfvKey(kfv), kfvFieldsValues(kfv));
+            }
+            auto restore = duration_cast<milliseconds>(steady_clock::now() - start).count();
+
+            start = steady_clock::now();
+            for (auto &kfv : refreshMap)
+            {
+                reconciler.insertRefresh(kfv.second);
+            }
+            auto insert = duration_cast<milliseconds>(steady_clock::now() - start).count();
+
+            start = steady_clock::now();
+            auto &stats = reconciler.reconcile();
+            auto reconcile = duration_cast<milliseconds>(steady_clock::now() - start).count();
+
+            ASSERT_EQ(written, changes);
+            ASSERT_EQ(stats.updated, routes / 100);
+            ASSERT_EQ(stats.stale, routes / 100);
+            ASSERT_EQ(stats.added, routes / 100);
+
+            cout << routes << " routes, entry by entry " << entryByEntry << " ms, fingerprints with "
+                 << stats.threads << " threads " << reconcile << " ms (" << restore << " ms while restored, "
+                 << insert << " ms while refreshed)" << endl;
+        }
+    }
+}
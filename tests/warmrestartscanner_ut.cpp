@@ -0,0 +1,167 @@
+#include <chrono>
+#include <fstream>
+#include <iostream>
+#include <set>
+
+#include "gtest/gtest.h"
+#include "warmRestartReconciler.h"
+#include "warmRestartScanner.h"
+
+using namespace std;
+using namespace std::chrono;
+using namespace swss;
+
+namespace warmrestartscanner_test
+{
+    static string prefix(uint32_t i)
+    {
+        return "10." + to_string((i >> 16) & 0xff) + "." + to_string((i >> 8) & 0xff) + "." + to_string(i & 0xff) + "/32";
+    }
+
+    static vector<FieldValueTuple> route(uint32_t i)
+    {
+        return { { "nexthop", i % 4 ? "10.255.0.1" : "10.255.0.1,10.255.0.5" },
+                 { "ifname", i % 4 ? "Ethernet0" : "Ethernet0,Ethernet4" } };
+    }
+
+    /*
+     * Table of routes generated on the fly, scanned like Redis does: the cursor
+     * is the index of the next route, and the last route of every chunk is
+     * returned again at the beginning of the next one.
+     */
+    class RouteScanner : public WarmStartScanner
+    {
+      public:
+
+        RouteScanner(uint32_t routes, size_t chunkSize) :
+            WarmStartScanner(chunkSize),
+            m_routes(routes)
+        {
+        }
+
+      protected:
+
+        string scanChunk(const string &cursor, size_t count,
+                         vector<KeyOpFieldsValuesTuple> &entries) override
+        {
+            uint32_t begin = static_cast<uint32_t>(stoul(cursor));
+            uint32_t end = static_cast<uint32_t>(min(static_cast<size_t>(m_routes), begin + count));
+
+            for (uint32_t i = begin ? begin - 1 : 0; i < end; i++)
+            {
+                entries.emplace_back(prefix(i), SET_COMMAND, route(i));
+            }
+
+            return end == m_routes ? "0" : to_string(end);
+        }
+
+      private:
+
+        uint32_t m_routes;
+    };
+
+    /* Peak resident memory in kB, since the last reset */
+    static uint64_t peakRss()
+    {
+        ifstream status("/proc/self/status");
+        string line;
+
+        while (getline(status, line))
+        {
+            if (line.compare(0, 6, "VmHWM:") == 0)
+            {
+                return stoull(line.substr(6));
+            }
+        }
+
+        return 0;
+    }
+
+    static uint64_t currentRss()
+    {
+        ifstream status("/proc/self/status");
+        string line;
+
+        while (getline(status, line))
+        {
+            if (line.compare(0, 6, "VmRSS:") == 0)
+            {
+                return stoull(line.substr(6));
+            }
+        }
+
+        return 0;
+    }
+
+    static void resetPeakRss()
+    {
+        ofstream("/proc/self/clear_refs") << "5";
+    }
+
+    TEST(WarmStartScanner, Scan)
+    {
+        RouteScanner scanner(2500, 1000);
+        set<string> keys;
+
+        uint64_t count = scanner.scan([&keys](const string &key, const vector<FieldValueTuple> &fv) {
+            keys.insert(key);
+            ASSERT_EQ(fv.size(), 2u);
+        });
+
+        ASSERT_EQ(scanner.getChunks(), 3u);
+        ASSERT_EQ(count, 2502u);
+        ASSERT_EQ(keys.size(), 2500u);
+
+        RouteScanner empty(0, 1000);
+        ASSERT_EQ(empty.scan([](const string &, const vector<FieldValueTuple> &) { FAIL(); }), 0u);
+        ASSERT_EQ(empty.getChunks(), 1u);
+    }
+
+    /*
+     * Restoration of 1M routes streamed into the reconciler, compared with
+     * loading the whole table before inserting it, like Table::getContent().
+     * Run with --gtest_also_run_disabled_tests.
+     */
+    TEST(WarmStartScanner, DISABLED_Benchmark)
+    {
+        const uint32_t routes = 1000000;
+
+        WarmStartReconciler reconciler([](const string &, const vector<FieldValueTuple> &) {},
+                                       [](const string &) {});
+        RouteScanner scanner(routes, DEFAULT_WARM_START_SCAN_CHUNK);
+
+        uint64_t baseRss = currentRss();
+        resetPeakRss();
+
+        auto start = steady_clock::now();
+        scanner.scan([&reconciler](const string &key, const vector<FieldValueTuple> &fv) {
+            reconciler.insertRestored(key, fv);
+        });
+        auto streaming = duration_cast<milliseconds>(steady_clock::now() - start).count();
+        uint64_t streamingRss = peakRss();
+
+        ASSERT_EQ(reconciler.restoredCount(), routes);
+        reconciler.clear();
+
+        RouteScanner fullScanner(routes, routes);
+        vector<KeyOpFieldsValuesTuple> restored;
+        resetPeakRss();
+
+        start = steady_clock::now();
+        fullScanner.scan([&restored](const string &key, const vector<FieldValueTuple> &fv) {
+            restored.emplace_back(key, SET_COMMAND, fv);
+        });
+        for (auto &kfv : restored)
+        {
+            reconciler.insertRestored(kfvKey(kfv), kfvFieldsValues(kfv));
+        }
+        auto full = duration_cast<milliseconds>(steady_clock::now() - start).count();
+        uint64_t fullRss = peakRss();
+
+        ASSERT_EQ(reconciler.restoredCount(), routes);
+
+        cout << routes << " routes restored, streaming " << streaming << " ms, peak RSS "
+             << (streamingRss - baseRss) / 1024 << " MB above start, full load " << full
+             << " ms, peak RSS " << (fullRss - baseRss) / 1024 << " MB above start" << endl;
+    }
+}
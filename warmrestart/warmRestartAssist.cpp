@@ -1,9 +1,12 @@
 #include <string>
 #include <algorithm>
+#include <inttypes.h>
 #include "logger.h"
 #include "schema.h"
 #include "warm_restart.h"
 #include "warmRestartAssist.h"
+#include "warmRestartReconciler.h"
+#include "warmRestartScanner.h"
 
 using namespace std;
 using namespace swss;
@@ -127,41 +130,60 @@ void AppRestartAssist::warmStartDisabled()
     WarmStart::setWarmStartState(m_appName, WarmStart::WSDISABLED);
 }
 
-// Read table(s) from APPDB and append stale flag then insert to cachemap
+// Read table(s) from APPDB a chunk at a time and keep the fingerprint of each entry
 void AppRestartAssist::readTablesToMap()
 {
-    vector<string> keys;
-
     for (auto it = m_appTables.begin(); it != m_appTables.end(); it++)
     {
-        (it->second)->getKeys(keys);
-        FieldValueTuple state(CACHE_STATE_FIELD, "");
+        auto &restoredMap = appTableRestoredMap[it->first];
+        RedisTableScanner scanner(m_pipeLine, *(it->second));
 
-        for (const auto &key: keys)
-        {
-            vector<FieldValueTuple> fv;
+        scanner.scan([&restoredMap](const string &key, const vector<FieldValueTuple> &fv) {
+            restoredMap[key] = WarmStartReconciler::exactFingerprint(fv);
+        });
 
-                // if the fieldvalue is empty, skip
-            if (!(it->second)->get(key, fv))
-            {
-                continue;
-            }
-
-            fv.push_back(state);
-            setCacheEntryState(fv, STALE);
+        WarmStart::setWarmStartState(m_appName, WarmStart::RESTORED);
+        SWSS_LOG_NOTICE("Restored appDB table %s, %zu entries in %" PRIu64 " chunks",
+                        (it->first).c_str(), restoredMap.size(), scanner.getChunks());
+    }
+    return;
+}
 
-            string s = joinVectorString(fv);
+/*
+ * Move a restored entry to the cache map, with STALE flag, when it's received
+ * for the first time.
+ * If the received value is the same as the restored one, as told by their
+ * fingerprints, it's cached as is. Otherwise the restored value is read from
+ * appDB, to be checked against the received one.
+ */
+void AppRestartAssist::loadRestoredEntry(const string &tableName, const string &key,
+                                         const vector<FieldValueTuple> &fvVector, bool delete_key)
+{
+    auto &restoredMap = appTableRestoredMap[tableName];
+    auto restored = restoredMap.find(key);
 
-            SWSS_LOG_INFO("write to cachemap: %s, key: %s, "
-                   "%s", (it->first).c_str(), key.c_str(), s.c_str());
+    if (restored == restoredMap.end())
+    {
+        return;
+    }
 
-            // insert to the cache map
-            appTableCacheMap[it->first][key] = fv;
-        }
-        WarmStart::setWarmStartState(m_appName, WarmStart::RESTORED);
-        SWSS_LOG_NOTICE("Restored appDB table to %s internal cache map", (it->first).c_str());
+    vector<FieldValueTuple> fv;
+    if (!delete_key && restored->second == WarmStartReconciler::exactFingerprint(fvVector))
+    {
+        fv = fvVector;
     }
-    return;
+    else if (!m_appTables[tableName]->get(key, fv))
+    {
+        restoredMap.erase(restored);
+        return;
+    }
+
+    FieldValueTuple state(CACHE_STATE_FIELD, "");
+    fv.push_back(state);
+    setCacheEntryState(fv, STALE);
+    appTableCacheMap[tableName][key] = fv;
+
+    restoredMap.erase(restored);
 }
 
 /*
@@ -181,6 +203,8 @@ void AppRestartAssist::insertToMap(string tableName, string key, vector<FieldVal
     SWSS_LOG_INFO("Received message %s, key: %s, "
             "%s, delete = %d", tableName.c_str(), key.c_str(), joinVectorString(fvVector).c_str(), delete_key);
 
+    loadRestoredEntry(tableName, key, fvVector, delete_key);
+
     auto found = appTableCacheMap[tableName].find(key);
 
     if (delete_key)
@@ -279,6 +303,20 @@ void AppRestartAssist::reconcile()
         appTableCacheMap[tableName].clear();
     }
     appTableCacheMap.clear();
+
+    // restored entries never received are STALE
+    for (auto tableIter = appTableRestoredMap.begin(); tableIter != appTableRestoredMap.end(); ++tableIter)
+    {
+        tableName = tableIter->first;
+        for (auto it = (tableIter->second).begin(); it != (tableIter->second).end(); ++it)
+        {
+            SWSS_LOG_NOTICE("%s STALE, key: %s", tableName.c_str(), it->first.c_str());
+
+            //delete from appDB
+            m_psTables[tableName]->del(it->first);
+        }
+    }
+    appTableRestoredMap.clear();
     WarmStart::setWarmStartState(m_appName, WarmStart::RECONCILED);
     m_warmStartInProgress = false;
     return;
@@ -103,10 +103,18 @@ private:
      */
     static const uint32_t DEFAULT_INTERNAL_TIMER_VALUE = 5;
     typedef std::map<std::string, std::unordered_map<std::string, std::vector<swss::FieldValueTuple>>> AppTableMap;
+    typedef std::map<std::string, std::unordered_map<std::string, uint64_t>> AppTableFingerprintMap;
 
     // cache map to store temporary application table
     AppTableMap appTableCacheMap;
 
+    /*
+     * fingerprints of the restored entries not received yet from the application
+     * an entry is moved to the cache map once received, the full field-values
+     * being read from appDB only if they can differ from the received ones
+     */
+    AppTableFingerprintMap appTableRestoredMap;
+
     RedisPipeline      *m_pipeLine;
     Tables              m_appTables;  // app tables
     std::string         m_dockerName; // docker name of the application
@@ -121,6 +129,8 @@ private:
     std::string joinVectorString(const std::vector<FieldValueTuple> &fv);
     void setCacheEntryState(std::vector<FieldValueTuple> &fvVector, cache_state_t state);
     cache_state_t getCacheEntryState(const std::vector<FieldValueTuple> &fvVector);
+    void loadRestoredEntry(const std::string &tableName, const std::string &key,
+                           const std::vector<FieldValueTuple> &fvVector, bool delete_key);
     bool contains(const std::vector<FieldValueTuple>& left,
                   const std::vector<FieldValueTuple>& right);
 };
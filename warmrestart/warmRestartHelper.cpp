@@ -1,4 +1,6 @@
 #include <cassert>
+#include <chrono>
+#include <inttypes.h>
 #include <sstream>
 
 #include "warmRestartHelper.h"
@@ -14,6 +16,13 @@ WarmStartHelper::WarmStartHelper(RedisPipeline      *pipeline,
                                  const std::string  &appName) :
     m_restorationTable(pipeline, syncTableName, false),
     m_syncTable(syncTable),
+    m_scanner(pipeline, m_restorationTable),
+    m_reconciler([syncTable](const std::string &key, const std::vector<FieldValueTuple> &fv) {
+                     syncTable->set(key, fv);
+                 },
+                 [syncTable](const std::string &key) {
+                     syncTable->del(key);
+                 }),
     m_syncTableName(syncTableName),
     m_dockName(dockerName),
     m_appName(appName)
@@ -65,8 +74,7 @@ bool WarmStartHelper::checkAndStart(void)
     }
 
     /* Cleaning state from previous (unsuccessful) warm-restart attempts */
-    m_restorationVector.clear();
-    m_refreshMap.clear();
+    m_reconciler.clear();
 
     /* Keeping track of warm-reboot active/inactive state */
     m_enabled = enabled;
@@ -98,19 +106,30 @@ uint32_t WarmStartHelper::getRestartTimer(void) const
  * are expected to call this method to upload their associated redisDB state into
  * a temporary buffer, which will eventually serve to resolve any conflict between
  * 'old' and 'new' state.
+ *
+ * The state is read a chunk at a time and only the fingerprint of each entry is
+ * kept, which is all the reconciliation needs from the 'old' state.
  */
 bool WarmStartHelper::runRestoration()
 {
     SWSS_LOG_NOTICE("Warm-Restart: Initiating AppDB restoration process for %s "
                     "application.", m_appName.c_str());
 
-    m_restorationTable.getContent(m_restorationVector);
+    auto start = std::chrono::steady_clock::now();
+    uint64_t chunks = m_scanner.getChunks();
+
+    m_scanner.scan([this](const std::string &key, const std::vector<FieldValueTuple> &fv) {
+        m_reconciler.insertRestored(key, fv);
+    });
+
+    auto elapsed = std::chrono::duration_cast<std::chrono::milliseconds>(
+                       std::chrono::steady_clock::now() - start);
 
     /*
      * If there's no AppDB state to restore, then alert callee right away to avoid
      * iterating through the 'reconciliation' process.
      */
-    if (!m_restorationVector.size())
+    if (!m_reconciler.restoredCount())
     {
         SWSS_LOG_NOTICE("Warm-Restart: No records received from AppDB for %s "
                         "application.", m_appName.c_str());
@@ -121,9 +140,11 @@ bool WarmStartHelper::runRestoration()
     }
 
     SWSS_LOG_NOTICE("Warm-Restart: Received %zu records from AppDB for %s "
-                    "application.",
-                    m_restorationVector.size(),
-                    m_appName.c_str());
+                    "application, in %" PRIu64 " chunks and %" PRId64 " ms.",
+                    m_reconciler.restoredCount(),
+                    m_appName.c_str(),
+                    m_scanner.getChunks() - chunks,
+                    static_cast<int64_t>(elapsed.count()));
 
     setState(WarmStart::RESTORED);
 
@@ -136,9 +157,7 @@ bool WarmStartHelper::runRestoration()
 
 void WarmStartHelper::insertRefreshMap(const KeyOpFieldsValuesTuple &kfv)
 {
-    const std::string key = kfvKey(kfv);
-
-    m_refreshMap[key] = kfv;
+    m_reconciler.insertRefresh(kfv);
 }
 
 
@@ -148,6 +167,11 @@ void WarmStartHelper::insertRefreshMap(const KeyOpFieldsValuesTuple &kfv)
  * generated by the application once it completes its restart cycle. If a
  * state-diff is found between these two, we will be honoring the refreshed
  * one received from the application, and will proceed to push it down to AppDB.
+ *
+ * Restored elements not refreshed, or explicitly deleted, by the application
+ * are deleted from AppDB, refreshed elements not found among the restored ones
+ * are introduced. Only these changes are pushed, the unchanged elements aren't
+ * touched.
  */
 void WarmStartHelper::reconcile(void)
 {
@@ -156,102 +180,23 @@ void WarmStartHelper::reconcile(void)
 
     assert(getState() == WarmStart::RESTORED);
 
-    for (auto &restoredElem : m_restorationVector)
-    {
-        std::string restoredKey  = kfvKey(restoredElem);
-        auto restoredFV          = kfvFieldsValues(restoredElem);
+    auto start = std::chrono::steady_clock::now();
 
-        auto iter = m_refreshMap.find(restoredKey);
+    auto &stats = m_reconciler.reconcile();
 
-        /*
-         * If the restored element is not found in the refreshMap, we must
-         * push a delete operation for this entry.
-         */
-        if (iter == m_refreshMap.end())
-        {
-            SWSS_LOG_NOTICE("Warm-Restart reconciliation: deleting stale entry %s",
-                            printKFV(restoredKey, restoredFV).c_str());
+    auto elapsed = std::chrono::duration_cast<std::chrono::milliseconds>(
+                       std::chrono::steady_clock::now() - start);
 
-            m_syncTable->del(restoredKey);
-            continue;
-        }
+    SWSS_LOG_NOTICE("Warm-Restart reconciliation: %" PRIu64 " restored and %" PRIu64
+                    " refreshed entries, %" PRIu64 " unchanged, %" PRIu64 " updated, %"
+                    PRIu64 " stale deleted, %" PRIu64 " deleted, %" PRIu64 " new, %"
+                    PRIu64 " non-existing discarded, in %" PRId64 " ms with %u threads",
+                    stats.restored, stats.refreshed, stats.unchanged, stats.updated,
+                    stats.stale, stats.deleted, stats.added, stats.discarded,
+                    static_cast<int64_t>(elapsed.count()), stats.threads);
 
-        /*
-         * If an explicit delete request is sent by the application, process it
-         * right away.
-         */
-        else if (kfvOp(iter->second) == DEL_COMMAND)
-        {
-            SWSS_LOG_NOTICE("Warm-Restart reconciliation: deleting entry %s",
-                            printKFV(restoredKey, restoredFV).c_str());
-
-            m_syncTable->del(restoredKey);
-        }
-
-        /*
-         * If a matching entry is found in refreshMap, proceed to compare it
-         * with its restored counterpart.
-         */
-        else
-        {
-            auto refreshedKey = kfvKey(iter->second);
-            auto refreshedFV  = kfvFieldsValues(iter->second);
-
-            if (compareAllFV(restoredFV, refreshedFV))
-            {
-                SWSS_LOG_NOTICE("Warm-Restart reconciliation: updating entry %s",
-                                printKFV(refreshedKey, refreshedFV).c_str());
-
-                m_syncTable->set(refreshedKey, refreshedFV);
-            }
-            else
-            {
-                SWSS_LOG_INFO("Warm-Restart reconciliation: no changes needed for "
-                              "existing entry %s",
-                              printKFV(refreshedKey, refreshedFV).c_str());
-            }
-        }
-
-        /* Deleting the just-processed restored entry from the refreshMap */
-        m_refreshMap.erase(restoredKey);
-    }
-
-    /*
-     * Iterate through all the entries left in the refreshMap, which correspond
-     * to brand-new entries to be pushed down to AppDB.
-     */
-    for (auto &kfv : m_refreshMap)
-    {
-        auto refreshedKey = kfvKey(kfv.second);
-        auto refreshedOp  = kfvOp(kfv.second);
-        auto refreshedFV  = kfvFieldsValues(kfv.second);
-
-        /*
-         * During warm-reboot, apps could receive an 'add' and a 'delete' for an
-         * entry that does not exist in AppDB. In these cases we must prevent the
-         * 'delete' from being pushed down to AppDB, so we are handling this case
-         * differently than the 'add' one.
-         */
-        if(refreshedOp == DEL_COMMAND)
-        {
-            SWSS_LOG_NOTICE("Warm-Restart reconciliation: discarding non-existing"
-                            " entry %s\n",
-                            refreshedKey.c_str());
-        }
-        else
-        {
-            SWSS_LOG_NOTICE("Warm-Restart reconciliation: introducing new entry %s",
-                            printKFV(refreshedKey, refreshedFV).c_str());
-
-            m_syncTable->set(refreshedKey, refreshedFV);
-        }
-    }
-
-    /* Clearing pending kfv's from refreshMap */
-    m_refreshMap.clear();
-
-    /* Clearing restoration vector */
-    m_restorationVector.clear();
+    /* Clearing restored and pending refreshed state */
+    m_reconciler.clear();
 
     setState(WarmStart::RECONCILED);
 
@@ -260,94 +205,6 @@ void WarmStartHelper::reconcile(void)
 }
 
 
-/*
- * Compare all field-value-tuples within two vectors.
- *
- * Example: v1 {nexthop: 10.1.1.1, ifname: eth1}
- *          v2 {nexthop: 10.1.1.2, ifname: eth2}
- *
- * Returns:
- *
- *    'false' : If the content of both 'fields' and 'values' fully match
- *    'true'  : No full-match is found
- */
-bool WarmStartHelper::compareAllFV(const std::vector<FieldValueTuple> &v1,
-                                   const std::vector<FieldValueTuple> &v2)
-{
-    std::unordered_map<std::string, std::string> v1Map((v1.begin()), v1.end());
-
-     /* Iterate though all v2 tuples to check if their content match v1 ones */
-    for (auto &v2fv : v2)
-    {
-        auto v1Iter = v1Map.find(v2fv.first);
-        /*
-         * The sizes of both tuple-vectors should always match within any
-         * given application. In other words, all fields within v1 should be
-         * also present in v2.
-         *
-         * To make this possible, every application should continue relying on a
-         * uniform schema to create/generate information. For example, fpmsyncd
-         * will be always expected to push FieldValueTuples with "nexthop" and
-         * "ifname" fields; neighsyncd is expected to make use of "family" and
-         * "neigh" fields, etc. The existing reconciliation logic will rely on
-         * this assumption.
-         */
-        assert(v1Iter != v1Map.end());
-
-        if (compareOneFV(v1Map[fvField(*v1Iter)], fvValue(v2fv)))
-        {
-            return true;
-        }
-    }
-
-    return false;
-}
-
-
-/*
- * Compare the values of a single field-value within two different KFVs.
- *
- * Example: s1 {nexthop: 10.1.1.1, 10.1.1.2}
- *          s2 {nexthop: 10.1.1.2, 10.1.1.1}
- *
- * Example: s1 {Ethernet1, Ethernet2}
- *          s2 {Ethernet2, Ethernet1}
- *
- * Returns:
- *
- *    'false' : If the content of both strings fully matches
- *    'true'  : No full-match is found
- */
-bool WarmStartHelper::compareOneFV(const std::string &s1, const std::string &s2)
-{
-    if (s1.size() != s2.size())
-    {
-        return true;
-    }
-
-    std::vector<std::string> splitValuesS1 = tokenize(s1, ',');
-    std::vector<std::string> splitValuesS2 = tokenize(s2, ',');
-
-    if (splitValuesS1.size() != splitValuesS2.size())
-    {
-        return true;
-    }
-
-    std::sort(splitValuesS1.begin(), splitValuesS1.end());
-    std::sort(splitValuesS2.begin(), splitValuesS2.end());
-
-    for (size_t i = 0; i < splitValuesS1.size(); i++)
-    {
-        if (splitValuesS1[i] != splitValuesS2[i])
-        {
-            return true;
-        }
-    }
-
-    return false;
-}
-
-
 /*
  * Helper method to print KFVs in a friendly fashion.
  *
@@ -0,0 +1,333 @@
+#include <algorithm>
+#include <thread>
+
+#include "warmRestartReconciler.h"
+
+
+using namespace swss;
+
+
+namespace {
+
+const uint64_t FNV_OFFSET_BASIS = UINT64_C(14695981039346656037);
+const uint64_t FNV_PRIME        = UINT64_C(1099511628211);
+
+
+uint64_t hashBytes(uint64_t hash, const char *data, size_t size)
+{
+    for (size_t i = 0; i < size; i++)
+    {
+        hash ^= static_cast<unsigned char>(data[i]);
+        hash *= FNV_PRIME;
+    }
+
+    return hash;
+}
+
+
+uint64_t hashSize(uint64_t hash, uint64_t size)
+{
+    return hashBytes(hash, reinterpret_cast<const char *>(&size), sizeof(size));
+}
+
+
+uint64_t hashString(uint64_t hash, const std::string &s)
+{
+    return hashBytes(hashSize(hash, s.size()), s.data(), s.size());
+}
+
+
+/* Finalizer of splitmix64, spreading the bits of the per-field hashes before they are summed */
+uint64_t mix(uint64_t hash)
+{
+    hash ^= hash >> 30;
+    hash *= UINT64_C(0xbf58476d1ce4e5b9);
+    hash ^= hash >> 27;
+    hash *= UINT64_C(0x94d049bb133111eb);
+    hash ^= hash >> 31;
+
+    return hash;
+}
+
+
+/*
+ * Split the buckets of a hash table in shards and run fn(shard, begin, end)
+ * for each of them, the first one on the calling thread
+ */
+template <typename F>
+void runShards(uint32_t shards, size_t buckets, const F &fn)
+{
+    std::vector<std::thread> threads;
+    size_t perShard = (buckets + shards - 1) / shards;
+
+    auto runShard = [&](uint32_t shard) {
+        size_t begin = std::min(buckets, shard * perShard);
+        size_t end = std::min(buckets, begin + perShard);
+
+        fn(shard, begin, end);
+    };
+
+    for (uint32_t i = 1; i < shards; i++)
+    {
+        threads.emplace_back(runShard, i);
+    }
+
+    runShard(0);
+
+    for (auto &thread : threads)
+    {
+        thread.join();
+    }
+}
+
+}
+
+
+WarmStartReconciler::WarmStartReconciler(SetFn setFn, DelFn delFn) :
+    m_setFn(setFn),
+    m_delFn(delFn),
+    m_threads(std::max(1u, std::min(std::thread::hardware_concurrency(),
+                                    static_cast<unsigned>(DEFAULT_RECONCILE_MAX_THREADS)))),
+    m_minShardSize(DEFAULT_RECONCILE_MIN_SHARD),
+    m_stats()
+{
+}
+
+
+void WarmStartReconciler::setThreads(uint32_t threads)
+{
+    m_threads = std::max(1u, threads);
+}
+
+
+void WarmStartReconciler::setMinShardSize(size_t size)
+{
+    m_minShardSize = std::max(static_cast<size_t>(1), size);
+}
+
+
+void WarmStartReconciler::insertRestored(const std::string &key, const std::vector<FieldValueTuple> &fv)
+{
+    m_restoredMap[key] = fingerprint(fv);
+}
+
+
+void WarmStartReconciler::insertRefresh(const KeyOpFieldsValuesTuple &kfv)
+{
+    RefreshedEntry &entry = m_refreshMap[kfvKey(kfv)];
+
+    entry.del         = (kfvOp(kfv) == DEL_COMMAND);
+    entry.matched     = false;
+    entry.fv          = kfvFieldsValues(kfv);
+    entry.fingerprint = entry.del ? 0 : fingerprint(entry.fv);
+}
+
+
+size_t WarmStartReconciler::restoredCount(void) const
+{
+    return m_restoredMap.size();
+}
+
+
+size_t WarmStartReconciler::refreshedCount(void) const
+{
+    return m_refreshMap.size();
+}
+
+
+void WarmStartReconciler::clear(void)
+{
+    m_restoredMap.clear();
+    m_refreshMap.clear();
+}
+
+
+/*
+ * Fingerprint of a field-value vector.
+ *
+ * Each field is hashed along with its value. The hashes of the elements of a
+ * comma-separated value are summed, so their order doesn't matter, and so are
+ * the per-field hashes, so the order of the fields doesn't matter either. The
+ * length of the value is hashed too, like the former string comparison did,
+ * so "a,b" doesn't match "a,b,".
+ */
+uint64_t WarmStartReconciler::fingerprint(const std::vector<FieldValueTuple> &fv)
+{
+    uint64_t sum = 0;
+
+    for (auto &elem : fv)
+    {
+        const std::string &value = fvValue(elem);
+
+        uint64_t hash = hashSize(hashString(FNV_OFFSET_BASIS, fvField(elem)), value.size());
+        uint64_t elements = 0;
+
+        for (size_t begin = 0, end; begin <= value.size(); begin = end + 1)
+        {
+            end = value.find(',', begin);
+            if (end == std::string::npos)
+            {
+                end = value.size();
+            }
+
+            elements += mix(hashBytes(hash, value.data() + begin, end - begin));
+        }
+
+        sum += mix(hash + elements);
+    }
+
+    return mix(sum + fv.size());
+}
+
+
+uint64_t WarmStartReconciler::exactFingerprint(const std::vector<FieldValueTuple> &fv)
+{
+    uint64_t sum = 0;
+
+    for (auto &elem : fv)
+    {
+        sum += mix(hashString(hashString(FNV_OFFSET_BASIS, fvField(elem)), fvValue(elem)));
+    }
+
+    return mix(sum + fv.size());
+}
+
+
+uint32_t WarmStartReconciler::getShards(size_t items) const
+{
+    size_t shards = std::max(static_cast<size_t>(1), items / m_minShardSize);
+
+    return static_cast<uint32_t>(std::min(shards, static_cast<size_t>(m_threads)));
+}
+
+
+/*
+ * Diff the restored entries in buckets [beginBucket, endBucket) with their
+ * refreshed counterparts.
+ *
+ * The shards of restored entries are disjoint and their keys unique, so every
+ * refreshed entry is looked up, and flagged as matched, by one thread at most.
+ */
+void WarmStartReconciler::diffRestored(size_t beginBucket, size_t endBucket,
+                                       std::vector<Change> &changes, Stats &stats)
+{
+    for (size_t bucket = beginBucket; bucket < endBucket; bucket++)
+    {
+        for (auto restored = m_restoredMap.cbegin(bucket); restored != m_restoredMap.cend(bucket); ++restored)
+        {
+            auto iter = m_refreshMap.find(restored->first);
+
+            /* Not refreshed by the application, the entry is stale */
+            if (iter == m_refreshMap.end())
+            {
+                changes.push_back({ &restored->first, nullptr });
+                stats.stale++;
+                continue;
+            }
+
+            RefreshedEntry &entry = iter->second;
+            entry.matched = true;
+
+            if (entry.del)
+            {
+                changes.push_back({ &restored->first, nullptr });
+                stats.deleted++;
+            }
+            else if (restored->second != entry.fingerprint)
+            {
+                changes.push_back({ &iter->first, &entry.fv });
+                stats.updated++;
+            }
+            else
+            {
+                stats.unchanged++;
+            }
+        }
+    }
+}
+
+
+/*
+ * Collect the refreshed entries in buckets [beginBucket, endBucket) which
+ * didn't match any restored entry.
+ *
+ * During warm-reboot, apps could receive an 'add' and a 'delete' for an entry
+ * that does not exist in AppDB. The 'delete' must not be pushed down to AppDB.
+ */
+void WarmStartReconciler::collectAdded(size_t beginBucket, size_t endBucket,
+                                       std::vector<Change> &changes, Stats &stats)
+{
+    for (size_t bucket = beginBucket; bucket < endBucket; bucket++)
+    {
+        for (auto iter = m_refreshMap.cbegin(bucket); iter != m_refreshMap.cend(bucket); ++iter)
+        {
+            const RefreshedEntry &entry = iter->second;
+
+            if (entry.matched)
+            {
+                continue;
+            }
+
+            if (entry.del)
+            {
+                stats.discarded++;
+            }
+            else
+            {
+                changes.push_back({ &iter->first, &entry.fv });
+                stats.added++;
+            }
+        }
+    }
+}
+
+
+const WarmStartReconciler::Stats &WarmStartReconciler::reconcile(void)
+{
+    uint32_t restoredShards = getShards(m_restoredMap.size());
+    uint32_t refreshedShards = getShards(m_refreshMap.size());
+
+    std::vector<std::vector<Change>> changes(restoredShards + refreshedShards);
+    std::vector<Stats> stats(restoredShards + refreshedShards, Stats());
+
+    runShards(restoredShards, m_restoredMap.bucket_count(), [&](uint32_t shard, size_t begin, size_t end) {
+        diffRestored(begin, end, changes[shard], stats[shard]);
+    });
+
+    runShards(refreshedShards, m_refreshMap.bucket_count(), [&](uint32_t shard, size_t begin, size_t end) {
+        collectAdded(begin, end, changes[restoredShards + shard], stats[restoredShards + shard]);
+    });
+
+    m_stats = Stats();
+    m_stats.restored = m_restoredMap.size();
+    m_stats.refreshed = m_refreshMap.size();
+    m_stats.threads = std::max(restoredShards, refreshedShards);
+
+    for (auto &shardStats : stats)
+    {
+        m_stats.unchanged += shardStats.unchanged;
+        m_stats.updated   += shardStats.updated;
+        m_stats.stale     += shardStats.stale;
+        m_stats.deleted   += shardStats.deleted;
+        m_stats.added     += shardStats.added;
+        m_stats.discarded += shardStats.discarded;
+    }
+
+    /* Restored entries first, then the new ones */
+    for (auto &shardChanges : changes)
+    {
+        for (auto &change : shardChanges)
+        {
+            if (change.fv)
+            {
+                m_setFn(*change.key, *change.fv);
+            }
+            else
+            {
+                m_delFn(*change.key);
+            }
+        }
+    }
+
+    return m_stats;
+}
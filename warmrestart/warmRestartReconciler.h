@@ -0,0 +1,123 @@
+#ifndef __WARMRESTART_RECONCILER__
+#define __WARMRESTART_RECONCILER__
+
+
+#include <stdint.h>
+#include <functional>
+#include <string>
+#include <unordered_map>
+#include <vector>
+
+#include "table.h"
+
+
+/* Default bounds of the threads diffing the restored and refreshed entries */
+#define DEFAULT_RECONCILE_MAX_THREADS   8
+#define DEFAULT_RECONCILE_MIN_SHARD     16384
+
+
+namespace swss {
+
+
+/*
+ * Reconciliation of the state restored from AppDB with the state refreshed by
+ * a restarting application.
+ *
+ * Field-values are compared through a 64-bit fingerprint computed once per
+ * entry, when it's inserted. Only the fingerprint of a restored entry is kept,
+ * its field-values are never needed again: a restored entry is either left
+ * untouched, deleted, or overwritten with the refreshed field-values. The
+ * fingerprint doesn't depend on the order of the fields nor on the order of
+ * the elements of comma-separated values, so "nexthop: 10.1.1.1,10.1.1.2"
+ * matches "nexthop: 10.1.1.2,10.1.1.1".
+ *
+ * The restored entries are split in shards of hash buckets diffed by separate
+ * threads, after which the refreshed entries not matching any restored one
+ * are collected in the same way. Only the changed entries are then written,
+ * back-to-back, through the set/del functions: first the changes of the
+ * restored entries, then the new entries, each in the hash bucket order of
+ * their map and not in the order they were inserted.
+ */
+class WarmStartReconciler {
+  public:
+
+    typedef std::function<void(const std::string &,
+                               const std::vector<FieldValueTuple> &)> SetFn;
+    typedef std::function<void(const std::string &)> DelFn;
+
+    struct Stats {
+        uint64_t restored;
+        uint64_t refreshed;
+        uint64_t unchanged;
+        uint64_t updated;      // restored entries refreshed with other values
+        uint64_t stale;        // restored entries not refreshed, deleted
+        uint64_t deleted;      // restored entries explicitly deleted
+        uint64_t added;        // refreshed entries not restored
+        uint64_t discarded;    // deletes of entries not restored
+        uint32_t threads;
+    };
+
+    WarmStartReconciler(SetFn setFn, DelFn delFn);
+
+    /* Maximum number of threads, one meaning no thread is spawned */
+    void setThreads(uint32_t threads);
+
+    /* Shards smaller than this are merged, to not spawn a thread for a few entries */
+    void setMinShardSize(size_t size);
+
+    void insertRestored(const std::string &key, const std::vector<FieldValueTuple> &fv);
+
+    void insertRefresh(const KeyOpFieldsValuesTuple &kfv);
+
+    size_t restoredCount(void) const;
+
+    size_t refreshedCount(void) const;
+
+    /* Diff the restored entries with the refreshed ones and write the changes */
+    const Stats &reconcile(void);
+
+    void clear(void);
+
+    static uint64_t fingerprint(const std::vector<FieldValueTuple> &fv);
+
+    /* Fingerprint of the exact field-values, in any order of the fields */
+    static uint64_t exactFingerprint(const std::vector<FieldValueTuple> &fv);
+
+  private:
+
+    struct RefreshedEntry {
+        bool                         del;
+        bool                         matched;
+        uint64_t                     fingerprint;
+        std::vector<FieldValueTuple> fv;
+    };
+
+    struct Change {
+        const std::string                  *key;
+        const std::vector<FieldValueTuple> *fv;  // nullptr for a delete
+    };
+
+    using restoredMap = std::unordered_map<std::string, uint64_t>;
+    using refreshMap  = std::unordered_map<std::string, RefreshedEntry>;
+
+    void diffRestored(size_t beginBucket, size_t endBucket,
+                      std::vector<Change> &changes, Stats &stats);
+
+    void collectAdded(size_t beginBucket, size_t endBucket,
+                      std::vector<Change> &changes, Stats &stats);
+
+    uint32_t getShards(size_t items) const;
+
+    SetFn       m_setFn;
+    DelFn       m_delFn;
+    uint32_t    m_threads;
+    size_t      m_minShardSize;
+    restoredMap m_restoredMap;  // fingerprints of the state restored from AppDB, by key
+    refreshMap  m_refreshMap;   // state refreshed by the application, by key
+    Stats       m_stats;
+};
+
+
+}
+
+#endif
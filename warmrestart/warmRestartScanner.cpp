@@ -0,0 +1,106 @@
+#include <stdexcept>
+
+#include "rediscommand.h"
+#include "redispipeline.h"
+#include "redisreply.h"
+#include "warmRestartScanner.h"
+
+
+using namespace swss;
+
+
+/*
+ * ARGV[1]: cursor, ARGV[2]: pattern of the keys, ARGV[3]: number of keys to scan
+ * Returns the next cursor followed by each key of the chunk and its field-values
+ */
+static const std::string scanChunkScript =
+    "local result = redis.call('SCAN', ARGV[1], 'MATCH', ARGV[2], 'COUNT', ARGV[3])\n"
+    "local entries = { result[1] }\n"
+    "for _, key in ipairs(result[2]) do\n"
+    "    if redis.call('TYPE', key).ok == 'hash' then\n"
+    "        entries[#entries + 1] = key\n"
+    "        entries[#entries + 1] = redis.call('HGETALL', key)\n"
+    "    end\n"
+    "end\n"
+    "return entries\n";
+
+
+WarmStartScanner::WarmStartScanner(size_t chunkSize) :
+    m_chunkSize(chunkSize),
+    m_chunks(0)
+{
+}
+
+
+uint64_t WarmStartScanner::scan(const EntryFn &fn)
+{
+    std::vector<KeyOpFieldsValuesTuple> entries;
+    std::string cursor = "0";
+    uint64_t count = 0;
+
+    do
+    {
+        entries.clear();
+        cursor = scanChunk(cursor, m_chunkSize, entries);
+        m_chunks++;
+
+        for (auto &entry : entries)
+        {
+            fn(kfvKey(entry), kfvFieldsValues(entry));
+        }
+
+        count += entries.size();
+    } while (cursor != "0");
+
+    return count;
+}
+
+
+RedisTableScanner::RedisTableScanner(RedisPipeline *pipeline, const Table &table, size_t chunkSize) :
+    WarmStartScanner(chunkSize),
+    m_pipeline(pipeline),
+    m_prefix(table.getTableName() + table.getTableNameSeparator())
+{
+    m_scanSha = m_pipeline->loadRedisScript(scanChunkScript);
+}
+
+
+std::string RedisTableScanner::scanChunk(const std::string &cursor, size_t count,
+                                         std::vector<KeyOpFieldsValuesTuple> &entries)
+{
+    RedisCommand command;
+    command.format(std::vector<std::string>({ "EVALSHA", m_scanSha, "0", cursor,
+                                              m_prefix + "*", std::to_string(count) }));
+
+    RedisReply r(m_pipeline->push(command, REDIS_REPLY_ARRAY));
+    redisReply *reply = r.getContext();
+
+    if (reply->elements == 0 || reply->element[0]->type != REDIS_REPLY_STRING)
+    {
+        throw std::runtime_error("Unexpected reply to SCAN of " + m_prefix);
+    }
+
+    for (size_t i = 1; i + 1 < reply->elements; i += 2)
+    {
+        redisReply *key = reply->element[i];
+        redisReply *values = reply->element[i + 1];
+
+        /* Skip the entries which have been removed meanwhile, like Table::get() */
+        if (values->type != REDIS_REPLY_ARRAY || values->elements == 0)
+        {
+            continue;
+        }
+
+        std::vector<FieldValueTuple> fv;
+        for (size_t j = 0; j + 1 < values->elements; j += 2)
+        {
+            fv.emplace_back(std::string(values->element[j]->str, values->element[j]->len),
+                            std::string(values->element[j + 1]->str, values->element[j + 1]->len));
+        }
+
+        entries.emplace_back(std::string(key->str + m_prefix.size(), key->len - m_prefix.size()),
+                             SET_COMMAND, std::move(fv));
+    }
+
+    return std::string(reply->element[0]->str, reply->element[0]->len);
+}
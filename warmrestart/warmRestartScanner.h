@@ -0,0 +1,92 @@
+#ifndef __WARMRESTART_SCANNER__
+#define __WARMRESTART_SCANNER__
+
+
+#include <stdint.h>
+#include <functional>
+#include <string>
+#include <vector>
+
+#include "table.h"
+
+
+/* Default number of keys requested from Redis per SCAN iteration */
+#define DEFAULT_WARM_START_SCAN_CHUNK   1000
+
+
+namespace swss {
+
+
+class RedisPipeline;
+
+
+/*
+ * Streaming restoration of an application table.
+ *
+ * The table is read a chunk of keys at a time, and every entry is handed to
+ * the callback and dropped before the next chunk is read, so the memory used
+ * doesn't grow with the size of the table the way Table::getContent() does.
+ *
+ * A key can be returned more than once when the table is modified while it's
+ * being scanned, the callback must be idempotent.
+ */
+class WarmStartScanner {
+  public:
+
+    typedef std::function<void(const std::string &,
+                               const std::vector<FieldValueTuple> &)> EntryFn;
+
+    WarmStartScanner(size_t chunkSize = DEFAULT_WARM_START_SCAN_CHUNK);
+
+    virtual ~WarmStartScanner() = default;
+
+    /* Call fn for every entry of the table, returns the number of entries read */
+    uint64_t scan(const EntryFn &fn);
+
+    uint64_t getChunks(void) const
+    {
+        return m_chunks;
+    }
+
+  protected:
+
+    /*
+     * Read the chunk at the cursor, "0" for the first one, and return the
+     * cursor of the next chunk, "0" once the whole table has been read
+     */
+    virtual std::string scanChunk(const std::string &cursor, size_t count,
+                                  std::vector<KeyOpFieldsValuesTuple> &entries) = 0;
+
+  private:
+
+    size_t   m_chunkSize;
+    uint64_t m_chunks;
+};
+
+
+/*
+ * Scanner of a table in Redis, getting the keys of a chunk with SCAN and their
+ * field-values with HGETALL in a single round trip through a lua script.
+ */
+class RedisTableScanner : public WarmStartScanner {
+  public:
+
+    RedisTableScanner(RedisPipeline *pipeline, const Table &table,
+                      size_t chunkSize = DEFAULT_WARM_START_SCAN_CHUNK);
+
+  protected:
+
+    std::string scanChunk(const std::string &cursor, size_t count,
+                          std::vector<KeyOpFieldsValuesTuple> &entries) override;
+
+  private:
+
+    RedisPipeline *m_pipeline;
+    std::string    m_prefix;      // table name and separator, to be removed from the keys
+    std::string    m_scanSha;
+};
+
+
+}
+
+#endif